@@ -0,0 +1,114 @@
+#!/usr/bin/env node
+/**
+ * Run the benchmark suite and compare it against a stored baseline.
+ *
+ * Usage:
+ *   node scripts/bench-compare.js             # compare against .bench/baseline.json
+ *   node scripts/bench-compare.js --save      # record a new baseline
+ *   node scripts/bench-compare.js --threshold 15
+ *
+ * Exits with code 1 when any benchmark's mean time regressed by more than the
+ * threshold (default 10%). Baselines are machine-specific and not committed:
+ * record one on the base branch, then compare on the feature branch.
+ */
+
+const { execSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+
+const BENCH_DIR = path.join(process.cwd(), '.bench');
+const BASELINE_FILE = path.join(BENCH_DIR, 'baseline.json');
+const CURRENT_FILE = path.join(BENCH_DIR, 'current.json');
+
+const args = process.argv.slice(2);
+const save = args.includes('--save');
+const thresholdIndex = args.indexOf('--threshold');
+const threshold = thresholdIndex >= 0 ? Number(args[thresholdIndex + 1]) : 10;
+
+if (!Number.isFinite(threshold) || threshold < 0) {
+    console.error('Error: --threshold must be a non-negative percentage');
+    process.exit(2);
+}
+
+fs.mkdirSync(BENCH_DIR, { recursive: true });
+const outputFile = save ? BASELINE_FILE : CURRENT_FILE;
+
+console.log('Running benchmarks...');
+execSync(
+    `npx vitest bench --run --project node --outputJson "${outputFile}"`,
+    { stdio: 'inherit', cwd: process.cwd() }
+);
+
+if (save) {
+    console.log(
+        `Baseline saved to ${path.relative(process.cwd(), BASELINE_FILE)}`
+    );
+    process.exit(0);
+}
+
+if (!fs.existsSync(BASELINE_FILE)) {
+    console.error(
+        'Error: no baseline found. Run `npm run bench:baseline` first.'
+    );
+    process.exit(2);
+}
+
+/**
+ * Flatten vitest's --outputJson report into "file > group > bench" -> mean (ms).
+ */
+function readMeans(file) {
+    const report = JSON.parse(fs.readFileSync(file, 'utf8'));
+    const means = new Map();
+    for (const benchFile of report.files ?? []) {
+        const fileName = path.basename(benchFile.filepath ?? '');
+        for (const group of benchFile.groups ?? []) {
+            for (const benchmark of group.benchmarks ?? []) {
+                const key = `${fileName} > ${group.fullName} > ${benchmark.name}`;
+                means.set(key, benchmark.mean);
+            }
+        }
+    }
+    return means;
+}
+
+const baseline = readMeans(BASELINE_FILE);
+const current = readMeans(CURRENT_FILE);
+const regressions = [];
+
+console.log('\nBenchmark comparison (mean time, lower is better)\n');
+for (const [key, mean] of current) {
+    const before = baseline.get(key);
+    if (before === undefined) {
+        console.log(`  new       ${key}: ${mean.toFixed(4)}ms`);
+        continue;
+    }
+    const change = ((mean - before) / before) * 100;
+    const status =
+        change > threshold
+            ? 'REGRESSED'
+            : change < -threshold
+              ? 'improved'
+              : 'same';
+    const sign = change >= 0 ? '+' : '';
+    console.log(
+        `  ${status.padEnd(9)} ${key}: ${before.toFixed(4)}ms -> ${mean.toFixed(4)}ms (${sign}${change.toFixed(1)}%)`
+    );
+    if (change > threshold) {
+        regressions.push(key);
+    }
+}
+
+for (const key of baseline.keys()) {
+    if (!current.has(key)) {
+        console.log(`  removed   ${key}`);
+    }
+}
+
+if (regressions.length > 0) {
+    console.error(
+        `\nFAILED: ${regressions.length} benchmark(s) regressed by more than ${threshold}%`
+    );
+    process.exit(1);
+}
+
+console.log(`\nOK: no regressions above ${threshold}%`);
@@ -0,0 +1,77 @@
+import { bench, describe } from 'vitest';
+import { generateSyntheticWorkspace } from '../__tests__/testUtils/syntheticRepo';
+import { formatReplayReport, runReplay } from './replay/replayHarness';
+import type { ReplayTranscript } from './replay/replayLLMClient';
+
+const workspace = generateSyntheticWorkspace({ files: 800, depth: 3 });
+
+/**
+ * A typical main-analysis shape: plan, look around, read a few files per
+ * turn, submit.
+ */
+function buildTranscript(rounds: number, readsPerRound: number) {
+    const sources = [...workspace.files.keys()].filter(
+        (file) =>
+            !workspace.ignoredByRoot.has(file) && /\.(ts|cpp|h)$/.test(file)
+    );
+    const plan =
+        '## PR Review Plan\n\n### Overview\nReplayed analysis.\n\n### Checklist\n- [ ] Review sources';
+    const transcript: ReplayTranscript = {
+        turns: [
+            {
+                toolCalls: [
+                    { name: 'update_plan', args: { plan } },
+                    {
+                        name: 'list_directory',
+                        args: { relative_path: 'src', recursive: true },
+                    },
+                ],
+            },
+        ],
+    };
+    for (let round = 0; round < rounds; round++) {
+        transcript.turns.push({
+            toolCalls: sources
+                .slice(round * readsPerRound, (round + 1) * readsPerRound)
+                .map((file) => ({
+                    name: 'read_file',
+                    args: { file_path: file },
+                })),
+        });
+    }
+    transcript.turns.push({
+        toolCalls: [
+            {
+                name: 'submit_review',
+                args: {
+                    review_content:
+                        '## Summary\n\nReplayed review with no findings.',
+                },
+            },
+        ],
+    });
+    return transcript;
+}
+
+const shortAnalysis = buildTranscript(5, 3);
+const longAnalysis = buildTranscript(30, 4);
+
+// Bench output only has totals; print where the time of one run goes
+const sampleReport = await runReplay(longAnalysis, { workspace });
+if (sampleReport.failedToolCalls > 0) {
+    // Failed calls return early and would make the replay look fast
+    throw new Error(
+        `${sampleReport.failedToolCalls} replayed tool calls failed; check the transcript's tool names and paths`
+    );
+}
+console.log(`Replay phases (32 turns): ${formatReplayReport(sampleReport)}`);
+
+describe('Analysis replay', () => {
+    bench('7 turns, 15 file reads', async () => {
+        await runReplay(shortAnalysis, { workspace });
+    });
+
+    bench('32 turns, 120 file reads', async () => {
+        await runReplay(longAnalysis, { workspace });
+    });
+});
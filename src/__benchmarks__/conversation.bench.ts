@@ -0,0 +1,46 @@
+import { bench, describe } from 'vitest';
+import type * as vscode from 'vscode';
+import { TokenValidator } from '../models/tokenValidator';
+import { ConversationManager } from '../models/conversationManager';
+import { TokenConstants } from '../models/tokenConstants';
+import { generateToolConversation } from './fixtures';
+
+/**
+ * Model stub with a chars/token estimate, so cleanup cost reflects the
+ * validator's own work rather than a real tokenizer.
+ */
+const model = {
+    maxInputTokens: 32_000,
+    countTokens: async (text: string) =>
+        Math.ceil(text.length / TokenConstants.CHARS_PER_TOKEN_ESTIMATE),
+} as unknown as vscode.LanguageModelChat;
+
+// ~40 rounds x 3 tool results x 2 KB: well past 80% of the stub's window
+const longConversation = generateToolConversation(40, 3, 2000);
+
+describe('TokenValidator.cleanupContext', () => {
+    const validator = new TokenValidator(model);
+
+    bench('trim 40-round conversation to 80%', async () => {
+        await validator.cleanupContext(longConversation, 'System prompt');
+    });
+
+    bench('validateTokens on 40-round conversation', async () => {
+        await validator.validateTokens(longConversation, 'System prompt');
+    });
+});
+
+describe('ConversationManager', () => {
+    const messages = generateToolConversation(50, 3, 1000);
+
+    bench('grow to 200 messages, reading history each turn', () => {
+        const conversation = new ConversationManager();
+        for (const message of messages) {
+            if (message.role === 'system') {
+                continue;
+            }
+            conversation.addMessage({ ...message, role: message.role });
+            conversation.getHistory();
+        }
+    });
+});
@@ -0,0 +1,39 @@
+import { bench, describe } from 'vitest';
+import { DiffUtils } from '../utils/diffUtils';
+import { filterBinaryDiffs } from '../services/gitService';
+import { generateSyntheticDiff } from '../__tests__/testUtils/syntheticRepo';
+
+// ~40 KB and ~3 MB diffs: a typical feature branch and a large refactor
+const mix = { binaryRatio: 0.1, renameRatio: 0.05, whitespaceRatio: 0.1 };
+const smallDiff = generateSyntheticDiff({
+    files: 20,
+    hunksPerFile: 3,
+    linesPerHunk: 15,
+    ...mix,
+});
+const largeDiff = generateSyntheticDiff({
+    files: 400,
+    hunksPerFile: 8,
+    linesPerHunk: 20,
+    ...mix,
+});
+
+describe('DiffUtils.parseDiff', () => {
+    bench('20 files', () => {
+        DiffUtils.parseDiff(smallDiff);
+    });
+
+    bench('400 files', () => {
+        DiffUtils.parseDiff(largeDiff);
+    });
+});
+
+describe('filterBinaryDiffs', () => {
+    bench('20 files', () => {
+        filterBinaryDiffs(smallDiff);
+    });
+
+    bench('400 files', () => {
+        filterBinaryDiffs(largeDiff);
+    });
+});
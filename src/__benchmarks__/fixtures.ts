@@ -0,0 +1,179 @@
+/**
+ * Deterministic fixtures for the benchmark suite.
+ *
+ * Every generator takes a seed so that runs on different machines (and the
+ * stored baseline) measure exactly the same input. Workspace and diff
+ * generators shared with the scale tests live in testUtils/syntheticRepo.
+ */
+import * as vscode from 'vscode';
+import type { RipgrepFileResult } from '../services/ripgrepSearchService';
+import type { ToolCallMessage } from '../types/modelTypes';
+import {
+    createRandom,
+    pick,
+    codeLine,
+} from '../__tests__/testUtils/syntheticRepo';
+
+/**
+ * Generate ripgrep `--json` output lines: begin/match/context/end per file.
+ */
+export function generateRipgrepJsonLines(
+    files: number,
+    matchesPerFile: number,
+    seed = 2
+): string[] {
+    const random = createRandom(seed);
+    const lines: string[] = [];
+
+    for (let file = 0; file < files; file++) {
+        const path = { text: `./src/module${file % 20}/file${file}.ts` };
+        lines.push(JSON.stringify({ type: 'begin', data: { path } }));
+
+        let lineNumber = 1;
+        for (let i = 0; i < matchesPerFile; i++) {
+            lineNumber += 1 + Math.floor(random() * 6);
+            const type = random() < 0.5 ? 'match' : 'context';
+            lines.push(
+                JSON.stringify({
+                    type,
+                    data: {
+                        path,
+                        lines: { text: `${codeLine(random)}\n` },
+                        line_number: lineNumber,
+                        absolute_offset: lineNumber * 40,
+                        submatches: [],
+                    },
+                })
+            );
+        }
+
+        lines.push(JSON.stringify({ type: 'end', data: { path } }));
+    }
+
+    return lines;
+}
+
+/**
+ * Generate already-collected ripgrep results, matches deliberately unsorted.
+ */
+export function generateRipgrepResults(
+    files: number,
+    matchesPerFile: number,
+    seed = 3
+): RipgrepFileResult[] {
+    const random = createRandom(seed);
+    return Array.from({ length: files }, (_, file) => ({
+        filePath: `src/module${file % 20}/file${file}.ts`,
+        matches: Array.from({ length: matchesPerFile }, () => ({
+            filePath: `src/module${file % 20}/file${file}.ts`,
+            lineNumber: 1 + Math.floor(random() * 2000),
+            content: codeLine(random),
+            isContext: random() < 0.5,
+        })),
+    }));
+}
+
+function symbolRange(line: number, length: number): vscode.Range {
+    return {
+        start: { line, character: 0 },
+        end: { line: line + length, character: 0 },
+    } as vscode.Range;
+}
+
+/**
+ * Generate a DocumentSymbol tree: `breadth` symbols per level, `depth` levels.
+ */
+export function generateDocumentSymbols(
+    breadth: number,
+    depth: number
+): vscode.DocumentSymbol[] {
+    let line = 0;
+    const build = (level: number, prefix: string): vscode.DocumentSymbol[] =>
+        Array.from({ length: breadth }, (_, i) => {
+            const name = `${prefix}${level === 0 ? 'Class' : 'member'}${i}`;
+            const start = line;
+            line += 3;
+            const children =
+                level + 1 < depth ? build(level + 1, `${name}_`) : [];
+            const range = symbolRange(start, line - start);
+            return {
+                name: level === 0 ? name : `${name}()`,
+                detail: '',
+                kind:
+                    level === 0
+                        ? vscode.SymbolKind.Class
+                        : vscode.SymbolKind.Method,
+                range,
+                selectionRange: range,
+                children,
+            } as vscode.DocumentSymbol;
+        });
+
+    return build(0, '');
+}
+
+/**
+ * Generate workspace symbols spread over nested C++-style namespaces.
+ */
+export function generateWorkspaceSymbols(
+    count: number,
+    seed = 4
+): vscode.SymbolInformation[] {
+    const random = createRandom(seed);
+    const namespaces = ['core', 'net', 'io', 'ui', 'util'];
+    return Array.from({ length: count }, (_, i) => {
+        const container = [
+            pick(random, namespaces),
+            pick(random, namespaces),
+            `Class${i % 50}`,
+        ].join('::');
+        return {
+            name: `${pick(random, WORDS)}${i % 200}(int, const std::string&)`,
+            containerName: container,
+            kind: vscode.SymbolKind.Method,
+            location: {} as vscode.Location,
+        } as vscode.SymbolInformation;
+    });
+}
+
+/**
+ * Generate a tool-calling conversation: a user prompt followed by `rounds` of
+ * assistant tool calls, each answered by `toolsPerRound` tool results.
+ */
+export function generateToolConversation(
+    rounds: number,
+    toolsPerRound: number,
+    resultChars: number
+): ToolCallMessage[] {
+    const random = createRandom(5);
+    const messages: ToolCallMessage[] = [
+        { role: 'user', content: 'Review this diff.' },
+    ];
+
+    for (let round = 0; round < rounds; round++) {
+        const ids = Array.from(
+            { length: toolsPerRound },
+            (_, i) => `call_${round}_${i}`
+        );
+        messages.push({
+            role: 'assistant',
+            content: 'Reading related files.',
+            toolCalls: ids.map((id) => ({
+                id,
+                function: {
+                    name: 'read_file',
+                    arguments: JSON.stringify({ file_path: `src/${id}.ts` }),
+                },
+            })),
+        });
+        for (const id of ids) {
+            let content = '';
+            while (content.length < resultChars) {
+                content += codeLine(random) + '\n';
+            }
+            messages.push({ role: 'tool', content, toolCallId: id });
+        }
+    }
+
+    return messages;
+}
@@ -0,0 +1,182 @@
+import { vi } from 'vitest';
+import * as vscode from 'vscode';
+import {
+    ConversationRunner,
+    type ConversationPhaseTimings,
+} from '../../models/conversationRunner';
+import { ConversationManager } from '../../models/conversationManager';
+import { ToolRegistry } from '../../models/toolRegistry';
+import { ToolExecutor } from '../../models/toolExecutor';
+import { PlanSessionManager } from '../../services/planSessionManager';
+import type { GitOperationsManager } from '../../services/gitOperationsManager';
+import { ListDirTool } from '../../tools/listDirTool';
+import { ReadFileTool } from '../../tools/readFileTool';
+import { UpdatePlanTool } from '../../tools/updatePlanTool';
+import { SubmitReviewTool } from '../../tools/submitReviewTool';
+import { ThinkAboutContextTool } from '../../tools/thinkAboutContextTool';
+import { ThinkAboutTaskTool } from '../../tools/thinkAboutTaskTool';
+import { ThinkAboutCompletionTool } from '../../tools/thinkAboutCompletionTool';
+import {
+    createWorkspaceFsStub,
+    type SyntheticWorkspace,
+} from '../../__tests__/testUtils/syntheticRepo';
+import {
+    createMockCancellationTokenSource,
+    createMockExecutionContext,
+    createMockGitRepositoryWithConfig,
+    createMockWorkspaceSettings,
+} from '../../__tests__/testUtils/mockFactories';
+import {
+    ReplayLLMClient,
+    type ReplayLLMClientOptions,
+    type ReplayTranscript,
+} from './replayLLMClient';
+
+const REPO_ROOT = '/replay/repo';
+
+export interface ReplayOptions extends ReplayLLMClientOptions {
+    /** Fixture the replayed tool calls run against */
+    workspace: SyntheticWorkspace;
+    /** Initial user message; stands in for the diff prompt */
+    prompt?: string;
+}
+
+/**
+ * Wall time of one replayed analysis, split by phase.
+ */
+export interface ReplayReport {
+    wallMs: number;
+    phases: ConversationPhaseTimings & {
+        /** convertMessages() inside the client, taken out of llmWaitMs */
+        messageConversionMs: number;
+    };
+    iterations: number;
+    toolCalls: number;
+    /** Calls that errored, e.g. a recorded path missing from the fixture */
+    failedToolCalls: number;
+    /** Names of the calls that ran successfully, in completion order */
+    succeededTools: string[];
+    /** Final review returned by the runner */
+    result: string;
+}
+
+/**
+ * Replay a transcript through the real ConversationRunner, ToolExecutor and
+ * tools, with vscode.workspace.fs served from the fixture workspace.
+ *
+ * Only tools that work off workspace.fs are registered; LSP and ripgrep tools
+ * and subagents need services the mocked vscode API can't provide.
+ */
+export async function runReplay(
+    transcript: ReplayTranscript,
+    options: ReplayOptions
+): Promise<ReplayReport> {
+    const stub = createWorkspaceFsStub(options.workspace, REPO_ROOT);
+    vi.mocked(vscode.workspace.fs.readDirectory).mockImplementation(
+        stub.readDirectory
+    );
+    vi.mocked(vscode.workspace.fs.readFile).mockImplementation(stub.readFile);
+    vi.mocked(vscode.workspace.fs.stat).mockImplementation(stub.stat);
+
+    const gitOperationsManager = {
+        getRepository: () => createMockGitRepositoryWithConfig(REPO_ROOT),
+    } as unknown as GitOperationsManager;
+
+    const registry = new ToolRegistry();
+    const tools = [
+        new ListDirTool(gitOperationsManager),
+        new ReadFileTool(gitOperationsManager),
+        new UpdatePlanTool(),
+        new ThinkAboutContextTool(),
+        new ThinkAboutTaskTool(),
+        new ThinkAboutCompletionTool(),
+        new SubmitReviewTool(),
+    ];
+    for (const tool of tools) {
+        registry.registerTool(tool);
+    }
+
+    const tokenSource = createMockCancellationTokenSource();
+    const context = createMockExecutionContext({
+        cancellationToken: tokenSource.token,
+        planManager: new PlanSessionManager(),
+    });
+    const totalToolCalls = transcript.turns.reduce(
+        (sum, turn) => sum + (turn.toolCalls?.length ?? 0),
+        0
+    );
+    const toolExecutor = new ToolExecutor(
+        registry,
+        createMockWorkspaceSettings({ maxIterations: totalToolCalls + 1 }),
+        context
+    );
+    const client = new ReplayLLMClient(transcript, {
+        maxInputTokens: 128_000,
+        ...options,
+    });
+    const runner = new ConversationRunner(client, toolExecutor);
+
+    const conversation = new ConversationManager();
+    conversation.addUserMessage(
+        options.prompt ?? 'Review the changes in this repository.'
+    );
+
+    let toolCalls = 0;
+    let failedToolCalls = 0;
+    const succeededTools: string[] = [];
+    const start = performance.now();
+    const result = await runner.run(
+        {
+            systemPrompt: 'You are replaying a recorded pull request review.',
+            maxIterations: transcript.turns.length + 1,
+            tools,
+            label: 'Replay',
+            requiresExplicitCompletion: true,
+        },
+        conversation,
+        tokenSource.token,
+        {
+            onToolCallComplete: (_id, name, _args, _result, success) => {
+                toolCalls++;
+                if (success) {
+                    succeededTools.push(name);
+                } else {
+                    failedToolCalls++;
+                }
+            },
+        }
+    );
+    const wallMs = performance.now() - start;
+
+    const phases = runner.phaseTimings;
+    return {
+        wallMs,
+        phases: {
+            ...phases,
+            llmWaitMs: Math.max(0, phases.llmWaitMs - client.conversionMs),
+            messageConversionMs: client.conversionMs,
+        },
+        iterations: runner.iterationsUsed,
+        toolCalls,
+        failedToolCalls,
+        succeededTools,
+        result,
+    };
+}
+
+/**
+ * One-line phase breakdown for bench output, e.g.
+ * "wall 41.2ms | llm 0.3 | conversion 6.1 | tools 28.4 | tokens 3.9 | prep 1.2".
+ */
+export function formatReplayReport(report: ReplayReport): string {
+    const ms = (value: number) => value.toFixed(1);
+    const { phases } = report;
+    return (
+        `wall ${ms(report.wallMs)}ms | llm ${ms(phases.llmWaitMs)}` +
+        ` | conversion ${ms(phases.messageConversionMs)}` +
+        ` | tools ${ms(phases.toolExecutionMs)}` +
+        ` | tokens ${ms(phases.tokenAccountingMs)}` +
+        ` | prep ${ms(phases.messagePreparationMs)}` +
+        ` (${report.iterations} iterations, ${report.toolCalls} tool calls)`
+    );
+}
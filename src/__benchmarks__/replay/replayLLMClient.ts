@@ -0,0 +1,194 @@
+import type { CancellationToken, LanguageModelChat } from 'vscode';
+import type { ILLMClient } from '../../models/ILLMClient';
+import { ModelRequestHandler } from '../../models/modelRequestHandler';
+import { TokenConstants } from '../../models/tokenConstants';
+import type {
+    ToolCall,
+    ToolCallRequest,
+    ToolCallResponse,
+} from '../../types/modelTypes';
+import type { ToolCallRecord } from '../../types/toolCallTypes';
+
+/**
+ * One model response in a recorded analysis.
+ */
+export interface ReplayTurn {
+    /** Assistant text returned alongside (or instead of) tool calls */
+    content?: string;
+    toolCalls?: { name: string; args: Record<string, unknown> }[];
+    /** Recorded model latency; only waited for when simulateLatency is set */
+    latencyMs?: number;
+}
+
+/**
+ * A recorded analysis: the sequence of model responses, replayed in order
+ * regardless of what the runner sends.
+ */
+export interface ReplayTranscript {
+    turns: ReplayTurn[];
+}
+
+export interface ReplayLLMClientOptions {
+    /** Sleep for each turn's recorded latency (default false: measure overhead only) */
+    simulateLatency?: boolean;
+    /** Context window reported by the stub model */
+    maxInputTokens?: number;
+}
+
+/**
+ * ILLMClient that replays a recorded transcript instead of calling a model.
+ *
+ * Requests still go through ModelRequestHandler.convertMessages() so the cost
+ * of converting the growing history is measured, and tool calls are reported
+ * through onToolCall exactly as the streaming client would.
+ */
+export class ReplayLLMClient implements ILLMClient {
+    private turnIndex = 0;
+    private _conversionMs = 0;
+    private _requestCount = 0;
+    private readonly model: LanguageModelChat;
+
+    constructor(
+        private readonly transcript: ReplayTranscript,
+        private readonly options: ReplayLLMClientOptions = {}
+    ) {
+        this.model = {
+            id: 'replay',
+            name: 'Replay',
+            vendor: 'replay',
+            family: 'replay',
+            version: '1',
+            maxInputTokens:
+                options.maxInputTokens ??
+                TokenConstants.DEFAULT_MAX_INPUT_TOKENS,
+            countTokens: async (text: unknown) =>
+                Math.ceil(
+                    (typeof text === 'string'
+                        ? text.length
+                        : JSON.stringify(text).length) /
+                        TokenConstants.CHARS_PER_TOKEN_ESTIMATE
+                ),
+        } as unknown as LanguageModelChat;
+    }
+
+    /** Time spent converting request messages to the VS Code format */
+    get conversionMs(): number {
+        return this._conversionMs;
+    }
+
+    get requestCount(): number {
+        return this._requestCount;
+    }
+
+    /** Whether every recorded turn has been served */
+    get exhausted(): boolean {
+        return this.turnIndex >= this.transcript.turns.length;
+    }
+
+    async sendRequest(
+        request: ToolCallRequest,
+        _token: CancellationToken
+    ): Promise<ToolCallResponse> {
+        this._requestCount++;
+
+        const start = performance.now();
+        ModelRequestHandler.convertMessages(request.messages);
+        this._conversionMs += performance.now() - start;
+
+        const turn = this.transcript.turns[this.turnIndex];
+        if (!turn) {
+            return { content: 'Replay transcript exhausted.' };
+        }
+        const turnNumber = this.turnIndex++;
+
+        if (this.options.simulateLatency && turn.latencyMs) {
+            await new Promise((resolve) =>
+                setTimeout(resolve, turn.latencyMs)
+            );
+        }
+
+        const toolCalls: ToolCall[] = (turn.toolCalls ?? []).map(
+            (call, i) => ({
+                id: `replay_${turnNumber}_${i}`,
+                function: {
+                    name: call.name,
+                    arguments: JSON.stringify(call.args),
+                },
+            })
+        );
+        for (const toolCall of toolCalls) {
+            request.onToolCall?.(toolCall);
+        }
+
+        return {
+            content: turn.content ?? null,
+            toolCalls: toolCalls.length > 0 ? toolCalls : undefined,
+        };
+    }
+
+    async getCurrentModel(): Promise<LanguageModelChat> {
+        return this.model;
+    }
+}
+
+/**
+ * Rebuild a transcript from an analysis's tool call records.
+ *
+ * Calls from one model response are started together, so records are grouped
+ * into turns by start-time proximity. The gap between one batch finishing and
+ * the next one starting is recorded as model latency.
+ *
+ * @param finalReview Review content for a closing submit_review turn, added
+ *   when the records don't already end with one
+ */
+export function transcriptFromToolCallRecords(
+    records: ToolCallRecord[],
+    options: { finalReview?: string; batchWindowMs?: number } = {}
+): ReplayTranscript {
+    const batchWindowMs = options.batchWindowMs ?? 50;
+    const sorted = [...records].sort((a, b) => a.timestamp - b.timestamp);
+    const turns: ReplayTurn[] = [];
+    let batchStart = -Infinity;
+    let batchEnd: number | undefined;
+    let current: ReplayTurn | undefined;
+
+    for (const record of sorted) {
+        if (!current || record.timestamp - batchStart > batchWindowMs) {
+            current = {
+                toolCalls: [],
+                latencyMs:
+                    batchEnd !== undefined
+                        ? Math.max(0, Math.round(record.timestamp - batchEnd))
+                        : undefined,
+            };
+            turns.push(current);
+            batchStart = record.timestamp;
+        }
+        current.toolCalls!.push({
+            name: record.toolName,
+            args: record.arguments,
+        });
+        batchEnd = Math.max(
+            batchEnd ?? 0,
+            record.timestamp + (record.durationMs ?? 0)
+        );
+    }
+
+    const last = sorted[sorted.length - 1];
+    if (last?.toolName !== 'submit_review') {
+        turns.push({
+            toolCalls: [
+                {
+                    name: 'submit_review',
+                    args: {
+                        review_content:
+                            options.finalReview ??
+                            '## Summary\n\nReplayed review: no findings recorded.',
+                    },
+                },
+            ],
+        });
+    }
+
+    return { turns };
+}
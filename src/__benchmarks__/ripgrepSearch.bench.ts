@@ -0,0 +1,36 @@
+import { bench, describe } from 'vitest';
+import {
+    RipgrepSearchService,
+    type RipgrepMatch,
+} from '../services/ripgrepSearchService';
+import { generateRipgrepJsonLines, generateRipgrepResults } from './fixtures';
+
+// No fs mock needed: the rg path is only resolved when a search spawns rg,
+// and these benchmarks only parse and format output
+const service = new RipgrepSearchService();
+const jsonLines = generateRipgrepJsonLines(200, 50);
+const results = generateRipgrepResults(200, 50);
+
+// processMessage is private; benchmarks drive it the way the stdout handler does
+const processMessage = (
+    service as unknown as {
+        processMessage(
+            message: unknown,
+            results: Map<string, RipgrepMatch[]>,
+            cwd: string
+        ): void;
+    }
+).processMessage.bind(service);
+
+describe('RipgrepSearchService', () => {
+    bench('processMessage: parse 10k JSON lines', () => {
+        const collected = new Map<string, RipgrepMatch[]>();
+        for (const line of jsonLines) {
+            processMessage(JSON.parse(line), collected, '/workspace');
+        }
+    });
+
+    bench('formatResults: 200 files x 50 matches', () => {
+        service.formatResults(results);
+    });
+});
@@ -0,0 +1,55 @@
+import { bench, describe } from 'vitest';
+import { SymbolMatcher } from '../utils/symbolMatcher';
+import { SymbolFormatter } from '../utils/symbolFormatter';
+import { generateDocumentSymbols, generateWorkspaceSymbols } from './fixtures';
+
+const workspaceSymbols = generateWorkspaceSymbols(5000);
+// 10 classes x 10 members x 10 nested = 1110 symbols
+const documentSymbols = generateDocumentSymbols(10, 3);
+
+describe('SymbolMatcher', () => {
+    bench('matchesWorkspaceSymbol: single segment', () => {
+        for (const symbol of workspaceSymbols) {
+            SymbolMatcher.matchesWorkspaceSymbol(symbol, ['value42']);
+        }
+    });
+
+    bench('matchesWorkspaceSymbol: Container/name', () => {
+        for (const symbol of workspaceSymbols) {
+            SymbolMatcher.matchesWorkspaceSymbol(symbol, [
+                'Class7',
+                'value42',
+            ]);
+        }
+    });
+
+    bench('matchesWorkspaceSymbol: nested path', () => {
+        for (const symbol of workspaceSymbols) {
+            SymbolMatcher.matchesWorkspaceSymbol(symbol, [
+                'net',
+                'Class7',
+                'value42',
+            ]);
+        }
+    });
+});
+
+describe('SymbolFormatter.formatSymbolsWithHierarchy', () => {
+    bench('1110 symbols with hierarchy', () => {
+        SymbolFormatter.formatSymbolsWithHierarchy(documentSymbols, undefined, {
+            maxDepth: -1,
+            showHierarchy: true,
+            includeBody: false,
+            maxSymbols: 5000,
+        });
+    });
+
+    bench('truncated at 100 symbols', () => {
+        SymbolFormatter.formatSymbolsWithHierarchy(documentSymbols, undefined, {
+            maxDepth: -1,
+            showHierarchy: true,
+            includeBody: false,
+            maxSymbols: 100,
+        });
+    });
+});
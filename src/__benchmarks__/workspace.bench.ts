@@ -0,0 +1,106 @@
+import { bench, describe, vi } from 'vitest';
+import * as vscode from 'vscode';
+import { promises as fs, rmSync } from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import ignore from 'ignore';
+import { FileDiscoverer } from '../utils/fileDiscoverer';
+import { SymbolExtractor } from '../utils/symbolExtractor';
+import { ListDirTool } from '../tools/listDirTool';
+import type { GitOperationsManager } from '../services/gitOperationsManager';
+import type { Repository } from '../types/vscodeGitExtension';
+import {
+    generateSyntheticWorkspace,
+    writeSyntheticWorkspace,
+    createWorkspaceFsStub,
+} from '../__tests__/testUtils/syntheticRepo';
+import { createMockCancellationTokenSource } from '../__tests__/testUtils/mockFactories';
+
+// ~11k files in ~1.5k directories: a mid-sized monorepo
+const workspace = generateSyntheticWorkspace({
+    files: 6000,
+    depth: 4,
+    dirsPerLevel: 5,
+    generatedRatio: 0.3,
+});
+
+const REPO_ROOT = '/synthetic/repo';
+const rootDir = await fs.mkdtemp(path.join(os.tmpdir(), 'lupa-bench-'));
+await writeSyntheticWorkspace(workspace, rootDir);
+process.on('exit', () => rmSync(rootDir, { recursive: true, force: true }));
+
+const diskRepository = {
+    rootUri: { fsPath: rootDir },
+    getGlobalConfig: async () => null,
+} as unknown as Repository;
+const gitOperationsManager = {
+    getRepository: () => ({
+        rootUri: { fsPath: REPO_ROOT },
+        getGlobalConfig: async () => null,
+    }),
+} as unknown as GitOperationsManager;
+
+const token = createMockCancellationTokenSource().token;
+
+/** Serve the workspace through the mocked vscode.workspace.fs */
+const useFsStub = (root: string) => () => {
+    const stub = createWorkspaceFsStub(workspace, root);
+    vi.mocked(vscode.workspace.fs.readDirectory).mockImplementation(
+        stub.readDirectory
+    );
+    vi.mocked(vscode.workspace.fs.readFile).mockImplementation(stub.readFile);
+};
+
+describe('FileDiscoverer.discoverFiles (on disk)', () => {
+    bench(
+        'all files, root .gitignore',
+        async () => {
+            await FileDiscoverer.discoverFiles(diskRepository, {
+                includePattern: '**/*',
+                maxResults: 100_000,
+                cancellationToken: token,
+            });
+        },
+        { setup: useFsStub(rootDir) }
+    );
+
+    bench(
+        '*.cpp with exclude pattern',
+        async () => {
+            await FileDiscoverer.discoverFiles(diskRepository, {
+                includePattern: '*.cpp',
+                excludePattern: '**/util*/**',
+                cancellationToken: token,
+            });
+        },
+        { setup: useFsStub(rootDir) }
+    );
+});
+
+describe('workspace.fs directory walks', () => {
+    const ig = ignore().add(workspace.files.get('.gitignore')!);
+
+    bench(
+        'SymbolExtractor.getAllFiles',
+        async () => {
+            await new SymbolExtractor(gitOperationsManager).getAllFiles(
+                REPO_ROOT,
+                '.',
+                ig,
+                { token }
+            );
+        },
+        { setup: useFsStub(REPO_ROOT) }
+    );
+
+    bench(
+        'ListDirTool recursive from root',
+        async () => {
+            await new ListDirTool(gitOperationsManager).execute(
+                { relative_path: '.', recursive: true },
+                { cancellationToken: token }
+            );
+        },
+        { setup: useFsStub(REPO_ROOT) }
+    );
+});
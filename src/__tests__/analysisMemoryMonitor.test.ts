@@ -0,0 +1,147 @@
+import { describe, it, expect, vi } from 'vitest';
+import {
+    AnalysisMemoryMonitor,
+    compactToolCallRecords,
+    estimateToolRecordBytes,
+} from '../services/analysisMemoryMonitor';
+import type { ToolCallRecord } from '../types/toolCallTypes';
+
+vi.mock('../services/loggingService', () => ({
+    Log: {
+        info: vi.fn(),
+        debug: vi.fn(),
+        error: vi.fn(),
+        warn: vi.fn(),
+    },
+}));
+
+const MB = 1024 * 1024;
+const retained = { conversation: 0, toolRecords: 0, diff: 0 };
+
+/** Memory reader returning the given heapUsed values in order (in MB) */
+const heapSequence = (...heapMB: number[]) => {
+    let index = 0;
+    return () => {
+        const heapUsed = heapMB[Math.min(index++, heapMB.length - 1)]! * MB;
+        return { heapUsed, rss: heapUsed * 2, external: 0 };
+    };
+};
+
+const createRecord = (
+    result: string,
+    nestedCalls?: ToolCallRecord[]
+): ToolCallRecord => ({
+    id: 'call_1',
+    toolName: 'read_file',
+    arguments: { file_path: 'a.ts' },
+    result,
+    success: true,
+    error: undefined,
+    durationMs: 5,
+    timestamp: 0,
+    nestedCalls,
+});
+
+describe('AnalysisMemoryMonitor', () => {
+    it('should track the baseline, peaks and samples', () => {
+        const monitor = new AnalysisMemoryMonitor(
+            1000 * MB,
+            heapSequence(100, 300, 200)
+        );
+
+        monitor.sample(1, { conversation: 10, toolRecords: 20, diff: 30 });
+        monitor.sample(2, retained);
+
+        const report = monitor.report();
+        expect(report.baselineHeapUsed).toBe(100 * MB);
+        expect(report.peakHeapUsed).toBe(300 * MB);
+        expect(report.peakRss).toBe(600 * MB);
+        expect(report.samples).toHaveLength(2);
+        expect(report.samples[0]).toMatchObject({
+            iteration: 1,
+            heapUsed: 300 * MB,
+            retained: { conversation: 10, toolRecords: 20, diff: 30 },
+        });
+    });
+
+    it('should not compact while under budget', () => {
+        const monitor = new AnalysisMemoryMonitor(
+            500 * MB,
+            heapSequence(100, 400)
+        );
+
+        expect(monitor.sample(1, retained)).toBe('none');
+        expect(monitor.report().toolResultCompactions).toBe(0);
+    });
+
+    it('should compact tool results first and history if still over budget', () => {
+        const monitor = new AnalysisMemoryMonitor(
+            500 * MB,
+            heapSequence(100, 600, 600, 600)
+        );
+
+        expect(monitor.sample(1, retained)).toBe('toolResults');
+        expect(monitor.sample(2, retained)).toBe('history');
+        // History is compacted once per over-budget episode
+        expect(monitor.sample(3, retained)).toBe('toolResults');
+
+        const report = monitor.report();
+        expect(report.toolResultCompactions).toBe(3);
+        expect(report.historyCompactions).toBe(1);
+    });
+
+    it('should allow history compaction again after dropping under budget', () => {
+        const monitor = new AnalysisMemoryMonitor(
+            500 * MB,
+            heapSequence(100, 600, 600, 400, 600, 600)
+        );
+
+        expect(monitor.sample(1, retained)).toBe('toolResults');
+        expect(monitor.sample(2, retained)).toBe('history');
+        expect(monitor.sample(3, retained)).toBe('none');
+        expect(monitor.sample(4, retained)).toBe('toolResults');
+        expect(monitor.sample(5, retained)).toBe('history');
+    });
+});
+
+describe('compactToolCallRecords', () => {
+    it('should cut long results to a preview and leave short ones', () => {
+        const records = [createRecord('x'.repeat(5000)), createRecord('short')];
+
+        const dropped = compactToolCallRecords(records, 100);
+
+        expect(dropped).toBe(4900);
+        expect(records[0]!.result).toMatch(/^x{100}\n\n\[\.\.\. 4900 /);
+        expect(records[1]!.result).toBe('short');
+    });
+
+    it('should compact inline nested calls', () => {
+        const nested = [createRecord('y'.repeat(1000))];
+        const records = [createRecord('ok', nested)];
+
+        expect(compactToolCallRecords(records, 100)).toBe(900);
+        expect((nested[0]!.result as string).startsWith('y'.repeat(100))).toBe(
+            true
+        );
+    });
+
+    it('should leave already compacted results alone', () => {
+        const records = [createRecord('x'.repeat(5000))];
+        compactToolCallRecords(records, 100);
+        const compacted = records[0]!.result;
+
+        expect(compactToolCallRecords(records, 100)).toBe(0);
+        expect(records[0]!.result).toBe(compacted);
+    });
+});
+
+describe('estimateToolRecordBytes', () => {
+    it('should count results, arguments and nested calls at two bytes per char', () => {
+        const argsLength = JSON.stringify({ file_path: 'a.ts' }).length;
+        const records = [createRecord('abcd', [createRecord('ef')])];
+
+        expect(estimateToolRecordBytes(records)).toBe(
+            (4 + 2 + 2 * argsLength) * 2
+        );
+    });
+});
@@ -0,0 +1,190 @@
+import { describe, it, expect } from 'vitest';
+import {
+    AnalysisPanelData,
+    batchBySize,
+    splitDiffByFile,
+} from '../services/analysisPanelData';
+import type { ToolCallRecord, ToolCallsData } from '../types/toolCallTypes';
+
+const createRecord = (
+    id: string,
+    result: string,
+    nestedCalls?: ToolCallRecord[]
+): ToolCallRecord => ({
+    id,
+    toolName: 'read_file',
+    arguments: { file_path: 'a.ts' },
+    result,
+    success: true,
+    error: undefined,
+    durationMs: 5,
+    timestamp: 0,
+    nestedCalls,
+});
+
+const createToolCalls = (calls: ToolCallRecord[]): ToolCallsData => ({
+    calls,
+    totalCalls: calls.length,
+    successfulCalls: calls.length,
+    failedCalls: 0,
+    analysisCompleted: true,
+    analysisError: undefined,
+});
+
+describe('splitDiffByFile', () => {
+    it('should split at git headers and count changes per file', () => {
+        const files = splitDiffByFile(
+            [
+                'diff --git a/a.ts b/a.ts',
+                'index 123..456 100644',
+                '--- a/a.ts',
+                '+++ b/a.ts',
+                '@@ -1,2 +1,3 @@',
+                ' context',
+                '-removed',
+                '+added',
+                '+added again',
+                'diff --git a/old.ts b/new.ts',
+                'similarity index 90%',
+                'rename from old.ts',
+                'rename to new.ts',
+                '--- a/old.ts',
+                '+++ b/new.ts',
+                '@@ -1 +1 @@',
+                '--- looks like a header',
+                '+++ looks like a header',
+                '@@ -10 +10 @@',
+                '-x',
+                '\\ No newline at end of file',
+            ].join('\n')
+        );
+
+        expect(files.map((file) => file.summary)).toEqual([
+            {
+                oldPath: 'a.ts',
+                newPath: 'a.ts',
+                additions: 2,
+                deletions: 1,
+                lines: 4,
+                hunks: 1,
+            },
+            {
+                oldPath: 'old.ts',
+                newPath: 'new.ts',
+                additions: 1,
+                deletions: 2,
+                lines: 3,
+                hunks: 2,
+            },
+        ]);
+        expect(files[0]!.text.endsWith('+added again\n')).toBe(true);
+        expect(files[1]!.text.startsWith('diff --git a/old.ts')).toBe(true);
+    });
+
+    it('should keep a diff without git headers as one file', () => {
+        const files = splitDiffByFile(
+            '--- a/a.ts\n+++ b/a.ts\n@@ -1 +1 @@\n+x'
+        );
+
+        expect(files).toHaveLength(1);
+        expect(files[0]!.summary).toMatchObject({
+            newPath: 'a.ts',
+            additions: 1,
+        });
+    });
+
+    it('should return no files for an empty diff', () => {
+        expect(splitDiffByFile('')).toEqual([]);
+    });
+});
+
+describe('batchBySize', () => {
+    it('should start a new batch when the next item would exceed the limit', () => {
+        expect(batchBySize([3, 3, 3, 10, 1], (size) => size, 6)).toEqual([
+            [3, 3],
+            [3],
+            [10],
+            [1],
+        ]);
+    });
+});
+
+describe('AnalysisPanelData', () => {
+    it('should reduce tool calls to summaries in the manifest', () => {
+        const nested = [createRecord('nested_1', 'nested result')];
+        const data = new AnalysisPanelData(
+            'diff --git a/a.ts b/a.ts\n@@ -1 +1 @@\n+x',
+            createToolCalls([
+                createRecord('call_1', 'result'),
+                createRecord('call_2', 'subagent', nested),
+            ])
+        );
+
+        const manifest = data.getManifest('Title', 'Analysis');
+
+        expect(manifest.diffFiles).toHaveLength(1);
+        expect(manifest.toolCalls?.totalCalls).toBe(2);
+        expect(manifest.toolCalls?.calls[0]).not.toHaveProperty('result');
+        expect(manifest.toolCalls?.calls[0]).not.toHaveProperty('arguments');
+        expect(manifest.toolCalls?.calls[1]).toMatchObject({
+            id: 'call_2',
+            nestedCallCount: 1,
+        });
+        expect(manifest.toolCalls?.calls[1]).not.toHaveProperty('nestedCalls');
+    });
+
+    it('should serve tool call records by index and skip unknown ones', () => {
+        const record = createRecord('call_1', 'result');
+        const data = new AnalysisPanelData('', createToolCalls([record]));
+
+        expect(data.getToolCallDetails([0, 3])).toEqual([
+            [{ index: 0, call: record }],
+        ]);
+        expect(data.getManifest('Title', 'Analysis').toolCalls).not.toBeNull();
+    });
+
+    it('should answer large requests in several batches', () => {
+        const big = 'x'.repeat(1024 * 1024);
+        const diff = [0, 1, 2]
+            .map((i) => `diff --git a/${i}.ts b/${i}.ts\n@@ -1 +1 @@\n+${big}`)
+            .join('\n');
+        const data = new AnalysisPanelData(diff, undefined);
+
+        const batches = data.getDiffFiles([0, 1, 2]);
+
+        expect(batches).toHaveLength(3);
+        expect(batches.flat().map((file) => file.index)).toEqual([0, 1, 2]);
+        expect(data.getManifest('Title', 'Analysis').toolCalls).toBeNull();
+    });
+
+    it('should append live tool calls and swap in the final result', () => {
+        const data = new AnalysisPanelData('', undefined, true);
+
+        expect(data.appendToolCall(createRecord('call_1', 'ok'))).toEqual({
+            index: 0,
+            call: expect.objectContaining({ id: 'call_1' }),
+        });
+        data.appendToolCall({
+            ...createRecord('call_2', ''),
+            success: false,
+        });
+        data.setPlan('- [ ] Check auth');
+
+        const live = data.getManifest('Title', '');
+        expect(live.running).toBe(true);
+        expect(live.plan).toBe('- [ ] Check auth');
+        expect(live.toolCalls).toMatchObject({
+            totalCalls: 2,
+            successfulCalls: 1,
+            failedCalls: 1,
+        });
+
+        const final = createToolCalls([createRecord('call_1', 'ok')]);
+        data.finish(final);
+
+        const manifest = data.getManifest('Title', 'Analysis');
+        expect(manifest.running).toBe(false);
+        expect(manifest.plan).toBeUndefined();
+        expect(manifest.toolCalls?.totalCalls).toBe(1);
+    });
+});
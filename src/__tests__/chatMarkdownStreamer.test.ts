@@ -1,6 +1,9 @@
 import { describe, it, expect, vi, beforeEach } from 'vitest';
 import * as vscode from 'vscode';
-import { streamMarkdownWithAnchors } from '../utils/chatMarkdownStreamer';
+import {
+    DiffPathMatcher,
+    streamMarkdownWithAnchors,
+} from '../utils/chatMarkdownStreamer';
 
 describe('streamMarkdownWithAnchors', () => {
     let mockStream: any;
@@ -36,10 +39,10 @@ describe('streamMarkdownWithAnchors', () => {
         );
     });
 
-    it('should stream plain text without file links', () => {
+    it('should stream plain text without file links', async () => {
         const markdown = 'This is plain text without any links.';
 
-        streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
+        await streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
 
         expect(mockStream.markdown).toHaveBeenCalledWith(
             'This is plain text without any links.'
@@ -47,10 +50,10 @@ describe('streamMarkdownWithAnchors', () => {
         expect(mockStream.anchor).not.toHaveBeenCalled();
     });
 
-    it('should handle file paths without line numbers', () => {
+    it('should handle file paths without line numbers', async () => {
         const markdown = 'Check out [src/file.ts](src/file.ts) for details.';
 
-        streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
+        await streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
 
         expect(mockStream.markdown).toHaveBeenCalledWith('Check out ');
         expect(mockStream.anchor).toHaveBeenCalledWith(
@@ -60,10 +63,10 @@ describe('streamMarkdownWithAnchors', () => {
         expect(mockStream.markdown).toHaveBeenCalledWith(' for details.');
     });
 
-    it('should handle file paths with single line numbers', () => {
+    it('should handle file paths with single line numbers', async () => {
         const markdown = 'See [src/file.ts:42](src/file.ts:42) for the issue.';
 
-        streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
+        await streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
 
         expect(mockStream.markdown).toHaveBeenCalledWith('See ');
         expect(mockStream.anchor).toHaveBeenCalledWith(
@@ -79,11 +82,11 @@ describe('streamMarkdownWithAnchors', () => {
         expect(vscode.Location).toHaveBeenCalled();
     });
 
-    it('should handle file paths with line ranges', () => {
+    it('should handle file paths with line ranges', async () => {
         const markdown =
             'The issue spans [src/file.ts:104-115](src/file.ts:104-115).';
 
-        streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
+        await streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
 
         expect(mockStream.markdown).toHaveBeenCalledWith('The issue spans ');
         expect(mockStream.anchor).toHaveBeenCalledWith(
@@ -102,10 +105,10 @@ describe('streamMarkdownWithAnchors', () => {
         expect(vscode.Location).toHaveBeenCalled();
     });
 
-    it('should handle file paths with line and column', () => {
+    it('should handle file paths with line and column', async () => {
         const markdown = 'Look at [src/file.ts:10:5](src/file.ts:10:5).';
 
-        streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
+        await streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
 
         expect(mockStream.markdown).toHaveBeenCalledWith('Look at ');
         expect(mockStream.anchor).toHaveBeenCalledWith(
@@ -122,11 +125,11 @@ describe('streamMarkdownWithAnchors', () => {
         expect(vscode.Location).toHaveBeenCalled();
     });
 
-    it('should handle multiple file links in mixed content', () => {
+    it('should handle multiple file links in mixed content', async () => {
         const markdown =
             'Check [file1.ts:10](file1.ts:10) and [file2.ts:20-25](file2.ts:20-25) for details.';
 
-        streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
+        await streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
 
         expect(mockStream.markdown).toHaveBeenCalledTimes(3);
         expect(mockStream.markdown).toHaveBeenCalledWith('Check ');
@@ -146,18 +149,16 @@ describe('streamMarkdownWithAnchors', () => {
         );
     });
 
-    it('should preserve external links as text', () => {
+    it('should preserve external links as text', async () => {
         const markdown =
             'See [external link](https://example.com) and [file.ts:42](file.ts:42).';
 
-        streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
+        await streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
 
         // External links are streamed as markdown text (link preserved)
-        expect(mockStream.markdown).toHaveBeenCalledWith('See ');
         expect(mockStream.markdown).toHaveBeenCalledWith(
-            '[external link](https://example.com)'
+            'See [external link](https://example.com) and '
         );
-        expect(mockStream.markdown).toHaveBeenCalledWith(' and ');
         // File link becomes an anchor
         expect(mockStream.anchor).toHaveBeenCalledWith(
             expect.any(Object),
@@ -166,11 +167,11 @@ describe('streamMarkdownWithAnchors', () => {
         expect(mockStream.markdown).toHaveBeenCalledWith('.');
     });
 
-    it('should handle absolute file paths', () => {
+    it('should handle absolute file paths', async () => {
         const markdown =
             'Check [/absolute/path/file.ts:15](/absolute/path/file.ts:15).';
 
-        streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
+        await streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
 
         expect(mockStream.markdown).toHaveBeenCalledWith('Check ');
         // anchor receives a Location object with uri.fsPath
@@ -185,30 +186,28 @@ describe('streamMarkdownWithAnchors', () => {
         expect(mockStream.markdown).toHaveBeenCalledWith('.');
     });
 
-    it('should handle empty string', () => {
-        streamMarkdownWithAnchors(mockStream, '', workspaceRoot);
+    it('should handle empty string', async () => {
+        await streamMarkdownWithAnchors(mockStream, '', workspaceRoot);
 
         expect(mockStream.markdown).not.toHaveBeenCalled();
         expect(mockStream.anchor).not.toHaveBeenCalled();
     });
 
-    it('should emit plain text when workspace root is undefined for relative paths', () => {
+    it('should emit plain text when workspace root is undefined for relative paths', async () => {
         const markdown = 'Check [file.ts:10](file.ts:10).';
 
-        streamMarkdownWithAnchors(mockStream, markdown, undefined);
+        await streamMarkdownWithAnchors(mockStream, markdown, undefined);
 
-        expect(mockStream.markdown).toHaveBeenCalledWith('Check ');
         // Relative path without workspace root: emit as plain text, not anchor
-        expect(mockStream.markdown).toHaveBeenCalledWith('file.ts:10');
-        expect(mockStream.markdown).toHaveBeenCalledWith('.');
+        expect(mockStream.markdown).toHaveBeenCalledWith('Check file.ts:10.');
         expect(mockStream.anchor).not.toHaveBeenCalled();
     });
 
-    it('should still create anchors for absolute paths when workspace root is undefined', () => {
+    it('should still create anchors for absolute paths when workspace root is undefined', async () => {
         const markdown =
             'Check [/absolute/path/file.ts:10](/absolute/path/file.ts:10).';
 
-        streamMarkdownWithAnchors(mockStream, markdown, undefined);
+        await streamMarkdownWithAnchors(mockStream, markdown, undefined);
 
         expect(mockStream.markdown).toHaveBeenCalledWith('Check ');
         // Absolute path resolves without workspace root
@@ -222,4 +221,131 @@ describe('streamMarkdownWithAnchors', () => {
         );
         expect(mockStream.markdown).toHaveBeenCalledWith('.');
     });
+
+    it('should resolve short link paths to files of the diff', async () => {
+        const markdown =
+            'See [handler.ts:45](handler.ts:45) and [auth/handler.ts](auth/handler.ts).';
+
+        vi.mocked(vscode.workspace.fs.stat).mockRejectedValue(
+            new Error('ENOENT')
+        );
+
+        await streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot, {
+            pathMatcher: new DiffPathMatcher([
+                'src/auth/handler.ts',
+                'src/index.ts',
+            ]),
+        });
+
+        expect(vscode.Uri.joinPath).toHaveBeenCalledWith(
+            workspaceRoot,
+            'src/auth/handler.ts'
+        );
+        expect(vscode.Uri.joinPath).not.toHaveBeenCalledWith(
+            workspaceRoot,
+            'handler.ts'
+        );
+        expect(mockStream.anchor).toHaveBeenCalledWith(
+            expect.objectContaining({
+                fsPath: '/workspace/src/auth/handler.ts',
+            }),
+            'auth/handler.ts'
+        );
+    });
+
+    it('should stream long reviews in chunks split at line breaks', async () => {
+        const line = 'x'.repeat(99);
+        const markdown = Array.from({ length: 60 }, () => line).join('\n');
+
+        await streamMarkdownWithAnchors(mockStream, markdown, workspaceRoot);
+
+        const parts = mockStream.markdown.mock.calls.map(
+            ([part]: [string]) => part
+        );
+        expect(parts.length).toBeGreaterThan(1);
+        expect(parts.join('')).toBe(markdown);
+        for (const part of parts.slice(0, -1)) {
+            expect(part.length).toBeLessThanOrEqual(2000);
+            expect(part.endsWith('\n')).toBe(true);
+        }
+    });
+
+    it('should stop between chunks when cancelled', async () => {
+        const markdown = 'x'.repeat(10000);
+        const token = { isCancellationRequested: false } as any;
+        mockStream.markdown.mockImplementation(() => {
+            token.isCancellationRequested = true;
+        });
+
+        const result = await streamMarkdownWithAnchors(
+            mockStream,
+            markdown,
+            workspaceRoot,
+            { token }
+        );
+
+        expect(result).toEqual({ cancelled: true });
+        expect(mockStream.markdown).toHaveBeenCalledTimes(1);
+    });
+
+    it('should report a complete stream as not cancelled', async () => {
+        const token = { isCancellationRequested: false } as any;
+
+        const result = await streamMarkdownWithAnchors(
+            mockStream,
+            'x'.repeat(10000),
+            workspaceRoot,
+            { token }
+        );
+
+        expect(result).toEqual({ cancelled: false });
+    });
+
+    it('should keep links to existing files outside the diff', async () => {
+        vi.mocked(vscode.workspace.fs.stat).mockResolvedValue({
+            type: vscode.FileType.File,
+        } as vscode.FileStat);
+
+        await streamMarkdownWithAnchors(
+            mockStream,
+            'See [index.ts](index.ts).',
+            workspaceRoot,
+            { pathMatcher: new DiffPathMatcher(['src/index.ts']) }
+        );
+
+        expect(mockStream.anchor).toHaveBeenCalledWith(
+            expect.objectContaining({ fsPath: '/workspace/index.ts' }),
+            'index.ts'
+        );
+    });
+});
+
+describe('DiffPathMatcher', () => {
+    const matcher = new DiffPathMatcher([
+        'src/auth/handler.ts',
+        'src/api/handler.ts',
+        'src/index.ts',
+        'index.ts',
+    ]);
+
+    it('should match full paths and unique suffixes', () => {
+        expect(matcher.match('src/auth/handler.ts')).toBe(
+            'src/auth/handler.ts'
+        );
+        expect(matcher.match('api/handler.ts')).toBe('src/api/handler.ts');
+        expect(matcher.match('./api/handler.ts')).toBe('src/api/handler.ts');
+        expect(matcher.match('src\\index.ts')).toBe('src/index.ts');
+    });
+
+    it('should not guess between files sharing a suffix', () => {
+        expect(matcher.match('handler.ts')).toBeUndefined();
+    });
+
+    it('should prefer an exact path over suffixes of other files', () => {
+        expect(matcher.match('index.ts')).toBe('index.ts');
+    });
+
+    it('should not match files outside the diff', () => {
+        expect(matcher.match('src/other.ts')).toBeUndefined();
+    });
 });
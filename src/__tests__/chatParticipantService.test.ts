@@ -3,6 +3,7 @@ import * as vscode from 'vscode';
 import { ChatParticipantService } from '../services/chatParticipantService';
 import { GitService } from '../services/gitService';
 import { ConversationRunner } from '../models/conversationRunner';
+import { SubagentSessionManager } from '../services/subagentSessionManager';
 import { MAIN_ANALYSIS_ONLY_TOOLS } from '../models/toolConstants';
 import { createMockCopilotModelManager } from './testUtils/mockFactories';
 
@@ -1075,6 +1076,63 @@ describe('ChatParticipantService', () => {
                 expect(markdownCalls).not.toContain('found so far');
                 expect(markdownCalls).not.toContain('partial');
             });
+
+            it('should report cancellation while streaming the review', async () => {
+                const mockToken = {
+                    isCancellationRequested: false,
+                    onCancellationRequested: vi.fn(),
+                };
+                const review = 'x'.repeat(10000);
+
+                vi.mocked(ConversationRunner).mockImplementation(function (
+                    this: any
+                ) {
+                    this.run = vi.fn().mockResolvedValue(review);
+                    this.reset = vi.fn();
+                    this.wasCancelled = false;
+                });
+                mockStream.markdown.mockImplementation((text: string) => {
+                    if (text.startsWith('xxx')) {
+                        mockToken.isCancellationRequested = true;
+                    }
+                });
+
+                const mockGitService = {
+                    isInitialized: vi.fn().mockReturnValue(true),
+                    compareBranches: vi.fn().mockResolvedValue({
+                        diffText: 'mock diff',
+                        refName: 'feature/test',
+                        error: undefined,
+                    }),
+                };
+                vi.mocked(GitService.getInstance).mockReturnValue(
+                    mockGitService as unknown as GitService
+                );
+
+                const instance = ChatParticipantService.getInstance();
+                instance.setDependencies({
+                    toolRegistry: mockToolRegistry,
+                    workspaceSettings: mockWorkspaceSettings,
+                    promptGenerator: mockPromptGenerator,
+                    gitOperations: mockGitOperations,
+                    copilotModelManager: createMockCopilotModelManager() as any,
+                });
+
+                const result = await capturedHandler(
+                    { command: 'branch', model: { id: 'test-model' } },
+                    {},
+                    mockStream,
+                    mockToken
+                );
+
+                expect(mockStream.markdown).toHaveBeenCalledWith(
+                    expect.stringContaining('Analysis Cancelled')
+                );
+                expect(result.metadata).toEqual({
+                    cancelled: true,
+                    responseIsIncomplete: true,
+                });
+            });
         });
 
         describe('cancellation during error', () => {
@@ -1492,6 +1550,44 @@ describe('ChatParticipantService', () => {
             expect(result.metadata.command).toBe('exploration');
         });
 
+        it('should cancel outstanding subagents when exploration fails', async () => {
+            const cancelOutstanding = vi.spyOn(
+                SubagentSessionManager.prototype,
+                'cancelOutstanding'
+            );
+            vi.mocked(ConversationRunner).mockImplementation(function (
+                this: any
+            ) {
+                this.run = vi.fn().mockRejectedValue(new Error('LLM error'));
+                this.reset = vi.fn();
+            });
+
+            const instance = ChatParticipantService.getInstance();
+            instance.setDependencies({
+                toolRegistry: mockToolRegistry,
+                workspaceSettings: mockWorkspaceSettings,
+                promptGenerator: mockPromptGenerator,
+                gitOperations: mockGitOperations,
+                copilotModelManager: createMockCopilotModelManager() as any,
+            });
+
+            await capturedHandler(
+                {
+                    command: undefined,
+                    prompt: 'Explain this',
+                    model: { id: 'test-model' },
+                },
+                {},
+                mockStream,
+                mockToken
+            );
+
+            expect(cancelOutstanding).toHaveBeenCalledWith(
+                'exploration finished'
+            );
+            cancelOutstanding.mockRestore();
+        });
+
         it('should handle pre-cancelled token', async () => {
             const cancelledToken = {
                 isCancellationRequested: true,
@@ -0,0 +1,108 @@
+import { describe, it, expect, vi, beforeEach, afterEach } from 'vitest';
+import type * as vscode from 'vscode';
+import { ChatStreamBatcher } from '../models/chatStreamBatcher';
+
+const fileUri = { fsPath: '/repo/src/a.ts' } as unknown as vscode.Uri;
+
+describe('ChatStreamBatcher', () => {
+    let writes: string[];
+    let stream: {
+        markdown: ReturnType<typeof vi.fn>;
+        anchor: ReturnType<typeof vi.fn>;
+        progress: ReturnType<typeof vi.fn>;
+    };
+    let batcher: ChatStreamBatcher;
+
+    beforeEach(() => {
+        vi.useFakeTimers();
+        writes = [];
+        stream = {
+            markdown: vi.fn((value: string) => writes.push(`md:${value}`)),
+            anchor: vi.fn((_target: unknown, title?: string) =>
+                writes.push(`anchor:${title}`)
+            ),
+            progress: vi.fn((value: string) =>
+                writes.push(`progress:${value}`)
+            ),
+        };
+        batcher = new ChatStreamBatcher(
+            stream as unknown as vscode.ChatResponseStream,
+            50
+        );
+    });
+
+    afterEach(() => {
+        vi.useRealTimers();
+    });
+
+    it('should write the first event immediately', () => {
+        batcher.progress('Reading files');
+
+        expect(writes).toEqual(['progress:Reading files']);
+    });
+
+    it('should flush a burst once at the end of the frame', () => {
+        batcher.progress('first');
+        batcher.markdown('a');
+        batcher.markdown('b');
+        batcher.progress('second');
+        batcher.progress('third');
+
+        expect(writes).toEqual(['progress:first']);
+
+        vi.advanceTimersByTime(50);
+
+        expect(writes).toEqual(['progress:first', 'md:ab', 'progress:third']);
+    });
+
+    it('should keep anchors in order between markdown writes', () => {
+        batcher.progress('start');
+        batcher.markdown('See ');
+        batcher.anchor(fileUri, 'src/a.ts');
+        batcher.markdown(' and ');
+        batcher.markdown('more');
+
+        vi.advanceTimersByTime(50);
+
+        expect(writes).toEqual([
+            'progress:start',
+            'md:See ',
+            'anchor:src/a.ts',
+            'md: and more',
+        ]);
+    });
+
+    it('should flush at most once per frame', () => {
+        for (let index = 0; index < 100; index++) {
+            batcher.progress(`event ${index}`);
+            vi.advanceTimersByTime(5);
+        }
+        vi.advanceTimersByTime(50);
+
+        // 500ms of events at one flush per 50ms frame
+        expect(stream.progress.mock.calls.length).toBeLessThanOrEqual(11);
+        expect(writes.at(-1)).toBe('progress:event 99');
+    });
+
+    it('should write queued events on flush', () => {
+        batcher.progress('first');
+        batcher.markdown('queued');
+
+        batcher.flush();
+
+        expect(writes).toEqual(['progress:first', 'md:queued']);
+        vi.advanceTimersByTime(50);
+        expect(writes).toHaveLength(2);
+    });
+
+    it('should flush on dispose and drop later writes', () => {
+        batcher.progress('first');
+        batcher.progress('queued');
+
+        batcher.dispose();
+        batcher.markdown('late');
+        vi.advanceTimersByTime(50);
+
+        expect(writes).toEqual(['progress:first', 'progress:queued']);
+    });
+});
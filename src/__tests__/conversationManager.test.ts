@@ -221,6 +221,19 @@ describe('ConversationManager', () => {
             expect(conversationManager.getMessageCount()).toBe(0);
         });
 
+        it('should count content and tool call argument characters', () => {
+            conversationManager.addAssistantMessage(null, [
+                {
+                    id: 'call_1',
+                    function: { name: 'read_file', arguments: '{"a":1}' },
+                },
+            ]);
+            conversationManager.addToolMessage('call_1', 'result');
+
+            // 3 x 'Message N' + arguments + 'result'
+            expect(conversationManager.getContentLength()).toBe(27 + 7 + 6);
+        });
+
         it('should prepend history messages at the beginning', () => {
             conversationManager.clearHistory();
             conversationManager.addUserMessage('Current message');
@@ -1,6 +1,7 @@
 import { describe, it, expect, vi, beforeEach } from 'vitest';
 import * as vscode from 'vscode';
 import {
+    ConversationBudget,
     ConversationRunner,
     ConversationRunnerConfig,
     ToolCallHandler,
@@ -11,6 +12,7 @@ import {
     CopilotApiError,
 } from '../models/copilotModelManager';
 import { ToolExecutor } from '../models/toolExecutor';
+import { TokenConstants } from '../models/tokenConstants';
 import type { ITool } from '../tools/ITool';
 
 // Mock dependencies
@@ -999,6 +1001,403 @@ describe('ConversationRunner', () => {
         });
     });
 
+    describe('Tool Pipelining', () => {
+        const readCall = {
+            id: 'call_read',
+            function: { name: 'read_file', arguments: '{"path":"a.ts"}' },
+        };
+        const planCall = {
+            id: 'call_plan',
+            function: { name: 'update_plan', arguments: '{"plan":"- [ ] a"}' },
+        };
+
+        it('should start read-only tools while the response is still streaming', async () => {
+            const events: string[] = [];
+            const modelManager = {
+                sendRequest: vi
+                    .fn()
+                    .mockImplementationOnce(async (request) => {
+                        // Tool call parts arrive before the stream finishes
+                        request.onToolCall?.(readCall);
+                        request.onToolCall?.(planCall);
+                        events.push('stream done');
+                        return {
+                            content: null,
+                            toolCalls: [readCall, planCall],
+                        };
+                    })
+                    .mockResolvedValue({ content: 'Done', toolCalls: undefined }),
+                getCurrentModel: vi.fn().mockResolvedValue({
+                    id: 'test-model',
+                    maxInputTokens: 100000,
+                    countTokens: vi.fn().mockResolvedValue(100),
+                }),
+            } as unknown as CopilotModelManager;
+            const earlyResult = {
+                name: 'read_file',
+                success: true,
+                result: 'file content',
+            };
+            const toolExecutor = {
+                executeTool: vi.fn().mockImplementation(async (name) => {
+                    events.push(`start ${name}`);
+                    return earlyResult;
+                }),
+                executeTools: vi
+                    .fn()
+                    .mockImplementation(
+                        async (
+                            requests: Array<{
+                                name: string;
+                                pending?: Promise<unknown>;
+                            }>
+                        ) =>
+                            Promise.all(
+                                requests.map(
+                                    (request) =>
+                                        request.pending ?? {
+                                            name: request.name,
+                                            success: true,
+                                            result: 'ok',
+                                        }
+                                )
+                            )
+                    ),
+                getAvailableTools: vi.fn().mockReturnValue([]),
+            } as unknown as ToolExecutor;
+            const runner = new ConversationRunner(modelManager, toolExecutor);
+            const handler: ToolCallHandler = {
+                onToolCallStart: vi.fn((name) => {
+                    events.push(`notify ${name}`);
+                }),
+            };
+
+            await runner.run(
+                {
+                    systemPrompt: 'Test prompt',
+                    maxIterations: 5,
+                    tools: [
+                        createMockTool('read_file'),
+                        createMockTool('update_plan'),
+                    ],
+                },
+                conversation,
+                createCancellationToken(),
+                handler
+            );
+
+            // Only the read-only tool is dispatched early, and before the stream ends.
+            // Each call is announced once, when it actually starts
+            expect(events).toEqual([
+                'notify read_file',
+                'start read_file',
+                'stream done',
+                'notify update_plan',
+            ]);
+            expect(toolExecutor.executeTool).toHaveBeenCalledTimes(1);
+            const requests = vi.mocked(toolExecutor.executeTools).mock
+                .calls[0]![0];
+            expect(requests[0]!.pending).toBeDefined();
+            expect(requests[1]!.pending).toBeUndefined();
+            expect(conversation.getHistory()).toContainEqual(
+                expect.objectContaining({
+                    role: 'tool',
+                    toolCallId: 'call_read',
+                    content: 'file content',
+                })
+            );
+        });
+
+        it('should release early-dispatched calls when the request fails', async () => {
+            const modelManager = {
+                sendRequest: vi
+                    .fn()
+                    .mockImplementationOnce(async (request) => {
+                        request.onToolCall?.(readCall);
+                        throw new Error('Stream interrupted');
+                    })
+                    .mockResolvedValue({ content: 'Done', toolCalls: undefined }),
+                getCurrentModel: vi.fn().mockResolvedValue({
+                    id: 'test-model',
+                    maxInputTokens: 100000,
+                    countTokens: vi.fn().mockResolvedValue(100),
+                }),
+            } as unknown as CopilotModelManager;
+            const toolExecutor = {
+                executeTool: vi.fn().mockResolvedValue({
+                    name: 'read_file',
+                    success: true,
+                    result: 'file content',
+                }),
+                executeTools: vi.fn().mockResolvedValue([]),
+                releaseToolCalls: vi.fn(),
+                getAvailableTools: vi.fn().mockReturnValue([]),
+            } as unknown as ToolExecutor;
+            const runner = new ConversationRunner(modelManager, toolExecutor);
+
+            const result = await runner.run(
+                {
+                    systemPrompt: 'Test prompt',
+                    maxIterations: 5,
+                    tools: [createMockTool('read_file')],
+                },
+                conversation,
+                createCancellationToken()
+            );
+
+            expect(result).toBe('Done');
+            expect(toolExecutor.executeTool).toHaveBeenCalledTimes(1);
+            expect(toolExecutor.releaseToolCalls).toHaveBeenCalledWith(1);
+        });
+    });
+
+    describe('Token Budget', () => {
+        const toolCallResponse = (id: string) => ({
+            content: `Checking ${id}`,
+            toolCalls: [
+                {
+                    id,
+                    function: {
+                        name: 'find_symbol',
+                        arguments: '{"name":"test"}',
+                    },
+                },
+            ],
+        });
+
+        it('should request a final answer without tools once the budget is spent', async () => {
+            const modelManager = createMockModelManager([
+                toolCallResponse('call_1'),
+                { content: 'Final answer within budget', toolCalls: undefined },
+            ]);
+            const runner = new ConversationRunner(
+                modelManager,
+                createMockToolExecutor()
+            );
+
+            conversation.addUserMessage('Investigate');
+            const result = await runner.run(
+                {
+                    systemPrompt: 'Test prompt',
+                    maxIterations: 10,
+                    tools: [createMockTool('find_symbol')],
+                    tokenBudget: 250,
+                },
+                conversation,
+                createCancellationToken()
+            );
+
+            expect(result).toBe('Final answer within budget');
+            const calls = vi.mocked(modelManager.sendRequest).mock.calls;
+            expect(calls).toHaveLength(2);
+            expect(calls[0][0].tools).toHaveLength(1);
+            expect(calls[1][0].tools).toEqual([]);
+            expect(runner.iterationsUsed).toBe(2);
+            expect(runner.tokensUsed).toBeGreaterThan(250);
+        });
+
+        it('should return the final answer even if the model still requests tools', async () => {
+            const modelManager = createMockModelManager([
+                toolCallResponse('call_1'),
+                toolCallResponse('call_2'),
+            ]);
+            const toolExecutor = createMockToolExecutor();
+            const runner = new ConversationRunner(modelManager, toolExecutor);
+
+            conversation.addUserMessage('Investigate');
+            const result = await runner.run(
+                {
+                    systemPrompt: 'Test prompt',
+                    maxIterations: 10,
+                    tools: [createMockTool('find_symbol')],
+                    tokenBudget: 250,
+                },
+                conversation,
+                createCancellationToken()
+            );
+
+            expect(result).toBe('Checking call_2');
+            expect(toolExecutor.executeTools).toHaveBeenCalledTimes(1);
+            expect(runner.hitMaxIterations).toBe(false);
+        });
+
+        it('should report the budget left while running', async () => {
+            const modelManager = createMockModelManager([
+                toolCallResponse('call_1'),
+                { content: 'Done', toolCalls: undefined },
+            ]);
+            const runner = new ConversationRunner(
+                modelManager,
+                createMockToolExecutor()
+            );
+            const budgets: ConversationBudget[] = [];
+
+            conversation.addUserMessage('Investigate');
+            await runner.run(
+                {
+                    systemPrompt: 'Test prompt',
+                    maxIterations: 10,
+                    tools: [createMockTool('find_symbol')],
+                    tokenBudget: 100_000,
+                },
+                conversation,
+                createCancellationToken(),
+                {
+                    onIterationStart: () => {
+                        budgets.push(runner.remainingBudget);
+                    },
+                }
+            );
+
+            expect(budgets.map((budget) => budget.iterations)).toEqual([9, 8]);
+            expect(budgets[0]!.tokens).toBe(100_000);
+            expect(budgets[1]!.tokens).toBeLessThan(100_000);
+            expect(budgets[1]!.timeMs).toBeGreaterThanOrEqual(0);
+        });
+
+        it('should always allow the first request', async () => {
+            const modelManager = createMockModelManager([
+                { content: 'Done', toolCalls: undefined },
+            ]);
+            const runner = new ConversationRunner(
+                modelManager,
+                createMockToolExecutor()
+            );
+
+            conversation.addUserMessage('Investigate');
+            await runner.run(
+                {
+                    systemPrompt: 'Test prompt',
+                    maxIterations: 10,
+                    tools: [createMockTool('find_symbol')],
+                    tokenBudget: 1,
+                },
+                conversation,
+                createCancellationToken()
+            );
+
+            const calls = vi.mocked(modelManager.sendRequest).mock.calls;
+            expect(calls[0][0].tools).toHaveLength(1);
+        });
+    });
+
+    describe('Token Usage', () => {
+        it('should record prompt tokens per iteration by category', async () => {
+            const modelManager = createMockModelManager([
+                {
+                    content: 'Checking',
+                    toolCalls: [
+                        {
+                            id: 'call_1',
+                            function: {
+                                name: 'find_symbol',
+                                arguments: '{"name":"test"}',
+                            },
+                        },
+                    ],
+                },
+                { content: 'Done', toolCalls: undefined },
+            ]);
+            const runner = new ConversationRunner(
+                modelManager,
+                createMockToolExecutor()
+            );
+
+            conversation.addUserMessage('Investigate');
+            await runner.run(
+                {
+                    systemPrompt: 'Test prompt',
+                    maxIterations: 10,
+                    tools: [createMockTool('find_symbol')],
+                },
+                conversation,
+                createCancellationToken()
+            );
+
+            // countTokens is mocked to 100, plus 5 overhead per message
+            const usage = runner.tokenUsage;
+            expect(usage).toHaveLength(2);
+            expect(usage[0]).toEqual({
+                iteration: 1,
+                system: 100,
+                prompt: 105,
+                assistant: 0,
+                toolResults: {},
+                other: 0,
+                total: 205,
+                evicted: 0,
+            });
+            expect(usage[1].prompt).toBe(105);
+            expect(usage[1].assistant).toBeGreaterThan(105);
+            expect(usage[1].toolResults).toEqual({ find_symbol: 105 });
+            expect(usage[0].total + usage[1].total).toBe(runner.tokensUsed);
+        });
+    });
+
+    describe('Memory Compaction', () => {
+        it('should evict old tool interactions when the handler asks for it', async () => {
+            const modelManager = createMockModelManager([
+                {
+                    content: 'Checking',
+                    toolCalls: [
+                        {
+                            id: 'call_1',
+                            function: {
+                                name: 'find_symbol',
+                                arguments: '{"name":"test"}',
+                            },
+                        },
+                    ],
+                },
+                { content: 'Done', toolCalls: undefined },
+            ]);
+            vi.mocked(modelManager.getCurrentModel).mockResolvedValue({
+                id: 'test-model',
+                maxInputTokens: 1000,
+                countTokens: vi.fn().mockResolvedValue(100),
+            } as any);
+            const handler: ToolCallHandler = {
+                shouldCompactContext: vi
+                    .fn()
+                    .mockReturnValueOnce(false)
+                    .mockReturnValueOnce(true),
+            };
+            const runner = new ConversationRunner(
+                modelManager,
+                createMockToolExecutor()
+            );
+
+            conversation.addUserMessage('Investigate');
+            await runner.run(
+                {
+                    systemPrompt: 'Test prompt',
+                    maxIterations: 10,
+                    tools: [createMockTool('find_symbol')],
+                },
+                conversation,
+                createCancellationToken(),
+                handler
+            );
+
+            // Second request is at 515 of 1000 tokens, well under the 90%
+            // warning, but over the 50% memory compaction target
+            const calls = vi.mocked(modelManager.sendRequest).mock.calls;
+            const secondRequest = calls[1]![0].messages;
+            expect(secondRequest.some((m: any) => m.role === 'tool')).toBe(
+                false
+            );
+            expect(runner.tokenUsage[1]!.evicted).toBe(310);
+            // Context is not full, so the model isn't told to finish
+            expect(
+                secondRequest.some(
+                    (m: any) =>
+                        m.content ===
+                        TokenConstants.TOOL_CONTEXT_MESSAGES.CONTEXT_FULL
+                )
+            ).toBe(false);
+        });
+    });
+
     describe('Reset', () => {
         it('should reset internal state', () => {
             const modelManager = createMockModelManager([]);
@@ -1010,6 +1409,62 @@ describe('ConversationRunner', () => {
         });
     });
 
+    describe('Phase Timings', () => {
+        it('should attribute time to LLM wait and tool execution', async () => {
+            const modelManager = createMockModelManager([]);
+            let calls = 0;
+            vi.mocked(modelManager.sendRequest).mockImplementation(
+                async () => {
+                    await new Promise((resolve) => setTimeout(resolve, 20));
+                    calls++;
+                    return calls === 1
+                        ? {
+                              content: null,
+                              toolCalls: [
+                                  {
+                                      id: 'call_1',
+                                      function: {
+                                          name: 'list_dir',
+                                          arguments: '{}',
+                                      },
+                                  },
+                              ],
+                          }
+                        : { content: 'Done' };
+                }
+            );
+            const toolExecutor = createMockToolExecutor();
+            vi.mocked(toolExecutor.executeTools).mockImplementation(
+                async () => {
+                    await new Promise((resolve) => setTimeout(resolve, 20));
+                    return [
+                        { name: 'list_dir', success: true, result: 'src/' },
+                    ];
+                }
+            );
+            const runner = new ConversationRunner(modelManager, toolExecutor);
+
+            conversation.addUserMessage('Analyze');
+            await runner.run(
+                {
+                    systemPrompt: 'Test prompt',
+                    maxIterations: 5,
+                    tools: [createMockTool('list_dir')],
+                },
+                conversation,
+                createCancellationToken()
+            );
+
+            const timings = runner.phaseTimings;
+            expect(timings.llmWaitMs).toBeGreaterThanOrEqual(30);
+            expect(timings.toolExecutionMs).toBeGreaterThanOrEqual(15);
+            expect(timings.toolExecutionMs).toBeLessThan(timings.llmWaitMs);
+
+            runner.reset();
+            expect(runner.phaseTimings.llmWaitMs).toBe(0);
+        });
+    });
+
     describe('Explicit Completion and Nudging', () => {
         it('should nudge model when requiresExplicitCompletion is true and no tool calls', async () => {
             const modelManager = createMockModelManager([
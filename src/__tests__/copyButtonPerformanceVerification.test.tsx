@@ -1,4 +1,4 @@
-import { render, fireEvent, act } from '@testing-library/react';
+import { render, fireEvent, act, waitFor } from '@testing-library/react';
 import { describe, it, expect, vi, beforeEach } from 'vitest';
 import React from 'react';
 import { MarkdownRenderer } from '../webview/components/MarkdownRenderer';
@@ -43,7 +43,6 @@ function test${i}() {
                     <MarkdownRenderer
                         content={createContentWithManyCodeBlocks()}
                         id={`renderer-${rendererIndex}`}
-                        isDarkTheme={false}
                         onCopy={copyToClipboard}
                     />
                 </div>
@@ -52,6 +51,14 @@ function test${i}() {
     );
 };
 
+// Markdown renders asynchronously (in a worker, or deferred without one)
+const waitForCopyButtons = (count: number) =>
+    waitFor(() =>
+        expect(document.querySelectorAll('button[title*="Copy"]').length).toBe(
+            count
+        )
+    );
+
 describe('Copy Button Performance Verification', () => {
     beforeEach(() => {
         vi.clearAllMocks();
@@ -64,24 +71,24 @@ describe('Copy Button Performance Verification', () => {
         });
     });
 
-    it('should handle many copy buttons without performance issues', () => {
+    it('should handle many copy buttons without performance issues', async () => {
         const startTime = performance.now();
 
         render(<ManyButtonsTest />);
 
         const renderTime = performance.now() - startTime;
 
-        // Should render many buttons quickly (under 1 second)
+        // Parsing happens off the render path, so mounting is quick
         expect(renderTime).toBeLessThan(1000);
 
         // Should have many copy buttons (5 renderers * 21 buttons each = 105 total)
         // 20 code blocks + 1 main copy button per renderer = 21 per renderer
-        const copyButtons = document.querySelectorAll('button[title*="Copy"]');
-        expect(copyButtons.length).toBe(105);
+        await waitForCopyButtons(105);
     });
 
     it('should handle rapid clicks on many buttons without delays', async () => {
         render(<ManyButtonsTest />);
+        await waitForCopyButtons(105);
 
         // Get first 10 copy buttons for testing
         const copyButtons = Array.from(
@@ -106,7 +113,7 @@ describe('Copy Button Performance Verification', () => {
         expect(navigator.clipboard.writeText).toHaveBeenCalledTimes(10);
     });
 
-    it('should not cause cascade re-renders when buttons are clicked', () => {
+    it('should not cause cascade re-renders when buttons are clicked', async () => {
         let renderCount = 0;
 
         // Create a component that tracks renders
@@ -126,13 +133,11 @@ describe('Copy Button Performance Verification', () => {
                         <MarkdownRenderer
                             content="# Test\n\n```js\ntest code 1\n```\n\n```js\ntest code 2\n```"
                             id="test-renderer-1"
-                            isDarkTheme={false}
                             onCopy={copyToClipboard}
                         />
                         <MarkdownRenderer
                             content="# Test 2\n\n```js\ntest code 3\n```\n\n```js\ntest code 4\n```"
                             id="test-renderer-2"
-                            isDarkTheme={false}
                             onCopy={copyToClipboard}
                         />
                     </div>
@@ -141,6 +146,7 @@ describe('Copy Button Performance Verification', () => {
         };
 
         render(<WrappedTest />);
+        await waitForCopyButtons(6);
 
         const initialRenderCount = renderCount;
 
@@ -155,6 +161,7 @@ describe('Copy Button Performance Verification', () => {
 
     it('should maintain button states independently', async () => {
         render(<ManyButtonsTest />);
+        await waitForCopyButtons(105);
 
         // Get first 3 copy buttons
         const buttons = Array.from(
@@ -1,4 +1,10 @@
-import { render, screen, fireEvent, act } from '@testing-library/react';
+import {
+    render,
+    screen,
+    fireEvent,
+    act,
+    waitFor,
+} from '@testing-library/react';
 import { describe, it, expect, vi, beforeEach } from 'vitest';
 import React from 'react';
 import { MarkdownRenderer } from '../webview/components/MarkdownRenderer';
@@ -56,7 +62,6 @@ def test${index}():
                     <MarkdownRenderer
                         content={createContentWithCodeBlocks(i)}
                         id={`renderer-${i}`}
-                        isDarkTheme={false}
                         onCopy={handleCopy}
                     />
                 </div>
@@ -65,6 +70,14 @@ def test${index}():
     );
 };
 
+// Markdown renders asynchronously (in a worker, or deferred without one)
+const waitForCopyButtons = (count: number) =>
+    waitFor(() =>
+        expect(document.querySelectorAll('button[title*="Copy"]').length).toBe(
+            count
+        )
+    );
+
 describe('Copy Button Performance Fix', () => {
     beforeEach(() => {
         vi.clearAllMocks();
@@ -77,7 +90,7 @@ describe('Copy Button Performance Fix', () => {
         });
     });
 
-    it('should render multiple MarkdownRenderers with copy buttons', () => {
+    it('should render multiple MarkdownRenderers with copy buttons', async () => {
         render(<TestMultipleRenderers />);
 
         // Should have 3 renderers
@@ -86,12 +99,12 @@ describe('Copy Button Performance Fix', () => {
         expect(screen.getByTestId('renderer-2')).toBeTruthy();
 
         // Should have multiple copy buttons (2 per renderer + 1 main = 9 total)
-        const copyButtons = document.querySelectorAll('button[title*="Copy"]');
-        expect(copyButtons.length).toBe(9);
+        await waitForCopyButtons(9);
     });
 
     it('should handle copy button clicks without performance issues', async () => {
         render(<TestMultipleRenderers />);
+        await waitForCopyButtons(9);
 
         // Get the first copy button
         const firstCopyButton = document.querySelector('button[title*="Copy"]');
@@ -120,6 +133,7 @@ describe('Copy Button Performance Fix', () => {
 
     it('should handle multiple rapid clicks efficiently', async () => {
         render(<TestMultipleRenderers />);
+        await waitForCopyButtons(9);
 
         // Get first 3 copy buttons
         const copyButtons = Array.from(
@@ -146,7 +160,7 @@ describe('Copy Button Performance Fix', () => {
         expect(statesInfo.textContent).toContain('3');
     });
 
-    it('should demonstrate the memo optimization working', () => {
+    it('should demonstrate the memo optimization working', async () => {
         let renderCount = 0;
 
         // Enhanced MarkdownRenderer that counts renders
@@ -164,13 +178,11 @@ describe('Copy Button Performance Fix', () => {
                     <CountingMarkdownRenderer
                         content="# Test\n\n```js\nconsole.log('test');\n```"
                         id="test-1"
-                        isDarkTheme={false}
                         onCopy={copyToClipboard}
                     />
                     <CountingMarkdownRenderer
                         content="# Test 2\n\n```js\nconsole.log('test2');\n```"
                         id="test-2"
-                        isDarkTheme={false}
                         onCopy={copyToClipboard}
                     />
                 </div>
@@ -178,6 +190,7 @@ describe('Copy Button Performance Fix', () => {
         };
 
         render(<TestComponent />);
+        await waitForCopyButtons(4);
 
         const initialRenderCount = renderCount;
 
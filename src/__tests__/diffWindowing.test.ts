@@ -0,0 +1,41 @@
+import { describe, it, expect } from 'vitest';
+import {
+    DIFF_FILE_GAP_PX,
+    DIFF_FILE_HEADER_HEIGHT_PX,
+    DIFF_LINE_HEIGHT_PX,
+    HUNK_BATCH_SIZE,
+    LARGE_FILE_LINES,
+    estimateDiffHeight,
+    estimateFileSectionHeight,
+    isCollapsedByDefault,
+} from '../webview/utils/diffWindowing';
+
+describe('diffWindowing', () => {
+    it('should collapse files larger than the threshold', () => {
+        expect(isCollapsedByDefault({ lines: LARGE_FILE_LINES })).toBe(false);
+        expect(isCollapsedByDefault({ lines: LARGE_FILE_LINES + 1 })).toBe(
+            true
+        );
+    });
+
+    it('should estimate height from the first batch of hunks only', () => {
+        expect(estimateDiffHeight({ lines: 20, hunks: 2 })).toBe(
+            (20 + 2) * DIFF_LINE_HEIGHT_PX
+        );
+
+        const hunks = HUNK_BATCH_SIZE + 10;
+        expect(estimateDiffHeight({ lines: hunks * 4, hunks })).toBe(
+            HUNK_BATCH_SIZE * 5 * DIFF_LINE_HEIGHT_PX
+        );
+    });
+
+    it('should estimate collapsed sections as header only', () => {
+        const file = { lines: 20, hunks: 2 };
+        const header = DIFF_FILE_HEADER_HEIGHT_PX + DIFF_FILE_GAP_PX;
+
+        expect(estimateFileSectionHeight(file, false)).toBe(header);
+        expect(estimateFileSectionHeight(file, true)).toBe(
+            header + estimateDiffHeight(file)
+        );
+    });
+});
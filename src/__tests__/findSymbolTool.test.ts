@@ -675,6 +675,7 @@ describe('FindSymbolTool (Integration Tests)', () => {
             expect(result.data).toContain(
                 '[Note: Results may be incomplete due to timeout'
             );
+            expect(result.metadata?.timedOut).toBe(true);
         });
 
         it('should propagate CancellationError during workspace symbol processing', async () => {
@@ -0,0 +1,101 @@
+import { describe, it, expect } from 'vitest';
+import {
+    applyAnalysisUpdate,
+    formatLiveAnalysisContent,
+    type LiveAnalysisState,
+} from '../webview/utils/liveAnalysis';
+import type { ToolCallSummary } from '../types/toolCallTypes';
+import type { AnalysisManifest } from '../types/webviewMessages';
+
+const manifest: AnalysisManifest = {
+    title: 'PR Analysis: main',
+    analysis: '',
+    diffFiles: [],
+    toolCalls: null,
+    running: true,
+};
+
+const createSummary = (id: string, success: boolean): ToolCallSummary => ({
+    id,
+    toolName: 'read_file',
+    success,
+    error: success ? undefined : 'File not found',
+    durationMs: 5,
+    timestamp: 0,
+});
+
+describe('applyAnalysisUpdate', () => {
+    const initial: LiveAnalysisState = { manifest, statusMessage: undefined };
+
+    it('should append tool calls and keep the counts', () => {
+        let state = applyAnalysisUpdate(initial, {
+            kind: 'toolCall',
+            index: 0,
+            call: createSummary('call_1', true),
+        });
+        state = applyAnalysisUpdate(state, {
+            kind: 'toolCall',
+            index: 1,
+            call: createSummary('call_2', false),
+        });
+
+        expect(state.manifest.toolCalls).toMatchObject({
+            totalCalls: 2,
+            successfulCalls: 1,
+            failedCalls: 1,
+            analysisCompleted: false,
+        });
+        const ids = state.manifest.toolCalls?.calls.map((call) => call.id);
+        expect(ids).toEqual(['call_1', 'call_2']);
+        // Earlier state is not mutated
+        expect(initial.manifest.toolCalls).toBeNull();
+    });
+
+    it('should track the plan and status message', () => {
+        let state = applyAnalysisUpdate(initial, {
+            kind: 'plan',
+            plan: '- [ ] Check auth',
+        });
+        state = applyAnalysisUpdate(state, {
+            kind: 'status',
+            message: 'Turn 2/40: Analyzing...',
+        });
+
+        expect(state.manifest.plan).toBe('- [ ] Check auth');
+        expect(state.statusMessage).toBe('Turn 2/40: Analyzing...');
+    });
+
+    it('should stop running with the reason as status', () => {
+        const state = applyAnalysisUpdate(initial, {
+            kind: 'stopped',
+            message: 'Analysis cancelled',
+        });
+
+        expect(state.manifest.running).toBe(false);
+        expect(state.statusMessage).toBe('Analysis cancelled');
+    });
+
+    it('should replace everything with the final manifest on completion', () => {
+        const final: AnalysisManifest = {
+            ...manifest,
+            analysis: 'Looks good',
+            running: false,
+        };
+
+        const state = applyAnalysisUpdate(
+            { manifest, statusMessage: 'Turn 3/40: Analyzing...' },
+            { kind: 'complete', manifest: final }
+        );
+
+        expect(state).toEqual({ manifest: final, statusMessage: undefined });
+    });
+});
+
+describe('formatLiveAnalysisContent', () => {
+    it('should include the plan once there is one', () => {
+        expect(formatLiveAnalysisContent(undefined)).not.toContain('Plan');
+        expect(formatLiveAnalysisContent('- [ ] Check auth')).toContain(
+            '## Review Plan\n\n- [ ] Check auth'
+        );
+    });
+});
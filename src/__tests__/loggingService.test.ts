@@ -0,0 +1,46 @@
+import { describe, it, expect, vi, beforeEach, afterEach } from 'vitest';
+import { Log, LoggingService } from '../services/loggingService';
+
+describe('LoggingService', () => {
+    let consoleLog: ReturnType<typeof vi.spyOn>;
+
+    beforeEach(() => {
+        consoleLog = vi.spyOn(console, 'log').mockImplementation(() => {});
+    });
+
+    afterEach(() => {
+        LoggingService.getInstance().setLogLevel('info');
+        consoleLog.mockRestore();
+    });
+
+    it('should not build lazy messages or serialize args for disabled levels', () => {
+        const message = vi.fn(() => 'expensive');
+        const arg = {
+            toJSON: vi.fn(() => ({ large: true })),
+        };
+
+        Log.debug(message, arg);
+
+        expect(message).not.toHaveBeenCalled();
+        expect(arg.toJSON).not.toHaveBeenCalled();
+        expect(consoleLog).not.toHaveBeenCalled();
+    });
+
+    it('should build lazy messages and format args once when enabled', () => {
+        LoggingService.getInstance().setLogLevel('debug');
+        const message = vi.fn(() => 'Loaded patterns: dist, out');
+        const arg = {
+            toJSON: vi.fn(() => ({ files: 2 })),
+        };
+
+        Log.debug(message, arg);
+
+        expect(message).toHaveBeenCalledOnce();
+        expect(arg.toJSON).toHaveBeenCalledOnce();
+        expect(consoleLog).toHaveBeenCalledWith(
+            expect.stringMatching(
+                /\[debug\] Loaded patterns: dist, out \{\n {2}"files": 2\n\}$/
+            )
+        );
+    });
+});
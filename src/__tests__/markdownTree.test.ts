@@ -0,0 +1,118 @@
+import { describe, it, expect } from 'vitest';
+import type { Element } from 'hast';
+import {
+    hashContent,
+    highlightCode,
+    renderMarkdown,
+} from '../webview/utils/markdownTree';
+
+const findElement = (
+    node: { children?: unknown[] },
+    tagName: string
+): Element | undefined => {
+    for (const child of (node.children ?? []) as Element[]) {
+        if (child.type !== 'element') {
+            continue;
+        }
+        if (child.tagName === tagName) {
+            return child;
+        }
+        const found = findElement(child, tagName);
+        if (found) {
+            return found;
+        }
+    }
+    return undefined;
+};
+
+describe('renderMarkdown', () => {
+    it('should set fenced code blocks aside', () => {
+        const { tree, codeBlocks } = renderMarkdown(
+            '# Review\n\n```ts\nconst answer = 42;\n```\n\nDone.'
+        );
+
+        expect(codeBlocks).toEqual([
+            { language: 'ts', code: 'const answer = 42;' },
+        ]);
+        expect(JSON.stringify(tree)).not.toContain('hljs');
+
+        const pre = findElement(tree, 'pre');
+        expect(pre?.properties.dataCodeBlock).toBe(0);
+        expect(pre?.children).toEqual([]);
+    });
+
+    it('should read the language of each code block', () => {
+        const { codeBlocks } = renderMarkdown(
+            '```\nplain text\n```\n\n```nosuchlang\nx\n```'
+        );
+
+        expect(codeBlocks.map((block) => block.language)).toEqual([
+            '',
+            'nosuchlang',
+        ]);
+    });
+
+    it('should keep inline code in the tree', () => {
+        const { tree, codeBlocks } = renderMarkdown('Call `run()` first.');
+
+        expect(codeBlocks).toEqual([]);
+        expect(findElement(tree, 'code')?.children).toEqual([
+            { type: 'text', value: 'run()' },
+        ]);
+    });
+
+    it('should render GitHub-flavored tables', () => {
+        const { tree } = renderMarkdown('| a | b |\n| - | - |\n| 1 | 2 |');
+
+        expect(findElement(tree, 'table')).toBeDefined();
+    });
+
+    it('should drop unsafe link URLs but keep file links', () => {
+        const { tree } = renderMarkdown(
+            '[bad](javascript:alert(1)) [file](src/index.ts#L10) [web](https://example.com)'
+        );
+
+        const paragraph = findElement(tree, 'p')!;
+        const hrefs = (paragraph.children as Element[])
+            .filter((child) => child.type === 'element')
+            .map((link) => link.properties.href);
+        expect(hrefs).toEqual(['', 'src/index.ts#L10', 'https://example.com']);
+    });
+
+    it('should strip source positions', () => {
+        const { tree } = renderMarkdown('Some *text*');
+
+        expect(JSON.stringify(tree)).not.toContain('position');
+    });
+});
+
+describe('highlightCode', () => {
+    it('should highlight code in a known language', () => {
+        const highlighted = highlightCode({
+            language: 'ts',
+            code: 'const answer = 42;',
+        });
+
+        expect(JSON.stringify(highlighted)).toContain('hljs-keyword');
+        expect(JSON.stringify(highlighted)).not.toContain('position');
+    });
+
+    it('should leave code in unknown languages unhighlighted', () => {
+        expect(highlightCode({ language: '', code: 'plain text' })).toEqual([
+            { type: 'text', value: 'plain text' },
+        ]);
+        expect(
+            highlightCode({ language: 'nosuchlang', code: 'x' })
+        ).toEqual([{ type: 'text', value: 'x' }]);
+    });
+});
+
+describe('hashContent', () => {
+    it('should be stable for the same content', () => {
+        expect(hashContent('# Review')).toBe(hashContent('# Review'));
+    });
+
+    it('should differ for different content of the same length', () => {
+        expect(hashContent('# Review A')).not.toBe(hashContent('# Review B'));
+    });
+});
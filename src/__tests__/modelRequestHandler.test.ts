@@ -501,6 +501,38 @@ describe('ModelRequestHandler', () => {
             expect(response.toolCalls![1].function.name).toBe('findSymbol');
         });
 
+        it('should report each tool call before the stream finishes', async () => {
+            const seen: string[] = [];
+            const mockStream = {
+                async *[Symbol.asyncIterator]() {
+                    yield new vscode.LanguageModelToolCallPart(
+                        'call-1',
+                        'read_file',
+                        { path: '/file1.ts' }
+                    );
+                    seen.push('after first call');
+                    yield new vscode.LanguageModelTextPart('trailing text');
+                },
+            };
+
+            mockModel.sendRequest.mockResolvedValue({ stream: mockStream });
+
+            const request: ToolCallRequest = {
+                messages: [{ role: 'user', content: 'test' }],
+                tools: [],
+                onToolCall: (toolCall) => seen.push(toolCall.id),
+            };
+
+            await ModelRequestHandler.sendRequest(
+                mockModel,
+                request,
+                cancellationTokenSource.token,
+                5000
+            );
+
+            expect(seen).toEqual(['call-1', 'after first call']);
+        });
+
         it('should timeout after specified duration', async () => {
             // Mock a request that never resolves
             mockModel.sendRequest.mockImplementation(
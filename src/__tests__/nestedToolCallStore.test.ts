@@ -0,0 +1,59 @@
+import { describe, it, expect, beforeEach } from 'vitest';
+import { NestedToolCallStore } from '../services/nestedToolCallStore';
+import type { ToolCallRecord } from '../types/toolCallTypes';
+
+const createRecord = (id: string, result: string): ToolCallRecord => ({
+    id,
+    toolName: 'read_file',
+    arguments: { file_path: 'src/auth.ts' },
+    result,
+    success: true,
+    error: undefined,
+    durationMs: 5,
+    timestamp: 0,
+});
+
+describe('NestedToolCallStore', () => {
+    let store: NestedToolCallStore;
+
+    beforeEach(() => {
+        store = new NestedToolCallStore();
+    });
+
+    it('should round-trip stored tool calls', async () => {
+        const calls = [
+            createRecord('call_1', 'export function validateToken() {}'),
+            createRecord('call_2', 'line\n'.repeat(1000)),
+        ];
+
+        const ref = await store.put(calls);
+
+        expect(ref.count).toBe(2);
+        expect(await store.get(ref.key)).toEqual(calls);
+    });
+
+    it('should store results compressed', async () => {
+        const result = 'const repeated = true;\n'.repeat(5000);
+
+        await store.put([createRecord('call_1', result)]);
+
+        expect(store.size).toBeGreaterThan(0);
+        expect(store.size).toBeLessThan(result.length / 10);
+    });
+
+    it('should issue distinct keys', async () => {
+        const first = await store.put([]);
+        const second = await store.put([]);
+
+        expect(first.key).not.toBe(second.key);
+    });
+
+    it('should return undefined for unknown or cleared keys', async () => {
+        const ref = await store.put([createRecord('call_1', 'ok')]);
+        store.clear();
+
+        expect(await store.get(ref.key)).toBeUndefined();
+        expect(await store.get('missing')).toBeUndefined();
+        expect(store.size).toBe(0);
+    });
+});
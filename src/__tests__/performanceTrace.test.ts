@@ -0,0 +1,216 @@
+import { describe, it, expect, vi } from 'vitest';
+import * as z from 'zod';
+import {
+    PerformanceTrace,
+    Trace,
+    type TraceEvent,
+} from '../services/performanceTrace';
+import { ConversationRunner } from '../models/conversationRunner';
+import { ConversationManager } from '../models/conversationManager';
+import { ToolExecutor } from '../models/toolExecutor';
+import { ToolRegistry } from '../models/toolRegistry';
+import type { ILLMClient } from '../models/ILLMClient';
+import type { ITool } from '../tools/ITool';
+import { toolSuccess } from '../types/toolResultTypes';
+import type { ToolCallRequest } from '../types/modelTypes';
+import {
+    createMockCancellationTokenSource,
+    createMockExecutionContext,
+    createMockWorkspaceSettings,
+} from './testUtils/mockFactories';
+
+const eventsOf = (trace: PerformanceTrace, ph?: TraceEvent['ph']) =>
+    trace
+        .toJSON()
+        .traceEvents.filter((event) => !ph || event.ph === ph);
+
+const trackNames = (trace: PerformanceTrace) =>
+    eventsOf(trace, 'M')
+        .filter((event) => event.name === 'thread_name')
+        .map((event) => event.args!.name);
+
+const listDirTool: ITool = {
+    name: 'list_dir',
+    description: 'List a directory',
+    schema: z.object({ relative_path: z.string() }),
+    getVSCodeTool: () => ({
+        name: 'list_dir',
+        description: 'List a directory',
+        inputSchema: {},
+    }),
+    execute: async () => toolSuccess('src/'),
+};
+
+describe('PerformanceTrace', () => {
+    it('should record nothing outside Trace.run', () => {
+        const span = Trace.span('orphan', 'iteration');
+
+        expect(() => span.end()).not.toThrow();
+        expect(() => Trace.instant('orphan', 'llm')).not.toThrow();
+    });
+
+    it('should record complete spans on the main track with merged args', async () => {
+        const trace = new PerformanceTrace('Main Analysis');
+
+        await Trace.run(trace, async () => {
+            const span = Trace.span('validateTokens', 'tokens', { a: 1 });
+            await new Promise((resolve) => setTimeout(resolve, 5));
+            span.end({ b: 2 });
+            span.end({ c: 3 });
+        });
+
+        const [span] = eventsOf(trace, 'X');
+        expect(span).toMatchObject({
+            name: 'validateTokens',
+            cat: 'tokens',
+            tid: 1,
+            args: { a: 1, b: 2 },
+        });
+        expect(span.dur).toBeGreaterThanOrEqual(4000);
+        expect(eventsOf(trace, 'X')).toHaveLength(1);
+        expect(trackNames(trace)).toEqual(['Main Analysis']);
+    });
+
+    it('should keep concurrent analyses in separate traces', async () => {
+        const first = new PerformanceTrace('First');
+        const second = new PerformanceTrace('Second');
+        const work = async (name: string) => {
+            await new Promise((resolve) => setTimeout(resolve, 1));
+            Trace.span(name, 'tool').end();
+        };
+
+        await Promise.all([
+            Trace.run(first, () => work('first')),
+            Trace.run(second, () => work('second')),
+        ]);
+
+        expect(eventsOf(first, 'X').map((event) => event.name)).toEqual([
+            'first',
+        ]);
+        expect(eventsOf(second, 'X').map((event) => event.name)).toEqual([
+            'second',
+        ]);
+    });
+
+    it('should put tracked work on its own track', async () => {
+        const trace = new PerformanceTrace('Main Analysis');
+
+        await Trace.run(trace, () =>
+            Trace.track('Subagent #1', async () => {
+                Trace.span('Iteration 1', 'iteration').end();
+            })
+        );
+
+        expect(trackNames(trace)).toEqual(['Main Analysis', 'Subagent #1']);
+        expect(eventsOf(trace, 'X')[0].tid).toBe(2);
+    });
+
+    it('should export metadata with the trace', () => {
+        const trace = new PerformanceTrace('Main Analysis');
+
+        trace.setMetadata('firstAnalysis', true);
+
+        expect(trace.toJSON().otherData).toMatchObject({
+            firstAnalysis: true,
+            label: 'Main Analysis',
+        });
+    });
+
+    it('should close measured spans when the promise rejects', async () => {
+        const trace = new PerformanceTrace('Main Analysis');
+
+        await Trace.run(trace, async () => {
+            await expect(
+                Trace.measure(
+                    'vscode.executeReferenceProvider',
+                    'lsp',
+                    Promise.reject(new Error('LSP crashed'))
+                )
+            ).rejects.toThrow('LSP crashed');
+        });
+
+        const [begin, end] = eventsOf(trace).filter(
+            (event) => event.cat === 'lsp'
+        );
+        expect(begin.ph).toBe('b');
+        expect(end).toMatchObject({
+            ph: 'e',
+            id: begin.id,
+            args: { failed: true },
+        });
+    });
+
+    it('should trace iterations, LLM requests and tools of a conversation', async () => {
+        const trace = new PerformanceTrace('Main Analysis');
+        const responses = [
+            {
+                content: null,
+                toolCalls: [
+                    {
+                        id: 'call_1',
+                        function: {
+                            name: 'list_dir',
+                            arguments: '{"relative_path":"."}',
+                        },
+                    },
+                ],
+            },
+            { content: 'Done' },
+        ];
+        const client: ILLMClient = {
+            sendRequest: vi.fn(async (request: ToolCallRequest) => {
+                const response = responses.shift()!;
+                await new Promise((resolve) => setTimeout(resolve, 2));
+                request.onFirstChunk?.();
+                return response;
+            }),
+            getCurrentModel: vi.fn().mockResolvedValue({
+                maxInputTokens: 100_000,
+                countTokens: vi.fn().mockResolvedValue(10),
+            }),
+        };
+        const registry = new ToolRegistry();
+        registry.registerTool(listDirTool);
+        const tokenSource = createMockCancellationTokenSource();
+        const runner = new ConversationRunner(
+            client,
+            new ToolExecutor(
+                registry,
+                createMockWorkspaceSettings(),
+                createMockExecutionContext({
+                    cancellationToken: tokenSource.token,
+                })
+            )
+        );
+        const conversation = new ConversationManager();
+        conversation.addUserMessage('Review');
+
+        await Trace.run(trace, () =>
+            runner.run(
+                { systemPrompt: 'System', maxIterations: 5, tools: [] },
+                conversation,
+                tokenSource.token
+            )
+        );
+
+        const spans = eventsOf(trace, 'X');
+        expect(spans.map((span) => span.name)).toEqual([
+            'validateTokens',
+            'LLM request',
+            'Iteration 1',
+            'validateTokens',
+            'LLM request',
+            'Iteration 2',
+        ]);
+        const request = spans.find((span) => span.name === 'LLM request')!;
+        expect(request.args!.timeToFirstTokenMs).toBeGreaterThanOrEqual(1);
+        expect(eventsOf(trace, 'i')).toHaveLength(2);
+
+        const [toolBegin, toolEnd] = eventsOf(trace).filter(
+            (event) => event.cat === 'tool'
+        );
+        expect(toolBegin).toMatchObject({ name: 'list_dir', ph: 'b' });
+        expect(toolBegin.args!.queueMs).toBeGreaterThanOrEqual(0);
+        expect(toolEnd).toMatchObject({ ph: 'e', args: { success: true } });
+    });
+});
@@ -1,4 +1,4 @@
-import { describe, it, expect, beforeEach } from 'vitest';
+import { describe, it, expect, beforeEach, vi } from 'vitest';
 import { PlanSessionManager } from '../services/planSessionManager';
 
 describe('PlanSessionManager', () => {
@@ -22,6 +22,19 @@ describe('PlanSessionManager', () => {
             expect(manager.getPlan()).toBe(plan);
         });
 
+        it('should notify the listener of every update', () => {
+            const onPlanUpdated = vi.fn();
+            manager = new PlanSessionManager(onPlanUpdated);
+
+            manager.updatePlan('Initial plan');
+            manager.updatePlan('Updated plan');
+
+            expect(onPlanUpdated.mock.calls).toEqual([
+                ['Initial plan'],
+                ['Updated plan'],
+            ]);
+        });
+
         it('should update plan multiple times', () => {
             manager.updatePlan('Initial plan');
             manager.updatePlan('Updated plan');
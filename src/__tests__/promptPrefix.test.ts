@@ -0,0 +1,66 @@
+import { describe, it, expect } from 'vitest';
+import type { LanguageModelChatTool } from 'vscode';
+import { fingerprintPromptPrefix } from '../utils/promptPrefix';
+import type { ToolCallMessage } from '../types/modelTypes';
+
+const tools: LanguageModelChatTool[] = [
+    {
+        name: 'read_file',
+        description: 'Read a file',
+        inputSchema: { type: 'object', properties: {} },
+    },
+];
+
+const baseMessages = (): ToolCallMessage[] => [
+    { role: 'system', content: 'You are a reviewer.' },
+    { role: 'user', content: 'Review this diff.' },
+];
+
+describe('fingerprintPromptPrefix', () => {
+    it('should be stable for identical input', () => {
+        const first = fingerprintPromptPrefix(baseMessages(), tools);
+        const second = fingerprintPromptPrefix(baseMessages(), [...tools]);
+
+        expect(first.hash).toBe(second.hash);
+        expect(first.hash).toMatch(/^[0-9a-f]{12}$/);
+    });
+
+    it('should ignore messages after the first user message', () => {
+        const first = fingerprintPromptPrefix(baseMessages(), tools);
+        const later = fingerprintPromptPrefix(
+            [
+                ...baseMessages(),
+                { role: 'assistant', content: 'Reading files.' },
+                { role: 'user', content: 'Continue.' },
+            ],
+            tools
+        );
+
+        expect(later.hash).toBe(first.hash);
+        expect(later.chars).toBe(first.chars);
+    });
+
+    it('should change when the system prompt changes', () => {
+        const messages = baseMessages();
+        messages[0]!.content = 'You are a strict reviewer.';
+
+        expect(fingerprintPromptPrefix(messages, tools).hash).not.toBe(
+            fingerprintPromptPrefix(baseMessages(), tools).hash
+        );
+    });
+
+    it('should change when the tool schemas change', () => {
+        expect(fingerprintPromptPrefix(baseMessages(), []).hash).not.toBe(
+            fingerprintPromptPrefix(baseMessages(), tools).hash
+        );
+    });
+
+    it('should change when the first user message changes', () => {
+        const messages = baseMessages();
+        messages[1]!.content = 'Review this other diff.';
+
+        expect(fingerprintPromptPrefix(messages, tools).hash).not.toBe(
+            fingerprintPromptPrefix(baseMessages(), tools).hash
+        );
+    });
+});
@@ -0,0 +1,171 @@
+import { describe, it, expect } from 'vitest';
+import { createMockCancellationTokenSource } from './testUtils/mockFactories';
+import { generateSyntheticWorkspace } from './testUtils/syntheticRepo';
+import {
+    ReplayLLMClient,
+    transcriptFromToolCallRecords,
+} from '../__benchmarks__/replay/replayLLMClient';
+import { runReplay } from '../__benchmarks__/replay/replayHarness';
+import type { ToolCallRecord } from '../types/toolCallTypes';
+import type { ToolCall } from '../types/modelTypes';
+
+const record = (
+    toolName: string,
+    args: Record<string, unknown>,
+    timestamp: number,
+    durationMs = 10
+): ToolCallRecord => ({
+    id: `${toolName}_${timestamp}`,
+    toolName,
+    arguments: args,
+    result: 'ok',
+    success: true,
+    error: undefined,
+    durationMs,
+    timestamp,
+});
+
+const review = '## Summary\n\nNo issues found in the replayed changes.';
+
+describe('Replay harness', () => {
+    describe('transcriptFromToolCallRecords', () => {
+        it('should group calls started together into one turn', () => {
+            const transcript = transcriptFromToolCallRecords([
+                record('read_file', { file_path: 'a.ts' }, 1000, 20),
+                record('read_file', { file_path: 'b.ts' }, 1002, 40),
+                record(
+                    'list_directory',
+                    { relative_path: 'src', recursive: false },
+                    3040
+                ),
+                record('submit_review', { review_content: review }, 5000),
+            ]);
+
+            expect(transcript.turns).toHaveLength(3);
+            expect(transcript.turns[0].toolCalls).toHaveLength(2);
+            expect(transcript.turns[0].latencyMs).toBeUndefined();
+            // First batch ends at 1042 (b.ts), next call starts at 3040
+            expect(transcript.turns[1].latencyMs).toBe(1998);
+            expect(transcript.turns[2].toolCalls![0].name).toBe(
+                'submit_review'
+            );
+        });
+
+        it('should append a submit_review turn when the records lack one', () => {
+            const transcript = transcriptFromToolCallRecords(
+                [
+                    record(
+                        'list_directory',
+                        { relative_path: '.', recursive: false },
+                        0
+                    ),
+                ],
+                { finalReview: review }
+            );
+
+            expect(transcript.turns.at(-1)!.toolCalls).toEqual([
+                { name: 'submit_review', args: { review_content: review } },
+            ]);
+        });
+    });
+
+    describe('ReplayLLMClient', () => {
+        it('should replay turns in order and report tool calls as they stream', async () => {
+            const client = new ReplayLLMClient({
+                turns: [
+                    {
+                        toolCalls: [
+                            {
+                                name: 'list_directory',
+                                args: { relative_path: '.', recursive: false },
+                            },
+                        ],
+                    },
+                    { content: 'Done' },
+                ],
+            });
+            const token = createMockCancellationTokenSource().token;
+            const streamed: ToolCall[] = [];
+
+            const first = await client.sendRequest(
+                {
+                    messages: [{ role: 'user', content: 'Review' }],
+                    onToolCall: (call) => streamed.push(call),
+                },
+                token
+            );
+            const second = await client.sendRequest(
+                { messages: [{ role: 'user', content: 'Review' }] },
+                token
+            );
+
+            expect(first.toolCalls).toEqual([
+                {
+                    id: 'replay_0_0',
+                    function: {
+                        name: 'list_directory',
+                        arguments: '{"relative_path":".","recursive":false}',
+                    },
+                },
+            ]);
+            expect(streamed).toEqual(first.toolCalls);
+            expect(second).toEqual({ content: 'Done', toolCalls: undefined });
+            expect(client.exhausted).toBe(true);
+            expect(client.requestCount).toBe(2);
+        });
+    });
+
+    describe('runReplay', () => {
+        const workspace = generateSyntheticWorkspace({ files: 100, depth: 2 });
+        const sourceFile = [...workspace.files.keys()].find(
+            (file) => file.endsWith('.ts') && !workspace.ignoredByRoot.has(file)
+        )!;
+
+        it('should run recorded tool calls against the fixture workspace', async () => {
+            const report = await runReplay(
+                {
+                    turns: [
+                        {
+                            toolCalls: [
+                                {
+                                    name: 'list_directory',
+                                    args: {
+                                        relative_path: '.',
+                                        recursive: false,
+                                    },
+                                },
+                                {
+                                    name: 'read_file',
+                                    args: { file_path: sourceFile },
+                                },
+                            ],
+                        },
+                        {
+                            toolCalls: [
+                                {
+                                    name: 'submit_review',
+                                    args: { review_content: review },
+                                },
+                            ],
+                        },
+                    ],
+                },
+                { workspace }
+            );
+
+            expect(report.result).toBe(review);
+            expect(report.iterations).toBe(2);
+            expect(report.toolCalls).toBe(3);
+            expect(report.failedToolCalls).toBe(0);
+            expect([...report.succeededTools].sort()).toEqual([
+                'list_directory',
+                'read_file',
+                'submit_review',
+            ]);
+            expect(report.wallMs).toBeGreaterThan(0);
+            expect(report.phases.toolExecutionMs).toBeGreaterThan(0);
+            expect(report.phases.messageConversionMs).toBeGreaterThan(0);
+            expect(report.phases.llmWaitMs).toBeGreaterThanOrEqual(0);
+        });
+    });
+});
@@ -10,7 +10,9 @@ vi.mock('child_process', () => ({
 
 // Mock fs for the path validation
 vi.mock('fs', () => ({
-    existsSync: vi.fn().mockReturnValue(true),
+    promises: {
+        access: vi.fn().mockResolvedValue(undefined),
+    },
 }));
 
 describe('RipgrepSearchService', () => {
@@ -37,6 +39,10 @@ describe('RipgrepSearchService', () => {
         }
     }
 
+    // The binary path is resolved asynchronously before ripgrep is spawned
+    const waitForSpawn = () =>
+        vi.waitFor(() => expect(mockSpawn).toHaveBeenCalled());
+
     beforeEach(() => {
         vi.clearAllMocks();
         vi.useFakeTimers();
@@ -77,6 +83,7 @@ describe('RipgrepSearchService', () => {
                 multiline: false,
                 token: mockToken as vscode.CancellationToken,
             });
+            await waitForSpawn();
 
             // Trigger cancellation and mark token as cancelled
             expect(cancellationCallback).toBeDefined();
@@ -124,6 +131,7 @@ describe('RipgrepSearchService', () => {
                 multiline: false,
                 token: mockToken as vscode.CancellationToken,
             });
+            await waitForSpawn();
 
             // Suppress unhandled rejection warning
             searchPromise.catch(() => {});
@@ -171,6 +179,7 @@ describe('RipgrepSearchService', () => {
                 multiline: false,
                 token: mockToken as vscode.CancellationToken,
             });
+            await waitForSpawn();
 
             // Trigger cancellation (this sets up the SIGKILL timeout)
             mockToken.isCancellationRequested = true;
@@ -222,6 +231,7 @@ describe('RipgrepSearchService', () => {
                 multiline: false,
                 token: mockToken as vscode.CancellationToken,
             });
+            await waitForSpawn();
 
             // Suppress unhandled rejection for cleanup
             searchPromise.catch(() => {});
@@ -274,6 +284,7 @@ describe('RipgrepSearchService', () => {
                 multiline: false,
                 token: mockToken as vscode.CancellationToken,
             });
+            await waitForSpawn();
 
             // Trigger cancellation
             mockToken.isCancellationRequested = true;
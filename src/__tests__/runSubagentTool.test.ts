@@ -13,6 +13,8 @@ import {
     createMockExecutionContext,
 } from './testUtils/mockFactories';
 import { TimeoutError } from '../types/errorTypes';
+import { TokenConstants } from '../models/tokenConstants';
+import { NestedToolCallStore } from '../services/nestedToolCallStore';
 
 const createMockExecutor = (
     result: Partial<SubagentResult> = {}
@@ -120,7 +122,8 @@ describe('RunSubagentTool', () => {
                     context: 'PR adds new JWT validation',
                 }),
                 expect.anything(),
-                expect.any(Number)
+                expect.any(Number),
+                expect.anything()
             );
         });
     });
@@ -162,7 +165,8 @@ describe('RunSubagentTool', () => {
             expect(mockExecutor.execute).toHaveBeenCalledWith(
                 expect.anything(),
                 expect.anything(),
-                1
+                1,
+                expect.anything()
             );
         });
 
@@ -191,6 +195,77 @@ describe('RunSubagentTool', () => {
         });
     });
 
+    describe('Budget Scheduling', () => {
+        it('should pass the allocated budget to the executor', async () => {
+            const mockExecutor = createMockExecutor();
+            const tool = new RunSubagentTool(workspaceSettings);
+            const context = createSubagentExecutionContext(
+                mockExecutor,
+                sessionManager
+            );
+
+            await tool.execute(
+                {
+                    task: 'Investigate the authentication flow thoroughly',
+                },
+                context
+            );
+
+            const options = vi.mocked(mockExecutor.execute).mock.calls[0][3];
+            expect(options?.budget?.iterations).toBeGreaterThan(0);
+            expect(options?.budget?.tokens).toBeGreaterThan(0);
+            expect(options?.budget?.timeoutMs).toBeGreaterThan(0);
+        });
+
+        it('should return unused budget after the subagent finishes', async () => {
+            const mockExecutor = createMockExecutor({
+                usage: { iterations: 0, tokens: 0 },
+            });
+            const tool = new RunSubagentTool(workspaceSettings);
+            const context = createSubagentExecutionContext(
+                mockExecutor,
+                sessionManager
+            );
+            const releaseSpy = vi.spyOn(sessionManager, 'releaseBudget');
+
+            await tool.execute(
+                {
+                    task: 'Investigate the authentication flow thoroughly',
+                },
+                context
+            );
+
+            expect(releaseSpy).toHaveBeenCalledWith(
+                expect.objectContaining({ iterations: expect.any(Number) }),
+                { iterations: 0, tokens: 0 }
+            );
+        });
+
+        it('should reject spawns when the budget pool is exhausted', async () => {
+            const mockExecutor = createMockExecutor();
+            const tool = new RunSubagentTool(workspaceSettings);
+            const context = createSubagentExecutionContext(
+                mockExecutor,
+                sessionManager
+            );
+            vi.spyOn(sessionManager, 'allocateBudget').mockReturnValue(
+                undefined
+            );
+
+            const result = await tool.execute(
+                {
+                    task: 'Investigate the authentication flow thoroughly',
+                },
+                context
+            );
+
+            expect(result.success).toBe(false);
+            expect(result.error).toContain('budget');
+            expect(mockExecutor.execute).not.toHaveBeenCalled();
+            expect(sessionManager.getCount()).toBe(0);
+        });
+    });
+
     describe('Result Formatting', () => {
         it('should format successful results with subagent ID', async () => {
             const mockExecutor = createMockExecutor({
@@ -221,6 +296,72 @@ describe('RunSubagentTool', () => {
             expect(result.data).toContain('8');
         });
 
+        it('should cap the response returned to the parent', async () => {
+            const findings = Array.from(
+                { length: 500 },
+                (_, i) => `- Finding ${i} in src/file${i}.ts:${i + 1}`
+            ).join('\n');
+            const mockExecutor = createMockExecutor({
+                response: `### Findings\n${findings}`,
+            });
+            const tool = new RunSubagentTool(workspaceSettings);
+            const context = createSubagentExecutionContext(
+                mockExecutor,
+                sessionManager
+            );
+
+            const result = await tool.execute(
+                {
+                    task: 'Investigate the authentication flow thoroughly',
+                },
+                context
+            );
+
+            expect(result.success).toBe(true);
+            expect(result.data!.length).toBeLessThan(
+                SubagentLimits.RESULT_MAX_TOKENS *
+                    TokenConstants.CHARS_PER_TOKEN_ESTIMATE +
+                    200
+            );
+            expect(result.data).toContain('Finding 0');
+            expect(result.data).toContain('Omitted');
+        });
+
+        it('should store nested tool calls out-of-line when a store is available', async () => {
+            const toolCalls = [
+                {
+                    id: 'call_1',
+                    toolName: 'read_file',
+                    arguments: { file_path: 'src/auth.ts' },
+                    result: 'file contents',
+                    success: true,
+                    error: undefined,
+                    durationMs: 3,
+                    timestamp: 0,
+                },
+            ];
+            const mockExecutor = createMockExecutor({ toolCalls });
+            const nestedToolCallStore = new NestedToolCallStore();
+            const tool = new RunSubagentTool(workspaceSettings);
+            const context = createMockExecutionContext({
+                subagentExecutor: mockExecutor,
+                subagentSessionManager: sessionManager,
+                nestedToolCallStore,
+            });
+
+            const result = await tool.execute(
+                {
+                    task: 'Investigate the authentication flow thoroughly',
+                },
+                context
+            );
+
+            expect(result.metadata?.nestedToolCalls).toBeUndefined();
+            const ref = result.metadata?.nestedToolCallsRef;
+            expect(ref?.count).toBe(1);
+            expect(await nestedToolCallStore.get(ref!.key)).toEqual(toolCalls);
+        });
+
         it('should report generic failures as tool errors', async () => {
             const mockExecutor = createMockExecutor({
                 success: false,
@@ -580,6 +721,42 @@ describe('RunSubagentTool', () => {
         });
     });
 
+    describe('Early Cancellation', () => {
+        it('should report early cancellation with partial findings', async () => {
+            const mockExecutor = {
+                execute: vi.fn().mockImplementation(async () => {
+                    // A sibling submit_review makes this investigation moot
+                    expect(sessionManager.getRunningCount()).toBe(1);
+                    sessionManager.cancelOutstanding('review submitted');
+                    return {
+                        success: false,
+                        response: 'login() already uses timingSafeEqual',
+                        error: 'cancelled',
+                        toolCallsMade: 2,
+                        toolCalls: [],
+                    };
+                }),
+            } as unknown as SubagentExecutor;
+            const tool = new RunSubagentTool(workspaceSettings);
+            const context = createSubagentExecutionContext(
+                mockExecutor,
+                sessionManager
+            );
+
+            const result = await tool.execute(
+                {
+                    task: 'Investigate the authentication flow thoroughly',
+                },
+                context
+            );
+
+            expect(result.success).toBe(false);
+            expect(result.error).toContain('stopped early (review submitted)');
+            expect(result.error).toContain('timingSafeEqual');
+            expect(sessionManager.getRunningCount()).toBe(0);
+        });
+    });
+
     describe('Parallel Execution Safety', () => {
         it('should use separate cancellation tokens for parallel executions', async () => {
             const capturedTokens: vscode.CancellationToken[] = [];
@@ -0,0 +1,246 @@
+import { describe, it, expect, vi, beforeEach } from 'vitest';
+import * as vscode from 'vscode';
+import { RunSubagentsTool } from '../tools/runSubagentsTool';
+import { SubagentExecutor } from '../services/subagentExecutor';
+import { SubagentSessionManager } from '../services/subagentSessionManager';
+import { WorkspaceSettingsService } from '../services/workspaceSettingsService';
+import { SUBAGENT_LIMITS } from '../models/workspaceSettingsSchema';
+import { SubagentLimits } from '../models/toolConstants';
+import type { SubagentResult, SubagentTask } from '../types/modelTypes';
+import {
+    createMockWorkspaceSettings,
+    createMockExecutionContext,
+} from './testUtils/mockFactories';
+
+const authTask = {
+    task: 'Investigate src/auth.ts: does login() compare passwords in constant time?',
+};
+const cacheTask = {
+    task: 'Investigate src/cache.ts: is the session cache invalidated on logout?',
+};
+
+const structured = (summary: string, finding: string, evidence: string) =>
+    `### Summary\n${summary}\n\n### Findings\n- ${finding}\n\n### Evidence\n- ${evidence}`;
+
+/**
+ * Executor whose result depends on the task, so parallel runs are distinguishable.
+ */
+const createMockExecutor = (
+    respond: (task: SubagentTask) => Partial<SubagentResult>
+): SubagentExecutor =>
+    ({
+        execute: vi.fn().mockImplementation(async (task: SubagentTask) => ({
+            success: true,
+            response: 'Findings',
+            toolCallsMade: 3,
+            toolCalls: [],
+            ...respond(task),
+        })),
+    }) as unknown as SubagentExecutor;
+
+describe('RunSubagentsTool', () => {
+    let sessionManager: SubagentSessionManager;
+    let workspaceSettings: WorkspaceSettingsService;
+
+    beforeEach(() => {
+        workspaceSettings = createMockWorkspaceSettings();
+        sessionManager = new SubagentSessionManager(workspaceSettings);
+    });
+
+    const createContext = (executor: SubagentExecutor) =>
+        createMockExecutionContext({
+            subagentExecutor: executor,
+            subagentSessionManager: sessionManager,
+        });
+
+    it('should have correct name', () => {
+        expect(new RunSubagentsTool(workspaceSettings).name).toBe(
+            'run_subagents'
+        );
+    });
+
+    it('should require at least two tasks', async () => {
+        const executor = createMockExecutor(() => ({}));
+        const tool = new RunSubagentsTool(workspaceSettings);
+
+        const result = await tool.execute(
+            { tasks: [authTask] },
+            createContext(executor)
+        );
+
+        expect(result.success).toBe(false);
+        expect(result.error).toContain('run_subagent');
+        expect(executor.execute).not.toHaveBeenCalled();
+    });
+
+    it('should reject more tasks than the fan-out limit', async () => {
+        const executor = createMockExecutor(() => ({}));
+        const tool = new RunSubagentsTool(workspaceSettings);
+        const tasks = Array.from(
+            { length: SubagentLimits.FANOUT_MAX_TASKS + 1 },
+            () => authTask
+        );
+
+        const result = await tool.execute({ tasks }, createContext(executor));
+
+        expect(result.success).toBe(false);
+        expect(executor.execute).not.toHaveBeenCalled();
+    });
+
+    it('should run tasks concurrently', async () => {
+        let inFlight = 0;
+        let maxInFlight = 0;
+        const executor = {
+            execute: vi.fn().mockImplementation(async () => {
+                inFlight++;
+                maxInFlight = Math.max(maxInFlight, inFlight);
+                await new Promise((resolve) => setTimeout(resolve, 10));
+                inFlight--;
+                return {
+                    success: true,
+                    response: 'Done',
+                    toolCallsMade: 1,
+                    toolCalls: [],
+                };
+            }),
+        } as unknown as SubagentExecutor;
+        const tool = new RunSubagentsTool(workspaceSettings);
+
+        const result = await tool.execute(
+            { tasks: [authTask, cacheTask] },
+            createContext(executor)
+        );
+
+        expect(result.success).toBe(true);
+        expect(maxInFlight).toBe(2);
+        expect(sessionManager.getCount()).toBe(2);
+    });
+
+    it('should merge duplicate findings across subagents', async () => {
+        const shared =
+            'High — logout leaves the session cached (src/cache.ts:40)';
+        const executor = createMockExecutor((task) => ({
+            response: task.task.includes('auth')
+                ? structured('Login is fine.', shared, 'src/auth.ts:10 — ok')
+                : structured(
+                      'Cache outlives logout.',
+                      shared,
+                      'src/cache.ts:40 — no delete'
+                  ),
+        }));
+        const tool = new RunSubagentsTool(workspaceSettings);
+
+        const result = await tool.execute(
+            { tasks: [authTask, cacheTask] },
+            createContext(executor)
+        );
+
+        expect(result.success).toBe(true);
+        expect(result.data).toContain('2/2 subagents succeeded');
+        expect(result.data).toContain('**Tool calls made:** 6');
+        expect(result.data).toContain(`[Task 1, Task 2] ${shared}`);
+        expect(result.data).toContain('**Task 2**: Cache outlives logout.');
+    });
+
+    it('should label flattened nested calls with their task', async () => {
+        const executor = createMockExecutor((task) => ({
+            toolCalls: [
+                {
+                    id: task.task.includes('auth') ? 'auth_call' : 'cache_call',
+                    toolName: 'read_file',
+                    arguments: {},
+                    result: 'ok',
+                    success: true,
+                    error: undefined,
+                    durationMs: 1,
+                    timestamp: 0,
+                },
+            ],
+        }));
+        const tool = new RunSubagentsTool(workspaceSettings);
+
+        const result = await tool.execute(
+            { tasks: [authTask, cacheTask] },
+            createContext(executor)
+        );
+
+        expect(
+            result.metadata?.nestedToolCalls?.map((call) => [
+                call.id,
+                call.subagentLabel,
+            ])
+        ).toEqual([
+            ['auth_call', 'Task 1'],
+            ['cache_call', 'Task 2'],
+        ]);
+    });
+
+    it('should report failed tasks alongside successful ones', async () => {
+        const executor = createMockExecutor((task) =>
+            task.task.includes('auth')
+                ? { success: false, error: 'LLM unavailable' }
+                : {}
+        );
+        const tool = new RunSubagentsTool(workspaceSettings);
+
+        const result = await tool.execute(
+            { tasks: [authTask, cacheTask] },
+            createContext(executor)
+        );
+
+        expect(result.success).toBe(true);
+        expect(result.data).toContain('1/2 subagents succeeded');
+        expect(result.data).toContain('### Failed Tasks');
+        expect(result.data).toContain('- Task 1: Subagent failed');
+    });
+
+    it('should return an error when every task fails', async () => {
+        const executor = createMockExecutor(() => ({
+            success: false,
+            error: 'LLM unavailable',
+        }));
+        const tool = new RunSubagentsTool(workspaceSettings);
+
+        const result = await tool.execute(
+            { tasks: [authTask, cacheTask] },
+            createContext(executor)
+        );
+
+        expect(result.success).toBe(false);
+        expect(result.error).toContain('All subagents failed');
+    });
+
+    it('should only spawn up to the session limit', async () => {
+        const maxSubagents = SUBAGENT_LIMITS.maxPerSession.default;
+        for (let i = 0; i < maxSubagents - 1; i++) {
+            sessionManager.recordSpawn();
+        }
+        const executor = createMockExecutor(() => ({}));
+        const tool = new RunSubagentsTool(workspaceSettings);
+
+        const result = await tool.execute(
+            { tasks: [authTask, cacheTask] },
+            createContext(executor)
+        );
+
+        expect(executor.execute).toHaveBeenCalledTimes(1);
+        expect(result.success).toBe(true);
+        expect(result.data).toContain('- Task 2: Maximum subagents');
+    });
+
+    it('should propagate parent cancellation', async () => {
+        const executor = {
+            execute: vi
+                .fn()
+                .mockRejectedValue(new vscode.CancellationError()),
+        } as unknown as SubagentExecutor;
+        const tool = new RunSubagentsTool(workspaceSettings);
+
+        await expect(
+            tool.execute(
+                { tasks: [authTask, cacheTask] },
+                createContext(executor)
+            )
+        ).rejects.toThrow(vscode.CancellationError);
+    });
+});
@@ -0,0 +1,236 @@
+import { describe, it, expect, vi, beforeEach, afterEach } from 'vitest';
+import { SubagentBudgetScheduler } from '../services/subagentBudgetScheduler';
+import { SubagentLimits } from '../models/toolConstants';
+import { ANALYSIS_LIMITS } from '../models/workspaceSettingsSchema';
+import { createMockWorkspaceSettings } from './testUtils/mockFactories';
+import type { ConversationBudget } from '../models/conversationRunner';
+
+const simpleTask = { task: 'Investigate the authentication flow thoroughly' };
+const detailedTask = {
+    task:
+        'Task about src/auth.ts:\n' +
+        'Questions:\n' +
+        '1. How does validateToken work?\n' +
+        '2. Does it handle expired tokens?\n' +
+        '3. Is the result cached in src/session.ts?',
+    context: 'See src/middleware.ts',
+};
+
+describe('SubagentBudgetScheduler', () => {
+    const maxIterations = ANALYSIS_LIMITS.maxIterations.default;
+    const timeoutMs = ANALYSIS_LIMITS.requestTimeoutSeconds.default * 1000;
+    const iterationPool =
+        maxIterations * SubagentLimits.BUDGET_ITERATION_POOL_FACTOR;
+
+    beforeEach(() => {
+        vi.useFakeTimers();
+    });
+
+    afterEach(() => {
+        vi.useRealTimers();
+    });
+
+    it('should size pools from workspace settings', () => {
+        const scheduler = new SubagentBudgetScheduler(
+            createMockWorkspaceSettings()
+        );
+
+        expect(scheduler.getIterationsRemaining()).toBe(iterationPool);
+        expect(scheduler.getTokensRemaining()).toBe(
+            iterationPool * SubagentLimits.BUDGET_TOKENS_PER_ITERATION
+        );
+    });
+
+    it('should give detailed tasks a larger share than simple ones', () => {
+        const scheduler = new SubagentBudgetScheduler(
+            createMockWorkspaceSettings()
+        );
+
+        const simple = scheduler.allocate(simpleTask, 10)!;
+        const detailed = scheduler.allocate(detailedTask, 9)!;
+
+        expect(detailed.iterations).toBeGreaterThan(simple.iterations);
+        expect(detailed.tokens).toBeGreaterThan(simple.tokens);
+    });
+
+    it('should never exceed the per-subagent iteration and timeout settings', () => {
+        const scheduler = new SubagentBudgetScheduler(
+            createMockWorkspaceSettings()
+        );
+
+        const budget = scheduler.allocate(detailedTask, 1)!;
+
+        expect(budget.iterations).toBe(maxIterations);
+        expect(budget.tokens).toBe(
+            maxIterations * SubagentLimits.BUDGET_TOKENS_PER_ITERATION
+        );
+        expect(budget.timeoutMs).toBe(timeoutMs);
+    });
+
+    it('should return unused budget to the pool', () => {
+        const scheduler = new SubagentBudgetScheduler(
+            createMockWorkspaceSettings()
+        );
+        const budget = scheduler.allocate(simpleTask, 10)!;
+        const afterAllocation = scheduler.getIterationsRemaining();
+
+        scheduler.release(budget, { iterations: 2, tokens: 1000 });
+
+        expect(scheduler.getIterationsRemaining()).toBe(
+            afterAllocation + budget.iterations - 2
+        );
+    });
+
+    it('should treat an allocation as spent when usage is unknown', () => {
+        const scheduler = new SubagentBudgetScheduler(
+            createMockWorkspaceSettings()
+        );
+        const budget = scheduler.allocate(simpleTask, 10)!;
+        const afterAllocation = scheduler.getIterationsRemaining();
+
+        scheduler.release(budget, undefined);
+
+        expect(scheduler.getIterationsRemaining()).toBe(afterAllocation);
+    });
+
+    it('should refuse allocations once the iteration pool is drained', () => {
+        const scheduler = new SubagentBudgetScheduler(
+            createMockWorkspaceSettings()
+        );
+
+        while (scheduler.allocate(detailedTask, 1)) {
+            // Drain the pool
+        }
+
+        expect(scheduler.getIterationsRemaining()).toBeLessThan(
+            SubagentLimits.BUDGET_MIN_ITERATIONS
+        );
+        expect(scheduler.allocate(simpleTask, 1)).toBeUndefined();
+    });
+
+    it('should shorten timeouts for late spawns and refuse past the deadline', () => {
+        const scheduler = new SubagentBudgetScheduler(
+            createMockWorkspaceSettings()
+        );
+        const window =
+            timeoutMs * SubagentLimits.BUDGET_TIME_WINDOW_FACTOR -
+            SubagentLimits.BUDGET_PARENT_RESERVE_MS;
+
+        vi.advanceTimersByTime(
+            window - 2 * SubagentLimits.BUDGET_MIN_TIMEOUT_MS
+        );
+        expect(scheduler.allocate(simpleTask, 10)?.timeoutMs).toBe(
+            2 * SubagentLimits.BUDGET_MIN_TIMEOUT_MS
+        );
+
+        vi.advanceTimersByTime(2 * SubagentLimits.BUDGET_MIN_TIMEOUT_MS);
+        expect(scheduler.allocate(simpleTask, 10)).toBeUndefined();
+    });
+
+    describe('with a parent budget', () => {
+        const createScheduler = (parent: ConversationBudget) =>
+            new SubagentBudgetScheduler(
+                createMockWorkspaceSettings(),
+                Date.now(),
+                () => parent
+            );
+
+        it('should size pools from the parent iterations left', () => {
+            const scheduler = createScheduler({
+                iterations: 10,
+                tokens: undefined,
+                timeMs: 20 * 60 * 1000,
+            });
+
+            expect(scheduler.getIterationsRemaining()).toBe(
+                10 * SubagentLimits.BUDGET_ITERATION_POOL_FACTOR
+            );
+        });
+
+        it('should cap the token pool at the parent token budget', () => {
+            const scheduler = createScheduler({
+                iterations: 10,
+                tokens: 200_000,
+                timeMs: 20 * 60 * 1000,
+            });
+
+            expect(scheduler.getTokensRemaining()).toBe(200_000);
+        });
+
+        it('should shrink allocations as the parent runs low', () => {
+            const parent: ConversationBudget = {
+                iterations: maxIterations,
+                tokens: undefined,
+                timeMs: 60 * 60 * 1000,
+            };
+            const scheduler = createScheduler(parent);
+            const early = scheduler.allocate(simpleTask, 10)!;
+
+            parent.iterations = 2;
+            const late = scheduler.allocate(simpleTask, 10)!;
+
+            expect(late.iterations).toBeLessThan(early.iterations);
+            expect(late.iterations).toBeLessThanOrEqual(
+                2 * SubagentLimits.BUDGET_ITERATION_POOL_FACTOR
+            );
+        });
+
+        it('should fit timeouts into the time the parent has left', () => {
+            const parent: ConversationBudget = {
+                iterations: maxIterations,
+                tokens: undefined,
+                timeMs:
+                    SubagentLimits.BUDGET_PARENT_RESERVE_MS +
+                    2 * SubagentLimits.BUDGET_MIN_TIMEOUT_MS,
+            };
+            const scheduler = createScheduler(parent);
+
+            expect(scheduler.allocate(simpleTask, 10)?.timeoutMs).toBe(
+                2 * SubagentLimits.BUDGET_MIN_TIMEOUT_MS
+            );
+
+            parent.timeMs = SubagentLimits.BUDGET_PARENT_RESERVE_MS;
+            expect(scheduler.allocate(simpleTask, 10)).toBeUndefined();
+        });
+
+        it('should cap the parent estimate by the wall-clock window', () => {
+            const windowMs =
+                timeoutMs * SubagentLimits.BUDGET_TIME_WINDOW_FACTOR;
+            const scheduler = new SubagentBudgetScheduler(
+                createMockWorkspaceSettings(),
+                // Late in a long run: the window is used up
+                Date.now() - windowMs,
+                () => ({
+                    iterations: maxIterations,
+                    tokens: undefined,
+                    timeMs: 24 * 60 * 60 * 1000,
+                })
+            );
+
+            expect(scheduler.allocate(simpleTask, 10)).toBeUndefined();
+        });
+    });
+
+    describe('estimateTaskWeight', () => {
+        it('should weight by numbered questions and referenced files', () => {
+            expect(
+                SubagentBudgetScheduler.estimateTaskWeight(simpleTask)
+            ).toBeLessThan(
+                SubagentBudgetScheduler.estimateTaskWeight(detailedTask)
+            );
+        });
+
+        it('should clamp the weight to the configured bounds', () => {
+            const manyQuestions = Array.from(
+                { length: 20 },
+                (_, i) => `${i + 1}. Question about file${i}.ts?`
+            ).join('\n');
+
+            expect(
+                SubagentBudgetScheduler.estimateTaskWeight({
+                    task: manyQuestions,
+                })
+            ).toBe(SubagentLimits.BUDGET_MAX_TASK_WEIGHT);
+        });
+    });
+});
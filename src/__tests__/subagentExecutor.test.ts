@@ -7,6 +7,8 @@ import { SubagentPromptGenerator } from '../prompts/subagentPromptGenerator';
 import { SubagentLimits } from '../models/toolConstants';
 import { WorkspaceSettingsService } from '../services/workspaceSettingsService';
 import type { ITool } from '../tools/ITool';
+import type { SubagentResult } from '../types/modelTypes';
+import type { SubagentResultCache } from '../services/subagentResultCache';
 import {
     createMockWorkspaceSettings,
     createMockCancellationTokenSource,
@@ -49,6 +51,7 @@ const createMockTool = (name: string): ITool =>
 const createMockPromptGenerator = () =>
     ({
         generateSystemPrompt: vi.fn().mockReturnValue('You are a subagent.'),
+        generateTaskMessage: vi.fn().mockReturnValue('Investigate this.'),
     }) as unknown as SubagentPromptGenerator;
 
 describe('SubagentExecutor', () => {
@@ -338,7 +341,7 @@ describe('SubagentExecutor', () => {
             // Verify prompt generator received only allowed tools
             const promptCall = vi.mocked(promptGenerator.generateSystemPrompt)
                 .mock.calls[0]!;
-            const toolsPassedToPrompt = promptCall[1] as ITool[];
+            const toolsPassedToPrompt = promptCall[0] as ITool[];
             const filteredNames = toolsPassedToPrompt.map((t) => t.name);
 
             expect(filteredNames).toContain('read_file');
@@ -356,7 +359,7 @@ describe('SubagentExecutor', () => {
 
             const promptCall = vi.mocked(promptGenerator.generateSystemPrompt)
                 .mock.calls[0]!;
-            const toolsPassedToPrompt = promptCall[1] as ITool[];
+            const toolsPassedToPrompt = promptCall[0] as ITool[];
             expect(toolsPassedToPrompt.map((t) => t.name)).toContain(
                 'think_about_investigation'
             );
@@ -393,4 +396,71 @@ describe('SubagentExecutor', () => {
             );
         });
     });
+
+    describe('Result Caching', () => {
+        const createCache = (cached: SubagentResult | undefined) =>
+            ({
+                get: vi.fn().mockResolvedValue(cached),
+                set: vi.fn().mockResolvedValue(undefined),
+            }) as unknown as SubagentResultCache;
+
+        const createCachingExecutor = (
+            modelManager: CopilotModelManager,
+            cache: SubagentResultCache
+        ) => {
+            const registry = new ToolRegistry();
+            registry.registerTool(createMockTool('read_file'));
+            return new SubagentExecutor(
+                modelManager,
+                registry,
+                promptGenerator,
+                workspaceSettings,
+                undefined,
+                undefined,
+                undefined,
+                cache
+            );
+        };
+
+        it('should return cached result without calling the model', async () => {
+            const modelManager = createMockModelManager([]);
+            const cache = createCache({
+                success: true,
+                response: 'Cached findings',
+                toolCallsMade: 4,
+                toolCalls: [],
+                fromCache: true,
+            });
+            const executor = createCachingExecutor(modelManager, cache);
+
+            const result = await executor.execute(
+                defaultTask,
+                tokenSource.token,
+                1
+            );
+
+            expect(result.response).toBe('Cached findings');
+            expect(result.fromCache).toBe(true);
+            expect(modelManager.sendRequest).not.toHaveBeenCalled();
+        });
+
+        it('should store successful results on cache miss', async () => {
+            const modelManager = createMockModelManager([
+                { content: 'Fresh findings' },
+            ]);
+            const cache = createCache(undefined);
+            const executor = createCachingExecutor(modelManager, cache);
+
+            await executor.execute(defaultTask, tokenSource.token, 1);
+
+            expect(cache.set).toHaveBeenCalledWith(
+                defaultTask,
+                expect.objectContaining({
+                    success: true,
+                    response: 'Fresh findings',
+                }),
+                expect.any(Number)
+            );
+        });
+    });
 });
@@ -20,48 +20,13 @@ describe('SubagentPromptGenerator', () => {
     });
 
     describe('generateSystemPrompt', () => {
-        it('should include the task in the prompt', () => {
-            const task: SubagentTask = {
-                task: 'Investigate the authentication flow in src/auth/',
-            };
-
-            const prompt = generator.generateSystemPrompt(task, [], 10);
-
-            expect(prompt).toContain(
-                'Investigate the authentication flow in src/auth/'
-            );
-        });
-
-        it('should include context when provided', () => {
-            const task: SubagentTask = {
-                task: 'Check for security issues',
-                context: 'PR adds new JWT validation in auth.ts',
-            };
-
-            const prompt = generator.generateSystemPrompt(task, [], 10);
-
-            expect(prompt).toContain('PR adds new JWT validation in auth.ts');
-            expect(prompt).toContain('Context from Parent Agent');
-        });
-
-        it('should not include context section when not provided', () => {
-            const task: SubagentTask = {
-                task: 'Check for security issues',
-            };
-
-            const prompt = generator.generateSystemPrompt(task, [], 10);
-
-            expect(prompt).not.toContain('Context from Parent Agent');
-        });
-
         it('should list available tools', () => {
             const tools = [
                 createMockTool('find_symbol', 'Finds symbols in code'),
                 createMockTool('read_file', 'Reads file contents'),
             ];
 
-            const task: SubagentTask = { task: 'Test task' };
-            const prompt = generator.generateSystemPrompt(task, tools, 10);
+            const prompt = generator.generateSystemPrompt(tools);
 
             expect(prompt).toContain('find_symbol');
             expect(prompt).toContain('Finds symbols in code');
@@ -70,32 +35,34 @@ describe('SubagentPromptGenerator', () => {
         });
 
         it('should indicate when no tools are available', () => {
-            const task: SubagentTask = { task: 'Test task' };
-            const prompt = generator.generateSystemPrompt(task, [], 10);
+            const prompt = generator.generateSystemPrompt([]);
 
             expect(prompt).toContain('No tools available');
         });
 
         it('should include response requirements section', () => {
-            const task: SubagentTask = { task: 'Test task' };
-            const prompt = generator.generateSystemPrompt(task, [], 10);
+            const prompt = generator.generateSystemPrompt([]);
 
             expect(prompt).toContain('## Response Requirements');
-            expect(prompt).toContain('### Findings');
-            expect(prompt).toContain('### Recommendations');
             expect(prompt).toContain('### Summary');
+            expect(prompt).toContain('### Findings');
+            expect(prompt).toContain('### Evidence');
+            expect(prompt).toContain('### Confidence');
         });
 
-        it('should include the maxIterations value in constraints', () => {
-            const task: SubagentTask = { task: 'Test task' };
-            const prompt = generator.generateSystemPrompt(task, [], 15);
+        it('should not depend on the task so subagents share a prefix', () => {
+            const tools = [createMockTool('read_file', 'Reads file contents')];
 
-            expect(prompt).toContain('15 tool iterations');
+            expect(generator.generateSystemPrompt(tools)).toBe(
+                generator.generateSystemPrompt(tools)
+            );
+            expect(generator.generateSystemPrompt(tools)).not.toContain(
+                'tool iterations**'
+            );
         });
 
         it('should include investigation approach guidance', () => {
-            const task: SubagentTask = { task: 'Test task' };
-            const prompt = generator.generateSystemPrompt(task, [], 10);
+            const prompt = generator.generateSystemPrompt([]);
 
             expect(prompt).toContain('## Investigation Approach');
             expect(prompt).toContain('Orient First');
@@ -104,12 +71,54 @@ describe('SubagentPromptGenerator', () => {
         });
 
         it('should include constraints section', () => {
-            const task: SubagentTask = { task: 'Test task' };
-            const prompt = generator.generateSystemPrompt(task, [], 10);
+            const prompt = generator.generateSystemPrompt([]);
 
             expect(prompt).toContain('## Constraints');
             expect(prompt).toContain('CANNOT see the PR diff');
             expect(prompt).toContain('CANNOT execute code');
         });
     });
+
+    describe('generateTaskMessage', () => {
+        it('should include the task', () => {
+            const task: SubagentTask = {
+                task: 'Investigate the authentication flow in src/auth/',
+            };
+
+            const message = generator.generateTaskMessage(task, 10);
+
+            expect(message).toContain(
+                'Investigate the authentication flow in src/auth/'
+            );
+        });
+
+        it('should include context when provided', () => {
+            const task: SubagentTask = {
+                task: 'Check for security issues',
+                context: 'PR adds new JWT validation in auth.ts',
+            };
+
+            const message = generator.generateTaskMessage(task, 10);
+
+            expect(message).toContain('PR adds new JWT validation in auth.ts');
+            expect(message).toContain('Context from Parent Agent');
+        });
+
+        it('should not include context section when not provided', () => {
+            const task: SubagentTask = {
+                task: 'Check for security issues',
+            };
+
+            const message = generator.generateTaskMessage(task, 10);
+
+            expect(message).not.toContain('Context from Parent Agent');
+        });
+
+        it('should include the maxIterations value', () => {
+            const task: SubagentTask = { task: 'Test task' };
+            const message = generator.generateTaskMessage(task, 15);
+
+            expect(message).toContain('15 tool iterations');
+        });
+    });
 });
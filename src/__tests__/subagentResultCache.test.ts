@@ -0,0 +1,272 @@
+import { describe, it, expect, vi, beforeEach } from 'vitest';
+import * as vscode from 'vscode';
+import { SubagentResultCache } from '../services/subagentResultCache';
+import { GitOperationsManager } from '../services/gitOperationsManager';
+import { SubagentLimits } from '../models/toolConstants';
+import type { SubagentResult } from '../types/modelTypes';
+import type { ToolCallRecord } from '../types/toolCallTypes';
+import {
+    createMockGitOperationsManager,
+    createMockGitRepository,
+} from './testUtils/mockFactories';
+
+const createRecord = (
+    toolName: string,
+    args: Record<string, unknown>
+): ToolCallRecord => ({
+    id: `call_${toolName}`,
+    toolName,
+    arguments: args,
+    result: 'ok',
+    success: true,
+    error: undefined,
+    durationMs: 1,
+    timestamp: 0,
+});
+
+const createResult = (
+    toolCalls: ToolCallRecord[],
+    overrides: Partial<SubagentResult> = {}
+): SubagentResult => ({
+    success: true,
+    response: 'All callers handle null.',
+    toolCallsMade: toolCalls.length,
+    toolCalls,
+    ...overrides,
+});
+
+describe('SubagentResultCache', () => {
+    let cache: SubagentResultCache;
+    let gitOperations: ReturnType<typeof createMockGitOperationsManager>;
+    let mtimes: Map<string, number>;
+    // Run start time, after the initial mtimes
+    const startedAt = 10;
+
+    beforeEach(() => {
+        mtimes = new Map([
+            ['/test/git-repo/src/auth.ts', 1],
+            ['/test/git-repo/src', 1],
+        ]);
+        vi.mocked(vscode.workspace.fs.stat).mockImplementation(
+            async (uri: vscode.Uri) => {
+                const mtime = mtimes.get(uri.fsPath);
+                if (mtime === undefined) {
+                    throw vscode.FileSystemError.FileNotFound(uri);
+                }
+                return {
+                    type: uri.fsPath.endsWith('.ts')
+                        ? vscode.FileType.File
+                        : vscode.FileType.Directory,
+                    ctime: 0,
+                    mtime,
+                    size: 100,
+                };
+            }
+        );
+        gitOperations = createMockGitOperationsManager();
+        cache = new SubagentResultCache(
+            gitOperations as unknown as GitOperationsManager
+        );
+    });
+
+    const task = {
+        task: 'Check all callers of validateToken handle null returns',
+        context: 'See src/auth.ts',
+    };
+
+    it('should return undefined on miss', async () => {
+        expect(await cache.get(task)).toBeUndefined();
+    });
+
+    it('should reuse results for tasks differing only in case and whitespace', async () => {
+        const result = createResult([
+            createRecord('read_file', { file_path: 'src/auth.ts' }),
+        ]);
+        await cache.set(task, result, startedAt);
+
+        const cached = await cache.get({
+            task: '  check all callers of   validateToken\nhandle null returns ',
+            context: 'see src/auth.ts',
+        });
+
+        expect(cached?.response).toBe(result.response);
+        expect(cached?.fromCache).toBe(true);
+    });
+
+    it('should not match a different context', async () => {
+        await cache.set(task, createResult([]), startedAt);
+
+        expect(
+            await cache.get({ ...task, context: 'See src/session.ts' })
+        ).toBeUndefined();
+    });
+
+    it('should not match the same task in another repository', async () => {
+        await cache.set(task, createResult([]), startedAt);
+
+        gitOperations._mockGetRepository.mockReturnValue(
+            createMockGitRepository('/test/other-repo')
+        );
+
+        expect(await cache.get(task)).toBeUndefined();
+    });
+
+    it('should not cache runs during which a read file changed', async () => {
+        mtimes.set('/test/git-repo/src/auth.ts', startedAt + 1);
+
+        await cache.set(
+            task,
+            createResult([
+                createRecord('read_file', { file_path: 'src/auth.ts' }),
+            ]),
+            startedAt
+        );
+
+        expect(cache.size).toBe(0);
+    });
+
+    it('should invalidate entries when a read file changes', async () => {
+        await cache.set(
+            task,
+            createResult([
+                createRecord('read_file', { file_path: 'src/auth.ts' }),
+                createRecord('list_directory', { relative_path: 'src' }),
+            ]),
+            startedAt
+        );
+
+        mtimes.set('/test/git-repo/src/auth.ts', 2);
+
+        expect(await cache.get(task)).toBeUndefined();
+        expect(cache.size).toBe(0);
+    });
+
+    it('should invalidate entries when a previously missing file appears', async () => {
+        await cache.set(
+            task,
+            createResult([
+                createRecord('read_file', { file_path: 'src/new.ts' }),
+            ]),
+            startedAt
+        );
+
+        mtimes.set('/test/git-repo/src/new.ts', 5);
+
+        expect(await cache.get(task)).toBeUndefined();
+    });
+
+    it('should not cache runs that searched the whole workspace', async () => {
+        await cache.set(
+            task,
+            createResult([
+                createRecord('read_file', { file_path: 'src/auth.ts' }),
+                createRecord('find_usages', { symbol_name: 'validateToken' }),
+            ]),
+            startedAt
+        );
+        await cache.set(
+            { task: 'Where is validateToken defined?' },
+            createResult([
+                createRecord('find_symbol', { name_path: 'validateToken' }),
+            ]),
+            startedAt
+        );
+
+        expect(cache.size).toBe(0);
+    });
+
+    it('should not cache runs that searched inside a directory', async () => {
+        await cache.set(
+            task,
+            createResult([
+                createRecord('find_symbol', {
+                    name_path: 'validateToken',
+                    relative_path: 'src',
+                }),
+            ]),
+            startedAt
+        );
+        await cache.set(
+            { task: 'List all sources' },
+            createResult([
+                createRecord('list_directory', {
+                    relative_path: 'src',
+                    recursive: true,
+                }),
+            ]),
+            startedAt
+        );
+
+        expect(cache.size).toBe(0);
+    });
+
+    it('should cache file-scoped searches and plain listings', async () => {
+        await cache.set(
+            task,
+            createResult([
+                createRecord('find_symbol', {
+                    name_path: 'validateToken',
+                    relative_path: 'src/auth.ts',
+                }),
+                createRecord('list_directory', {
+                    relative_path: 'src',
+                    recursive: false,
+                }),
+            ]),
+            startedAt
+        );
+
+        expect((await cache.get(task))?.fromCache).toBe(true);
+    });
+
+    it('should not cache failed results', async () => {
+        await cache.set(
+            task,
+            createResult([], { success: false, error: 'max_iterations' }),
+            startedAt
+        );
+
+        expect(cache.size).toBe(0);
+    });
+
+    it('should evict least recently used entries beyond the limit', async () => {
+        for (let i = 0; i <= SubagentLimits.RESULT_CACHE_MAX_ENTRIES; i++) {
+            await cache.set(
+                { task: `${task.task} variant ${i}` },
+                createResult([]),
+                startedAt
+            );
+        }
+
+        expect(cache.size).toBe(SubagentLimits.RESULT_CACHE_MAX_ENTRIES);
+        expect(
+            await cache.get({ task: `${task.task} variant 0` })
+        ).toBeUndefined();
+    });
+
+    describe('collectReadPaths', () => {
+        it('should collect distinct sanitized paths from path arguments', () => {
+            const paths = SubagentResultCache.collectReadPaths([
+                createRecord('read_file', { file_path: 'src/auth.ts' }),
+                createRecord('find_symbol', {
+                    name_path: 'validateToken',
+                    relative_path: './src/auth.ts',
+                }),
+                createRecord('search_for_pattern', {
+                    pattern: 'null',
+                    search_path: 'src',
+                }),
+            ]);
+
+            expect(paths.sort()).toEqual(['src', 'src/auth.ts']);
+        });
+
+        it('should skip traversal attempts', () => {
+            const paths = SubagentResultCache.collectReadPaths([
+                createRecord('read_file', { file_path: '../secret.txt' }),
+            ]);
+
+            expect(paths).toEqual([]);
+        });
+    });
+});
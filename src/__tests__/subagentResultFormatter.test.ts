@@ -0,0 +1,167 @@
+import { describe, it, expect } from 'vitest';
+import {
+    parseSubagentResponse,
+    compactSubagentResponse,
+    aggregateSubagentResponses,
+} from '../utils/subagentResultFormatter';
+
+const structuredResponse = `I looked at the token validation path first.
+
+### Summary
+validateToken returns null for expired tokens and two of three callers handle it.
+
+### Findings
+- 🟠 High — refreshSession dereferences the result without a null check
+  (src/session.ts:88)
+- 🟢 Low — logout ignores the result entirely, which is harmless
+
+\`\`\`ts
+const user = validateToken(token).user;
+\`\`\`
+
+### Evidence
+- \`src/auth.ts:42\` — returns null when exp < now
+- \`src/session.ts:88\` — reads .user directly
+
+### Confidence
+High — all call sites found via find_usages were read.
+`;
+
+describe('subagentResultFormatter', () => {
+    describe('parseSubagentResponse', () => {
+        it('should parse summary, findings, evidence and confidence', () => {
+            const parsed = parseSubagentResponse(structuredResponse);
+
+            expect(parsed?.summary).toBe(
+                'validateToken returns null for expired tokens and two of three callers handle it.'
+            );
+            expect(parsed?.findings).toEqual([
+                '🟠 High — refreshSession dereferences the result without a null check (src/session.ts:88)',
+                '🟢 Low — logout ignores the result entirely, which is harmless',
+            ]);
+            expect(parsed?.evidence).toHaveLength(2);
+            expect(parsed?.confidence).toBe('high');
+            expect(parsed?.confidenceNote).toBe(
+                'all call sites found via find_usages were read.'
+            );
+        });
+
+        it('should derive evidence from findings when the section is missing', () => {
+            const parsed = parseSubagentResponse(
+                '### Findings\n- Missing check at src/a.ts:10 and src/b.ts:20-25'
+            );
+
+            expect(parsed?.evidence).toEqual(['src/a.ts:10', 'src/b.ts:20-25']);
+            expect(parsed?.confidence).toBeUndefined();
+        });
+
+        it('should return undefined for unstructured responses', () => {
+            expect(
+                parseSubagentResponse('Everything looks fine to me.')
+            ).toBeUndefined();
+        });
+    });
+
+    describe('compactSubagentResponse', () => {
+        it('should drop narration and code blocks from structured responses', () => {
+            const compact = compactSubagentResponse(structuredResponse, 4000);
+
+            expect(compact).toContain('**Confidence:** High');
+            expect(compact).toContain('### Findings');
+            expect(compact).toContain('src/auth.ts:42');
+            expect(compact).not.toContain('I looked at');
+            expect(compact).not.toContain('validateToken(token).user');
+        });
+
+        it('should stay within the size cap and report omitted items', () => {
+            const findings = Array.from(
+                { length: 50 },
+                (_, i) => `- Finding ${i} in src/file${i}.ts:${i + 1}`
+            ).join('\n');
+            const compact = compactSubagentResponse(
+                `### Findings\n${findings}`,
+                500
+            );
+
+            expect(compact.length).toBeLessThanOrEqual(500);
+            expect(compact).toContain('Finding 0');
+            expect(compact).toMatch(/Omitted \d+ finding\(s\)/);
+        });
+
+        it('should truncate unstructured responses at a line boundary', () => {
+            const response = Array.from(
+                { length: 100 },
+                (_, i) => `Line ${i} of free-form notes`
+            ).join('\n');
+
+            const compact = compactSubagentResponse(response, 300);
+
+            expect(compact.length).toBeLessThanOrEqual(300);
+            expect(compact).toContain('Line 0 of free-form notes');
+            expect(compact).toContain('truncated');
+        });
+
+        it('should leave short unstructured responses unchanged', () => {
+            expect(compactSubagentResponse('No issues found.', 300)).toBe(
+                'No issues found.'
+            );
+        });
+    });
+
+    describe('aggregateSubagentResponses', () => {
+        const otherResponse = `### Summary
+Session refresh has one unchecked call site.
+
+### Findings
+- 🟠 High — refreshSession dereferences the result without a null-check (src/session.ts:88)
+
+### Evidence
+- src/session.ts:88 — .user read directly
+- src/cache.ts:12 — stores the session`;
+
+        it('should merge duplicate findings and attribute every reporter', () => {
+            const report = aggregateSubagentResponses(
+                [
+                    { label: 'Task 1', response: structuredResponse },
+                    { label: 'Task 2', response: otherResponse },
+                ],
+                4000
+            );
+
+            expect(report).toContain('**Task 1** (High confidence):');
+            expect(report).toContain(
+                '[Task 1, Task 2] 🟠 High — refreshSession dereferences'
+            );
+            expect(report.match(/src\/session\.ts:88`? —/g)).toHaveLength(1);
+            expect(report).toContain('src/cache.ts:12');
+        });
+
+        it('should summarize unstructured responses', () => {
+            const report = aggregateSubagentResponses(
+                [
+                    { label: 'Task 1', response: 'Nothing relevant found.' },
+                    { label: 'Task 2', response: otherResponse },
+                ],
+                4000
+            );
+
+            expect(report).toContain('**Task 1**: Nothing relevant found.');
+            expect(report).toContain('[Task 2] 🟠 High');
+        });
+
+        it('should stay within the size cap', () => {
+            const entries = Array.from({ length: 4 }, (_, t) => ({
+                label: `Task ${t + 1}`,
+                response: `### Findings\n${Array.from(
+                    { length: 40 },
+                    (_, i) => `- Finding ${t}-${i} in src/f${t}.ts:${i + 1}`
+                ).join('\n')}`,
+            }));
+
+            const report = aggregateSubagentResponses(entries, 800);
+
+            expect(report.length).toBeLessThanOrEqual(800);
+            expect(report).toMatch(/Omitted \d+ finding\(s\)/);
+        });
+    });
+});
@@ -1,7 +1,9 @@
 import { describe, it, expect, beforeEach, vi } from 'vitest';
+import * as vscode from 'vscode';
 import { SubagentSessionManager } from '../services/subagentSessionManager';
 import { WorkspaceSettingsService } from '../services/workspaceSettingsService';
 import { SUBAGENT_LIMITS } from '../models/workspaceSettingsSchema';
+import { createMockWorkspaceSettings } from './testUtils/mockFactories';
 
 const createMockSettings = (
     maxPerSession: number = SUBAGENT_LIMITS.maxPerSession.default
@@ -117,4 +119,89 @@ describe('SubagentSessionManager', () => {
             expect(sessionManager.getRemainingBudget()).toBe(defaultMax);
         });
     });
+
+    describe('Budget Allocation', () => {
+        const task = { task: 'Investigate the authentication flow thoroughly' };
+
+        it('should refill the budget pool on reset', () => {
+            const manager = new SubagentSessionManager(
+                createMockWorkspaceSettings({ maxSubagentsPerSession: 1 })
+            );
+
+            expect(manager.allocateBudget(task)).toBeDefined();
+            while (manager.allocateBudget(task)) {
+                // Drain the pool
+            }
+
+            manager.reset();
+            expect(manager.allocateBudget(task)).toBeDefined();
+        });
+    });
+
+    describe('Early Cancellation', () => {
+        it('should cancel a tracked subagent and record the reason', () => {
+            const source = new vscode.CancellationTokenSource();
+            sessionManager.trackSubagent(1, source);
+
+            expect(sessionManager.cancelSubagent(1, 'superseded')).toBe(true);
+            expect(source.token.isCancellationRequested).toBe(true);
+            expect(sessionManager.getCancellationReason(1)).toBe('superseded');
+        });
+
+        it('should cancel all outstanding subagents', () => {
+            const first = new vscode.CancellationTokenSource();
+            const second = new vscode.CancellationTokenSource();
+            sessionManager.trackSubagent(1, first);
+            sessionManager.trackSubagent(2, second);
+
+            expect(sessionManager.cancelOutstanding('review submitted')).toBe(
+                2
+            );
+            expect(first.token.isCancellationRequested).toBe(true);
+            expect(second.token.isCancellationRequested).toBe(true);
+        });
+
+        it('should not cancel subagents that already finished', () => {
+            const source = new vscode.CancellationTokenSource();
+            const tracking = sessionManager.trackSubagent(1, source);
+            tracking.dispose();
+
+            expect(sessionManager.cancelOutstanding('review submitted')).toBe(
+                0
+            );
+            expect(source.token.isCancellationRequested).toBe(false);
+            expect(sessionManager.getCancellationReason(1)).toBeUndefined();
+        });
+    });
+
+    describe('Token Usage', () => {
+        it('should list finished subagents by ID and clear on reset', () => {
+            sessionManager.recordUsage(2, 'Trace callers', {
+                iterations: 3,
+                tokens: 9000,
+            });
+            sessionManager.recordUsage(1, 'Check tests', {
+                iterations: 1,
+                tokens: 1200,
+            });
+
+            expect(sessionManager.getTokenUsage()).toEqual([
+                {
+                    subagentId: 1,
+                    task: 'Check tests',
+                    iterations: 1,
+                    tokens: 1200,
+                },
+                {
+                    subagentId: 2,
+                    task: 'Trace callers',
+                    iterations: 3,
+                    tokens: 9000,
+                },
+            ]);
+
+            sessionManager.reset();
+            expect(sessionManager.getTokenUsage()).toEqual([]);
+        });
+    });
 });
@@ -1,6 +1,7 @@
 import { describe, it, expect, beforeEach, vi } from 'vitest';
 import { SubmitReviewTool } from '../tools/submitReviewTool';
 import { createMockExecutionContext } from './testUtils/mockFactories';
+import type { SubagentSessionManager } from '../services/subagentSessionManager';
 
 // Mock the logging service
 vi.mock('../services/loggingService', () => ({
@@ -74,6 +75,24 @@ describe('SubmitReviewTool', () => {
             expect(result.metadata).toEqual({ isCompletion: true });
         });
 
+        it('should cancel subagents still running in the same turn', async () => {
+            const subagentSessionManager = {
+                cancelOutstanding: vi.fn().mockReturnValue(1),
+            } as unknown as SubagentSessionManager;
+
+            await tool.execute(
+                {
+                    review_content:
+                        'Final review content long enough to pass validation.',
+                },
+                createMockExecutionContext({ subagentSessionManager })
+            );
+
+            expect(
+                subagentSessionManager.cancelOutstanding
+            ).toHaveBeenCalledWith('review submitted');
+        });
+
         it('should preserve markdown formatting', async () => {
             const reviewContent = `## Summary
 > **TL;DR**: Adds new feature.
@@ -0,0 +1,291 @@
+import {
+    describe,
+    it,
+    expect,
+    vi,
+    beforeEach,
+    beforeAll,
+    afterAll,
+} from 'vitest';
+import * as vscode from 'vscode';
+import { promises as fs } from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import ignore from 'ignore';
+import { FileDiscoverer } from '../utils/fileDiscoverer';
+import { SymbolExtractor } from '../utils/symbolExtractor';
+import { CodeFileUtils } from '../utils/codeFileUtils';
+import { DiffUtils } from '../utils/diffUtils';
+import { filterBinaryDiffs } from '../services/gitService';
+import { ListDirTool } from '../tools/listDirTool';
+import type { GitOperationsManager } from '../services/gitOperationsManager';
+import type { Repository } from '../types/vscodeGitExtension';
+import {
+    generateSyntheticWorkspace,
+    generateSyntheticDiff,
+    writeSyntheticWorkspace,
+    createWorkspaceFsStub,
+    type SyntheticWorkspace,
+} from './testUtils/syntheticRepo';
+import {
+    createMockExecutionContext,
+    createMockGitRepositoryWithConfig,
+    createMockCancellationTokenSource,
+} from './testUtils/mockFactories';
+
+const REPO_ROOT = '/synthetic/repo';
+
+/**
+ * Scale tests: run discovery and diff handling against generated repositories
+ * large enough to surface quadratic behaviour, but small enough for CI.
+ */
+describe('Synthetic repository scale tests', () => {
+    const workspace = generateSyntheticWorkspace({
+        files: 1500,
+        depth: 3,
+        generatedRatio: 0.2,
+    });
+
+    /** Files the root .gitignore keeps, i.e. what every lister should return */
+    const visibleFiles = (ws: SyntheticWorkspace) =>
+        [...ws.files.keys()].filter((file) => !ws.ignoredByRoot.has(file));
+
+    describe('generator', () => {
+        it('should be deterministic for the same seed', () => {
+            const again = generateSyntheticWorkspace({
+                files: 1500,
+                depth: 3,
+                generatedRatio: 0.2,
+            });
+
+            expect([...again.files]).toEqual([...workspace.files]);
+        });
+
+        it('should differ across seeds', () => {
+            const other = generateSyntheticWorkspace({
+                files: 1500,
+                depth: 3,
+                generatedRatio: 0.2,
+                seed: 2,
+            });
+
+            expect([...other.files.keys()]).not.toEqual([
+                ...workspace.files.keys(),
+            ]);
+        });
+
+        it('should mix C++ and TypeScript with ignored and generated output', () => {
+            const files = [...workspace.files.keys()];
+
+            expect(files.some((file) => file.endsWith('.cpp'))).toBe(true);
+            expect(files.some((file) => file.endsWith('.ts'))).toBe(true);
+            expect(files.some((file) => file.endsWith('/.gitignore'))).toBe(
+                true
+            );
+            expect(workspace.ignoredByRoot.size).toBeGreaterThan(0);
+            expect(workspace.ignoredByNested.size).toBeGreaterThan(0);
+        });
+    });
+
+    describe('FileDiscoverer on disk', () => {
+        let rootDir: string;
+        let repository: Repository;
+
+        beforeAll(async () => {
+            rootDir = await fs.mkdtemp(path.join(os.tmpdir(), 'lupa-synth-'));
+            await writeSyntheticWorkspace(workspace, rootDir);
+        });
+
+        afterAll(async () => {
+            await fs.rm(rootDir, { recursive: true, force: true });
+        });
+
+        beforeEach(() => {
+            repository = createMockGitRepositoryWithConfig(
+                rootDir
+            ) as unknown as Repository;
+            const stub = createWorkspaceFsStub(workspace, rootDir);
+            vi.mocked(vscode.workspace.fs.readFile).mockImplementation(
+                stub.readFile
+            );
+        });
+
+        it('should find every source file outside root-ignored paths', async () => {
+            const result = await FileDiscoverer.discoverFiles(repository, {
+                includePattern: '**/*',
+                maxResults: 100_000,
+                cancellationToken: createMockCancellationTokenSource().token,
+            });
+
+            // Globs skip dotfiles such as the nested .gitignore files
+            const expected = visibleFiles(workspace).filter(
+                (file) => !path.posix.basename(file).startsWith('.')
+            );
+            expect(result.truncated).toBe(false);
+            expect(result.files).toEqual(expected.sort());
+        });
+
+        it('should truncate at maxResults on a large tree', async () => {
+            const result = await FileDiscoverer.discoverFiles(repository, {
+                includePattern: '*.cpp',
+                maxResults: 50,
+                cancellationToken: createMockCancellationTokenSource().token,
+            });
+
+            expect(result.truncated).toBe(true);
+            expect(result.files).toHaveLength(50);
+            expect(result.totalFound).toBeGreaterThan(50);
+        });
+    });
+
+    describe('workspace.fs based listing', () => {
+        let gitOperationsManager: GitOperationsManager;
+
+        beforeEach(() => {
+            const stub = createWorkspaceFsStub(workspace, REPO_ROOT);
+            vi.mocked(vscode.workspace.fs.readDirectory).mockImplementation(
+                stub.readDirectory
+            );
+            vi.mocked(vscode.workspace.fs.readFile).mockImplementation(
+                stub.readFile
+            );
+            gitOperationsManager = {
+                getRepository: vi
+                    .fn()
+                    .mockReturnValue(
+                        createMockGitRepositoryWithConfig(REPO_ROOT)
+                    ),
+            } as unknown as GitOperationsManager;
+        });
+
+        it('ListDirTool should list the whole tree recursively', async () => {
+            const tool = new ListDirTool(gitOperationsManager);
+
+            const result = await tool.execute(
+                { relative_path: '.', recursive: true },
+                createMockExecutionContext()
+            );
+
+            expect(result.success).toBe(true);
+            const listed = result.data!.split('\n');
+            const files = listed.filter((line) => !line.endsWith('/'));
+            expect(files.sort()).toEqual(visibleFiles(workspace).sort());
+            expect(listed).not.toContain('build/');
+            expect(listed).not.toContain('node_modules/');
+        });
+
+        it('SymbolExtractor.getAllFiles should return visible code files', async () => {
+            const extractor = new SymbolExtractor(gitOperationsManager);
+            const patterns = workspace.files.get('.gitignore')!;
+
+            const result = await extractor.getAllFiles(
+                REPO_ROOT,
+                '.',
+                ignore().add(patterns),
+                { token: createMockCancellationTokenSource().token }
+            );
+
+            const expected = visibleFiles(workspace).filter((file) =>
+                CodeFileUtils.isCodeFile(path.posix.basename(file))
+            );
+            expect(result.truncated).toBe(false);
+            expect(result.files.sort()).toEqual(expected.sort());
+        });
+    });
+
+    describe('diff pipeline', () => {
+        // ~3 MB: the size of a large refactoring branch
+        const diff = generateSyntheticDiff({
+            files: 400,
+            hunksPerFile: 8,
+            linesPerHunk: 20,
+            binaryRatio: 0.1,
+            renameRatio: 0.1,
+            whitespaceRatio: 0.2,
+        });
+
+        it('should generate a multi-megabyte diff', () => {
+            expect(diff.length).toBeGreaterThan(1_000_000);
+        });
+
+        it('should drop binaries and keep renamed files under their new path', () => {
+            const { filteredDiff, binaryFiles } = filterBinaryDiffs(diff);
+            const parsed = DiffUtils.parseDiff(filteredDiff);
+
+            expect(binaryFiles.length).toBeGreaterThan(0);
+            expect(filteredDiff).not.toContain('Binary files');
+            expect(parsed).toHaveLength(400 - binaryFiles.length);
+            expect(diff).toContain('rename from src/legacy');
+            expect(
+                parsed.every((file) => file.filePath.startsWith('src/module'))
+            ).toBe(true);
+        });
+
+        it('should parse whitespace-only hunks as changes', () => {
+            const parsed = DiffUtils.parseDiff(
+                generateSyntheticDiff({
+                    files: 5,
+                    hunksPerFile: 4,
+                    linesPerHunk: 10,
+                    whitespaceRatio: 1,
+                    newFileRatio: 0,
+                })
+            );
+
+            for (const file of parsed) {
+                expect(file.hunks).toHaveLength(4);
+                for (const hunk of file.hunks) {
+                    const added = hunk.parsedLines.filter(
+                        (line) => line.type === 'added'
+                    );
+                    const removed = hunk.parsedLines.filter(
+                        (line) => line.type === 'removed'
+                    );
+                    expect(added.map((line) => line.content.trim())).toEqual(
+                        removed.map((line) => line.content.trim())
+                    );
+                }
+            }
+        });
+
+        it('should emit hunk headers that match their lines', () => {
+            const sample = generateSyntheticDiff({
+                files: 50,
+                hunksPerFile: 4,
+                linesPerHunk: 10,
+                renameRatio: 0.1,
+                whitespaceRatio: 0.3,
+                newFileRatio: 0.3,
+            });
+            let hunks = 0;
+            let newFileHunks = 0;
+
+            for (const fileDiff of sample.split(/^(?=diff --git )/m)) {
+                const isNew = fileDiff.includes('\n--- /dev/null\n');
+                for (const hunk of fileDiff.split(/^(?=@@ )/m).slice(1)) {
+                    const [header, ...body] = hunk.trimEnd().split('\n');
+                    const [, oldCount, newCount] = header!.match(
+                        /^@@ -\d+,(\d+) \+\d+,(\d+) @@/
+                    )!;
+                    expect(
+                        body.filter((line) => !line.startsWith('+')).length
+                    ).toBe(Number(oldCount));
+                    expect(
+                        body.filter((line) => !line.startsWith('-')).length
+                    ).toBe(Number(newCount));
+                    if (isNew) {
+                        expect(header).toMatch(/^@@ -0,0 \+1,/);
+                        expect(body.every((line) => line.startsWith('+'))).toBe(
+                            true
+                        );
+                        newFileHunks++;
+                    }
+                    hunks++;
+                }
+            }
+
+            expect(hunks).toBeGreaterThan(100);
+            expect(newFileHunks).toBeGreaterThan(0);
+        });
+    });
+});
@@ -550,6 +550,7 @@ export function createMockWorkspaceSettings(
     overrides: Partial<{
         maxIterations: number;
         requestTimeoutSeconds: number;
+        heapBudgetMB: number;
         maxSubagentsPerSession: number;
     }> = {}
 ): WorkspaceSettingsService {
@@ -559,6 +560,8 @@ export function createMockWorkspaceSettings(
         getRequestTimeoutSeconds: () =>
             overrides.requestTimeoutSeconds ??
             ANALYSIS_LIMITS.requestTimeoutSeconds.default,
+        getHeapBudgetMB: () =>
+            overrides.heapBudgetMB ?? ANALYSIS_LIMITS.heapBudgetMB.default,
         getMaxSubagentsPerSession: () =>
             overrides.maxSubagentsPerSession ??
             SUBAGENT_LIMITS.maxPerSession.default,
@@ -0,0 +1,468 @@
+/**
+ * Deterministic synthetic repositories for scale tests and benchmarks.
+ *
+ * Generates workspaces (nested directories, .gitignore files, mixed C++/TS
+ * sources, generated output) and git diffs (renames, binaries, whitespace-only
+ * hunks) of configurable size. Everything is derived from a seed, so the same
+ * options always produce byte-identical output on every machine.
+ */
+import { promises as fs } from 'fs';
+import * as path from 'path';
+import * as vscode from 'vscode';
+
+const WORDS = [
+    'const',
+    'return',
+    'value',
+    'result',
+    'config',
+    'handler',
+    'await',
+    'options',
+    'token',
+    'message',
+    'context',
+    'index',
+];
+
+/**
+ * Small seeded PRNG (mulberry32). Math.random() would make fixture sizes,
+ * and therefore timings, differ between runs.
+ */
+export function createRandom(seed: number): () => number {
+    let state = seed >>> 0;
+    return () => {
+        state = (state + 0x6d2b79f5) >>> 0;
+        let t = state;
+        t = Math.imul(t ^ (t >>> 15), t | 1);
+        t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+        return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+    };
+}
+
+export function pick<T>(random: () => number, items: readonly T[]): T {
+    return items[Math.floor(random() * items.length)]!;
+}
+
+export function codeLine(random: () => number): string {
+    const length = 3 + Math.floor(random() * 8);
+    const words = Array.from({ length }, () => pick(random, WORDS));
+    return `    ${words.join(' ')};`;
+}
+
+// ---------------------------------------------------------------------------
+// Workspaces
+// ---------------------------------------------------------------------------
+
+export interface SyntheticWorkspaceOptions {
+    /** Number of source files (excluding generated and ignored output) */
+    files: number;
+    /** Directory nesting depth below each top-level source root */
+    depth: number;
+    /** Subdirectories per directory; the tree has dirsPerLevel^depth leaves */
+    dirsPerLevel?: number;
+    /** Fraction of source files that are C++ (the rest are TypeScript) */
+    cppRatio?: number;
+    /** Generated files per source file: build output, *.generated.ts, node_modules */
+    generatedRatio?: number;
+    /** Lines per source file */
+    linesPerFile?: number;
+    seed?: number;
+}
+
+export interface SyntheticWorkspace {
+    /** File contents by POSIX path relative to the workspace root */
+    files: Map<string, string>;
+    /** Direct children of each directory ('.' is the root) */
+    directories: Map<string, Map<string, vscode.FileType>>;
+    /** Files excluded by the root .gitignore */
+    ignoredByRoot: Set<string>;
+    /** Files excluded only by a nested .gitignore */
+    ignoredByNested: Set<string>;
+}
+
+const SOURCE_ROOTS = ['src', 'lib'];
+const DIR_NAMES = ['core', 'net', 'io', 'ui', 'util', 'model', 'service'];
+
+/**
+ * Generate an in-memory workspace. Use writeSyntheticWorkspace() to put it on
+ * disk for fdir/ripgrep, or createWorkspaceFsStub() to serve it through the
+ * mocked vscode.workspace.fs.
+ */
+export function generateSyntheticWorkspace(
+    options: SyntheticWorkspaceOptions
+): SyntheticWorkspace {
+    const random = createRandom(options.seed ?? 1);
+    const dirsPerLevel = options.dirsPerLevel ?? 4;
+    const cppRatio = options.cppRatio ?? 0.5;
+    const generatedRatio = options.generatedRatio ?? 0.1;
+    const linesPerFile = options.linesPerFile ?? 60;
+
+    const workspace: SyntheticWorkspace = {
+        files: new Map(),
+        directories: new Map([['.', new Map()]]),
+        ignoredByRoot: new Set(),
+        ignoredByNested: new Set(),
+    };
+
+    addFile(
+        workspace,
+        '.gitignore',
+        ['build/', 'node_modules/', '*.log', ''].join('\n')
+    );
+
+    // Source directory tree
+    const sourceDirs: string[] = [];
+    const addTree = (dir: string, level: number) => {
+        sourceDirs.push(dir);
+        if (level >= options.depth) {
+            return;
+        }
+        for (let i = 0; i < dirsPerLevel; i++) {
+            addTree(`${dir}/${pick(random, DIR_NAMES)}${i}`, level + 1);
+        }
+    };
+    for (const root of SOURCE_ROOTS) {
+        addTree(root, 0);
+    }
+
+    // Every fourth directory ignores its generated TypeScript
+    const nestedIgnoreDirs = new Set(
+        sourceDirs.filter((_, index) => index % 4 === 1)
+    );
+    for (const dir of nestedIgnoreDirs) {
+        addFile(workspace, `${dir}/.gitignore`, '*.generated.ts\n');
+    }
+
+    for (let i = 0; i < options.files; i++) {
+        const dir = pick(random, sourceDirs);
+        const isCpp = random() < cppRatio;
+        const name = `${pick(random, WORDS)}${i}`;
+        if (isCpp) {
+            addFile(
+                workspace,
+                `${dir}/${name}.cpp`,
+                cppSource(random, name, linesPerFile)
+            );
+            addFile(workspace, `${dir}/${name}.h`, cppHeader(name));
+        } else {
+            addFile(
+                workspace,
+                `${dir}/${name}.ts`,
+                tsSource(random, name, linesPerFile)
+            );
+        }
+    }
+
+    const generatedCount = Math.round(options.files * generatedRatio);
+    for (let i = 0; i < generatedCount; i++) {
+        const kind = i % 3;
+        if (kind === 0) {
+            const file = `build/obj/${pick(random, SOURCE_ROOTS)}/out${i}.js`;
+            addFile(workspace, file, tsSource(random, `out${i}`, 20));
+            workspace.ignoredByRoot.add(file);
+        } else if (kind === 1) {
+            const file = `node_modules/pkg${i % 7}/lib/index${i}.js`;
+            addFile(workspace, file, tsSource(random, `index${i}`, 20));
+            workspace.ignoredByRoot.add(file);
+        } else {
+            const dir = pick(random, sourceDirs);
+            const file = `${dir}/schema${i}.generated.ts`;
+            addFile(workspace, file, tsSource(random, `schema${i}`, 20));
+            if (nestedIgnoreDirs.has(dir)) {
+                workspace.ignoredByNested.add(file);
+            }
+        }
+    }
+
+    addFile(workspace, 'debug.log', 'log output\n');
+    workspace.ignoredByRoot.add('debug.log');
+
+    return workspace;
+}
+
+function addFile(
+    workspace: SyntheticWorkspace,
+    filePath: string,
+    content: string
+): void {
+    workspace.files.set(filePath, content);
+
+    const segments = filePath.split('/');
+    let parent = '.';
+    segments.forEach((segment, index) => {
+        const isFile = index === segments.length - 1;
+        const children = workspace.directories.get(parent)!;
+        children.set(
+            segment,
+            isFile ? vscode.FileType.File : vscode.FileType.Directory
+        );
+        if (!isFile) {
+            parent = parent === '.' ? segment : `${parent}/${segment}`;
+            if (!workspace.directories.has(parent)) {
+                workspace.directories.set(parent, new Map());
+            }
+        }
+    });
+}
+
+function tsSource(random: () => number, name: string, lines: number): string {
+    const out = [
+        `import { Service } from './service';`,
+        '',
+        `export class ${capitalize(name)} {`,
+    ];
+    let method = 0;
+    while (out.length < lines - 1) {
+        out.push(`  handle${method++}(input: string): number {`);
+        for (let i = 0; i < 4; i++) {
+            out.push(codeLine(random));
+        }
+        out.push('  }');
+    }
+    out.push('}');
+    return out.join('\n') + '\n';
+}
+
+function cppSource(random: () => number, name: string, lines: number): string {
+    const out = [
+        `#include "${name}.h"`,
+        '',
+        'namespace app {',
+        '',
+    ];
+    let method = 0;
+    while (out.length < lines - 1) {
+        out.push(`int ${capitalize(name)}::handle${method++}(int input) {`);
+        for (let i = 0; i < 4; i++) {
+            out.push(codeLine(random));
+        }
+        out.push('}');
+    }
+    out.push('}  // namespace app');
+    return out.join('\n') + '\n';
+}
+
+function cppHeader(name: string): string {
+    return [
+        '#pragma once',
+        '',
+        'namespace app {',
+        `class ${capitalize(name)} {`,
+        'public:',
+        '    int handle0(int input);',
+        '};',
+        '}  // namespace app',
+        '',
+    ].join('\n');
+}
+
+function capitalize(text: string): string {
+    return text.charAt(0).toUpperCase() + text.slice(1);
+}
+
+/**
+ * Write a workspace under `rootDir` (which must exist), for code that reads
+ * the real file system such as FileDiscoverer (fdir) and ripgrep.
+ */
+export async function writeSyntheticWorkspace(
+    workspace: SyntheticWorkspace,
+    rootDir: string
+): Promise<void> {
+    for (const dir of workspace.directories.keys()) {
+        await fs.mkdir(path.join(rootDir, dir), { recursive: true });
+    }
+    await Promise.all(
+        [...workspace.files].map(([filePath, content]) =>
+            fs.writeFile(path.join(rootDir, filePath), content)
+        )
+    );
+}
+
+/**
+ * Implementations for the mocked vscode.workspace.fs that serve the workspace
+ * as if it were checked out at `rootDir`.
+ *
+ * @example
+ * const stub = createWorkspaceFsStub(workspace, '/repo');
+ * vi.mocked(vscode.workspace.fs.readDirectory).mockImplementation(stub.readDirectory);
+ * vi.mocked(vscode.workspace.fs.readFile).mockImplementation(stub.readFile);
+ * vi.mocked(vscode.workspace.fs.stat).mockImplementation(stub.stat);
+ */
+export function createWorkspaceFsStub(
+    workspace: SyntheticWorkspace,
+    rootDir: string
+): {
+    readDirectory: (uri: vscode.Uri) => Promise<[string, vscode.FileType][]>;
+    readFile: (uri: vscode.Uri) => Promise<Uint8Array>;
+    stat: (uri: vscode.Uri) => Promise<vscode.FileStat>;
+} {
+    const toRelative = (uri: vscode.Uri) =>
+        path.posix.relative(rootDir, uri.fsPath.replaceAll('\\', '/')) || '.';
+
+    return {
+        readDirectory: async (uri) => {
+            const children = workspace.directories.get(toRelative(uri));
+            if (!children) {
+                throw vscode.FileSystemError.FileNotFound(uri);
+            }
+            return [...children];
+        },
+        readFile: async (uri) => {
+            const content = workspace.files.get(toRelative(uri));
+            if (content === undefined) {
+                throw vscode.FileSystemError.FileNotFound(uri);
+            }
+            return Buffer.from(content);
+        },
+        stat: async (uri) => {
+            const relativePath = toRelative(uri);
+            const content = workspace.files.get(relativePath);
+            if (
+                content === undefined &&
+                !workspace.directories.has(relativePath)
+            ) {
+                throw vscode.FileSystemError.FileNotFound(uri);
+            }
+            return {
+                type:
+                    content === undefined
+                        ? vscode.FileType.Directory
+                        : vscode.FileType.File,
+                ctime: 0,
+                mtime: 0,
+                size: content?.length ?? 0,
+            };
+        },
+    };
+}
+
+// ---------------------------------------------------------------------------
+// Diffs
+// ---------------------------------------------------------------------------
+
+export interface SyntheticDiffOptions {
+    files: number;
+    hunksPerFile: number;
+    linesPerHunk: number;
+    /** Fraction of files emitted as "Binary files ... differ" */
+    binaryRatio?: number;
+    /** Fraction of files that are renamed (with content changes) */
+    renameRatio?: number;
+    /** Fraction of hunks that only change indentation or trailing whitespace */
+    whitespaceRatio?: number;
+    /** Fraction of the other files that are new (default 0.1); they get one hunk of added lines */
+    newFileRatio?: number;
+    seed?: number;
+}
+
+/**
+ * Generate a unified diff in `git diff` format with a mix of modified, new,
+ * renamed and binary files. 400 files x 8 hunks x 20 lines is about 3 MB.
+ */
+export function generateSyntheticDiff(options: SyntheticDiffOptions): string {
+    const random = createRandom(options.seed ?? 1);
+    const binaryRatio = options.binaryRatio ?? 0;
+    const renameRatio = options.renameRatio ?? 0;
+    const whitespaceRatio = options.whitespaceRatio ?? 0;
+    const newFileRatio = options.newFileRatio ?? 0.1;
+    const parts: string[] = [];
+
+    for (let file = 0; file < options.files; file++) {
+        const filePath = `src/module${file % 20}/file${file}.ts`;
+
+        const kind = random();
+        if (kind < binaryRatio) {
+            const assetPath = `assets/image${file}.png`;
+            parts.push(
+                `diff --git a/${assetPath} b/${assetPath}\n` +
+                    `index 1a2b3c4..5d6e7f8 100644\n` +
+                    `Binary files a/${assetPath} and b/${assetPath} differ\n`
+            );
+            continue;
+        }
+
+        const isRename = kind < binaryRatio + renameRatio;
+        const isNew = !isRename && random() < newFileRatio;
+        const oldPath = isRename
+            ? `src/legacy${file % 20}/file${file}.ts`
+            : filePath;
+        const lines = [`diff --git a/${oldPath} b/${filePath}`];
+        if (isRename) {
+            lines.push(
+                `similarity index ${80 + Math.floor(random() * 20)}%`,
+                `rename from ${oldPath}`,
+                `rename to ${filePath}`
+            );
+        } else if (isNew) {
+            lines.push('new file mode 100644');
+        }
+        lines.push(
+            'index 1a2b3c4..5d6e7f8 100644',
+            isNew ? '--- /dev/null' : `--- a/${oldPath}`,
+            `+++ b/${filePath}`
+        );
+
+        if (isNew) {
+            // A new file is one hunk of added lines
+            const added = options.hunksPerFile * options.linesPerHunk;
+            lines.push(`@@ -0,0 +1,${added} @@`);
+            for (let i = 0; i < added; i++) {
+                lines.push('+' + codeLine(random));
+            }
+            parts.push(lines.join('\n') + '\n');
+            continue;
+        }
+
+        let oldLine = 1;
+        let newLine = 1;
+        for (let hunk = 0; hunk < options.hunksPerFile; hunk++) {
+            const gap = 10 + Math.floor(random() * 40);
+            oldLine += gap;
+            newLine += gap;
+
+            const body: string[] = [];
+            if (random() < whitespaceRatio) {
+                body.push(...whitespaceOnlyHunk(random, options.linesPerHunk));
+            } else {
+                for (let i = 0; i < options.linesPerHunk; i++) {
+                    const change = random();
+                    const prefix =
+                        change < 0.2 ? '-' : change < 0.45 ? '+' : ' ';
+                    body.push(prefix + codeLine(random));
+                }
+            }
+
+            // Counts come from the emitted lines: context and removed lines
+            // are in the old file, context and added lines in the new one
+            const oldCount = body.filter((line) => line[0] !== '+').length;
+            const newCount = body.filter((line) => line[0] !== '-').length;
+            lines.push(
+                `@@ -${hunkRange(oldLine, oldCount)} +${hunkRange(newLine, newCount)} @@ function handler${hunk}() {`,
+                ...body
+            );
+            oldLine += oldCount;
+            newLine += newCount;
+        }
+
+        parts.push(lines.join('\n') + '\n');
+    }
+
+    return parts.join('');
+}
+
+/** `start,count` of a hunk header; an empty range starts at the line before */
+function hunkRange(start: number, count: number): string {
+    return `${count === 0 ? start - 1 : start},${count}`;
+}
+
+/** Pairs of -/+ lines that differ only in indentation or trailing spaces */
+function whitespaceOnlyHunk(random: () => number, lines: number): string[] {
+    const out: string[] = [];
+    while (out.length < lines) {
+        const line = codeLine(random);
+        out.push(`-${line}`);
+        out.push(random() < 0.5 ? `+\t${line.trimStart()}` : `+${line}  `);
+    }
+    return out;
+}
@@ -0,0 +1,152 @@
+import { describe, it, expect } from 'vitest';
+import {
+    buildTokenBreakdown,
+    categorizePromptTokens,
+    reconcileTokenCounts,
+} from '../models/tokenBreakdown';
+import { formatTokenBreakdownAsMarkdown } from '../webview/utils/tokenBreakdown';
+import type { ToolCallMessage } from '../types/modelTypes';
+
+const userMessage = (content: string): ToolCallMessage => ({
+    role: 'user',
+    content,
+});
+
+const assistantCall = (id: string, name: string): ToolCallMessage => ({
+    role: 'assistant',
+    content: null,
+    toolCalls: [{ id, function: { name, arguments: '{}' } }],
+});
+
+const toolResult = (id: string, content: string): ToolCallMessage => ({
+    role: 'tool',
+    content,
+    toolCallId: id,
+});
+
+describe('tokenBreakdown', () => {
+    describe('categorizePromptTokens', () => {
+        it('should split tokens by role and attribute tool results to their tool', () => {
+            const messages = [
+                userMessage('Review this diff'),
+                assistantCall('call_1', 'read_file'),
+                toolResult('call_1', 'contents'),
+                assistantCall('call_2', 'find_symbol'),
+                toolResult('call_2', 'definition'),
+                toolResult('call_3', 'orphan'),
+                userMessage('Please call submit_review'),
+            ];
+
+            const usage = categorizePromptTokens(
+                2,
+                50,
+                messages,
+                [400, 20, 300, 20, 100, 10, 30],
+                0
+            );
+
+            expect(usage).toEqual({
+                iteration: 2,
+                system: 50,
+                prompt: 400,
+                assistant: 40,
+                toolResults: { read_file: 300, find_symbol: 100, unknown: 10 },
+                other: 30,
+                total: 930,
+                evicted: 0,
+            });
+        });
+
+        it('should estimate messages added after validation', () => {
+            const usage = categorizePromptTokens(
+                1,
+                0,
+                [userMessage('diff'), userMessage('x'.repeat(40))],
+                [100],
+                0
+            );
+
+            // 40 chars / 4 chars per token + 5 overhead
+            expect(usage.other).toBe(15);
+            expect(usage.total).toBe(115);
+        });
+    });
+
+    describe('reconcileTokenCounts', () => {
+        it('should carry counts to kept messages and sum the dropped ones', () => {
+            const prompt = userMessage('diff');
+            const call = assistantCall('call_1', 'read_file');
+            const result = toolResult('call_1', 'contents');
+            const notice = userMessage('Context is full');
+
+            const reconciled = reconcileTokenCounts(
+                [prompt, call, result],
+                [100, 20, 500],
+                [prompt, notice]
+            );
+
+            expect(reconciled.tokenCounts).toEqual([100, undefined]);
+            expect(reconciled.evicted).toBe(520);
+        });
+    });
+
+    describe('buildTokenBreakdown', () => {
+        it('should total prompt and evicted tokens across iterations', () => {
+            const first = categorizePromptTokens(
+                1,
+                50,
+                [userMessage('diff')],
+                [100],
+                0
+            );
+            const second = categorizePromptTokens(
+                2,
+                50,
+                [userMessage('diff')],
+                [100],
+                300
+            );
+
+            const breakdown = buildTokenBreakdown(128000, [first, second], []);
+
+            expect(breakdown.totalPromptTokens).toBe(300);
+            expect(breakdown.evictedTokens).toBe(300);
+            expect(breakdown.maxInputTokens).toBe(128000);
+        });
+    });
+
+    describe('formatTokenBreakdownAsMarkdown', () => {
+        it('should keep pipes and line breaks in cell text inside the cell', () => {
+            const lines = formatTokenBreakdownAsMarkdown({
+                maxInputTokens: 128000,
+                iterations: [
+                    {
+                        iteration: 1,
+                        system: 10,
+                        prompt: 20,
+                        assistant: 5,
+                        toolResults: { 'odd|tool': 40 },
+                        other: 0,
+                        total: 75,
+                        evicted: 0,
+                    },
+                ],
+                totalPromptTokens: 75,
+                evictedTokens: 0,
+                subagents: [
+                    {
+                        subagentId: 1,
+                        task: 'Check a | b\nand C:\\path',
+                        iterations: 3,
+                        tokens: 900,
+                    },
+                ],
+            });
+
+            expect(lines).toContain('| odd\\|tool | 40 |');
+            expect(lines).toContain(
+                '| #1 Check a \\| b and C:\\\\path | 3 | 900 |'
+            );
+        });
+    });
+});
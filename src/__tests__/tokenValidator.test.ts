@@ -47,6 +47,8 @@ describe('TokenValidator', () => {
             expect(result.exceedsWarningThreshold).toBe(false);
             expect(result.exceedsMaxTokens).toBe(false);
             expect(result.totalTokens).toBe(155); // 100 + 50 + TOKEN_OVERHEAD_PER_MESSAGE
+            expect(result.systemTokens).toBe(100);
+            expect(result.messageTokens).toEqual([55]);
         });
 
         it('should return remove_old_context action when exceeding warning threshold', async () => {
@@ -236,6 +238,46 @@ describe('TokenValidator', () => {
             );
         });
 
+        it('should leave out the context full message when asked to', async () => {
+            const messages: ToolCallMessage[] = [
+                {
+                    role: 'assistant',
+                    content: 'I will call a tool',
+                    toolCalls: [
+                        {
+                            id: 'call_1',
+                            function: { name: 'tool1', arguments: '{}' },
+                        },
+                    ],
+                    toolCallId: undefined,
+                },
+                {
+                    role: 'tool',
+                    content: 'Tool result 1',
+                    toolCalls: undefined,
+                    toolCallId: 'call_1',
+                },
+                {
+                    role: 'user',
+                    content: 'Continue',
+                    toolCalls: undefined,
+                    toolCallId: undefined,
+                },
+            ];
+            mockModel.countTokens.mockResolvedValue(1000);
+
+            const result = await tokenValidator.cleanupContext(
+                messages,
+                'System prompt',
+                0.5,
+                false
+            );
+
+            expect(result.toolResultsRemoved).toBe(1);
+            expect(result.contextFullMessageAdded).toBe(false);
+            expect(result.cleanedMessages).toEqual([messages[2]]);
+        });
+
         it('should not modify messages when under target utilization', async () => {
             const systemPrompt = 'You are a helpful assistant';
             const messages: ToolCallMessage[] = [
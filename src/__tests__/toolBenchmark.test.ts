@@ -0,0 +1,143 @@
+import { describe, it, expect, vi } from 'vitest';
+import * as vscode from 'vscode';
+import {
+    runToolBenchmark,
+    type ToolBenchmarkOptions,
+} from '../services/toolBenchmark';
+import type { ToolExecutionResult } from '../models/toolExecutor';
+
+const createToken = (): vscode.CancellationToken & {
+    isCancellationRequested: boolean;
+} => ({
+    isCancellationRequested: false,
+    onCancellationRequested: vi.fn(),
+});
+
+const options = (
+    overrides: Partial<ToolBenchmarkOptions> = {}
+): ToolBenchmarkOptions => ({
+    toolName: 'read_file',
+    parameters: { file_path: 'src/index.ts' },
+    runs: 5,
+    concurrency: 1,
+    cacheMode: 'cold',
+    ...overrides,
+});
+
+const success = (result: string): ToolExecutionResult => ({
+    name: 'read_file',
+    success: true,
+    result,
+});
+
+describe('runToolBenchmark', () => {
+    it('should time every run and summarize sizes and errors', async () => {
+        let call = 0;
+        const execute = vi.fn(async () => {
+            call++;
+            return call === 3
+                ? { name: 'read_file', success: false, error: 'not found' }
+                : success('x'.repeat(call * 10));
+        });
+
+        const report = await runToolBenchmark(options(), execute, createToken());
+
+        expect(execute).toHaveBeenCalledTimes(5);
+        expect(report.results.map((r) => r.run)).toEqual([1, 2, 3, 4, 5]);
+        expect(report.errors).toBe(1);
+        expect(report.errorRate).toBeCloseTo(0.2);
+        expect(report.results[2]).toMatchObject({
+            success: false,
+            responseChars: 0,
+            error: 'not found',
+        });
+        // Failed runs are left out of the size distribution
+        expect(report.responseChars.max).toBe(50);
+        expect(report.latencyMs.min).toBeLessThanOrEqual(report.latencyMs.p50);
+        expect(report.cancelled).toBe(false);
+    });
+
+    it('should run one untimed warm-up call in warm mode', async () => {
+        const execute = vi.fn(async () => success('ok'));
+
+        const report = await runToolBenchmark(
+            options({ runs: 3, cacheMode: 'warm' }),
+            execute,
+            createToken()
+        );
+
+        expect(execute).toHaveBeenCalledTimes(4);
+        expect(report.results).toHaveLength(3);
+    });
+
+    it('should keep at most `concurrency` runs in flight', async () => {
+        let inFlight = 0;
+        let maxInFlight = 0;
+        const execute = async () => {
+            inFlight++;
+            maxInFlight = Math.max(maxInFlight, inFlight);
+            await new Promise((resolve) => setTimeout(resolve, 5));
+            inFlight--;
+            return success('ok');
+        };
+
+        const report = await runToolBenchmark(
+            options({ runs: 10, concurrency: 3 }),
+            execute,
+            createToken()
+        );
+
+        expect(report.results).toHaveLength(10);
+        expect(maxInFlight).toBe(3);
+    });
+
+    it('should count thrown errors as failed runs', async () => {
+        const report = await runToolBenchmark(
+            options({ runs: 2 }),
+            async () => {
+                throw new Error('LSP crashed');
+            },
+            createToken()
+        );
+
+        expect(report.errors).toBe(2);
+        expect(report.results[0].error).toBe('LSP crashed');
+    });
+
+    it('should stop starting runs once cancelled and report what finished', async () => {
+        const token = createToken();
+        const onProgress = vi.fn((completed: number) => {
+            if (completed === 2) {
+                token.isCancellationRequested = true;
+            }
+        });
+
+        const report = await runToolBenchmark(
+            options({ runs: 10 }),
+            async () => success('ok'),
+            token,
+            onProgress
+        );
+
+        expect(report.results).toHaveLength(2);
+        expect(report.cancelled).toBe(true);
+        expect(onProgress).toHaveBeenLastCalledWith(2, 10);
+    });
+
+    it('should clamp runs and concurrency to sane values', async () => {
+        const report = await runToolBenchmark(
+            options({ runs: 2, concurrency: 50 }),
+            async () => success('ok'),
+            createToken()
+        );
+
+        expect(report.concurrency).toBe(2);
+
+        const zeroRuns = await runToolBenchmark(
+            options({ runs: 0 }),
+            async () => success('ok'),
+            createToken()
+        );
+        expect(zeroRuns.runs).toBe(1);
+    });
+});
@@ -236,11 +236,23 @@ index 1234567..abcdefg 100644
                     ],
                 });
 
+            const onUpdate = vi.fn();
             const result = await provider.analyze(
                 sampleDiff,
-                tokenSource.token
+                tokenSource.token,
+                undefined,
+                onUpdate
             );
 
+            // Each completed tool call is reported as it happens
+            expect(onUpdate).toHaveBeenCalledWith({
+                type: 'toolCall',
+                call: expect.objectContaining({
+                    id: 'call_1',
+                    toolName: 'find_symbol',
+                }),
+            });
+
             // Verify tool execute was called with parsed arguments
             // Zod schema adds default value for includeFullBody
             expect(executeSpy).toHaveBeenCalledWith(
@@ -65,5 +65,11 @@ describe('toolConstants', () => {
             expect(message).toContain('Subagent failed');
             expect(message).toContain('LLM returned empty response');
         });
+
+        it('should produce budgetExhausted message pointing to direct tools', () => {
+            const message = SubagentErrors.budgetExhausted();
+            expect(message).toContain('budget');
+            expect(message).toContain('direct tools');
+        });
     });
 });
@@ -3,6 +3,8 @@ import * as vscode from 'vscode';
 import * as z from 'zod';
 import { ToolExecutor, ToolExecutionRequest } from '../models/toolExecutor';
 import { ToolRegistry } from '../models/toolRegistry';
+import { ToolResultCache } from '../models/toolResultCache';
+import { ToolMetricsStore } from '../services/toolMetricsStore';
 import { ITool } from '../tools/ITool';
 import { WorkspaceSettingsService } from '../services/workspaceSettingsService';
 import {
@@ -357,6 +359,26 @@ describe('ToolExecutor', () => {
             expect(limitedExecutor.getToolCallCount()).toBe(3);
         });
 
+        it('should release discarded calls without going below zero', async () => {
+            const limitedExecutor = new ToolExecutor(
+                toolRegistry,
+                createMockSettings(10),
+                createMockExecutionContext()
+            );
+
+            await limitedExecutor.executeTool('success_tool', {
+                message: 'test1',
+            });
+            await limitedExecutor.executeTool('success_tool', {
+                message: 'test2',
+            });
+            limitedExecutor.releaseToolCalls(1);
+            expect(limitedExecutor.getToolCallCount()).toBe(1);
+
+            limitedExecutor.releaseToolCalls(5);
+            expect(limitedExecutor.getToolCallCount()).toBe(0);
+        });
+
         it('should use settings with default limit', async () => {
             const defaultExecutor = new ToolExecutor(
                 toolRegistry,
@@ -711,6 +733,189 @@ describe('ToolExecutor', () => {
         });
     });
 
+    describe('Shared Tool Result Cache', () => {
+        class CountingReadTool extends MockSuccessTool {
+            override name = 'read_file';
+            calls = 0;
+
+            override async execute(
+                args: any,
+                _context: ExecutionContext
+            ): Promise<ToolResult> {
+                this.calls++;
+                return toolSuccess(`Read: ${args.message}`);
+            }
+        }
+
+        it('should share read-only results between executors using the same cache', async () => {
+            const readTool = new CountingReadTool();
+            toolRegistry.registerTool(readTool);
+            const toolResultCache = new ToolResultCache();
+
+            const parent = new ToolExecutor(
+                toolRegistry,
+                mockSettings,
+                createMockExecutionContext({ toolResultCache })
+            );
+            const subagent = new ToolExecutor(
+                toolRegistry,
+                mockSettings,
+                createMockExecutionContext({ toolResultCache })
+            );
+
+            const [first, second] = await Promise.all([
+                parent.executeTool('read_file', { message: 'a' }),
+                subagent.executeTool('read_file', { message: 'a' }),
+            ]);
+
+            expect(first.result).toBe('Read: a');
+            expect(second.result).toBe('Read: a');
+            expect(readTool.calls).toBe(1);
+        });
+
+        it('should leave cache hits out of tool metrics', async () => {
+            toolRegistry.registerTool(new CountingReadTool());
+            const toolMetrics = new ToolMetricsStore();
+            const executor = new ToolExecutor(
+                toolRegistry,
+                mockSettings,
+                createMockExecutionContext({
+                    toolResultCache: new ToolResultCache(),
+                    toolMetrics,
+                })
+            );
+
+            await executor.executeTool('read_file', { message: 'a' });
+            await executor.executeTool('read_file', { message: 'a' });
+
+            expect(toolMetrics.getSnapshot().totalCalls).toBe(1);
+        });
+
+        it('should count a shared timeout once', async () => {
+            class TimingOutReadTool extends CountingReadTool {
+                override async execute(): Promise<ToolResult> {
+                    this.calls++;
+                    await new Promise((resolve) => setTimeout(resolve, 5));
+                    throw new TimeoutError('Read timed out', 'read_file', 5);
+                }
+            }
+            toolRegistry.registerTool(new TimingOutReadTool());
+            const toolMetrics = new ToolMetricsStore();
+            const toolResultCache = new ToolResultCache();
+            const createExecutor = () =>
+                new ToolExecutor(
+                    toolRegistry,
+                    mockSettings,
+                    createMockExecutionContext({ toolResultCache, toolMetrics })
+                );
+
+            const results = await Promise.all([
+                createExecutor().executeTool('read_file', { message: 'a' }),
+                createExecutor().executeTool('read_file', { message: 'a' }),
+            ]);
+
+            expect(results.every((result) => !result.success)).toBe(true);
+            const { totalCalls, tools } = toolMetrics.getSnapshot();
+            expect(totalCalls).toBe(1);
+            expect(tools[0]).toMatchObject({ timeouts: 1 });
+        });
+
+        it('should not cache tools outside the read-only set', async () => {
+            const toolResultCache = new ToolResultCache();
+            const executor = new ToolExecutor(
+                toolRegistry,
+                mockSettings,
+                createMockExecutionContext({ toolResultCache })
+            );
+
+            await executor.executeTool('success_tool', { message: 'a' });
+            await executor.executeTool('success_tool', { message: 'a' });
+
+            expect(toolResultCache.getStats().size).toBe(0);
+        });
+    });
+
+    describe('Tool Metrics', () => {
+        it('should record outcome, latency and response size per tool', async () => {
+            const toolMetrics = new ToolMetricsStore();
+            const oversizedTool: ITool = {
+                name: 'oversized_tool',
+                description: 'Returns oversized response',
+                schema: z.object({}),
+                getVSCodeTool: () => ({
+                    name: 'oversized_tool',
+                    description: 'test',
+                    inputSchema: {},
+                }),
+                execute: async (): Promise<ToolResult> =>
+                    toolSuccess(
+                        'x'.repeat(TokenConstants.MAX_TOOL_RESPONSE_CHARS + 1)
+                    ),
+            };
+            toolRegistry.registerTool(oversizedTool);
+            const executor = new ToolExecutor(
+                toolRegistry,
+                mockSettings,
+                createMockExecutionContext({ toolMetrics })
+            );
+
+            await executor.executeTool('success_tool', { message: 'a' });
+            await executor.executeTool('error_tool', { input: 'a' });
+            await executor.executeTool('oversized_tool', {});
+            // Rejected before reaching the tool: not recorded
+            await executor.executeTool('success_tool', {});
+            await executor.executeTool('missing_tool', {});
+
+            const { totalCalls, tools } = toolMetrics.getSnapshot();
+            const byName = new Map(tools.map((tool) => [tool.toolName, tool]));
+            expect(totalCalls).toBe(3);
+            expect(byName.get('success_tool')).toMatchObject({
+                calls: 1,
+                errors: 0,
+                responseChars: { max: 'Success: a'.length },
+            });
+            expect(byName.get('error_tool')).toMatchObject({
+                calls: 1,
+                errorRate: 1,
+            });
+            expect(byName.get('oversized_tool')).toMatchObject({
+                calls: 1,
+                oversized: 1,
+                oversizedRate: 1,
+            });
+        });
+
+        it('should count partial results after a timeout as timeouts', async () => {
+            const toolMetrics = new ToolMetricsStore();
+            toolRegistry.registerTool({
+                name: 'partial_tool',
+                description: 'Returns partial results',
+                schema: z.object({}),
+                getVSCodeTool: () => ({
+                    name: 'partial_tool',
+                    description: 'test',
+                    inputSchema: {},
+                }),
+                execute: async (): Promise<ToolResult> =>
+                    toolSuccess('Some results', { timedOut: true }),
+            });
+            const executor = new ToolExecutor(
+                toolRegistry,
+                mockSettings,
+                createMockExecutionContext({ toolMetrics })
+            );
+
+            const result = await executor.executeTool('partial_tool', {});
+
+            expect(result.success).toBe(true);
+            expect(toolMetrics.getSnapshot().tools[0]).toMatchObject({
+                toolName: 'partial_tool',
+                timeouts: 1,
+                timeoutRate: 1,
+            });
+        });
+    });
+
     describe('Constructor Validation', () => {
         it('should throw error when ExecutionContext lacks cancellationToken', () => {
             // Type assertion to bypass TypeScript's type checking for invalid context
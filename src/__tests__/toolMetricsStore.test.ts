@@ -0,0 +1,78 @@
+import { describe, it, expect } from 'vitest';
+import { ToolMetricsStore } from '../services/toolMetricsStore';
+import { percentile } from '../utils/statsUtils';
+
+describe('ToolMetricsStore', () => {
+    it('should compute nearest-rank percentiles', () => {
+        const sorted = Array.from({ length: 100 }, (_, i) => i + 1);
+
+        expect(percentile(sorted, 50)).toBe(50);
+        expect(percentile(sorted, 95)).toBe(95);
+        expect(percentile(sorted, 99)).toBe(99);
+        expect(percentile([7], 99)).toBe(7);
+        expect(percentile([], 50)).toBe(0);
+    });
+
+    it('should aggregate latency, size and failure rates per tool', () => {
+        const store = new ToolMetricsStore();
+        for (let i = 1; i <= 20; i++) {
+            store.record({
+                toolName: 'find_symbol',
+                durationMs: i * 100,
+                outcome: i === 20 ? 'timeout' : 'success',
+                responseChars: i === 20 ? undefined : i * 1000,
+            });
+        }
+        store.record({
+            toolName: 'read_file',
+            durationMs: 5,
+            outcome: 'oversized',
+            responseChars: 25_000,
+        });
+
+        const snapshot = store.getSnapshot();
+
+        expect(snapshot.totalCalls).toBe(21);
+        // Slowest p95 first
+        expect(snapshot.tools.map((tool) => tool.toolName)).toEqual([
+            'find_symbol',
+            'read_file',
+        ]);
+        expect(snapshot.tools[0]).toMatchObject({
+            calls: 20,
+            timeouts: 1,
+            timeoutRate: 0.05,
+            latencyMs: { p50: 1000, p95: 1900, p99: 2000, max: 2000 },
+            responseChars: { p50: 10_000, max: 19_000 },
+        });
+        expect(snapshot.tools[1]).toMatchObject({
+            oversized: 1,
+            oversizedRate: 1,
+        });
+    });
+
+    it('should keep distributions bounded to the most recent calls', () => {
+        const store = new ToolMetricsStore();
+        for (let i = 0; i < 1500; i++) {
+            store.record({
+                toolName: 'list_dir',
+                durationMs: i < 500 ? 10_000 : 1,
+                outcome: 'success',
+            });
+        }
+
+        const [listDir] = store.getSnapshot().tools;
+
+        expect(listDir.calls).toBe(1500);
+        expect(listDir.latencyMs.max).toBe(1);
+    });
+
+    it('should clear statistics on reset', () => {
+        const store = new ToolMetricsStore();
+        store.record({ toolName: 'list_dir', durationMs: 1, outcome: 'error' });
+
+        store.reset();
+
+        expect(store.getSnapshot()).toMatchObject({ totalCalls: 0, tools: [] });
+    });
+});
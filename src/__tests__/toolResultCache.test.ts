@@ -0,0 +1,120 @@
+import { describe, it, expect, vi } from 'vitest';
+import { ToolResultCache } from '../models/toolResultCache';
+import { ToolConstants } from '../models/toolConstants';
+import {
+    ToolResult,
+    toolSuccess,
+    toolError,
+} from '../types/toolResultTypes';
+
+describe('ToolResultCache', () => {
+    it('should coalesce concurrent identical requests onto one execution', async () => {
+        const cache = new ToolResultCache();
+        let resolveRead!: () => void;
+        const execute = vi.fn(
+            () =>
+                new Promise<ToolResult>((resolve) => {
+                    resolveRead = () => resolve(toolSuccess('contents'));
+                })
+        );
+
+        const first = cache.getOrExecute('read_file:a', execute);
+        const second = cache.getOrExecute('read_file:a', execute);
+        resolveRead();
+
+        expect(await first).toEqual(toolSuccess('contents'));
+        expect(await second).toEqual(toolSuccess('contents'));
+        expect(execute).toHaveBeenCalledTimes(1);
+        expect(cache.getStats()).toEqual({ hits: 1, misses: 1, size: 1 });
+    });
+
+    it('should serve settled results from the cache', async () => {
+        const cache = new ToolResultCache();
+        const execute = vi.fn(async () => toolSuccess('contents'));
+
+        await cache.getOrExecute('key', execute);
+        await cache.getOrExecute('key', execute);
+
+        expect(execute).toHaveBeenCalledTimes(1);
+    });
+
+    it('should not retain failed results', async () => {
+        const cache = new ToolResultCache();
+        const execute = vi
+            .fn()
+            .mockResolvedValueOnce(toolError('File not found'))
+            .mockResolvedValueOnce(toolSuccess('contents'));
+
+        expect((await cache.getOrExecute('key', execute)).success).toBe(false);
+        expect((await cache.getOrExecute('key', execute)).success).toBe(true);
+        expect(execute).toHaveBeenCalledTimes(2);
+    });
+
+    it('should not retain results cut short by a timeout', async () => {
+        const cache = new ToolResultCache();
+        const execute = vi
+            .fn()
+            .mockResolvedValue(toolSuccess('partial', { timedOut: true }));
+
+        await cache.getOrExecute('key', execute);
+        await cache.getOrExecute('key', execute);
+
+        expect(execute).toHaveBeenCalledTimes(2);
+    });
+
+    it('should evict rejected executions so the next caller retries', async () => {
+        const cache = new ToolResultCache();
+        const execute = vi
+            .fn()
+            .mockRejectedValueOnce(new Error('boom'))
+            .mockResolvedValueOnce(toolSuccess('contents'));
+
+        await expect(cache.getOrExecute('key', execute)).rejects.toThrow(
+            'boom'
+        );
+        expect(cache.getStats().size).toBe(0);
+        expect((await cache.getOrExecute('key', execute)).success).toBe(true);
+    });
+
+    it('should drop the oldest entries beyond the size limit', async () => {
+        const cache = new ToolResultCache();
+        const execute = async () => toolSuccess('x');
+
+        for (let i = 0; i <= ToolConstants.TOOL_RESULT_CACHE_MAX_ENTRIES; i++) {
+            await cache.getOrExecute(`key${i}`, execute);
+        }
+
+        expect(cache.getStats().size).toBe(
+            ToolConstants.TOOL_RESULT_CACHE_MAX_ENTRIES
+        );
+    });
+
+    describe('buildKey', () => {
+        it('should ignore argument order and undefined values', () => {
+            expect(
+                ToolResultCache.buildKey('read_file', {
+                    file_path: 'src/a.ts',
+                    start_line: 1,
+                    end_line: undefined,
+                })
+            ).toBe(
+                ToolResultCache.buildKey('read_file', {
+                    start_line: 1,
+                    file_path: 'src/a.ts',
+                })
+            );
+        });
+
+        it('should distinguish tools and argument values', () => {
+            const args = { relative_path: 'src' };
+            expect(ToolResultCache.buildKey('list_directory', args)).not.toBe(
+                ToolResultCache.buildKey('find_symbol', args)
+            );
+            expect(
+                ToolResultCache.buildKey('read_file', { file_path: 'a.ts' })
+            ).not.toBe(
+                ToolResultCache.buildKey('read_file', { file_path: 'b.ts' })
+            );
+        });
+    });
+});
@@ -1,5 +1,7 @@
 import { describe, it, expect, vi, beforeEach } from 'vitest';
 import { UIManager } from '../services/uiManager';
+import { NestedToolCallStore } from '../services/nestedToolCallStore';
+import { AnalysisPanelData } from '../services/analysisPanelData';
 import * as vscode from 'vscode';
 
 vi.mock('vscode', async (importOriginal) => {
@@ -263,6 +265,274 @@ describe('UIManager', () => {
         });
     });
 
+    describe('getNestedToolCalls message handling', () => {
+        it('should return stored subagent tool calls', async () => {
+            const store = new NestedToolCallStore();
+            const calls = [
+                {
+                    id: 'call_1',
+                    toolName: 'read_file',
+                    arguments: { file_path: 'src/auth.ts' },
+                    result: 'contents',
+                    success: true,
+                    error: undefined,
+                    durationMs: 1,
+                    timestamp: 0,
+                },
+            ];
+            const ref = await store.put(calls);
+            uiManager = new UIManager(
+                mockExtensionContext,
+                '/mock/git/repo/root',
+                store
+            );
+            uiManager.displayAnalysisResults('Test', 'diff', 'analysis');
+
+            messageHandler({
+                command: 'getNestedToolCalls',
+                payload: { key: ref.key },
+            });
+
+            await vi.waitFor(() =>
+                expect(mockWebview.postMessage).toHaveBeenCalledWith({
+                    command: 'nestedToolCallsResult',
+                    payload: { key: ref.key, calls },
+                })
+            );
+        });
+
+        it('should report an error for unknown keys', async () => {
+            uiManager.displayAnalysisResults('Test', 'diff', 'analysis');
+
+            messageHandler({
+                command: 'getNestedToolCalls',
+                payload: { key: 'missing' },
+            });
+
+            await vi.waitFor(() =>
+                expect(mockWebview.postMessage).toHaveBeenCalledWith({
+                    command: 'nestedToolCallsResult',
+                    payload: expect.objectContaining({
+                        key: 'missing',
+                        error: expect.stringContaining('no longer available'),
+                    }),
+                })
+            );
+        });
+    });
+
+    describe('paged analysis data', () => {
+        const diffText = [
+            'diff --git a/a.ts b/a.ts',
+            '--- a/a.ts',
+            '+++ b/a.ts',
+            '@@ -1 +1 @@',
+            '-old',
+            '+new',
+            'diff --git a/b.ts b/b.ts',
+            '--- a/b.ts',
+            '+++ b/b.ts',
+            '@@ -1 +1,2 @@',
+            ' keep',
+            '+added',
+        ].join('\n');
+        const toolCalls = {
+            calls: [
+                {
+                    id: 'call_1',
+                    toolName: 'read_file',
+                    arguments: { file_path: 'a.ts' },
+                    result: 'full file contents',
+                    success: true,
+                    error: undefined,
+                    durationMs: 3,
+                    timestamp: 0,
+                },
+            ],
+            totalCalls: 1,
+            successfulCalls: 1,
+            failedCalls: 0,
+            analysisCompleted: true,
+            analysisError: undefined,
+        };
+
+        it('should embed only the manifest in the panel HTML', () => {
+            uiManager.displayAnalysisResults(
+                'Test',
+                diffText,
+                'analysis',
+                toolCalls
+            );
+
+            expect(mockWebview.html).toContain('"diffFiles"');
+            expect(mockWebview.html).toContain('read_file');
+            expect(mockWebview.html).not.toContain('full file contents');
+            expect(mockWebview.html).not.toContain('+added');
+        });
+
+        it('should send requested diff files', async () => {
+            uiManager.displayAnalysisResults('Test', diffText, 'analysis');
+
+            messageHandler({
+                command: 'getDiffFiles',
+                payload: { indices: [1, 5] },
+            });
+
+            await vi.waitFor(() =>
+                expect(mockWebview.postMessage).toHaveBeenCalledWith({
+                    command: 'diffFilesResult',
+                    payload: {
+                        files: [
+                            {
+                                index: 1,
+                                text: expect.stringContaining('+added'),
+                            },
+                        ],
+                        requested: [1, 5],
+                    },
+                })
+            );
+        });
+
+        it('should send requested tool call details', async () => {
+            uiManager.displayAnalysisResults(
+                'Test',
+                diffText,
+                'analysis',
+                toolCalls
+            );
+
+            messageHandler({
+                command: 'getToolCallDetails',
+                payload: { indices: [0] },
+            });
+
+            await vi.waitFor(() =>
+                expect(mockWebview.postMessage).toHaveBeenCalledWith({
+                    command: 'toolCallDetailsResult',
+                    payload: {
+                        calls: [{ index: 0, call: toolCalls.calls[0] }],
+                        requested: [0],
+                    },
+                })
+            );
+        });
+
+        it('should answer requests for unknown indices', async () => {
+            uiManager.displayAnalysisResults('Test', diffText, 'analysis');
+
+            messageHandler({
+                command: 'getToolCallDetails',
+                payload: { indices: [3] },
+            });
+
+            await vi.waitFor(() =>
+                expect(mockWebview.postMessage).toHaveBeenCalledWith({
+                    command: 'toolCallDetailsResult',
+                    payload: { calls: [], requested: [3] },
+                })
+            );
+        });
+    });
+
+    describe('live analysis', () => {
+        const record = {
+            id: 'call_1',
+            toolName: 'read_file',
+            arguments: { file_path: 'a.ts' },
+            result: 'full file contents',
+            success: true,
+            error: undefined,
+            durationMs: 3,
+            timestamp: 0,
+        };
+
+        it('should append tool calls and plan updates to the open panel', () => {
+            const live = uiManager.openLiveAnalysis('Test', 'diff');
+            expect(mockWebview.html).toContain('"running":true');
+
+            live.appendToolCall(record);
+            live.updatePlan('- [ ] Check auth');
+
+            expect(mockWebview.postMessage).toHaveBeenCalledWith({
+                command: 'analysisUpdate',
+                payload: {
+                    kind: 'toolCall',
+                    index: 0,
+                    call: expect.not.objectContaining({
+                        result: expect.anything(),
+                    }),
+                },
+            });
+            expect(mockWebview.postMessage).toHaveBeenCalledWith({
+                command: 'analysisUpdate',
+                payload: { kind: 'plan', plan: '- [ ] Check auth' },
+            });
+        });
+
+        it('should serve details of calls made so far', async () => {
+            const live = uiManager.openLiveAnalysis('Test', 'diff');
+            live.appendToolCall(record);
+
+            messageHandler({
+                command: 'getToolCallDetails',
+                payload: { indices: [0] },
+            });
+
+            await vi.waitFor(() =>
+                expect(mockWebview.postMessage).toHaveBeenCalledWith({
+                    command: 'toolCallDetailsResult',
+                    payload: {
+                        calls: [{ index: 0, call: record }],
+                        requested: [0],
+                    },
+                })
+            );
+        });
+
+        it('should send the final result in place of a re-render', () => {
+            const live = uiManager.openLiveAnalysis('Test', 'diff');
+            const html = mockWebview.html;
+
+            live.complete('<explanation>Done</explanation>', undefined);
+
+            expect(mockWebview.html).toBe(html);
+            expect(mockWebview.postMessage).toHaveBeenCalledWith({
+                command: 'analysisUpdate',
+                payload: {
+                    kind: 'complete',
+                    manifest: expect.objectContaining({
+                        analysis: 'Done',
+                        running: false,
+                    }),
+                },
+            });
+        });
+
+        it('should reopen the panel if it was closed during the analysis', () => {
+            let disposePanel: () => void = () => {};
+            (vscode.window.onDidChangeActiveColorTheme as any).mockReturnValue({
+                dispose: vi.fn(),
+            });
+            (vscode.window.createWebviewPanel as any).mockReturnValue({
+                webview: mockWebview,
+                onDidDispose: vi.fn((handler) => {
+                    disposePanel = handler;
+                }),
+                dispose: vi.fn(),
+            });
+            const live = uiManager.openLiveAnalysis('Test', 'diff');
+            disposePanel();
+
+            live.appendToolCall(record);
+            live.complete('Done', undefined);
+
+            expect(mockWebview.postMessage).not.toHaveBeenCalled();
+            expect(vscode.window.createWebviewPanel).toHaveBeenCalledTimes(2);
+            expect(mockWebview.html).toContain('"running":false');
+        });
+    });
+
     describe('theme handling', () => {
         it('should set up theme change listeners', () => {
             uiManager.displayAnalysisResults('Test', 'diff', 'analysis');
@@ -333,10 +603,9 @@ describe('UIManager', () => {
 
             const html = uiManager.generatePRAnalysisHtml(
                 'Test',
-                'diff',
                 analysis,
                 mockPanel,
-                undefined
+                new AnalysisPanelData('diff', undefined)
             );
 
             expect(html).toContain('Security issue');
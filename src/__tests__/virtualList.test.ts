@@ -0,0 +1,46 @@
+import { describe, it, expect } from 'vitest';
+import { computeVirtualRange } from '../webview/utils/virtualList';
+
+const heights = Array.from({ length: 100 }, () => 40);
+
+describe('computeVirtualRange', () => {
+    it('should cover the viewport plus overscan', () => {
+        expect(computeVirtualRange(heights, 0, 400, 80)).toEqual({
+            start: 0,
+            end: 12,
+            offsetBefore: 0,
+            offsetAfter: 88 * 40,
+        });
+    });
+
+    it('should skip items scrolled past', () => {
+        const range = computeVirtualRange(heights, 2000, 400, 80);
+
+        expect(range.start).toBe(48);
+        expect(range.end).toBe(62);
+        expect(range.offsetBefore).toBe(48 * 40);
+        expect(range.offsetBefore + (range.end - range.start) * 40).toBe(
+            100 * 40 - range.offsetAfter
+        );
+    });
+
+    it('should use measured heights of expanded items', () => {
+        const measured = [...heights];
+        measured[0] = 1000;
+
+        const range = computeVirtualRange(measured, 1000, 400, 0);
+
+        expect(range.start).toBe(1);
+        expect(range.offsetBefore).toBe(1000);
+        expect(range.end).toBe(11);
+    });
+
+    it('should render nothing for an empty list', () => {
+        expect(computeVirtualRange([], 0, 400)).toEqual({
+            start: 0,
+            end: 0,
+            offsetBefore: 0,
+            offsetAfter: 0,
+        });
+    });
+});
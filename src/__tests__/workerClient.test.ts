@@ -0,0 +1,103 @@
+import { describe, it, expect, vi } from 'vitest';
+import {
+    createWorkerClient,
+    handleWorkerRequests,
+} from '../webview/utils/workerClient';
+
+describe('createWorkerClient', () => {
+    it('should run requests on the main thread when the worker cannot start', async () => {
+        const warn = vi.spyOn(console, 'warn').mockImplementation(() => {});
+        const createWorker = vi.fn(() => {
+            throw new Error('Workers are not supported');
+        });
+        const run = createWorkerClient('Test', createWorker, (text: string) =>
+            text.toUpperCase()
+        );
+
+        await expect(run('a')).resolves.toBe('A');
+        await expect(run('b')).resolves.toBe('B');
+        // Not retried after the first failure
+        expect(createWorker).toHaveBeenCalledTimes(1);
+        expect(warn).toHaveBeenCalledTimes(1);
+        warn.mockRestore();
+    });
+
+    it('should send requests to the worker and resolve with its results', async () => {
+        const worker = {
+            onmessage: null as ((event: MessageEvent) => void) | null,
+            onerror: null,
+            postMessage: vi.fn((message: { id: number; request: number }) =>
+                worker.onmessage?.({
+                    data: { id: message.id, result: message.request * 2 },
+                } as MessageEvent)
+            ),
+            terminate: vi.fn(),
+        };
+        const runOnMainThread = vi.fn((value: number) => value);
+        const run = createWorkerClient(
+            'Test',
+            () => worker as unknown as Worker,
+            runOnMainThread
+        );
+
+        await expect(run(21)).resolves.toBe(42);
+        expect(runOnMainThread).not.toHaveBeenCalled();
+    });
+
+    it('should reject requests whose handler throws in the worker', async () => {
+        const scope = {
+            onmessage: null as ((event: MessageEvent) => void) | null,
+            postMessage: vi.fn(),
+        };
+        vi.stubGlobal('self', scope);
+        handleWorkerRequests((value: number) => {
+            if (value < 0) {
+                throw new Error('negative');
+            }
+            return value * 2;
+        });
+        vi.unstubAllGlobals();
+
+        const worker = {
+            onmessage: null as ((event: MessageEvent) => void) | null,
+            onerror: null,
+            postMessage: vi.fn((message: unknown) => {
+                scope.postMessage.mockImplementationOnce((reply: unknown) =>
+                    worker.onmessage?.({ data: reply } as MessageEvent)
+                );
+                scope.onmessage?.({ data: message } as MessageEvent);
+            }),
+            terminate: vi.fn(),
+        };
+        const run = createWorkerClient(
+            'Test',
+            () => worker as unknown as Worker,
+            (value: number) => value
+        );
+
+        await expect(run(-1)).rejects.toThrow('Test failed: negative');
+        // The worker keeps serving later requests
+        await expect(run(21)).resolves.toBe(42);
+        expect(worker.terminate).not.toHaveBeenCalled();
+    });
+
+    it('should reject main thread requests that throw', async () => {
+        const warn = vi.spyOn(console, 'warn').mockImplementation(() => {});
+        const run = createWorkerClient(
+            'Test',
+            () => {
+                throw new Error('Workers are not supported');
+            },
+            (text: string) => {
+                if (!text) {
+                    throw new Error('empty');
+                }
+                return text;
+            }
+        );
+
+        await expect(run('')).rejects.toThrow('empty');
+        await expect(run('a')).resolves.toBe('a');
+        warn.mockRestore();
+    });
+});
@@ -18,6 +18,9 @@ describe('WorkspaceSettingsSchema', () => {
                 expect(result.data.requestTimeoutSeconds).toBe(
                     ANALYSIS_LIMITS.requestTimeoutSeconds.default
                 );
+                expect(result.data.heapBudgetMB).toBe(
+                    ANALYSIS_LIMITS.heapBudgetMB.default
+                );
                 expect(result.data.maxSubagentsPerSession).toBe(
                     SUBAGENT_LIMITS.maxPerSession.default
                 );
@@ -30,6 +33,7 @@ describe('WorkspaceSettingsSchema', () => {
                 preferredModelIdentifier: 'copilot/gpt-4.1',
                 maxIterations: 20,
                 requestTimeoutSeconds: 120,
+                heapBudgetMB: 1024,
                 maxSubagentsPerSession: 15,
                 logLevel: 'debug' as const,
             };
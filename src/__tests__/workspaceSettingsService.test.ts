@@ -4,8 +4,11 @@ import * as fs from 'fs';
 import { WorkspaceSettingsService } from '../services/workspaceSettingsService';
 
 vi.mock('fs', () => ({
-    existsSync: vi.fn(),
-    readFileSync: vi.fn(),
+    promises: {
+        readFile: vi.fn(),
+        writeFile: vi.fn(),
+        mkdir: vi.fn(),
+    },
     writeFileSync: vi.fn(),
     mkdirSync: vi.fn(),
 }));
@@ -42,8 +45,7 @@ describe('WorkspaceSettingsService', () => {
             globalStorageUri: { fsPath: '/global/storage' },
         } as unknown as vscode.ExtensionContext;
 
-        vi.mocked(fs.existsSync).mockReturnValue(true);
-        vi.mocked(fs.readFileSync).mockReturnValue('{}');
+        vi.mocked(fs.promises.readFile).mockResolvedValue('{}');
     });
 
     afterEach(() => {
@@ -52,85 +54,90 @@ describe('WorkspaceSettingsService', () => {
 
     describe('WORKSPACE_ROOT_MARKER functionality', () => {
         describe('setSelectedRepositoryPath', () => {
-            it('should store "." when repo path matches workspace root exactly', () => {
+            it('should store "." when repo path matches workspace root exactly', async () => {
                 (vscode.workspace as any).workspaceFolders = [
                     { uri: { fsPath: '/test/workspace' } },
                 ];
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 service.setSelectedRepositoryPath('/test/workspace');
-                vi.advanceTimersByTime(600); // Trigger debounced save
+                await vi.advanceTimersByTimeAsync(600); // Trigger debounced save
 
-                expect(fs.writeFileSync).toHaveBeenCalledWith(
+                expect(fs.promises.writeFile).toHaveBeenCalledWith(
                     expect.any(String),
                     expect.stringContaining('"selectedRepositoryPath": "."'),
                     'utf-8'
                 );
             });
 
-            it('should store "." when paths differ only in trailing slash', () => {
+            it('should store "." when paths differ only in trailing slash', async () => {
                 (vscode.workspace as any).workspaceFolders = [
                     { uri: { fsPath: '/test/workspace' } },
                 ];
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 service.setSelectedRepositoryPath('/test/workspace/');
-                vi.advanceTimersByTime(600);
+                await vi.advanceTimersByTimeAsync(600);
 
-                expect(fs.writeFileSync).toHaveBeenCalledWith(
+                expect(fs.promises.writeFile).toHaveBeenCalledWith(
                     expect.any(String),
                     expect.stringContaining('"selectedRepositoryPath": "."'),
                     'utf-8'
                 );
             });
 
-            it('should store "." when paths differ only in backslash vs forward slash', () => {
+            it('should store "." when paths differ only in backslash vs forward slash', async () => {
                 (vscode.workspace as any).workspaceFolders = [
                     { uri: { fsPath: 'C:\\test\\workspace' } },
                 ];
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 service.setSelectedRepositoryPath('C:/test/workspace');
-                vi.advanceTimersByTime(600);
+                await vi.advanceTimersByTimeAsync(600);
 
-                expect(fs.writeFileSync).toHaveBeenCalledWith(
+                expect(fs.promises.writeFile).toHaveBeenCalledWith(
                     expect.any(String),
                     expect.stringContaining('"selectedRepositoryPath": "."'),
                     'utf-8'
                 );
             });
 
-            it('should store "." when paths differ in double slashes', () => {
+            it('should store "." when paths differ in double slashes', async () => {
                 (vscode.workspace as any).workspaceFolders = [
                     { uri: { fsPath: '/test/workspace' } },
                 ];
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 service.setSelectedRepositoryPath('/test//workspace');
-                vi.advanceTimersByTime(600);
+                await vi.advanceTimersByTimeAsync(600);
 
-                expect(fs.writeFileSync).toHaveBeenCalledWith(
+                expect(fs.promises.writeFile).toHaveBeenCalledWith(
                     expect.any(String),
                     expect.stringContaining('"selectedRepositoryPath": "."'),
                     'utf-8'
                 );
             });
 
-            it('should store absolute path when repo path differs from workspace root', () => {
+            it('should store absolute path when repo path differs from workspace root', async () => {
                 (vscode.workspace as any).workspaceFolders = [
                     { uri: { fsPath: '/test/workspace' } },
                 ];
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 service.setSelectedRepositoryPath('/other/repo');
-                vi.advanceTimersByTime(600);
+                await vi.advanceTimersByTimeAsync(600);
 
-                expect(fs.writeFileSync).toHaveBeenCalledWith(
+                expect(fs.promises.writeFile).toHaveBeenCalledWith(
                     expect.any(String),
                     expect.stringContaining(
                         '"selectedRepositoryPath": "/other/repo"'
@@ -139,28 +146,31 @@ describe('WorkspaceSettingsService', () => {
                 );
             });
 
-            it('should store undefined when called with undefined', () => {
+            it('should store undefined when called with undefined', async () => {
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 service.setSelectedRepositoryPath(undefined);
-                vi.advanceTimersByTime(600);
+                await vi.advanceTimersByTimeAsync(600);
 
                 // Should not contain selectedRepositoryPath or should have it as null/undefined
-                const writeCall = vi.mocked(fs.writeFileSync).mock.calls[0];
+                const writeCall = vi.mocked(fs.promises.writeFile).mock
+                    .calls[0];
                 const writtenContent = writeCall?.[1] as string;
                 const parsed = JSON.parse(writtenContent);
                 expect(parsed.selectedRepositoryPath).toBeUndefined();
             });
 
-            it('should store absolute path when workspace root is undefined', () => {
+            it('should store absolute path when workspace root is undefined', async () => {
                 (vscode.workspace as any).workspaceFolders = undefined;
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 service.setSelectedRepositoryPath('/some/repo');
-                vi.advanceTimersByTime(600);
+                await vi.advanceTimersByTimeAsync(600);
 
-                expect(fs.writeFileSync).toHaveBeenCalledWith(
+                expect(fs.promises.writeFile).toHaveBeenCalledWith(
                     expect.any(String),
                     expect.stringContaining(
                         '"selectedRepositoryPath": "/some/repo"'
@@ -171,61 +181,65 @@ describe('WorkspaceSettingsService', () => {
         });
 
         describe('getSelectedRepositoryPath', () => {
-            it('should resolve "." back to workspace root path', () => {
+            it('should resolve "." back to workspace root path', async () => {
                 (vscode.workspace as any).workspaceFolders = [
                     { uri: { fsPath: '/test/workspace' } },
                 ];
-                vi.mocked(fs.readFileSync).mockReturnValue(
+                vi.mocked(fs.promises.readFile).mockResolvedValue(
                     JSON.stringify({
                         selectedRepositoryPath: '.',
                     })
                 );
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 expect(service.getSelectedRepositoryPath()).toBe(
                     '/test/workspace'
                 );
             });
 
-            it('should return undefined when "." stored but no workspace folders', () => {
+            it('should return undefined when "." stored but no workspace folders', async () => {
                 (vscode.workspace as any).workspaceFolders = undefined;
-                vi.mocked(fs.readFileSync).mockReturnValue(
+                vi.mocked(fs.promises.readFile).mockResolvedValue(
                     JSON.stringify({
                         selectedRepositoryPath: '.',
                     })
                 );
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 expect(service.getSelectedRepositoryPath()).toBeUndefined();
             });
 
-            it('should return absolute path as-is when not "."', () => {
-                vi.mocked(fs.readFileSync).mockReturnValue(
+            it('should return absolute path as-is when not "."', async () => {
+                vi.mocked(fs.promises.readFile).mockResolvedValue(
                     JSON.stringify({
                         selectedRepositoryPath: '/custom/repo/path',
                     })
                 );
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 expect(service.getSelectedRepositoryPath()).toBe(
                     '/custom/repo/path'
                 );
             });
 
-            it('should return undefined when no path is stored', () => {
-                vi.mocked(fs.readFileSync).mockReturnValue('{}');
+            it('should return undefined when no path is stored', async () => {
+                vi.mocked(fs.promises.readFile).mockResolvedValue('{}');
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 expect(service.getSelectedRepositoryPath()).toBeUndefined();
             });
         });
 
         describe('path normalization edge cases', () => {
-            it('should handle Windows paths with case differences', () => {
+            it('should handle Windows paths with case differences', async () => {
                 // Simulate Windows behavior
                 const originalPlatform = process.platform;
                 Object.defineProperty(process, 'platform', { value: 'win32' });
@@ -236,11 +250,12 @@ describe('WorkspaceSettingsService', () => {
                     ];
 
                     service = new WorkspaceSettingsService(mockContext);
+                    await service.whenLoaded();
 
                     service.setSelectedRepositoryPath('c:\\test\\workspace');
-                    vi.advanceTimersByTime(600);
+                    await vi.advanceTimersByTimeAsync(600);
 
-                    expect(fs.writeFileSync).toHaveBeenCalledWith(
+                    expect(fs.promises.writeFile).toHaveBeenCalledWith(
                         expect.any(String),
                         expect.stringContaining(
                             '"selectedRepositoryPath": "."'
@@ -255,34 +270,36 @@ describe('WorkspaceSettingsService', () => {
                 }
             });
 
-            it('should handle paths with multiple consecutive slashes', () => {
+            it('should handle paths with multiple consecutive slashes', async () => {
                 (vscode.workspace as any).workspaceFolders = [
                     { uri: { fsPath: '/test/workspace' } },
                 ];
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 service.setSelectedRepositoryPath('/test///workspace');
-                vi.advanceTimersByTime(600);
+                await vi.advanceTimersByTimeAsync(600);
 
-                expect(fs.writeFileSync).toHaveBeenCalledWith(
+                expect(fs.promises.writeFile).toHaveBeenCalledWith(
                     expect.any(String),
                     expect.stringContaining('"selectedRepositoryPath": "."'),
                     'utf-8'
                 );
             });
 
-            it('should not match different paths that look similar', () => {
+            it('should not match different paths that look similar', async () => {
                 (vscode.workspace as any).workspaceFolders = [
                     { uri: { fsPath: '/test/workspace' } },
                 ];
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 service.setSelectedRepositoryPath('/test/workspace-other');
-                vi.advanceTimersByTime(600);
+                await vi.advanceTimersByTimeAsync(600);
 
-                expect(fs.writeFileSync).toHaveBeenCalledWith(
+                expect(fs.promises.writeFile).toHaveBeenCalledWith(
                     expect.any(String),
                     expect.stringContaining(
                         '"selectedRepositoryPath": "/test/workspace-other"'
@@ -291,17 +308,18 @@ describe('WorkspaceSettingsService', () => {
                 );
             });
 
-            it('should not match parent directory as workspace root', () => {
+            it('should not match parent directory as workspace root', async () => {
                 (vscode.workspace as any).workspaceFolders = [
                     { uri: { fsPath: '/test/workspace/subdir' } },
                 ];
 
                 service = new WorkspaceSettingsService(mockContext);
+                await service.whenLoaded();
 
                 service.setSelectedRepositoryPath('/test/workspace');
-                vi.advanceTimersByTime(600);
+                await vi.advanceTimersByTimeAsync(600);
 
-                expect(fs.writeFileSync).toHaveBeenCalledWith(
+                expect(fs.promises.writeFile).toHaveBeenCalledWith(
                     expect.any(String),
                     expect.stringContaining(
                         '"selectedRepositoryPath": "/test/workspace"'
@@ -311,4 +329,101 @@ describe('WorkspaceSettingsService', () => {
             });
         });
     });
+
+    describe('loading', () => {
+        it('should write defaults when the settings file does not exist', async () => {
+            (vscode.workspace as any).workspaceFolders = [
+                { uri: { fsPath: '/test/workspace' } },
+            ];
+            vi.mocked(fs.promises.readFile).mockRejectedValue(
+                Object.assign(new Error('not found'), { code: 'ENOENT' })
+            );
+
+            service = new WorkspaceSettingsService(mockContext);
+            await service.whenLoaded();
+
+            expect(fs.promises.mkdir).toHaveBeenCalledWith(
+                expect.stringContaining('.vscode'),
+                { recursive: true }
+            );
+            expect(fs.promises.writeFile).toHaveBeenCalledWith(
+                expect.stringContaining('lupa.json'),
+                expect.any(String),
+                'utf-8'
+            );
+        });
+
+        it('should keep the newest load when reloads overlap', async () => {
+            let finishFirstRead!: (data: string) => void;
+            vi.mocked(fs.promises.readFile)
+                .mockReturnValueOnce(
+                    new Promise((resolve) => {
+                        finishFirstRead = resolve;
+                    })
+                )
+                .mockResolvedValueOnce(
+                    JSON.stringify({ preferredModelIdentifier: 'copilot/new' })
+                );
+
+            service = new WorkspaceSettingsService(mockContext);
+            const onFoldersChanged = vi.mocked(
+                vscode.workspace.onDidChangeWorkspaceFolders
+            ).mock.calls[0]![0] as () => void;
+            onFoldersChanged();
+            finishFirstRead(
+                JSON.stringify({ preferredModelIdentifier: 'copilot/old' })
+            );
+            await service.whenLoaded();
+
+            expect(service.getPreferredModelIdentifier()).toBe('copilot/new');
+        });
+
+        it('should keep values set while a load is in flight', async () => {
+            let finishRead!: (data: string) => void;
+            vi.mocked(fs.promises.readFile).mockReturnValueOnce(
+                new Promise((resolve) => {
+                    finishRead = resolve;
+                })
+            );
+
+            service = new WorkspaceSettingsService(mockContext);
+            service.setPreferredModelIdentifier('copilot/chosen');
+            finishRead(
+                JSON.stringify({
+                    preferredModelIdentifier: 'copilot/stored',
+                    maxIterations: 42,
+                })
+            );
+            await service.whenLoaded();
+
+            expect(service.getPreferredModelIdentifier()).toBe(
+                'copilot/chosen'
+            );
+            expect(service.getMaxIterations()).toBe(42);
+        });
+
+        it('should not touch the disk synchronously', async () => {
+            service = new WorkspaceSettingsService(mockContext);
+            await service.whenLoaded();
+            service.setSelectedRepositoryPath('/other/repo');
+            await vi.advanceTimersByTimeAsync(600);
+
+            expect(fs.writeFileSync).not.toHaveBeenCalled();
+            expect(fs.mkdirSync).not.toHaveBeenCalled();
+        });
+
+        it('should flush a pending save synchronously on dispose', async () => {
+            service = new WorkspaceSettingsService(mockContext);
+            await service.whenLoaded();
+            service.setSelectedRepositoryPath('/other/repo');
+
+            service.dispose();
+
+            expect(fs.writeFileSync).toHaveBeenCalledWith(
+                expect.any(String),
+                expect.stringContaining('/other/repo'),
+                'utf-8'
+            );
+        });
+    });
 });
@@ -3,11 +3,13 @@ import { AnalysisMode } from '../types/modelTypes';
 import type {
     ToolCallsData,
     AnalysisProgressCallback,
+    AnalysisUpdateCallback,
 } from '../types/toolCallTypes';
 import { IServiceRegistry } from '../services/serviceManager';
 import { isCancellationError } from '../utils/asyncUtils';
 import { getErrorMessage } from '../utils/errorUtils';
 import { Log } from '../services/loggingService';
+import type { ChromeTrace } from '../services/performanceTrace';
 
 /**
  * AnalysisOrchestrator handles the core PR analysis workflow.
@@ -16,6 +18,7 @@ import { Log } from '../services/loggingService';
  */
 export class AnalysisOrchestrator implements vscode.Disposable {
     private isAnalysisRunning = false;
+    private lastTrace: ChromeTrace | undefined;
 
     constructor(
         private readonly context: vscode.ExtensionContext,
@@ -133,23 +136,43 @@ export class AnalysisOrchestrator implements vscode.Disposable {
                         cancellationTokenSource.cancel();
                     });
 
+                // Show tool calls and the plan as they happen instead of
+                // waiting minutes for the final result
+                const title = `PR Analysis: ${refName}`;
+                const livePanel = this.services.uiManager.openLiveAnalysis(
+                    title,
+                    diffText
+                );
+
                 try {
                     const updateProgress = (message: string) => {
                         progress.report({ message });
+                        livePanel.updateStatus(message);
                     };
 
                     updateProgress('Starting analysis...');
 
                     const progressCallback: AnalysisProgressCallback =
                         updateProgress;
+                    const onUpdate: AnalysisUpdateCallback = (update) => {
+                        if (update.type === 'toolCall') {
+                            livePanel.appendToolCall(update.call);
+                        } else {
+                            livePanel.updatePlan(update.plan);
+                        }
+                    };
 
                     const result =
                         await this.services.toolCallingAnalysisProvider.analyze(
                             diffText,
                             cancellationTokenSource.token,
-                            progressCallback
+                            progressCallback,
+                            onUpdate
                         );
 
+                    // Kept for cancelled runs too: a slow analysis is often cancelled
+                    this.lastTrace = result.trace;
+
                     if (result.wasCancelled) {
                         throw new vscode.CancellationError();
                     }
@@ -158,20 +181,21 @@ export class AnalysisOrchestrator implements vscode.Disposable {
                     const toolCallsData: ToolCallsData | undefined =
                         result.toolCalls;
 
-                    // Display results in webview
-                    const title = `PR Analysis: ${refName}`;
-                    this.services.uiManager.displayAnalysisResults(
-                        title,
-                        diffText,
-                        analysis,
-                        toolCallsData
-                    );
+                    // Display results in the panel that showed progress
+                    livePanel.complete(analysis, toolCallsData);
 
                     this.services.statusBar.showTemporaryMessage(
                         'Analysis complete',
                         3000,
                         'check'
                     );
+                } catch (error) {
+                    livePanel.stop(
+                        isCancellationError(error)
+                            ? 'Analysis cancelled'
+                            : `Analysis failed: ${getErrorMessage(error)}`
+                    );
+                    throw error;
                 } finally {
                     progressCancellationDisposable.dispose();
                     cancellationTokenSource.dispose();
@@ -180,6 +204,44 @@ export class AnalysisOrchestrator implements vscode.Disposable {
         );
     }
 
+    /**
+     * Save the performance trace of the last analysis as Chrome trace-event JSON
+     */
+    public async exportLastTrace(): Promise<void> {
+        if (!this.lastTrace) {
+            vscode.window.showInformationMessage(
+                'No analysis trace available. Run an analysis first.'
+            );
+            return;
+        }
+
+        const trace = this.lastTrace;
+        const startedAt = String(trace.otherData.startedAt ?? Date.now());
+        const fileName = `lupa-trace-${startedAt.replace(/[:.]/g, '-')}.json`;
+        const folder = vscode.workspace.workspaceFolders?.[0]?.uri;
+        const uri = await vscode.window.showSaveDialog({
+            defaultUri: folder
+                ? vscode.Uri.joinPath(folder, fileName)
+                : undefined,
+            filters: { 'Trace Files': ['json'] },
+            saveLabel: 'Export Trace',
+        });
+        if (!uri) {
+            return;
+        }
+
+        await vscode.workspace.fs.writeFile(
+            uri,
+            Buffer.from(JSON.stringify(trace), 'utf8')
+        );
+        Log.info(
+            `Exported analysis trace (${trace.traceEvents.length} events) to ${uri.fsPath}`
+        );
+        vscode.window.showInformationMessage(
+            `Trace saved to ${uri.fsPath}. Open it in https://ui.perfetto.dev or chrome://tracing.`
+        );
+    }
+
     /**
      * Get analysis options from user
      */
@@ -3,6 +3,7 @@ import { AnalysisOrchestrator } from './analysisOrchestrator';
 import { CopilotModelCoordinator } from './copilotModelCoordinator';
 import { IServiceRegistry } from '../services/serviceManager';
 import { ANALYSIS_LIMITS } from '../models/workspaceSettingsSchema';
+import { Log } from '../services/loggingService';
 
 /**
  * CommandRegistry handles all VS Code command registration.
@@ -27,6 +28,14 @@ export class CommandRegistry implements vscode.Disposable {
             this.analysisOrchestrator.analyzePR()
         );
 
+        this.registerCommand('lupa.exportAnalysisTrace', () =>
+            this.analysisOrchestrator.exportLastTrace()
+        );
+
+        this.registerCommand('lupa.exportToolMetrics', () =>
+            this.exportToolMetrics()
+        );
+
         // Copilot language model commands
         this.registerCommand('lupa.selectLanguageModel', () =>
             this.copilotModelCoordinator.showCopilotModelSelectionOptions()
@@ -64,6 +73,39 @@ export class CommandRegistry implements vscode.Disposable {
         );
     }
 
+    /**
+     * Save per-tool latency, response size and failure statistics as JSON
+     */
+    private async exportToolMetrics(): Promise<void> {
+        const snapshot = this.services.toolMetrics.getSnapshot();
+        if (snapshot.totalCalls === 0) {
+            vscode.window.showInformationMessage(
+                'No tool calls recorded yet. Run an analysis first.'
+            );
+            return;
+        }
+
+        const folder = vscode.workspace.workspaceFolders?.[0]?.uri;
+        const uri = await vscode.window.showSaveDialog({
+            defaultUri: folder
+                ? vscode.Uri.joinPath(folder, 'lupa-tool-metrics.json')
+                : undefined,
+            filters: { 'JSON Files': ['json'] },
+            saveLabel: 'Export Tool Metrics',
+        });
+        if (!uri) {
+            return;
+        }
+
+        await vscode.workspace.fs.writeFile(
+            uri,
+            Buffer.from(JSON.stringify(snapshot, null, 2), 'utf8')
+        );
+        Log.info(
+            `Exported metrics for ${snapshot.tools.length} tools (${snapshot.totalCalls} calls) to ${uri.fsPath}`
+        );
+    }
+
     /**
      * Allow user to manually select a different Git repository
      */
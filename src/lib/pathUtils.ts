@@ -207,8 +207,16 @@ export interface MarkdownSegment {
  * @returns Array of segments alternating between text and file links
  */
 export function parseMarkdownFileLinks(markdown: string): MarkdownSegment[] {
-    const segments: MarkdownSegment[] = [];
+    return Array.from(iterateMarkdownFileLinks(markdown));
+}
 
+/**
+ * Lazy form of parseMarkdownFileLinks: yields segments in a single pass as
+ * the markdown is scanned, so a caller can start writing before the end.
+ */
+export function* iterateMarkdownFileLinks(
+    markdown: string
+): Generator<MarkdownSegment> {
     // Match markdown links: [title](url)
     const linkRegex = /\[([^\]]+)\]\(([^)]+)\)/g;
     let lastIndex = 0;
@@ -223,15 +231,15 @@ export function parseMarkdownFileLinks(markdown: string): MarkdownSegment[] {
 
         // Add text before this match
         if (match.index > lastIndex) {
-            segments.push({
+            yield {
                 type: 'text',
                 content: markdown.slice(lastIndex, match.index),
-            });
+            };
         }
 
         if (parsedPath) {
             // This is a file link
-            segments.push({
+            yield {
                 type: 'fileLink',
                 content: fullMatch,
                 filePath: parsedPath.filePath,
@@ -239,13 +247,13 @@ export function parseMarkdownFileLinks(markdown: string): MarkdownSegment[] {
                 endLine: parsedPath.endLine,
                 column: parsedPath.column,
                 title,
-            });
+            };
         } else {
             // Not a file link, keep as text (regular markdown link)
-            segments.push({
+            yield {
                 type: 'text',
                 content: fullMatch,
-            });
+            };
         }
 
         lastIndex = match.index + fullMatch.length;
@@ -253,11 +261,9 @@ export function parseMarkdownFileLinks(markdown: string): MarkdownSegment[] {
 
     // Add remaining text after last match
     if (lastIndex < markdown.length) {
-        segments.push({
+        yield {
             type: 'text',
             content: markdown.slice(lastIndex),
-        });
+        };
     }
-
-    return segments;
 }
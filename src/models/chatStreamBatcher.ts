@@ -0,0 +1,118 @@
+import * as vscode from 'vscode';
+
+type ChatStreamPart =
+    | { kind: 'markdown'; value: string }
+    | { kind: 'anchor'; target: vscode.Uri | vscode.Location; title?: string }
+    | { kind: 'progress'; value: string };
+
+/**
+ * Coalesces writes to a chat response stream into at most one flush per
+ * frame, so bursts of events (e.g. parallel subagents starting and finishing
+ * tools) don't flood the chat renderer.
+ *
+ * Writes keep their order. Within a frame, adjacent markdown writes are
+ * joined into one part and adjacent progress messages collapse to the
+ * latest; anchors are kept as they are. A write after a quiet frame is sent
+ * immediately.
+ *
+ * Call `flush()` before writing to the underlying stream directly, and
+ * `dispose()` when the response is complete: later writes are dropped.
+ */
+export class ChatStreamBatcher implements vscode.Disposable {
+    private readonly queue: ChatStreamPart[] = [];
+    private timer: ReturnType<typeof setTimeout> | undefined;
+    private lastFlushTime = 0;
+    private disposed = false;
+
+    /**
+     * @param stream The chat response stream to write to
+     * @param frameMs Minimum time between flushes
+     */
+    constructor(
+        private readonly stream: Pick<
+            vscode.ChatResponseStream,
+            'markdown' | 'anchor' | 'progress'
+        >,
+        private readonly frameMs = 50
+    ) {}
+
+    markdown(value: string): void {
+        if (this.disposed) {
+            return;
+        }
+        const last = this.queue.at(-1);
+        if (last?.kind === 'markdown') {
+            last.value += value;
+        } else {
+            this.queue.push({ kind: 'markdown', value });
+        }
+        this.schedule();
+    }
+
+    anchor(target: vscode.Uri | vscode.Location, title?: string): void {
+        if (this.disposed) {
+            return;
+        }
+        this.queue.push({ kind: 'anchor', target, title });
+        this.schedule();
+    }
+
+    progress(value: string): void {
+        if (this.disposed) {
+            return;
+        }
+        const last = this.queue.at(-1);
+        if (last?.kind === 'progress') {
+            last.value = value;
+        } else {
+            this.queue.push({ kind: 'progress', value });
+        }
+        this.schedule();
+    }
+
+    /** Write everything queued now */
+    flush(): void {
+        if (this.timer) {
+            clearTimeout(this.timer);
+            this.timer = undefined;
+        }
+        this.lastFlushTime = Date.now();
+
+        const parts = this.queue.splice(0);
+        for (const part of parts) {
+            switch (part.kind) {
+                case 'markdown':
+                    this.stream.markdown(part.value);
+                    break;
+                case 'anchor':
+                    this.stream.anchor(part.target, part.title);
+                    break;
+                case 'progress':
+                    this.stream.progress(part.value);
+                    break;
+            }
+        }
+    }
+
+    /** Flush what is queued and ignore further writes */
+    dispose(): void {
+        if (this.disposed) {
+            return;
+        }
+        this.flush();
+        this.disposed = true;
+    }
+
+    private schedule(): void {
+        if (this.timer) {
+            return;
+        }
+
+        const wait = this.lastFlushTime + this.frameMs - Date.now();
+        if (wait <= 0) {
+            this.flush();
+        } else {
+            this.timer = setTimeout(() => this.flush(), wait);
+        }
+    }
+}
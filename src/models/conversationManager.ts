@@ -68,6 +68,21 @@ export class ConversationManager {
         return this.messages.length;
     }
 
+    /**
+     * Total characters of message content and tool call arguments, for
+     * memory accounting. Does not clone the history.
+     */
+    getContentLength(): number {
+        let chars = 0;
+        for (const message of this.messages) {
+            chars += message.content?.length ?? 0;
+            for (const toolCall of message.toolCalls ?? []) {
+                chars += toolCall.function?.arguments?.length ?? 0;
+            }
+        }
+        return chars;
+    }
+
     /**
      * Clear all messages from the conversation history.
      */
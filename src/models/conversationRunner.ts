@@ -1,16 +1,33 @@
 import * as vscode from 'vscode';
 import { ConversationManager } from './conversationManager';
-import { ToolExecutor, type ToolExecutionRequest } from './toolExecutor';
+import {
+    ToolExecutor,
+    type ToolExecutionRequest,
+    type ToolExecutionResult,
+} from './toolExecutor';
+import { isReadOnlyTool } from './toolConstants';
 import { ILLMClient } from './ILLMClient';
 import { CopilotApiError } from './copilotModelManager';
 import { TokenValidator } from './tokenValidator';
-import type { ToolCallMessage, ToolCall } from '../types/modelTypes';
+import { TokenConstants } from './tokenConstants';
+import {
+    categorizePromptTokens,
+    reconcileTokenCounts,
+} from './tokenBreakdown';
+import type {
+    ToolCallMessage,
+    ToolCall,
+    ToolCallResponse,
+} from '../types/modelTypes';
 import type { ToolResultMetadata } from '../types/toolResultTypes';
+import type { IterationTokenUsage } from '../types/toolCallTypes';
 import { Log } from '../services/loggingService';
+import { Trace } from '../services/performanceTrace';
 import { ITool } from '../tools/ITool';
 import { extractReviewFromMalformedToolCall } from '../utils/reviewExtractionUtils';
 import { isCancellationError } from '../utils/asyncUtils';
 import { getErrorMessage } from '../utils/errorUtils';
+import { fingerprintPromptPrefix } from '../utils/promptPrefix';
 
 /**
  * Configuration for running a conversation loop.
@@ -33,6 +50,12 @@ export interface ConversationRunnerConfig {
      * Subagents and exploration modes can complete with direct responses.
      */
     requiresExplicitCompletion?: boolean;
+    /**
+     * Optional cap on prompt tokens sent across all iterations.
+     * Once the next request would exceed it, the runner asks for a final answer
+     * without tools and returns it. Used for budgeted subagents.
+     */
+    tokenBudget?: number;
 }
 
 /**
@@ -65,6 +88,45 @@ export interface ToolCallHandler {
 
     /** Called when a conversation iteration starts */
     onIterationStart?: (current: number, max: number) => void;
+
+    /**
+     * Called before each request that is within the context window. Return
+     * true to evict old tool interactions anyway, down to
+     * TokenConstants.MEMORY_COMPACTION_UTILIZATION (e.g., under memory pressure).
+     * Unlike a full context, this doesn't ask the model to finish.
+     */
+    shouldCompactContext?: () => boolean;
+}
+
+/**
+ * Wall-clock time spent in each phase of the last run(), in milliseconds.
+ * Time not covered here is the runner's own bookkeeping.
+ */
+export interface ConversationPhaseTimings {
+    /** Building request messages from the conversation history */
+    messagePreparationMs: number;
+    /** Token counting and context cleanup */
+    tokenAccountingMs: number;
+    /** Waiting for client.sendRequest (includes the client's message conversion) */
+    llmWaitMs: number;
+    /** Waiting for tool results after the response; excludes work overlapped with streaming */
+    toolExecutionMs: number;
+}
+
+/**
+ * What the current run() has left, for sizing work it delegates (subagents).
+ */
+export interface ConversationBudget {
+    /** Iterations left before maxIterations */
+    iterations: number;
+    /** Prompt tokens left under tokenBudget; undefined when the run has none */
+    tokens: number | undefined;
+    /**
+     * How much longer the run lasts if the remaining iterations take as long
+     * as the ones so far. An upper bound: runs rarely use every iteration, so
+     * consumers also cap it by their own deadline.
+     */
+    timeMs: number;
 }
 
 /**
@@ -89,6 +151,13 @@ export class ConversationRunner {
     private tokenValidator: TokenValidator | null = null;
     private _hitMaxIterations = false;
     private _wasCancelled = false;
+    private _iterationsUsed = 0;
+    private _tokensUsed = 0;
+    private _tokenUsage: IterationTokenUsage[] = [];
+    private _phaseTimings: ConversationPhaseTimings = emptyPhaseTimings();
+    private _maxIterations = 0;
+    private _tokenBudget: number | undefined;
+    private _runStartedAt = 0;
 
     constructor(
         private readonly client: ILLMClient,
@@ -105,6 +174,46 @@ export class ConversationRunner {
         return this._wasCancelled;
     }
 
+    /** Iterations started by the last run(). */
+    get iterationsUsed(): number {
+        return this._iterationsUsed;
+    }
+
+    /** Estimated prompt tokens sent by the last run(). */
+    get tokensUsed(): number {
+        return this._tokensUsed;
+    }
+
+    /** Prompt tokens of each request in the last run(), by category. */
+    get tokenUsage(): IterationTokenUsage[] {
+        return [...this._tokenUsage];
+    }
+
+    /** Per-phase wall-clock time of the last run(). */
+    get phaseTimings(): ConversationPhaseTimings {
+        return { ...this._phaseTimings };
+    }
+
+    /** Budget the current run() has left; read while it is running. */
+    get remainingBudget(): ConversationBudget {
+        const iterations = Math.max(
+            0,
+            this._maxIterations - this._iterationsUsed
+        );
+        const msPerIteration =
+            this._iterationsUsed > 0
+                ? (Date.now() - this._runStartedAt) / this._iterationsUsed
+                : 0;
+        return {
+            iterations,
+            tokens:
+                this._tokenBudget === undefined
+                    ? undefined
+                    : Math.max(0, this._tokenBudget - this._tokensUsed),
+            timeMs: Math.round(iterations * msPerIteration),
+        };
+    }
+
     /**
      * Execute a conversation loop until completion or max iterations.
      * @returns The final response content from the LLM
@@ -121,9 +230,21 @@ export class ConversationRunner {
         const logPrefix = config.label ? `[${config.label}]` : '[Conversation]';
         this._hitMaxIterations = false;
         this._wasCancelled = false;
+        this._iterationsUsed = 0;
+        this._tokensUsed = 0;
+        this._tokenUsage = [];
+        this._phaseTimings = emptyPhaseTimings();
+        this._maxIterations = config.maxIterations;
+        this._tokenBudget = config.tokenBudget;
+        this._runStartedAt = Date.now();
+
+        // Built once so tool schemas are byte-identical on every request (prompt-cache prefix)
+        const vscodeTools = config.tools.map((tool) => tool.getVSCodeTool());
+        let previousPrefixHash: string | undefined;
 
         while (iteration < config.maxIterations) {
             iteration++;
+            this._iterationsUsed = iteration;
             Log.info(
                 `${logPrefix} Iteration ${iteration}/${config.maxIterations}`
             );
@@ -137,11 +258,12 @@ export class ConversationRunner {
             }
 
             handler?.onIterationStart?.(iteration, config.maxIterations);
+            const iterationSpan = Trace.span(
+                `Iteration ${iteration}`,
+                'iteration'
+            );
 
             try {
-                const vscodeTools = config.tools.map((tool) =>
-                    tool.getVSCodeTool()
-                );
                 let messages = this.prepareMessagesForLLM(
                     config.systemPrompt,
                     conversation
@@ -154,10 +276,23 @@ export class ConversationRunner {
                 }
 
                 // Validate token count and handle context limits
+                let phaseStart = performance.now();
+                const validationSpan = Trace.span('validateTokens', 'tokens');
+                const validatedMessages = messages.slice(1); // Exclude system prompt
                 const validation = await this.tokenValidator.validateTokens(
-                    messages.slice(1), // Exclude system prompt from validation
+                    validatedMessages,
                     config.systemPrompt
                 );
+                validationSpan.end({
+                    totalTokens: validation.totalTokens,
+                    action: validation.suggestedAction,
+                });
+                this.addPhaseTime('tokenAccountingMs', phaseStart);
+
+                // Aligned with messages.slice(1); notices appended below stay uncounted
+                let sentTokenCounts: (number | undefined)[] =
+                    validation.messageTokens;
+                let evictedTokens = 0;
 
                 if (validation.suggestedAction === 'request_final_answer') {
                     conversation.addUserMessage(
@@ -168,12 +303,35 @@ export class ConversationRunner {
                         conversation
                     );
                 } else if (
-                    validation.suggestedAction === 'remove_old_context'
+                    validation.suggestedAction === 'remove_old_context' ||
+                    handler?.shouldCompactContext?.()
                 ) {
+                    // Memory compaction still has context left, so the model
+                    // must not be told to wrap up
+                    const contextFull =
+                        validation.suggestedAction === 'remove_old_context';
+                    phaseStart = performance.now();
+                    const cleanupSpan = Trace.span('cleanupContext', 'tokens');
                     const cleanup = await this.tokenValidator.cleanupContext(
-                        messages.slice(1),
-                        config.systemPrompt
+                        validatedMessages,
+                        config.systemPrompt,
+                        contextFull
+                            ? undefined
+                            : TokenConstants.MEMORY_COMPACTION_UTILIZATION,
+                        contextFull
                     );
+                    cleanupSpan.end({
+                        toolResultsRemoved: cleanup.toolResultsRemoved,
+                        assistantMessagesRemoved:
+                            cleanup.assistantMessagesRemoved,
+                    });
+                    this.addPhaseTime('tokenAccountingMs', phaseStart);
+                    ({ tokenCounts: sentTokenCounts, evicted: evictedTokens } =
+                        reconcileTokenCounts(
+                            validatedMessages,
+                            validation.messageTokens,
+                            cleanup.cleanedMessages
+                        ));
 
                     // Rebuild conversation with cleaned messages
                     conversation.clearHistory();
@@ -198,20 +356,112 @@ export class ConversationRunner {
                         conversation
                     );
 
-                    if (cleanup.contextFullMessageAdded) {
+                    if (
+                        cleanup.toolResultsRemoved > 0 ||
+                        cleanup.assistantMessagesRemoved > 0
+                    ) {
                         Log.info(
                             `${logPrefix} Context cleanup: removed ${cleanup.toolResultsRemoved} tool results and ${cleanup.assistantMessagesRemoved} assistant messages`
                         );
                     }
                 }
 
-                const response = await this.client.sendRequest(
-                    {
-                        messages,
-                        tools: vscodeTools,
-                    },
-                    token
+                // Always allow the first request so a budget can't yield an empty run
+                const tokenBudgetExhausted =
+                    config.tokenBudget !== undefined &&
+                    this._tokensUsed > 0 &&
+                    this._tokensUsed + validation.totalTokens >
+                        config.tokenBudget;
+                if (tokenBudgetExhausted) {
+                    Log.warn(
+                        `${logPrefix} Token budget (${config.tokenBudget}) exhausted after ${this._tokensUsed} tokens, requesting final answer`
+                    );
+                    conversation.addUserMessage(
+                        'Your token budget is used up. Provide your final answer now based on the information you have gathered so far.'
+                    );
+                    messages = this.prepareMessagesForLLM(
+                        config.systemPrompt,
+                        conversation
+                    );
+                }
+                this._tokensUsed += validation.totalTokens;
+                this._tokenUsage.push(
+                    categorizePromptTokens(
+                        iteration,
+                        validation.systemTokens,
+                        messages.slice(1),
+                        sentTokenCounts,
+                        evictedTokens
+                    )
+                );
+
+                const requestTools = tokenBudgetExhausted ? [] : vscodeTools;
+                const prefix = fingerprintPromptPrefix(messages, requestTools);
+                Log.info(
+                    `${logPrefix} Prompt prefix ${prefix.hash} (${prefix.chars} chars)` +
+                        (previousPrefixHash && previousPrefixHash !== prefix.hash
+                            ? ' - changed since last request'
+                            : '')
                 );
+                previousPrefixHash = prefix.hash;
+
+                // Read-only tools are started as soon as the stream yields them,
+                // overlapping their I/O with the rest of the model's response
+                const earlyDispatched = new Map<
+                    string,
+                    Promise<ToolExecutionResult>
+                >();
+                // When each tool call arrived, so tool spans can show time spent queued
+                const toolCallArrivals = new Map<string, number>();
+                phaseStart = performance.now();
+                const requestStart = phaseStart;
+                const requestSpan = Trace.span('LLM request', 'llm', {
+                    messages: messages.length,
+                    promptTokens: validation.totalTokens,
+                });
+                const requestSpanArgs: Record<string, unknown> = {};
+                let response: ToolCallResponse;
+                try {
+                    response = await this.client.sendRequest(
+                        {
+                            messages,
+                            tools: requestTools,
+                            onToolCall: (toolCall) => {
+                                toolCallArrivals.set(
+                                    toolCall.id,
+                                    performance.now()
+                                );
+                                this.dispatchEarly(
+                                    toolCall,
+                                    earlyDispatched,
+                                    toolCallArrivals.size - 1,
+                                    handler,
+                                    logPrefix
+                                );
+                            },
+                            onFirstChunk: () => {
+                                requestSpanArgs.timeToFirstTokenMs =
+                                    Math.round(
+                                        performance.now() - requestStart
+                                    );
+                                Trace.instant('First token', 'llm');
+                            },
+                        },
+                        token
+                    );
+                } catch (error) {
+                    // The failed response is discarded, so tools it started
+                    // shouldn't use up the rate limit for the retry
+                    if (earlyDispatched.size > 0) {
+                        this.toolExecutor.releaseToolCalls(
+                            earlyDispatched.size
+                        );
+                    }
+                    throw error;
+                } finally {
+                    requestSpan.end(requestSpanArgs);
+                }
+                this.addPhaseTime('llmWaitMs', phaseStart);
 
                 if (token.isCancellationRequested) {
                     Log.info(`${logPrefix} Cancelled by user`);
@@ -234,16 +484,27 @@ export class ConversationRunner {
                     return '';
                 }
 
+                if (tokenBudgetExhausted) {
+                    return (
+                        response.content ||
+                        'Token budget exhausted before a final answer was produced.'
+                    );
+                }
+
                 if (response.toolCalls && response.toolCalls.length > 0) {
                     // Reset nudge counter - model is cooperating with tool calls
                     completionNudgeCount = 0;
 
+                    phaseStart = performance.now();
                     const result = await this.handleToolCalls(
                         response.toolCalls,
                         conversation,
                         handler,
-                        logPrefix
+                        logPrefix,
+                        earlyDispatched,
+                        toolCallArrivals
                     );
+                    this.addPhaseTime('toolExecutionMs', phaseStart);
 
                     // Check cancellation after tool execution completes —
                     // tools may finish normally even when the token fires mid-execution
@@ -373,6 +634,8 @@ export class ConversationRunner {
                     this._hitMaxIterations = true;
                     return errorMessage;
                 }
+            } finally {
+                iterationSpan.end();
             }
         }
 
@@ -467,6 +730,7 @@ export class ConversationRunner {
         systemPrompt: string,
         conversation: ConversationManager
     ): ToolCallMessage[] {
+        const start = performance.now();
         const messages: ToolCallMessage[] = [
             {
                 role: 'system',
@@ -486,48 +750,111 @@ export class ConversationRunner {
             });
         }
 
+        this.addPhaseTime('messagePreparationMs', start);
         return messages;
     }
 
+    private addPhaseTime(
+        phase: keyof ConversationPhaseTimings,
+        start: number
+    ): void {
+        this._phaseTimings[phase] += performance.now() - start;
+    }
+
+    /**
+     * Start a read-only tool while the rest of the response is still streaming.
+     * Tools with side effects or ordering requirements (submit_review, update_plan,
+     * run_subagent) still wait for the complete response.
+     * The handler is notified here; the final response's total isn't known yet,
+     * so totalTools is the number of calls streamed so far.
+     */
+    private dispatchEarly(
+        toolCall: ToolCall,
+        dispatched: Map<string, Promise<ToolExecutionResult>>,
+        index: number,
+        handler: ToolCallHandler | undefined,
+        logPrefix: string
+    ): void {
+        if (
+            !toolCall.id ||
+            dispatched.has(toolCall.id) ||
+            !isReadOnlyTool(toolCall.function.name)
+        ) {
+            return;
+        }
+
+        const args = this.parseToolArgs(toolCall, logPrefix);
+        handler?.onToolCallStart?.(
+            toolCall.function.name,
+            args,
+            index,
+            index + 1
+        );
+        const pending = this.toolExecutor.executeTool(
+            toolCall.function.name,
+            args,
+            performance.now()
+        );
+        // If the request fails after dispatch, the result is discarded unobserved
+        pending.catch(() => {});
+        dispatched.set(toolCall.id, pending);
+    }
+
+    private parseToolArgs(
+        call: ToolCall,
+        logPrefix: string
+    ): Record<string, unknown> {
+        try {
+            return JSON.parse(call.function.arguments);
+        } catch (error) {
+            Log.error(
+                `${logPrefix} Failed to parse args for ${call.function.name}: ${call.function.arguments}`,
+                error
+            );
+            return {};
+        }
+    }
+
     /**
      * Execute tool calls and add results to conversation.
+     * Calls already started by dispatchEarly() are awaited rather than re-run.
      * @returns Object with finalReview if submit_review was called
      */
     private async handleToolCalls(
         toolCalls: ToolCall[],
         conversation: ConversationManager,
         handler?: ToolCallHandler,
-        logPrefix = '[Conversation]'
+        logPrefix = '[Conversation]',
+        earlyDispatched?: Map<string, Promise<ToolExecutionResult>>,
+        toolCallArrivals?: Map<string, number>
     ): Promise<HandleToolCallsResult> {
         // Log which tools are being called
         const toolNames = toolCalls.map((tc) => tc.function.name).join(', ');
+        const earlyCount = earlyDispatched?.size ?? 0;
         Log.info(
-            `${logPrefix} Executing ${toolCalls.length} tool(s): ${toolNames}`
+            `${logPrefix} Executing ${toolCalls.length} tool(s): ${toolNames}` +
+                (earlyCount > 0
+                    ? ` (${earlyCount} started while streaming)`
+                    : '')
         );
 
         // Pre-parse arguments for all tool calls before notifying handlers
-        const toolRequests: ToolExecutionRequest[] = toolCalls.map((call) => {
-            let parsedArgs: Record<string, unknown> = {};
-
-            try {
-                parsedArgs = JSON.parse(call.function.arguments);
-            } catch (error) {
-                Log.error(
-                    `${logPrefix} Failed to parse args for ${call.function.name}: ${call.function.arguments}`,
-                    error
-                );
-            }
-
-            return {
-                name: call.function.name,
-                args: parsedArgs,
-            };
-        });
-
-        // Notify handler about tool calls starting (with parsed args for message formatting)
+        const responseReceivedAt = performance.now();
+        const toolRequests: ToolExecutionRequest[] = toolCalls.map((call) => ({
+            name: call.function.name,
+            args: this.parseToolArgs(call, logPrefix),
+            pending: call.id ? earlyDispatched?.get(call.id) : undefined,
+            queuedAt: toolCallArrivals?.get(call.id) ?? responseReceivedAt,
+        }));
+
+        // Notify handler about tool calls starting (with parsed args for message formatting).
+        // Early-dispatched calls were already announced by dispatchEarly()
         for (let i = 0; i < toolCalls.length; i++) {
             const toolCall = toolCalls[i]!;
             const toolRequest = toolRequests[i]!;
+            if (toolRequest.pending) {
+                continue;
+            }
             handler?.onToolCallStart?.(
                 toolCall.function.name,
                 toolRequest.args as Record<string, unknown>,
@@ -597,5 +924,21 @@ export class ConversationRunner {
         this.tokenValidator = null;
         this._hitMaxIterations = false;
         this._wasCancelled = false;
+        this._iterationsUsed = 0;
+        this._tokensUsed = 0;
+        this._tokenUsage = [];
+        this._phaseTimings = emptyPhaseTimings();
+        this._maxIterations = 0;
+        this._tokenBudget = undefined;
+        this._runStartedAt = 0;
     }
 }
+
+function emptyPhaseTimings(): ConversationPhaseTimings {
+    return {
+        messagePreparationMs: 0,
+        tokenAccountingMs: 0,
+        llmWaitMs: 0,
+        toolExecutionMs: 0,
+    };
+}
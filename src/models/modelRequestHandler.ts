@@ -211,7 +211,9 @@ export class ModelRequestHandler {
                 model,
                 messages,
                 options,
-                linkedTokenSource.token
+                linkedTokenSource.token,
+                request.onToolCall,
+                request.onFirstChunk
             );
             // Suppress late rejections from stream consumption if timeout/cancellation wins the race.
             // Must be attached before any early throws to prevent unhandled rejections.
@@ -242,17 +244,21 @@ export class ModelRequestHandler {
     /**
      * Internal method that sends the request and consumes the entire response stream.
      * Separated from sendRequest to allow the entire operation to be wrapped in timeout.
+     * Each tool call is reported via `onToolCall` as soon as its part arrives.
      */
     private static async sendAndConsumeStream(
         model: vscode.LanguageModelChat,
         messages: vscode.LanguageModelChatMessage[],
         options: vscode.LanguageModelChatRequestOptions,
-        token: vscode.CancellationToken
+        token: vscode.CancellationToken,
+        onToolCall?: (toolCall: ToolCall) => void,
+        onFirstChunk?: () => void
     ): Promise<ToolCallResponse> {
         const response = await model.sendRequest(messages, options, token);
 
         let responseText = '';
         const toolCalls: ToolCall[] = [];
+        let firstChunk = true;
 
         for await (const chunk of response.stream) {
             // Check cancellation between chunks for responsive cancellation
@@ -261,16 +267,23 @@ export class ModelRequestHandler {
                 throw new vscode.CancellationError();
             }
 
+            if (firstChunk) {
+                firstChunk = false;
+                onFirstChunk?.();
+            }
+
             if (chunk instanceof vscode.LanguageModelTextPart) {
                 responseText += chunk.value;
             } else if (chunk instanceof vscode.LanguageModelToolCallPart) {
-                toolCalls.push({
+                const toolCall: ToolCall = {
                     id: chunk.callId,
                     function: {
                         name: chunk.name,
                         arguments: JSON.stringify(chunk.input),
                     },
-                });
+                };
+                toolCalls.push(toolCall);
+                onToolCall?.(toolCall);
             }
         }
 
@@ -0,0 +1,121 @@
+import type { ToolCallMessage } from '../types/modelTypes';
+import type {
+    IterationTokenUsage,
+    SubagentTokenUsage,
+    TokenBreakdown,
+} from '../types/toolCallTypes';
+import { TokenConstants } from './tokenConstants';
+
+/**
+ * Split the prompt tokens of one request by message category.
+ *
+ * @param messages Messages sent after the system prompt
+ * @param tokenCounts Counts from TokenValidator.validateTokens, aligned with
+ *   messages. Messages added after validation (e.g., the context-full notice)
+ *   have no count and are estimated from their length instead.
+ * @param evicted Tokens removed by context cleanup before this request
+ */
+export function categorizePromptTokens(
+    iteration: number,
+    systemTokens: number,
+    messages: readonly ToolCallMessage[],
+    tokenCounts: readonly (number | undefined)[],
+    evicted: number
+): IterationTokenUsage {
+    const toolNames = new Map<string, string>();
+    for (const message of messages) {
+        for (const call of message.toolCalls ?? []) {
+            toolNames.set(call.id, call.function.name);
+        }
+    }
+
+    const usage: IterationTokenUsage = {
+        iteration,
+        system: systemTokens,
+        prompt: 0,
+        assistant: 0,
+        toolResults: {},
+        other: 0,
+        total: systemTokens,
+        evicted,
+    };
+    let promptSeen = false;
+
+    for (const [index, message] of messages.entries()) {
+        const tokens = tokenCounts[index] ?? estimateTokens(message);
+        usage.total += tokens;
+
+        if (message.role === 'assistant') {
+            usage.assistant += tokens;
+        } else if (message.role === 'tool') {
+            const toolName =
+                toolNames.get(message.toolCallId ?? '') ?? 'unknown';
+            usage.toolResults[toolName] =
+                (usage.toolResults[toolName] ?? 0) + tokens;
+        } else if (message.role === 'user' && !promptSeen) {
+            usage.prompt += tokens;
+            promptSeen = true;
+        } else {
+            usage.other += tokens;
+        }
+    }
+
+    return usage;
+}
+
+/**
+ * Carry validated token counts over to the messages kept by context cleanup.
+ * Cleanup returns the original message objects, so counts follow identity.
+ * @returns Counts aligned with `after`, and the tokens of dropped messages
+ */
+export function reconcileTokenCounts(
+    before: readonly ToolCallMessage[],
+    beforeCounts: readonly number[],
+    after: readonly ToolCallMessage[]
+): { tokenCounts: (number | undefined)[]; evicted: number } {
+    const counts = new Map<ToolCallMessage, number>();
+    for (const [index, message] of before.entries()) {
+        counts.set(message, beforeCounts[index] ?? 0);
+    }
+    const kept = new Set(after);
+    let evicted = 0;
+    for (const [message, tokens] of counts) {
+        if (!kept.has(message)) {
+            evicted += tokens;
+        }
+    }
+    return {
+        tokenCounts: after.map((message) => counts.get(message)),
+        evicted,
+    };
+}
+
+export function buildTokenBreakdown(
+    maxInputTokens: number,
+    iterations: IterationTokenUsage[],
+    subagents: SubagentTokenUsage[]
+): TokenBreakdown {
+    let totalPromptTokens = 0;
+    let evictedTokens = 0;
+    for (const usage of iterations) {
+        totalPromptTokens += usage.total;
+        evictedTokens += usage.evicted;
+    }
+    return {
+        maxInputTokens,
+        iterations,
+        totalPromptTokens,
+        evictedTokens,
+        subagents,
+    };
+}
+
+function estimateTokens(message: ToolCallMessage): number {
+    return (
+        TokenConstants.TOKEN_OVERHEAD_PER_MESSAGE +
+        Math.ceil(
+            (message.content?.length ?? 0) /
+                TokenConstants.CHARS_PER_TOKEN_ESTIMATE
+        )
+    );
+}
@@ -27,6 +27,7 @@ export class TokenConstants {
     // Tool calling constants
     static readonly MAX_TOOL_RESPONSE_CHARS = 20000;
     static readonly CONTEXT_WARNING_RATIO = 0.9; // 90% of context window
+    static readonly MEMORY_COMPACTION_UTILIZATION = 0.5; // Cleanup target under heap pressure
     static readonly MAX_FILE_READ_LINES = 200; // Maximum lines for ReadFileTool
 
     // Tool context management messages
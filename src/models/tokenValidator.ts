@@ -9,6 +9,10 @@ import { Log } from '../services/loggingService';
 export interface TokenValidationResult {
     /** Total token count of all messages */
     totalTokens: number;
+    /** Tokens of the system prompt */
+    systemTokens: number;
+    /** Tokens of each message, in the order given */
+    messageTokens: number[];
     /** Maximum tokens allowed for this model */
     maxTokens: number;
     /** Whether messages exceed context warning threshold */
@@ -55,12 +59,14 @@ export class TokenValidator {
             const systemTokens = await this.model.countTokens(systemPrompt);
 
             // Count tokens for all messages
-            let messageTokens = 0;
+            const messageTokens: number[] = [];
+            let totalTokens = systemTokens;
             for (const message of messages) {
-                messageTokens += await this.countMessageTokens(message);
+                const tokens = await this.countMessageTokens(message);
+                messageTokens.push(tokens);
+                totalTokens += tokens;
             }
 
-            const totalTokens = systemTokens + messageTokens;
             const maxTokens =
                 this.model.maxInputTokens ||
                 TokenConstants.DEFAULT_MAX_INPUT_TOKENS;
@@ -81,6 +87,8 @@ export class TokenValidator {
 
             return {
                 totalTokens,
+                systemTokens,
+                messageTokens,
                 maxTokens,
                 exceedsWarningThreshold,
                 exceedsMaxTokens,
@@ -91,6 +99,8 @@ export class TokenValidator {
             // Return conservative result on error
             return {
                 totalTokens: 0,
+                systemTokens: 0,
+                messageTokens: [],
                 maxTokens: TokenConstants.DEFAULT_MAX_INPUT_TOKENS,
                 exceedsWarningThreshold: false,
                 exceedsMaxTokens: false,
@@ -104,12 +114,15 @@ export class TokenValidator {
      * @param messages Messages to clean up
      * @param systemPrompt System prompt for token calculation
      * @param targetUtilization Target context utilization (0.8 = 80%)
+     * @param addContextFullMessage Ask the model to finish once anything was
+     *     removed. Off when compacting for memory rather than context space.
      * @returns Cleanup result with modified messages
      */
     async cleanupContext(
         messages: ToolCallMessage[],
         systemPrompt: string,
-        targetUtilization: number = 0.8
+        targetUtilization: number = 0.8,
+        addContextFullMessage: boolean = true
     ): Promise<ContextCleanupResult> {
         const maxTokens =
             this.model.maxInputTokens ||
@@ -149,7 +162,10 @@ export class TokenValidator {
             }
 
             // Add context full message if we removed any tool interactions
-            if (toolResultsRemoved > 0 || assistantMessagesRemoved > 0) {
+            if (
+                addContextFullMessage &&
+                (toolResultsRemoved > 0 || assistantMessagesRemoved > 0)
+            ) {
                 cleanedMessages.push({
                     role: 'user',
                     content: TokenConstants.TOOL_CONTEXT_MESSAGES.CONTEXT_FULL,
@@ -120,6 +120,9 @@ export class ToolCallStreamAdapter implements ToolCallHandler {
             case 'run_subagent':
                 return '🤖 Running subagent investigation...';
 
+            case 'run_subagents':
+                return '🤖 Running parallel subagent investigations...';
+
             case 'think_about_context':
                 return '🧠 Analyzing context...';
 
@@ -24,6 +24,12 @@ export class ToolConstants {
      */
     static readonly MAX_SYMBOL_RESULTS_LIMIT = 200;
 
+    /**
+     * Maximum entries in the per-analysis ToolResultCache.
+     * Oldest entries are evicted first; in-flight requests stay coalesced until they settle.
+     */
+    static readonly TOOL_RESULT_CACHE_MAX_ENTRIES = 500;
+
     /**
      * Error messages for tool execution failures.
      * Provides clear, actionable feedback to the LLM.
@@ -34,6 +40,29 @@ export class ToolConstants {
     } as const;
 }
 
+/**
+ * Tools whose results depend only on their arguments and workspace state, with no side effects.
+ * Their results can be shared across agents via ToolResultCache.
+ */
+export const READ_ONLY_TOOLS = [
+    'find_symbol',
+    'find_usages',
+    'list_directory',
+    'find_files_by_pattern',
+    'read_file',
+    'get_symbols_overview',
+    'search_for_pattern',
+] as const;
+
+/**
+ * Check whether a tool is side-effect free (see READ_ONLY_TOOLS).
+ */
+export function isReadOnlyTool(toolName: string): boolean {
+    return READ_ONLY_TOOLS.includes(
+        toolName as (typeof READ_ONLY_TOOLS)[number]
+    );
+}
+
 /**
  * Static limits for subagent execution that don't need user configuration.
  * Dynamic limits (max per session, timeout) come from WorkspaceSettingsService.
@@ -44,6 +73,7 @@ export const SubagentLimits = {
     /** Tools that subagents cannot access */
     DISALLOWED_TOOLS: [
         'run_subagent', // Prevent sub-subagent recursion
+        'run_subagents', // Prevent sub-subagent recursion (fan-out variant)
         'update_plan', // Main agent only - subagents don't track review progress
         'submit_review', // Main agent only - explicit completion signal
         'think_about_completion', // Main agent only - for final review verification
@@ -53,6 +83,35 @@ export const SubagentLimits = {
         // It's the only think tool designed for focused investigations without
         // needing diff context or PR-level review state that subagents don't have.
     ] as const,
+    /** Maximum cached subagent results kept across analyses (LRU eviction) */
+    RESULT_CACHE_MAX_ENTRIES: 50,
+    /** Cached results older than this are discarded even if their files are unchanged */
+    RESULT_CACHE_TTL_MS: 30 * 60 * 1000,
+    /** Results that read more paths than this are not cached (fingerprinting cost) */
+    RESULT_CACHE_MAX_TRACKED_PATHS: 200,
+    /** Subagent iterations per remaining parent iteration (sizes and caps the iteration pool) */
+    BUDGET_ITERATION_POOL_FACTOR: 3,
+    /** Prompt tokens budgeted per allocated iteration (sizes the token pool) */
+    BUDGET_TOKENS_PER_ITERATION: 30_000,
+    /** Wall-clock window for subagents without a linked parent, as a multiple of the request timeout setting */
+    BUDGET_TIME_WINDOW_FACTOR: 4,
+    /** Time kept at the end of the parent's run for it to use subagent results */
+    BUDGET_PARENT_RESERVE_MS: 60 * 1000,
+    /** Smallest useful allocation; below this a spawn is refused */
+    BUDGET_MIN_ITERATIONS: 5,
+    /** Smallest useful time slice; below this a spawn is refused */
+    BUDGET_MIN_TIMEOUT_MS: 30 * 1000,
+    /** Bounds for the task complexity weight applied to the fair share */
+    BUDGET_MIN_TASK_WEIGHT: 0.5,
+    BUDGET_MAX_TASK_WEIGHT: 2,
+    /** Hard cap on the subagent result returned to the parent conversation */
+    RESULT_MAX_TOKENS: 1500,
+    /** Compressed bytes of nested tool calls kept for the webview (LRU eviction) */
+    NESTED_STORE_MAX_BYTES: 16 * 1024 * 1024,
+    /** Most tasks a single run_subagents call may fan out to */
+    FANOUT_MAX_TASKS: 6,
+    /** Hard cap on the aggregated run_subagents result */
+    FANOUT_RESULT_MAX_TOKENS: 4000,
 } as const;
 
 /**
@@ -86,4 +145,14 @@ export const SubagentErrors = {
         `Investigation may be incomplete. Break the task into smaller, more focused subtasks.`,
 
     failed: (error: string) => `Subagent failed: ${error}`,
+
+    cancelledEarly: (reason: string) =>
+        `Subagent stopped early (${reason}); its remaining investigation was no longer needed.`,
+
+    fanOutFailed: (failures: string) =>
+        `All subagents failed:\n${failures}\nUse direct tools or narrower tasks.`,
+
+    budgetExhausted: () =>
+        'Subagent budget for this analysis is exhausted (iterations, tokens or time). ' +
+        'Use direct tools for remaining investigations.',
 } as const;
@@ -2,11 +2,17 @@ import * as vscode from 'vscode';
 import { ToolRegistry } from './toolRegistry';
 import type { ITool } from '../tools/ITool';
 import { TokenConstants } from './tokenConstants';
-import { ToolConstants } from './toolConstants';
+import { ToolConstants, isReadOnlyTool } from './toolConstants';
+import { ToolResultCache } from './toolResultCache';
 import { WorkspaceSettingsService } from '../services/workspaceSettingsService';
-import type { ToolResultMetadata } from '../types/toolResultTypes';
+import type {
+    ToolResult,
+    ToolResultMetadata,
+} from '../types/toolResultTypes';
 import type { ExecutionContext } from '../types/executionContext';
 import { Log } from '../services/loggingService';
+import { Trace } from '../services/performanceTrace';
+import type { ToolCallOutcome } from '../services/toolMetricsStore';
 import { isCancellationError, isTimeoutError } from '../utils/asyncUtils';
 import { getErrorMessage } from '../utils/errorUtils';
 
@@ -16,8 +22,17 @@ import { getErrorMessage } from '../utils/errorUtils';
 export interface ToolExecutionRequest {
     name: string;
     args: any;
+    /** Execution already started via executeTool (e.g., dispatched while the response streamed) */
+    pending?: Promise<ToolExecutionResult>;
+    /** performance.now() when the model emitted the call; traced as queue time */
+    queuedAt?: number;
 }
 
+/** Outcome of running a validated tool call; see ToolExecutor.runTool */
+type ToolRun =
+    | { result: ToolResult; cached: boolean }
+    | { error: unknown; cached: boolean };
+
 /**
  * Interface for tool execution results
  */
@@ -91,9 +106,36 @@ export class ToolExecutor {
      * Execute a single tool with the provided arguments.
      * @param name The name of the tool to execute
      * @param args The arguments to pass to the tool
+     * @param queuedAt performance.now() when the model emitted the call, if known
      * @returns Promise resolving to the tool execution result
      */
-    async executeTool(name: string, args: any): Promise<ToolExecutionResult> {
+    async executeTool(
+        name: string,
+        args: any,
+        queuedAt?: number
+    ): Promise<ToolExecutionResult> {
+        const span = Trace.asyncSpan(
+            name,
+            'tool',
+            queuedAt !== undefined
+                ? { queueMs: Math.round(performance.now() - queuedAt) }
+                : undefined
+        );
+        let result: ToolExecutionResult | undefined;
+        try {
+            result = await this.executeToolCall(name, args);
+            return result;
+        } finally {
+            span.end(
+                result ? { success: result.success } : { cancelled: true }
+            );
+        }
+    }
+
+    private async executeToolCall(
+        name: string,
+        args: any
+    ): Promise<ToolExecutionResult> {
         const startTime = Date.now();
 
         // Defensive cancellation check FIRST - before any other logic.
@@ -114,7 +156,8 @@ export class ToolExecutor {
 
         if (this.toolCallCount > this.maxToolCalls) {
             Log.warn(
-                `Tool '${name}' ✗ rate limit exceeded (${this.toolCallCount}/${this.maxToolCalls}) | args: ${this.formatArgsForLog(args)}`
+                () =>
+                    `Tool '${name}' ✗ rate limit exceeded (${this.toolCallCount}/${this.maxToolCalls}) | args: ${this.formatArgsForLog(args)}`
             );
             return {
                 name,
@@ -131,7 +174,8 @@ export class ToolExecutor {
 
             if (!tool) {
                 Log.warn(
-                    `Tool '${name}' ✗ not found in registry | args: ${this.formatArgsForLog(args)}`
+                    () =>
+                        `Tool '${name}' ✗ not found in registry | args: ${this.formatArgsForLog(args)}`
                 );
                 return {
                     name,
@@ -152,7 +196,8 @@ export class ToolExecutor {
                     )
                     .join(', ');
                 Log.warn(
-                    `Tool '${name}' ✗ schema validation failed: ${errorDetails} | args: ${this.formatArgsForLog(args)}`
+                    () =>
+                        `Tool '${name}' ✗ schema validation failed: ${errorDetails} | args: ${this.formatArgsForLog(args)}`
                 );
                 return {
                     name,
@@ -162,11 +207,18 @@ export class ToolExecutor {
             }
 
             const validatedArgs = parseResult.data;
-            const toolResult = await tool.execute(
-                validatedArgs,
-                this.executionContext
-            );
+            const run = await this.runTool(tool, validatedArgs);
             const elapsed = Date.now() - startTime;
+            if ('error' in run) {
+                return this.handleToolError(
+                    name,
+                    args,
+                    run.error,
+                    elapsed,
+                    run.cached
+                );
+            }
+            const { result: toolResult, cached } = run;
 
             // Validate response size only for successful results with data
             if (toolResult.success && toolResult.data) {
@@ -175,8 +227,18 @@ export class ToolExecutor {
                     name
                 );
                 if (!validationResult.isValid) {
+                    const resultSize = toolResult.data.length;
+                    if (!cached) {
+                        this.recordMetrics(
+                            name,
+                            elapsed,
+                            'oversized',
+                            resultSize
+                        );
+                    }
                     Log.warn(
-                        `Tool '${name}' ✗ response too large (${toolResult.data.length} chars) [${elapsed}ms] | args: ${this.formatArgsForLog(args)}`
+                        () =>
+                            `Tool '${name}' ✗ response too large (${resultSize} chars) [${elapsed}ms] | args: ${this.formatArgsForLog(args)}`
                     );
                     return {
                         name,
@@ -186,6 +248,16 @@ export class ToolExecutor {
                 }
             }
 
+            // A cache hit says nothing about how the tool performs
+            if (!cached) {
+                this.recordMetrics(
+                    name,
+                    elapsed,
+                    getOutcome(toolResult),
+                    toolResult.data?.length
+                );
+            }
+
             if (toolResult.success) {
                 const resultSize = toolResult.data?.length ?? 0;
                 Log.info(
@@ -193,7 +265,8 @@ export class ToolExecutor {
                 );
             } else {
                 Log.info(
-                    `Tool '${name}' ✗ ${toolResult.error ?? 'unknown error'} [${elapsed}ms] | args: ${this.formatArgsForLog(args)}`
+                    () =>
+                        `Tool '${name}' ✗ ${toolResult.error ?? 'unknown error'} [${elapsed}ms] | args: ${this.formatArgsForLog(args)}`
                 );
             }
 
@@ -211,31 +284,136 @@ export class ToolExecutor {
                 throw error;
             }
 
-            const elapsed = Date.now() - startTime;
+            return this.handleToolError(
+                name,
+                args,
+                error,
+                Date.now() - startTime,
+                false
+            );
+        }
+    }
 
-            // TimeoutError gets a helpful message for the LLM
-            if (isTimeoutError(error)) {
-                Log.warn(
-                    `Tool '${name}' timed out [${elapsed}ms] | args: ${this.formatArgsForLog(args)}`
-                );
-                return {
-                    name,
-                    success: false,
-                    error: `Operation timed out. Try a more specific query or limit the search scope.`,
-                };
+    /**
+     * Turn a tool that threw (other than by cancellation) into a failed
+     * result. `cached` errors came from another caller's in-flight run and
+     * were already recorded by that caller.
+     */
+    private handleToolError(
+        name: string,
+        args: unknown,
+        error: unknown,
+        elapsed: number,
+        cached: boolean
+    ): ToolExecutionResult {
+        // TimeoutError gets a helpful message for the LLM
+        if (isTimeoutError(error)) {
+            if (!cached) {
+                this.recordMetrics(name, elapsed, 'timeout');
             }
-
-            const errorMsg = getErrorMessage(error);
-            Log.error(
-                `Tool '${name}' threw exception: ${errorMsg} [${elapsed}ms] | args: ${this.formatArgsForLog(args)}`,
-                error
+            Log.warn(
+                () =>
+                    `Tool '${name}' timed out [${elapsed}ms] | args: ${this.formatArgsForLog(args)}`
             );
             return {
                 name,
                 success: false,
-                error: errorMsg,
+                error: `Operation timed out. Try a more specific query or limit the search scope.`,
             };
         }
+
+        if (!cached) {
+            this.recordMetrics(name, elapsed, 'error');
+        }
+        const errorMsg = getErrorMessage(error);
+        Log.error(
+            () =>
+                `Tool '${name}' threw exception: ${errorMsg} [${elapsed}ms] | args: ${this.formatArgsForLog(args)}`,
+            error
+        );
+        return {
+            name,
+            success: false,
+            error: errorMsg,
+        };
+    }
+
+    /**
+     * Record a call that reached the tool in the shared ToolMetricsStore.
+     * Calls rejected before execution (rate limit, unknown tool, invalid
+     * arguments) and calls served from the ToolResultCache say nothing about
+     * tool performance and are not recorded.
+     */
+    private recordMetrics(
+        toolName: string,
+        durationMs: number,
+        outcome: ToolCallOutcome,
+        responseChars?: number
+    ): void {
+        this.executionContext.toolMetrics?.record({
+            toolName,
+            durationMs,
+            outcome,
+            responseChars,
+        });
+    }
+
+    /**
+     * Run a validated tool call, serving read-only tools through the shared
+     * ToolResultCache when the ExecutionContext provides one. Cancellation
+     * is thrown; other errors are returned.
+     * @returns The result or error, and whether it came from the cache (a
+     *   stored result or another caller's in-flight run) instead of this call
+     */
+    private async runTool(tool: ITool, args: unknown): Promise<ToolRun> {
+        const cache = this.executionContext.toolResultCache;
+        if (!cache || !isReadOnlyTool(tool.name)) {
+            return this.executeUncached(tool, args);
+        }
+
+        const key = ToolResultCache.buildKey(tool.name, args);
+        let executed = false;
+        try {
+            const result = await cache.getOrExecute(key, () => {
+                executed = true;
+                return tool.execute(args, this.executionContext);
+            });
+            return { result, cached: !executed };
+        } catch (error) {
+            // A coalesced request runs under the token of the agent that started it.
+            // If that agent was cancelled (e.g., a sibling subagent timed out) but we
+            // weren't, run the tool ourselves instead of propagating its cancellation.
+            if (
+                isCancellationError(error) &&
+                !this.executionContext.cancellationToken.isCancellationRequested
+            ) {
+                Log.debug(
+                    `Tool '${tool.name}' shared request was cancelled by another agent; retrying`
+                );
+                return this.executeUncached(tool, args);
+            }
+            if (isCancellationError(error)) {
+                throw error;
+            }
+            return { error, cached: !executed };
+        }
+    }
+
+    private async executeUncached(
+        tool: ITool,
+        args: unknown
+    ): Promise<ToolRun> {
+        try {
+            return {
+                result: await tool.execute(args, this.executionContext),
+                cached: false,
+            };
+        } catch (error) {
+            if (isCancellationError(error)) {
+                throw error;
+            }
+            return { error, cached: false };
+        }
     }
 
     /**
@@ -264,9 +442,11 @@ export class ToolExecutor {
         );
         const startTime = Date.now();
 
-        // Execute all tools in parallel using Promise.all
-        const executionPromises = requests.map((request) =>
-            this.executeTool(request.name, request.args)
+        // Execute all tools in parallel using Promise.all; calls started early are awaited as-is
+        const executionPromises = requests.map(
+            (request) =>
+                request.pending ??
+                this.executeTool(request.name, request.args, request.queuedAt)
         );
 
         try {
@@ -322,6 +502,15 @@ export class ToolExecutor {
         return this.toolCallCount;
     }
 
+    /**
+     * Un-count tool calls whose results were discarded, e.g. calls started
+     * while streaming a response that then failed and will be retried.
+     * @param count Number of calls to release
+     */
+    releaseToolCalls(count: number): void {
+        this.toolCallCount = Math.max(0, this.toolCallCount - count);
+    }
+
     /**
      * Reset the tool call counter for a new analysis session.
      * Should be called at the start of each new analysis to ensure clean rate limiting.
@@ -360,3 +549,15 @@ export class ToolExecutor {
         // No resources to dispose of currently
     }
 }
+
+/**
+ * Metrics outcome of a tool that returned normally. Partial results after an
+ * internal timeout count as timeouts, so timeout rates cover tools that
+ * degrade instead of failing.
+ */
+function getOutcome(result: ToolResult): ToolCallOutcome {
+    if (result.metadata?.timedOut) {
+        return 'timeout';
+    }
+    return result.success ? 'success' : 'error';
+}
@@ -0,0 +1,112 @@
+import type { ToolResult } from '../types/toolResultTypes';
+import { ToolConstants } from './toolConstants';
+
+/**
+ * Analysis-scoped cache for read-only tool results, shared between the main
+ * agent and all of its subagents.
+ *
+ * Concurrency model: the cache stores the in-flight promise rather than the
+ * settled value, so identical requests issued while the first one is still
+ * running are coalesced onto it (single-flight). Parallel subagents asking for
+ * the same file therefore trigger exactly one read.
+ *
+ * Only complete, successful results are retained; failures, rejections and
+ * results cut short by a timeout are evicted so the next caller retries.
+ * Create one instance per analysis — results are not invalidated on file
+ * changes, which is acceptable within a single review run.
+ */
+export class ToolResultCache {
+    private readonly entries = new Map<string, Promise<ToolResult>>();
+    private hits = 0;
+    private misses = 0;
+
+    /**
+     * Return the cached (or in-flight) result for `key`, or run `execute` and
+     * share its promise with every concurrent caller using the same key.
+     */
+    getOrExecute(
+        key: string,
+        execute: () => Promise<ToolResult>
+    ): Promise<ToolResult> {
+        const existing = this.entries.get(key);
+        if (existing) {
+            this.hits++;
+            return existing;
+        }
+
+        this.misses++;
+        const pending = execute().then(
+            (result) => {
+                if (!result.success || result.metadata?.timedOut) {
+                    this.evict(key, pending);
+                }
+                return result;
+            },
+            (error: unknown) => {
+                this.evict(key, pending);
+                throw error;
+            }
+        );
+        this.entries.set(key, pending);
+
+        while (
+            this.entries.size > ToolConstants.TOOL_RESULT_CACHE_MAX_ENTRIES
+        ) {
+            const oldestKey = this.entries.keys().next().value;
+            if (oldestKey === undefined) {
+                break;
+            }
+            this.entries.delete(oldestKey);
+        }
+
+        return pending;
+    }
+
+    /**
+     * Hit/miss counters for logging. Coalesced in-flight requests count as hits.
+     */
+    getStats(): { hits: number; misses: number; size: number } {
+        return {
+            hits: this.hits,
+            misses: this.misses,
+            size: this.entries.size,
+        };
+    }
+
+    clear(): void {
+        this.entries.clear();
+    }
+
+    /**
+     * Build a cache key from the tool name and validated arguments.
+     * Object keys are sorted so argument order doesn't affect the key.
+     */
+    static buildKey(toolName: string, args: unknown): string {
+        return `${toolName}:${stableStringify(args)}`;
+    }
+
+    private evict(key: string, pending: Promise<ToolResult>): void {
+        // Only evict our own entry; it may already have been replaced
+        if (this.entries.get(key) === pending) {
+            this.entries.delete(key);
+        }
+    }
+}
+
+function stableStringify(value: unknown): string {
+    if (Array.isArray(value)) {
+        return `[${value.map(stableStringify).join(',')}]`;
+    }
+    if (value !== null && typeof value === 'object') {
+        const record = value as Record<string, unknown>;
+        const fields = Object.keys(record)
+            .filter((key) => record[key] !== undefined)
+            .sort()
+            .map(
+                (key) =>
+                    `${JSON.stringify(key)}:${stableStringify(record[key])}`
+            );
+        return `{${fields.join(',')}}`;
+    }
+    return JSON.stringify(value) ?? 'undefined';
+}
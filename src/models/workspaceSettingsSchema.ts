@@ -4,6 +4,8 @@ import { LOG_LEVELS } from './loggingTypes';
 export const ANALYSIS_LIMITS = {
     maxIterations: { default: 100, min: 3, max: 200 },
     requestTimeoutSeconds: { default: 300, min: 60, max: 600 },
+    /** Extension host heap size above which an analysis compacts its data */
+    heapBudgetMB: { default: 2048, min: 256, max: 16384 },
 } as const;
 
 export const SUBAGENT_LIMITS = {
@@ -24,6 +26,11 @@ export const WorkspaceSettingsSchema = z.looseObject({
         .min(ANALYSIS_LIMITS.requestTimeoutSeconds.min)
         .max(ANALYSIS_LIMITS.requestTimeoutSeconds.max)
         .default(ANALYSIS_LIMITS.requestTimeoutSeconds.default),
+    heapBudgetMB: z
+        .number()
+        .min(ANALYSIS_LIMITS.heapBudgetMB.min)
+        .max(ANALYSIS_LIMITS.heapBudgetMB.max)
+        .default(ANALYSIS_LIMITS.heapBudgetMB.default),
     maxSubagentsPerSession: z
         .number()
         .min(SUBAGENT_LIMITS.maxPerSession.min)
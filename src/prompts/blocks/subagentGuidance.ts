@@ -33,6 +33,10 @@ export function generateSubagentGuidance(): string {
 
 **Before spawning, ask yourself:** "Could someone who never saw the git history answer this?"
 
+### Parallel Investigations
+
+For 2+ independent modules, use \`run_subagents\` with one task per module instead of separate \`run_subagent\` calls. They run concurrently and return one merged report with duplicate findings combined.
+
 ### Task Format
 
 \`\`\`
@@ -94,7 +98,7 @@ context: "[User's original question or what you need to understand]"
 
 ### Tips
 
-- ONE module per subagent—spawn multiple for multiple modules
+- ONE module per subagent—use \`run_subagents\` to investigate several modules in parallel
 - Be specific about which functions/classes to examine
 - Subagents have full tool access but work independently
 </subagent_guidance>`;
@@ -22,6 +22,7 @@ export function generateToolSelectionGuide(): string {
 | Read config/docs | \`read_file\` | \`path\`, \`start_line\`, \`end_line\` |
 | Track progress | \`update_plan\` | \`plan\` (markdown checklist) |
 | Deep investigation | \`run_subagent\` | \`task\`, \`context\` |
+| Parallel investigations | \`run_subagents\` | \`tasks\` (2+ independent modules) |
 
 ### Principles
 
@@ -61,6 +62,7 @@ export function generateExplorationToolGuide(): string {
 | Find files | \`find_files_by_pattern\` | \`pattern\` |
 | Read config/docs | \`read_file\` | \`path\`, \`start_line\`, \`end_line\` |
 | Deep investigation | \`run_subagent\` | \`task\`, \`context\` |
+| Parallel investigations | \`run_subagents\` | \`tasks\` (2+ independent modules) |
 
 ### Principles
 
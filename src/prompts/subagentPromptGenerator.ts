@@ -1,5 +1,6 @@
 import type { SubagentTask } from '../types/modelTypes';
 import type { ITool } from '../tools/ITool';
+import { SubagentLimits } from '../models/toolConstants';
 
 /**
  * Generates focused system prompts for subagent investigations.
@@ -12,37 +13,23 @@ import type { ITool } from '../tools/ITool';
  */
 export class SubagentPromptGenerator {
     /**
-     * Generate a system prompt for a subagent investigation.
-     * @param task The investigation task definition
+     * Generate the system prompt shared by all subagent investigations.
+     *
+     * Deliberately task-independent: everything that varies per subagent (task,
+     * parent context, iteration budget) goes in the first user message via
+     * generateTaskMessage(), so subagents with the same tool set send a
+     * byte-identical prefix and can hit the provider's prompt cache.
+     *
      * @param tools Available tools (run_subagent will be filtered out by executor)
-     * @param maxIterations Maximum conversation iterations for this subagent
      * @returns Complete system prompt for the subagent
      */
-    generateSystemPrompt(
-        task: SubagentTask,
-        tools: ITool[],
-        maxIterations: number
-    ): string {
+    generateSystemPrompt(tools: ITool[]): string {
         const toolList = this.formatToolList(tools);
-        const contextSection = task.context
-            ? `<context_from_parent>
-## Context from Parent Agent
-
-The parent agent has provided the following code/information relevant to your investigation:
-
-${task.context}
-</context_from_parent>`
-            : '';
+        const maxResultWords = Math.round(
+            (SubagentLimits.RESULT_MAX_TOKENS * 3) / 4
+        );
 
-        return `You are a focused investigation subagent. A senior engineer reviewing a pull request has delegated a specific investigation to you.
-
-<your_task>
-## Your Assigned Task
-
-${task.task}
-</your_task>
-
-${contextSection}
+        return `You are a focused investigation subagent. A senior engineer reviewing a pull request has delegated a specific investigation to you. Your task is given in the first user message.
 
 <available_tools>
 ## Available Tools
@@ -69,23 +56,23 @@ Follow this systematic approach:
 <response_requirements>
 ## Response Requirements
 
-Your response MUST include:
+The parent agent receives only a compact version of your answer, capped at roughly ${maxResultWords} words. Use exactly these sections so nothing important is dropped:
+
+### Summary
+1-3 sentences directly answering the task's questions.
 
 ### Findings
-For each issue discovered, provide:
-- **Location**: [file/path.ts:lineNumber](file/path.ts:lineNumber)
-- **Evidence**: Code snippet demonstrating the issue
-- **Severity**: 🔴 Critical / 🟠 High / 🟡 Medium / 🟢 Low
-- **Explanation**: Why this is a problem
+One bullet per issue, most important first:
+- 🔴 Critical / 🟠 High / 🟡 Medium / 🟢 Low — what is wrong and why, citing \`file/path.ts:lineNumber\`
 
-### Recommendations
-- Specific code changes or patterns to apply
-- Example fix if helpful
+### Evidence
+One bullet per location that supports your findings:
+- \`file/path.ts:lineNumber\` — what the code there shows (no code blocks; the parent can read the file)
 
-### Summary
-2-3 sentences summarizing your investigation for the parent agent.
+### Confidence
+High / Medium / Low — one sentence on what you verified and what you could not.
 
-If you find NO issues, explicitly state what you checked and why it passed.
+If you find NO issues, say so under Findings and list what you checked under Evidence.
 </response_requirements>
 
 <constraints>
@@ -97,7 +84,7 @@ If you find NO issues, explicitly state what you checked and why it passed.
 - If you discover unrelated issues, note briefly but don't deep-dive
 
 **Technical Limits:**
-- You have **${maxIterations} tool iterations** - use them wisely
+- Your tool iteration budget is stated with your task - use it wisely
 - You CANNOT see the PR diff - only what the parent provided in context
 - You CANNOT execute code or run tests
 
@@ -107,6 +94,33 @@ If you find NO issues, explicitly state what you checked and why it passed.
 </constraints>`;
     }
 
+    /**
+     * Generate the first user message carrying the per-subagent details.
+     * @param task The investigation task definition
+     * @param maxIterations Maximum conversation iterations for this subagent
+     */
+    generateTaskMessage(task: SubagentTask, maxIterations: number): string {
+        const contextSection = task.context
+            ? `
+
+<context_from_parent>
+## Context from Parent Agent
+
+The parent agent has provided the following code/information relevant to your investigation:
+
+${task.context}
+</context_from_parent>`
+            : '';
+
+        return `<your_task>
+## Your Assigned Task
+
+${task.task}
+</your_task>${contextSection}
+
+You have **${maxIterations} tool iterations** for this investigation.`;
+    }
+
     /**
      * Format the list of available tools for the prompt.
      */
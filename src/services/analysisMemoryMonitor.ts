@@ -0,0 +1,196 @@
+import type { ToolCallRecord } from '../types/toolCallTypes';
+import { Log } from './loggingService';
+import { Trace } from './performanceTrace';
+
+/**
+ * Stored tool results are cut to this many characters when compacted. Results
+ * up to twice as long are kept, which also leaves compacted results alone.
+ */
+export const COMPACTED_RESULT_PREVIEW_CHARS = 1000;
+
+/**
+ * Approximate bytes held by the analysis' own data, counted as two bytes per
+ * string character (V8 stores many strings in one byte, so this is an upper
+ * bound).
+ */
+export interface RetainedBytes {
+    /** Conversation history sent to the model */
+    conversation: number;
+    /** ToolCallRecords kept for the result, including inline nested calls */
+    toolRecords: number;
+    /** Original and processed diff */
+    diff: number;
+}
+
+export interface MemorySample {
+    iteration: number;
+    heapUsed: number;
+    rss: number;
+    external: number;
+    retained: RetainedBytes;
+}
+
+export interface AnalysisMemoryReport {
+    heapBudgetBytes: number;
+    /** heapUsed when the monitor was created */
+    baselineHeapUsed: number;
+    peakHeapUsed: number;
+    peakRss: number;
+    samples: MemorySample[];
+    toolResultCompactions: number;
+    historyCompactions: number;
+}
+
+/**
+ * What the analysis should drop after a sample:
+ * - none: under budget
+ * - toolResults: cut stored tool results down to a preview
+ * - history: also evict old tool interactions from the conversation
+ */
+export type MemoryCompaction = 'none' | 'toolResults' | 'history';
+
+type MemoryReader = () => Pick<
+    NodeJS.MemoryUsage,
+    'heapUsed' | 'rss' | 'external'
+>;
+
+/**
+ * Tracks the extension host heap over one analysis and decides when to
+ * compact.
+ *
+ * The heap is shared with everything else in the extension host, so the
+ * budget is checked against the whole process, while `retained` shows which
+ * part of it this analysis is holding. Compaction escalates: stored tool
+ * results are cut first, and the conversation history is only compacted if
+ * the next sample is still over budget. History is compacted at most once
+ * until the heap drops under budget again.
+ */
+export class AnalysisMemoryMonitor {
+    private readonly samples: MemorySample[] = [];
+    private readonly baselineHeapUsed: number;
+    private peakHeapUsed: number;
+    private peakRss = 0;
+    private overBudget = false;
+    private historyCompacted = false;
+    private toolResultCompactions = 0;
+    private historyCompactions = 0;
+
+    constructor(
+        private readonly heapBudgetBytes: number,
+        private readonly readMemory: MemoryReader = () => process.memoryUsage()
+    ) {
+        this.baselineHeapUsed = this.readMemory().heapUsed;
+        this.peakHeapUsed = this.baselineHeapUsed;
+    }
+
+    /**
+     * Record memory at an iteration boundary.
+     * @returns The compaction the caller should apply before continuing
+     */
+    sample(iteration: number, retained: RetainedBytes): MemoryCompaction {
+        const { heapUsed, rss, external } = this.readMemory();
+        this.samples.push({ iteration, heapUsed, rss, external, retained });
+        this.peakHeapUsed = Math.max(this.peakHeapUsed, heapUsed);
+        this.peakRss = Math.max(this.peakRss, rss);
+        Trace.counter('Memory (MB)', {
+            heapUsed: toMB(heapUsed),
+            conversation: toMB(retained.conversation),
+            toolRecords: toMB(retained.toolRecords),
+            diff: toMB(retained.diff),
+        });
+
+        if (heapUsed <= this.heapBudgetBytes) {
+            this.overBudget = false;
+            this.historyCompacted = false;
+            return 'none';
+        }
+
+        Log.warn(
+            `[Memory]: Heap ${toMB(heapUsed)}MB exceeds budget ${toMB(this.heapBudgetBytes)}MB at iteration ${iteration} (conversation ${toMB(retained.conversation)}MB, tool records ${toMB(retained.toolRecords)}MB, diff ${toMB(retained.diff)}MB)`
+        );
+
+        const escalate = this.overBudget && !this.historyCompacted;
+        this.overBudget = true;
+        this.toolResultCompactions++;
+        if (escalate) {
+            this.historyCompacted = true;
+            this.historyCompactions++;
+            return 'history';
+        }
+        return 'toolResults';
+    }
+
+    report(): AnalysisMemoryReport {
+        return {
+            heapBudgetBytes: this.heapBudgetBytes,
+            baselineHeapUsed: this.baselineHeapUsed,
+            peakHeapUsed: this.peakHeapUsed,
+            peakRss: this.peakRss,
+            samples: [...this.samples],
+            toolResultCompactions: this.toolResultCompactions,
+            historyCompactions: this.historyCompactions,
+        };
+    }
+}
+
+/**
+ * Approximate bytes held by tool call records, including inline nested calls.
+ */
+export function estimateToolRecordBytes(
+    records: readonly ToolCallRecord[]
+): number {
+    return toolRecordChars(records) * 2;
+}
+
+/**
+ * Cut the stored results of tool call records (and inline nested calls) down
+ * to a short preview. The model has already seen the full results; this only
+ * affects what the results view can show afterwards.
+ * @returns Characters dropped
+ */
+export function compactToolCallRecords(
+    records: ToolCallRecord[],
+    previewChars: number = COMPACTED_RESULT_PREVIEW_CHARS
+): number {
+    let dropped = 0;
+    for (const record of records) {
+        const length = resultLength(record.result);
+        if (length > previewChars * 2) {
+            const text =
+                typeof record.result === 'string'
+                    ? record.result
+                    : JSON.stringify(record.result);
+            record.result = `${text.slice(0, previewChars)}\n\n[... ${length - previewChars} characters dropped to reduce memory use ...]`;
+            dropped += length - previewChars;
+        }
+        if (record.nestedCalls) {
+            dropped += compactToolCallRecords(record.nestedCalls, previewChars);
+        }
+    }
+    return dropped;
+}
+
+function toolRecordChars(records: readonly ToolCallRecord[]): number {
+    let chars = 0;
+    for (const record of records) {
+        chars +=
+            resultLength(record.result) +
+            JSON.stringify(record.arguments).length +
+            (record.error?.length ?? 0);
+        if (record.nestedCalls) {
+            chars += toolRecordChars(record.nestedCalls);
+        }
+    }
+    return chars;
+}
+
+function resultLength(result: ToolCallRecord['result']): number {
+    return typeof result === 'string'
+        ? result.length
+        : JSON.stringify(result).length;
+}
+
+/** Megabytes with one decimal */
+function toMB(bytes: number): number {
+    return Math.round(bytes / ((1024 * 1024) / 10)) / 10;
+}
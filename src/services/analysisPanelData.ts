@@ -0,0 +1,263 @@
+import type {
+    ToolCallRecord,
+    ToolCallsData,
+    ToolCallSummary,
+} from '../types/toolCallTypes';
+import type {
+    AnalysisManifest,
+    DiffFileSummary,
+} from '../types/webviewMessages';
+import { estimateToolRecordBytes } from './analysisMemoryMonitor';
+
+/**
+ * Upper bound for the content of one reply to the webview. Larger requests
+ * are answered in several messages so the webview can render what arrived
+ * while the rest is still being serialized.
+ */
+export const MAX_REPLY_BYTES = 2 * 1024 * 1024;
+
+export interface DiffFileChunk {
+    summary: DiffFileSummary;
+    text: string;
+}
+
+const FILE_HEADER = 'diff --git ';
+
+/**
+ * Split a unified diff into per-file sections at `diff --git` headers,
+ * counting changes on the way. Text before the first header is dropped; a
+ * diff without git headers is kept as a single file.
+ */
+export function splitDiffByFile(diffText: string): DiffFileChunk[] {
+    const starts: number[] = [];
+    if (diffText.startsWith(FILE_HEADER)) {
+        starts.push(0);
+    }
+    let position = diffText.indexOf(`\n${FILE_HEADER}`);
+    while (position !== -1) {
+        starts.push(position + 1);
+        position = diffText.indexOf(`\n${FILE_HEADER}`, position + 1);
+    }
+    if (starts.length === 0 && diffText.trim()) {
+        starts.push(0);
+    }
+
+    return starts.map((start, index) => {
+        const text = diffText.slice(start, starts[index + 1]);
+        return { summary: summarizeDiffFile(text), text };
+    });
+}
+
+function summarizeDiffFile(text: string): DiffFileSummary {
+    const summary: DiffFileSummary = {
+        oldPath: '',
+        newPath: '',
+        additions: 0,
+        deletions: 0,
+        lines: 0,
+        hunks: 0,
+    };
+
+    let lineStart = 0;
+    while (lineStart < text.length) {
+        let lineEnd = text.indexOf('\n', lineStart);
+        if (lineEnd === -1) {
+            lineEnd = text.length;
+        }
+        const line = text.slice(lineStart, lineEnd);
+        lineStart = lineEnd + 1;
+
+        if (summary.hunks === 0) {
+            readHeaderLine(line, summary);
+            continue;
+        }
+        switch (line[0]) {
+            case '@':
+                if (line.startsWith('@@')) {
+                    summary.hunks++;
+                }
+                break;
+            case '+':
+                summary.additions++;
+                summary.lines++;
+                break;
+            case '-':
+                summary.deletions++;
+                summary.lines++;
+                break;
+            case ' ':
+                summary.lines++;
+                break;
+        }
+    }
+    return summary;
+}
+
+/** Paths and the first hunk from the lines preceding it */
+function readHeaderLine(line: string, summary: DiffFileSummary): void {
+    const gitHeader = /^diff --git a\/(.+) b\/(.+)$/.exec(line);
+    if (gitHeader) {
+        summary.oldPath = gitHeader[1] ?? '';
+        summary.newPath = gitHeader[2] ?? '';
+    } else if (line.startsWith('rename from ')) {
+        summary.oldPath = line.slice('rename from '.length);
+    } else if (line.startsWith('rename to ')) {
+        summary.newPath = line.slice('rename to '.length);
+    } else if (line.startsWith('--- a/')) {
+        summary.oldPath = line.slice('--- a/'.length);
+    } else if (line.startsWith('+++ b/')) {
+        summary.newPath = line.slice('+++ b/'.length);
+    } else if (line.startsWith('@@')) {
+        summary.hunks = 1;
+    }
+}
+
+function summarizeToolCall(call: ToolCallRecord): ToolCallSummary {
+    const {
+        arguments: _arguments,
+        result: _result,
+        nestedCalls,
+        ...summary
+    } = call;
+    return nestedCalls
+        ? { ...summary, nestedCallCount: nestedCalls.length }
+        : summary;
+}
+
+/**
+ * Split items into consecutive batches of at most `maxBytes` (a single
+ * larger item gets a batch of its own).
+ */
+export function batchBySize<T>(
+    items: readonly T[],
+    sizeOf: (item: T) => number,
+    maxBytes: number = MAX_REPLY_BYTES
+): T[][] {
+    const batches: T[][] = [];
+    let current: T[] = [];
+    let currentBytes = 0;
+    for (const item of items) {
+        const size = sizeOf(item);
+        if (current.length > 0 && currentBytes + size > maxBytes) {
+            batches.push(current);
+            current = [];
+            currentBytes = 0;
+        }
+        current.push(item);
+        currentBytes += size;
+    }
+    if (current.length > 0) {
+        batches.push(current);
+    }
+    return batches;
+}
+
+/**
+ * Data behind one analysis panel. The panel HTML embeds only the manifest;
+ * diff files and tool call details are served from here as the webview asks
+ * for them, so first paint does not wait for data the user may never open.
+ *
+ * For a running analysis, tool calls are appended as they complete and
+ * `finish` swaps in the final data.
+ */
+export class AnalysisPanelData {
+    private readonly diffFiles: DiffFileChunk[];
+    private plan: string | undefined;
+
+    constructor(
+        diffText: string,
+        private toolCalls: ToolCallsData | undefined,
+        private running: boolean = false
+    ) {
+        this.diffFiles = splitDiffByFile(diffText);
+    }
+
+    getManifest(title: string, analysis: string): AnalysisManifest {
+        return {
+            title,
+            analysis,
+            diffFiles: this.diffFiles.map((file) => file.summary),
+            toolCalls: this.toolCalls
+                ? {
+                      ...this.toolCalls,
+                      calls: this.toolCalls.calls.map(summarizeToolCall),
+                  }
+                : null,
+            running: this.running,
+            plan: this.running ? this.plan : undefined,
+        };
+    }
+
+    /**
+     * Record a tool call of the running analysis.
+     * @returns Its index and the summary to send to the webview
+     */
+    appendToolCall(record: ToolCallRecord): {
+        index: number;
+        call: ToolCallSummary;
+    } {
+        this.toolCalls ??= {
+            calls: [],
+            totalCalls: 0,
+            successfulCalls: 0,
+            failedCalls: 0,
+            analysisCompleted: false,
+            analysisError: undefined,
+        };
+        this.toolCalls.calls.push(record);
+        this.toolCalls.totalCalls++;
+        if (record.success) {
+            this.toolCalls.successfulCalls++;
+        } else {
+            this.toolCalls.failedCalls++;
+        }
+        return {
+            index: this.toolCalls.calls.length - 1,
+            call: summarizeToolCall(record),
+        };
+    }
+
+    setPlan(plan: string): void {
+        this.plan = plan;
+    }
+
+    /**
+     * Replace the live data with the analysis result. Calls keep their
+     * indices: the result lists them in the order they were appended.
+     */
+    finish(toolCalls: ToolCallsData | undefined): void {
+        this.toolCalls = toolCalls;
+        this.running = false;
+    }
+
+    /**
+     * Requested diff files in reply-sized batches. Unknown indices are
+     * skipped.
+     */
+    getDiffFiles(
+        indices: readonly number[]
+    ): { index: number; text: string }[][] {
+        const files = indices.flatMap((index) => {
+            const file = this.diffFiles[index];
+            return file ? [{ index, text: file.text }] : [];
+        });
+        return batchBySize(files, (file) => file.text.length * 2);
+    }
+
+    /**
+     * Requested tool call records in reply-sized batches. Unknown indices are
+     * skipped.
+     */
+    getToolCallDetails(
+        indices: readonly number[]
+    ): { index: number; call: ToolCallRecord }[][] {
+        const calls = this.toolCalls?.calls ?? [];
+        const details = indices.flatMap((index) => {
+            const call = calls[index];
+            return call ? [{ index, call }] : [];
+        });
+        return batchBySize(details, (detail) =>
+            estimateToolRecordBytes([detail.call])
+        );
+    }
+}
@@ -6,22 +6,29 @@ import { GitOperationsManager } from './gitOperationsManager';
 import { WorkspaceSettingsService } from './workspaceSettingsService';
 import { ToolExecutor } from '../models/toolExecutor';
 import { ToolRegistry } from '../models/toolRegistry';
+import { ToolResultCache } from '../models/toolResultCache';
 import { ConversationRunner } from '../models/conversationRunner';
 import { ConversationManager } from '../models/conversationManager';
 import { ChatLLMClient } from '../models/chatLLMClient';
 import { ToolCallStreamAdapter } from '../models/toolCallStreamAdapter';
 import { DebouncedStreamHandler } from '../models/debouncedStreamHandler';
+import { ChatStreamBatcher } from '../models/chatStreamBatcher';
 import { ChatContextManager } from '../models/chatContextManager';
 import { PromptGenerator } from '../models/promptGenerator';
 import { PlanSessionManager } from './planSessionManager';
 import { SubagentSessionManager } from './subagentSessionManager';
 import { SubagentExecutor } from './subagentExecutor';
+import { SubagentResultCache } from './subagentResultCache';
+import type { ToolMetricsStore } from './toolMetricsStore';
 import { SubagentPromptGenerator } from '../prompts/subagentPromptGenerator';
 import { CopilotModelManager } from '../models/copilotModelManager';
 import { MAIN_ANALYSIS_ONLY_TOOLS } from '../models/toolConstants';
 import { DiffUtils } from '../utils/diffUtils';
 import { buildFileTree } from '../utils/fileTreeBuilder';
-import { streamMarkdownWithAnchors } from '../utils/chatMarkdownStreamer';
+import {
+    DiffPathMatcher,
+    streamMarkdownWithAnchors,
+} from '../utils/chatMarkdownStreamer';
 import { isCancellationError } from '../utils/asyncUtils';
 import { getErrorMessage } from '../utils/errorUtils';
 import { ACTIVITY, SEVERITY } from '../config/chatEmoji';
@@ -42,6 +49,10 @@ export interface ChatParticipantDependencies {
     promptGenerator: PromptGenerator;
     gitOperations: GitOperationsManager;
     copilotModelManager: CopilotModelManager;
+    /** Optional: reuses subagent results across chat requests when files are unchanged */
+    subagentResultCache?: SubagentResultCache;
+    /** Optional: records per-tool performance statistics */
+    toolMetrics?: ToolMetricsStore;
 }
 
 /**
@@ -53,12 +64,12 @@ export interface ChatParticipantDependencies {
  * - `onFileReference`: Creates clickable file anchors for file-based tools
  * - `onMarkdown`: Streams rich markdown content
  *
- * @param stream The VS Code chat response stream for output
+ * @param stream Batched writer for the VS Code chat response stream
  * @param gitRootUri Optional Git repository root for resolving file paths
  * @returns ChatToolCallHandler implementation
  */
 function createChatStreamHandler(
-    stream: vscode.ChatResponseStream,
+    stream: ChatStreamBatcher,
     gitRootUri?: vscode.Uri
 ): ChatToolCallHandler {
     return {
@@ -248,18 +259,16 @@ export class ChatParticipantService implements vscode.Disposable {
             return this.handleCancellation(stream);
         }
 
-        try {
-            // Create stream adapter first - needed for subagent tool streaming
-            const gitRootUri = this.deps.gitOperations.getRepository()?.rootUri;
-            const { debouncedHandler, adapter } = this.createStreamAdapter(
-                stream,
-                gitRootUri
-            );
+        // Create stream adapter first - needed for subagent tool streaming
+        const gitRootUri = this.deps.gitOperations.getRepository()?.rootUri;
+        const { debouncedHandler, streamBatcher, adapter } =
+            this.createStreamAdapter(stream, gitRootUri);
 
-            // Create per-request subagent infrastructure with chat handler
-            const { subagentSessionManager, subagentExecutor } =
-                this.createSubagentContext(token, debouncedHandler);
+        // Create per-request subagent infrastructure with chat handler
+        const { subagentSessionManager, subagentExecutor } =
+            this.createSubagentContext(token, debouncedHandler);
 
+        try {
             // Create per-request ToolExecutor with subagent context
             const toolExecutor = new ToolExecutor(
                 this.deps.toolRegistry,
@@ -267,6 +276,8 @@ export class ChatParticipantService implements vscode.Disposable {
                 {
                     subagentSessionManager,
                     subagentExecutor,
+                    toolResultCache: new ToolResultCache(),
+                    toolMetrics: this.deps.toolMetrics,
                     cancellationToken: token,
                 }
             );
@@ -275,6 +286,9 @@ export class ChatParticipantService implements vscode.Disposable {
                 this.deps.workspaceSettings.getRequestTimeoutSeconds() * 1000;
             const client = new ChatLLMClient(request.model, timeoutMs);
             const runner = new ConversationRunner(client, toolExecutor);
+            subagentSessionManager.setParentBudget(
+                () => runner.remainingBudget
+            );
             const conversation = new ConversationManager();
 
             // Filter out main-analysis-only tools for exploration mode
@@ -337,12 +351,21 @@ export class ChatParticipantService implements vscode.Disposable {
             );
 
             debouncedHandler.flush();
+            streamBatcher.dispose();
 
             if (runner.wasCancelled) {
                 return this.handleCancellation(stream);
             }
 
-            streamMarkdownWithAnchors(stream, result, gitRootUri);
+            const { cancelled } = await streamMarkdownWithAnchors(
+                stream,
+                result,
+                gitRootUri,
+                { token }
+            );
+            if (cancelled) {
+                return this.handleCancellation(stream);
+            }
 
             return {
                 metadata: {
@@ -352,6 +375,9 @@ export class ChatParticipantService implements vscode.Disposable {
                 } satisfies ChatAnalysisMetadata,
             };
         } catch (error) {
+            // Write queued tool activity before the error
+            streamBatcher.dispose();
+
             // Check error type rather than token state to avoid race conditions
             // where the error is already thrown before we can check the token
             if (isCancellationError(error)) {
@@ -381,6 +407,12 @@ export class ChatParticipantService implements vscode.Disposable {
                     responseIsIncomplete: true,
                 },
             };
+        } finally {
+            streamBatcher.dispose();
+            // Nothing can consume subagent results once the answer is written
+            subagentSessionManager.cancelOutstanding('exploration finished');
+            subagentSessionManager.setParentCancellationToken(undefined);
+            subagentSessionManager.setParentBudget(undefined);
         }
     }
 
@@ -505,10 +537,8 @@ export class ChatParticipantService implements vscode.Disposable {
         const gitRootUri = this.deps!.gitOperations.getRepository()?.rootUri;
 
         // Create stream adapter first - needed for subagent tool streaming
-        const { debouncedHandler, adapter } = this.createStreamAdapter(
-            stream,
-            gitRootUri
-        );
+        const { debouncedHandler, streamBatcher, adapter } =
+            this.createStreamAdapter(stream, gitRootUri);
 
         // Create per-analysis instances for complete isolation
         const planManager = new PlanSessionManager();
@@ -522,6 +552,8 @@ export class ChatParticipantService implements vscode.Disposable {
                 planManager,
                 subagentSessionManager,
                 subagentExecutor,
+                toolResultCache: new ToolResultCache(),
+                toolMetrics: this.deps!.toolMetrics,
                 cancellationToken: token,
             }
         );
@@ -533,6 +565,7 @@ export class ChatParticipantService implements vscode.Disposable {
             this.deps!.workspaceSettings.getRequestTimeoutSeconds() * 1000;
         const client = new ChatLLMClient(request.model, timeoutMs);
         const runner = new ConversationRunner(client, toolExecutor);
+        subagentSessionManager.setParentBudget(() => runner.remainingBudget);
         const conversation = new ConversationManager();
         const availableTools = toolExecutor.getAvailableTools();
         const systemPrompt =
@@ -568,12 +601,24 @@ export class ChatParticipantService implements vscode.Disposable {
             );
 
             debouncedHandler.flush();
+            streamBatcher.dispose();
 
             if (runner.wasCancelled) {
                 return this.handleCancellation(stream);
             }
 
-            streamMarkdownWithAnchors(stream, analysisResult, gitRootUri);
+            const pathMatcher = new DiffPathMatcher(
+                parsedDiff.map((file) => file.filePath)
+            );
+            const { cancelled } = await streamMarkdownWithAnchors(
+                stream,
+                analysisResult,
+                gitRootUri,
+                { pathMatcher, token }
+            );
+            if (cancelled) {
+                return this.handleCancellation(stream);
+            }
 
             const contentAnalysis = this.analyzeResultContent(analysisResult);
 
@@ -591,7 +636,11 @@ export class ChatParticipantService implements vscode.Disposable {
                 } satisfies ChatAnalysisMetadata,
             };
         } finally {
+            // Write queued tool activity before any error message
+            streamBatcher.dispose();
+            subagentSessionManager.cancelOutstanding('analysis finished');
             subagentSessionManager.setParentCancellationToken(undefined);
+            subagentSessionManager.setParentBudget(undefined);
         }
     }
 
@@ -665,7 +714,10 @@ export class ChatParticipantService implements vscode.Disposable {
             this.deps!.toolRegistry,
             new SubagentPromptGenerator(),
             this.deps!.workspaceSettings,
-            chatHandler // Pass handler for subagent tool streaming
+            chatHandler, // Pass handler for subagent tool streaming
+            undefined,
+            undefined,
+            this.deps!.subagentResultCache
         );
         subagentSessionManager.setParentCancellationToken(token);
         return { subagentSessionManager, subagentExecutor };
@@ -675,6 +727,10 @@ export class ChatParticipantService implements vscode.Disposable {
      * Create stream adapter pipeline for tool-calling UI feedback.
      * Extracted to avoid duplication between exploration and analysis modes.
      *
+     * Tool activity is written through a ChatStreamBatcher. Flush the
+     * debounced handler and then dispose the batcher before writing the
+     * response, so it follows all queued activity.
+     *
      * @param stream The VS Code chat response stream
      * @param gitRootUri Optional Git root for resolving file paths in anchors
      */
@@ -683,12 +739,14 @@ export class ChatParticipantService implements vscode.Disposable {
         gitRootUri?: vscode.Uri
     ): {
         debouncedHandler: DebouncedStreamHandler;
+        streamBatcher: ChatStreamBatcher;
         adapter: ToolCallStreamAdapter;
     } {
-        const uiHandler = createChatStreamHandler(stream, gitRootUri);
+        const streamBatcher = new ChatStreamBatcher(stream);
+        const uiHandler = createChatStreamHandler(streamBatcher, gitRootUri);
         const debouncedHandler = new DebouncedStreamHandler(uiHandler);
         const adapter = new ToolCallStreamAdapter(debouncedHandler);
-        return { debouncedHandler, adapter };
+        return { debouncedHandler, streamBatcher, adapter };
     }
 
     /**
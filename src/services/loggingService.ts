@@ -9,21 +9,28 @@ const LOG_LEVEL_VALUES: Record<LogLevel, number> = {
     error: 3,
 };
 
+/**
+ * A log message, or a function building it. Pass a function when the message
+ * is expensive to build (serialized arguments, joined lists): it is only
+ * called if the level is enabled.
+ */
+export type LogMessage = string | (() => string);
+
 /**
  * High-level logging functions for convenient usage throughout the codebase
  * These provide a clean replacement for console.log calls
  */
 export class Log {
-    static debug = (message: string, ...args: any[]): void =>
+    static debug = (message: LogMessage, ...args: any[]): void =>
         LoggingService.getInstance().debug(message, ...args);
 
-    static info = (message: string, ...args: any[]): void =>
+    static info = (message: LogMessage, ...args: any[]): void =>
         LoggingService.getInstance().info(message, ...args);
 
-    static warn = (message: string, ...args: any[]): void =>
+    static warn = (message: LogMessage, ...args: any[]): void =>
         LoggingService.getInstance().warn(message, ...args);
 
-    static error = (messageOrError: string | Error, ...args: any[]): void =>
+    static error = (messageOrError: LogMessage | Error, ...args: any[]): void =>
         LoggingService.getInstance().error(messageOrError, ...args);
 }
 
@@ -145,7 +152,7 @@ export class LoggingService implements vscode.Disposable {
     private formatMessage(
         level: LogLevel,
         message: string,
-        ...args: any[]
+        formattedArgs: string[]
     ): string {
         const now = new Date();
         const timestamp = `${now.getFullYear()}-${String(now.getMonth() + 1).padStart(2, '0')}-${String(now.getDate()).padStart(2, '0')} ${String(now.getHours()).padStart(2, '0')}:${String(now.getMinutes()).padStart(2, '0')}:${String(now.getSeconds()).padStart(2, '0')}.${String(now.getMilliseconds()).padStart(3, '0')}`;
@@ -153,20 +160,21 @@ export class LoggingService implements vscode.Disposable {
         const levelStr = level;
         let formattedMessage = `${timestamp} [${levelStr}] ${message}`;
 
-        if (args.length > 0) {
-            const argsStr = args.map((arg) => this.formatArg(arg)).join(' ');
-            formattedMessage += ` ${argsStr}`;
+        if (formattedArgs.length > 0) {
+            formattedMessage += ` ${formattedArgs.join(' ')}`;
         }
 
         return formattedMessage;
     }
 
     /**
-     * Internal logging method used by all public logging methods
+     * Internal logging method used by all public logging methods.
+     * Nothing is built or serialized before the level check, so disabled
+     * levels cost a single comparison.
      */
     private _log(
         level: LogLevel,
-        message: string | Error,
+        message: LogMessage | Error,
         ...args: any[]
     ): void {
         if (!this.shouldLog(level)) {
@@ -176,13 +184,14 @@ export class LoggingService implements vscode.Disposable {
         let logMessage: string;
         if (message instanceof Error) {
             logMessage = `${message.message}\nStack trace:\n${message.stack}`;
+        } else if (typeof message === 'function') {
+            logMessage = message();
         } else {
             logMessage = message;
         }
 
         // Format args for proper error display
         const formattedArgs = args.map((arg) => this.formatArg(arg));
-        const formattedMessage = this.formatMessage(level, logMessage, ...args);
 
         const output =
             this.outputTarget === 'channel' ? this.outputChannel : console;
@@ -205,6 +214,11 @@ export class LoggingService implements vscode.Disposable {
             }
         } else {
             // Output to console based on log level
+            const formattedMessage = this.formatMessage(
+                level,
+                logMessage,
+                formattedArgs
+            );
             switch (level) {
                 case 'debug':
                 case 'info':
@@ -223,28 +237,28 @@ export class LoggingService implements vscode.Disposable {
     /**
      * Log a debug message
      */
-    public debug(message: string, ...args: any[]): void {
+    public debug(message: LogMessage, ...args: any[]): void {
         this._log('debug', message, ...args);
     }
 
     /**
      * Log an info message
      */
-    public info(message: string, ...args: any[]): void {
+    public info(message: LogMessage, ...args: any[]): void {
         this._log('info', message, ...args);
     }
 
     /**
      * Log a warning message
      */
-    public warn(message: string, ...args: any[]): void {
+    public warn(message: LogMessage, ...args: any[]): void {
         this._log('warn', message, ...args);
     }
 
     /**
      * Log an error message
      */
-    public error(messageOrError: string | Error, ...args: any[]): void {
+    public error(messageOrError: LogMessage | Error, ...args: any[]): void {
         this._log('error', messageOrError, ...args);
     }
 
@@ -0,0 +1,93 @@
+import * as zlib from 'zlib';
+import { promisify } from 'util';
+import { SubagentLimits } from '../models/toolConstants';
+import type {
+    ToolCallRecord,
+    NestedToolCallsRef,
+} from '../types/toolCallTypes';
+import { Log } from './loggingService';
+
+const gzip = promisify(zlib.gzip);
+const gunzip = promisify(zlib.gunzip);
+
+/**
+ * Out-of-line store for subagent tool calls.
+ *
+ * Subagent tool results (full file reads, symbol bodies) are only needed when the
+ * user drills into a run_subagent call in the webview. Keeping them inline in tool
+ * metadata retained them for the whole analysis and shipped them in the initial
+ * webview payload. Instead, RunSubagentTool stores them here gzip-compressed and
+ * keeps only a NestedToolCallsRef; the webview fetches them via UIManager on expand.
+ *
+ * Bounded by total compressed size with least-recently-used eviction.
+ * Long-lived (owned by ServiceManager) and shared across analyses.
+ */
+export class NestedToolCallStore {
+    private readonly entries = new Map<string, Buffer>();
+    private totalBytes = 0;
+    private nextId = 1;
+
+    /**
+     * Compress and store tool calls.
+     * @returns A reference the webview can use to fetch them later
+     */
+    async put(calls: ToolCallRecord[]): Promise<NestedToolCallsRef> {
+        const key = `nested-${this.nextId++}-${Date.now().toString(36)}`;
+        const compressed = await gzip(JSON.stringify(calls));
+
+        this.entries.set(key, compressed);
+        this.totalBytes += compressed.byteLength;
+        this.evictOverflow();
+
+        return { key, count: calls.length };
+    }
+
+    /**
+     * Fetch and decompress stored tool calls.
+     * @returns The calls, or undefined if the key is unknown or was evicted
+     */
+    async get(key: string): Promise<ToolCallRecord[] | undefined> {
+        const compressed = this.entries.get(key);
+        if (!compressed) {
+            return undefined;
+        }
+
+        // Refresh LRU position
+        this.entries.delete(key);
+        this.entries.set(key, compressed);
+
+        const json = await gunzip(compressed);
+        return JSON.parse(json.toString('utf8')) as ToolCallRecord[];
+    }
+
+    /**
+     * Total compressed bytes currently held.
+     */
+    get size(): number {
+        return this.totalBytes;
+    }
+
+    clear(): void {
+        this.entries.clear();
+        this.totalBytes = 0;
+    }
+
+    dispose(): void {
+        this.clear();
+    }
+
+    private evictOverflow(): void {
+        while (
+            this.totalBytes > SubagentLimits.NESTED_STORE_MAX_BYTES &&
+            this.entries.size > 1
+        ) {
+            const oldestKey = this.entries.keys().next().value;
+            if (oldestKey === undefined) {
+                break;
+            }
+            this.totalBytes -= this.entries.get(oldestKey)!.byteLength;
+            this.entries.delete(oldestKey);
+            Log.debug(`Nested tool call store evicted ${oldestKey}`);
+        }
+    }
+}
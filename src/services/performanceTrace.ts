@@ -0,0 +1,328 @@
+import { AsyncLocalStorage } from 'async_hooks';
+
+/**
+ * A single event in Chrome's trace-event format, loadable in
+ * chrome://tracing or https://ui.perfetto.dev.
+ */
+export interface TraceEvent {
+    name: string;
+    cat: string;
+    /** X = complete span, b/e = async span begin/end, i = instant, C = counter, M = metadata */
+    ph: 'X' | 'b' | 'e' | 'i' | 'C' | 'M';
+    /** Microseconds since the trace started */
+    ts: number;
+    /** Duration in microseconds (complete spans only) */
+    dur?: number;
+    pid: number;
+    /** Track the event is drawn on: the main agent or one subagent */
+    tid: number;
+    /** Pairs async begin/end events */
+    id?: string;
+    /** Instant event scope */
+    s?: 't';
+    args?: Record<string, unknown>;
+}
+
+/** JSON object format of a Chrome trace */
+export interface ChromeTrace {
+    traceEvents: TraceEvent[];
+    displayTimeUnit: 'ms';
+    otherData: Record<string, unknown>;
+}
+
+/**
+ * What a span measures. Sequential phases (iteration, llm, tokens) nest on
+ * their agent's track; concurrent work (tools, LSP calls, processes,
+ * subagents) is recorded as async spans.
+ */
+export type TraceCategory =
+    | 'analysis'
+    | 'iteration'
+    | 'llm'
+    | 'tokens'
+    | 'tool'
+    | 'lsp'
+    | 'process'
+    | 'subagent'
+    | 'memory';
+
+export interface TraceSpan {
+    /** Close the span; args are merged into the event. Later calls are ignored. */
+    end(args?: Record<string, unknown>): void;
+}
+
+const NOOP_SPAN: TraceSpan = { end: () => {} };
+const PID = 1;
+/** Keeps a runaway analysis from growing the trace without bound */
+const MAX_EVENTS = 50_000;
+
+/**
+ * Collects the trace events of one analysis.
+ *
+ * Events are recorded through the Trace facade; create one PerformanceTrace
+ * per analysis and run the analysis inside Trace.run().
+ */
+export class PerformanceTrace {
+    private readonly events: TraceEvent[] = [];
+    private readonly origin = performance.now();
+    private readonly startedAt = new Date();
+    private nextTrackId = 1;
+    private nextSpanId = 1;
+    private droppedEvents = 0;
+    private readonly metadata: Record<string, unknown> = {};
+
+    constructor(readonly label: string) {
+        this.push({
+            name: 'process_name',
+            cat: '__metadata',
+            ph: 'M',
+            ts: 0,
+            pid: PID,
+            tid: 0,
+            args: { name: `Lupa: ${label}` },
+        });
+    }
+
+    /** Register a named track and return its id */
+    createTrack(name: string): number {
+        const tid = this.nextTrackId++;
+        this.push({
+            name: 'thread_name',
+            cat: '__metadata',
+            ph: 'M',
+            ts: 0,
+            pid: PID,
+            tid,
+            args: { name },
+        });
+        return tid;
+    }
+
+    span(
+        tid: number,
+        name: string,
+        cat: TraceCategory,
+        args?: Record<string, unknown>
+    ): TraceSpan {
+        const ts = this.now();
+        let ended = false;
+        return {
+            end: (endArgs) => {
+                if (ended) {
+                    return;
+                }
+                ended = true;
+                this.push({
+                    name,
+                    cat,
+                    ph: 'X',
+                    ts,
+                    dur: this.now() - ts,
+                    pid: PID,
+                    tid,
+                    args: mergeArgs(args, endArgs),
+                });
+            },
+        };
+    }
+
+    asyncSpan(
+        tid: number,
+        name: string,
+        cat: TraceCategory,
+        args?: Record<string, unknown>
+    ): TraceSpan {
+        const id = String(this.nextSpanId++);
+        this.push({
+            name,
+            cat,
+            ph: 'b',
+            ts: this.now(),
+            pid: PID,
+            tid,
+            id,
+            args,
+        });
+        let ended = false;
+        return {
+            end: (endArgs) => {
+                if (ended) {
+                    return;
+                }
+                ended = true;
+                this.push({
+                    name,
+                    cat,
+                    ph: 'e',
+                    ts: this.now(),
+                    pid: PID,
+                    tid,
+                    id,
+                    args: endArgs,
+                });
+            },
+        };
+    }
+
+    instant(
+        tid: number,
+        name: string,
+        cat: TraceCategory,
+        args?: Record<string, unknown>
+    ): void {
+        this.push({
+            name,
+            cat,
+            ph: 'i',
+            s: 't',
+            ts: this.now(),
+            pid: PID,
+            tid,
+            args,
+        });
+    }
+
+    /** Counter values are drawn as a stacked graph per name */
+    counter(tid: number, name: string, values: Record<string, number>): void {
+        this.push({
+            name,
+            cat: 'memory',
+            ph: 'C',
+            ts: this.now(),
+            pid: PID,
+            tid,
+            args: values,
+        });
+    }
+
+    /** Attach a value to the exported trace's otherData */
+    setMetadata(key: string, value: unknown): void {
+        this.metadata[key] = value;
+    }
+
+    toJSON(): ChromeTrace {
+        return {
+            traceEvents: [...this.events],
+            displayTimeUnit: 'ms',
+            otherData: {
+                ...this.metadata,
+                label: this.label,
+                startedAt: this.startedAt.toISOString(),
+                droppedEvents: this.droppedEvents,
+            },
+        };
+    }
+
+    private now(): number {
+        return Math.round((performance.now() - this.origin) * 1000);
+    }
+
+    private push(event: TraceEvent): void {
+        if (this.events.length >= MAX_EVENTS) {
+            this.droppedEvents++;
+            return;
+        }
+        this.events.push(event);
+    }
+}
+
+function mergeArgs(
+    start: Record<string, unknown> | undefined,
+    end: Record<string, unknown> | undefined
+): Record<string, unknown> | undefined {
+    return start && end ? { ...start, ...end } : (start ?? end);
+}
+
+interface TraceScope {
+    trace: PerformanceTrace;
+    tid: number;
+}
+
+const scopes = new AsyncLocalStorage<TraceScope>();
+
+/**
+ * Records spans on the trace of the analysis running in the current async
+ * context, so concurrent analyses never share a trace and instrumented code
+ * (tools, LSP helpers, ripgrep) needs no trace parameter.
+ *
+ * Every method is a no-op outside Trace.run().
+ */
+export class Trace {
+    /** Run fn with `trace` active, recording on a track named after the trace */
+    static run<T>(trace: PerformanceTrace, fn: () => T): T {
+        return scopes.run(
+            { trace, tid: trace.createTrack(trace.label) },
+            fn
+        );
+    }
+
+    /** Run fn on a new track of the active trace (e.g., one per subagent) */
+    static track<T>(name: string, fn: () => T): T {
+        const scope = scopes.getStore();
+        if (!scope) {
+            return fn();
+        }
+        return scopes.run(
+            { trace: scope.trace, tid: scope.trace.createTrack(name) },
+            fn
+        );
+    }
+
+    /** Span for a sequential phase; must close before its enclosing span */
+    static span(
+        name: string,
+        cat: TraceCategory,
+        args?: Record<string, unknown>
+    ): TraceSpan {
+        const scope = scopes.getStore();
+        return scope
+            ? scope.trace.span(scope.tid, name, cat, args)
+            : NOOP_SPAN;
+    }
+
+    /** Span for work that may overlap other spans on the same track */
+    static asyncSpan(
+        name: string,
+        cat: TraceCategory,
+        args?: Record<string, unknown>
+    ): TraceSpan {
+        const scope = scopes.getStore();
+        return scope
+            ? scope.trace.asyncSpan(scope.tid, name, cat, args)
+            : NOOP_SPAN;
+    }
+
+    static instant(
+        name: string,
+        cat: TraceCategory,
+        args?: Record<string, unknown>
+    ): void {
+        const scope = scopes.getStore();
+        scope?.trace.instant(scope.tid, name, cat, args);
+    }
+
+    static counter(name: string, values: Record<string, number>): void {
+        const scope = scopes.getStore();
+        scope?.trace.counter(scope.tid, name, values);
+    }
+
+    /**
+     * Record an async span covering `thenable` and return it as a promise.
+     * The span closes when it settles, even if the caller stopped waiting
+     * (e.g., an LSP call that outlived its timeout).
+     */
+    static measure<T>(
+        name: string,
+        cat: TraceCategory,
+        thenable: Thenable<T>,
+        args?: Record<string, unknown>
+    ): Promise<T> {
+        const span = Trace.asyncSpan(name, cat, args);
+        const promise = Promise.resolve(thenable);
+        promise.then(
+            () => span.end(),
+            () => span.end({ failed: true })
+        );
+        return promise;
+    }
+}
@@ -8,12 +8,18 @@
 export class PlanSessionManager {
     private plan: string | undefined;
 
+    /**
+     * @param onPlanUpdated Called with every new plan (e.g. to show it live)
+     */
+    constructor(private readonly onPlanUpdated?: (plan: string) => void) {}
+
     /**
      * Update the current plan.
      * @param plan Markdown-formatted plan string
      */
     updatePlan(plan: string): void {
         this.plan = plan;
+        this.onPlanUpdated?.(plan);
     }
 
     /**
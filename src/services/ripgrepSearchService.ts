@@ -5,6 +5,7 @@ import * as vscode from 'vscode';
 import { CodeFileDetector } from '../utils/codeFileDetector';
 import { getErrorMessage } from '../utils/errorUtils';
 import { Log } from './loggingService';
+import { Trace } from './performanceTrace';
 
 /**
  * Gets the path to ripgrep binary bundled with VS Code.
@@ -13,13 +14,14 @@ import { Log } from './loggingService';
  * - node_modules/@vscode/ripgrep/bin/ (standard installation)
  * - node_modules.asar.unpacked/@vscode/ripgrep/bin/ (asar-packed builds)
  *
- * This function checks both paths and returns the first one that exists.
+ * This function checks both paths and returns the first one that exists, or
+ * throws if neither does.
  *
  * If VS Code changes this path in the future, the extension should fall back
  * to platform-specific packaging with @vscode/ripgrep as a bundled dependency.
  * See: https://code.visualstudio.com/api/working-with-extensions/publishing-extension#platformspecific-extensions
  */
-function getVSCodeRipgrepPath(): string {
+async function getVSCodeRipgrepPath(): Promise<string> {
     const rgBinary = process.platform === 'win32' ? 'rg.exe' : 'rg';
     const appRoot = vscode.env.appRoot;
 
@@ -44,13 +46,16 @@ function getVSCodeRipgrepPath(): string {
     ];
 
     for (const candidatePath of candidatePaths) {
-        if (fs.existsSync(candidatePath)) {
+        if (await validateRipgrepPath(candidatePath)) {
             return candidatePath;
         }
     }
 
-    // Return the first path for error messaging (will fail validation)
-    return candidatePaths[0]!;
+    throw new Error(
+        `VS Code ripgrep binary not found at: ${candidatePaths[0]}. ` +
+            `This may indicate VS Code has changed its internal structure. ` +
+            `Please report this issue at https://github.com/auric/lupa/issues`
+    );
 }
 
 /**
@@ -71,8 +76,13 @@ const SIGKILL_FINAL_WATCHDOG_MS = 5000;
  * Validates that the VS Code ripgrep binary exists at the expected path.
  * @returns true if the binary exists, false otherwise
  */
-export function validateRipgrepPath(rgPath: string): boolean {
-    return fs.existsSync(rgPath);
+export async function validateRipgrepPath(rgPath: string): Promise<boolean> {
+    try {
+        await fs.promises.access(rgPath);
+        return true;
+    } catch {
+        return false;
+    }
 }
 
 export interface RipgrepMatch {
@@ -159,22 +169,23 @@ interface RipgrepSummaryData {
 }
 
 export class RipgrepSearchService {
-    private readonly rgPath: string;
-
-    constructor() {
-        this.rgPath = getVSCodeRipgrepPath();
-
-        // Validate ripgrep binary exists at startup
-        if (!validateRipgrepPath(this.rgPath)) {
-            const errorMsg =
-                `VS Code ripgrep binary not found at: ${this.rgPath}. ` +
-                `This may indicate VS Code has changed its internal structure. ` +
-                `Please report this issue at https://github.com/auric/lupa/issues`;
-            throw new Error(errorMsg);
-        }
+    /**
+     * Binary path, located on the first search rather than at construction so
+     * extension activation doesn't probe the file system
+     */
+    private rgPath: Promise<string> | undefined;
+
+    private getRipgrepPath(): Promise<string> {
+        this.rgPath ??= getVSCodeRipgrepPath().catch((error: unknown) => {
+            // Retry on the next search rather than caching the failure
+            this.rgPath = undefined;
+            throw error;
+        });
+        return this.rgPath;
     }
 
     async search(options: RipgrepSearchOptions): Promise<RipgrepFileResult[]> {
+        const rgPath = await this.getRipgrepPath();
         const args = this.buildArgs(options);
 
         return new Promise((resolve, reject) => {
@@ -190,7 +201,10 @@ export class RipgrepSearchService {
             const results = new Map<string, RipgrepMatch[]>();
             let stderr = '';
 
-            const rg: ChildProcess = spawn(this.rgPath, args, {
+            const processSpan = Trace.asyncSpan('ripgrep', 'process', {
+                pattern: options.pattern,
+            });
+            const rg: ChildProcess = spawn(rgPath, args, {
                 cwd: options.cwd,
                 stdio: ['ignore', 'pipe', 'pipe'],
             });
@@ -265,6 +279,7 @@ export class RipgrepSearchService {
                                         );
                                         settled = true;
                                         clearAllTimersAndDisposables();
+                                        processSpan.end({ unresponsive: true });
                                         // Remove process listeners to prevent resource leaks
                                         // since the process may still be alive
                                         removeAllProcessListeners();
@@ -316,6 +331,7 @@ export class RipgrepSearchService {
                 }
                 settled = true;
                 clearAllTimersAndDisposables();
+                processSpan.end({ exitCode: code, files: results.size });
 
                 if (options.token.isCancellationRequested) {
                     reject(new vscode.CancellationError());
@@ -354,6 +370,7 @@ export class RipgrepSearchService {
                 }
                 settled = true;
                 clearAllTimersAndDisposables();
+                processSpan.end({ error: err.message });
                 reject(new Error(`Failed to spawn ripgrep: ${err.message}`));
             });
         });
@@ -9,6 +9,9 @@ import { CopilotModelManager } from '../models/copilotModelManager';
 import { UIManager } from './uiManager';
 import { GitOperationsManager } from './gitOperationsManager';
 import { ToolTestingWebviewService } from './toolTestingWebview';
+import { SubagentResultCache } from './subagentResultCache';
+import { NestedToolCallStore } from './nestedToolCallStore';
+import { ToolMetricsStore } from './toolMetricsStore';
 
 import { LanguageModelToolProvider } from './languageModelToolProvider';
 
@@ -35,6 +38,7 @@ import { ThinkAboutTaskTool } from '../tools/thinkAboutTaskTool';
 import { ThinkAboutCompletionTool } from '../tools/thinkAboutCompletionTool';
 import { ThinkAboutInvestigationTool } from '../tools/thinkAboutInvestigationTool';
 import { RunSubagentTool } from '../tools/runSubagentTool';
+import { RunSubagentsTool } from '../tools/runSubagentsTool';
 import { UpdatePlanTool } from '../tools/updatePlanTool';
 import { SubmitReviewTool } from '../tools/submitReviewTool';
 
@@ -67,6 +71,9 @@ export interface IServiceRegistry {
     toolExecutor: ToolExecutor;
     conversationManager: ConversationManager;
     toolCallingAnalysisProvider: ToolCallingAnalysisProvider;
+    subagentResultCache: SubagentResultCache;
+    nestedToolCallStore: NestedToolCallStore;
+    toolMetrics: ToolMetricsStore;
 
     // Note: SubagentExecutor and SubagentSessionManager are created per-analysis
     // in ToolCallingAnalysisProvider for concurrent-safety.
@@ -85,6 +92,8 @@ export class ServiceManager implements vscode.Disposable {
     private disposed = false;
     /** Token source for utility ToolExecutor - disposed on shutdown */
     private utilityTokenSource: vscode.CancellationTokenSource | undefined;
+    /** Milliseconds spent in each initialization phase, in order */
+    private readonly phaseTimings: [string, number][] = [];
 
     constructor(private readonly context: vscode.ExtensionContext) {}
 
@@ -97,16 +106,31 @@ export class ServiceManager implements vscode.Disposable {
         }
 
         try {
+            const start = performance.now();
+
             // Phase 1: Foundation services (no dependencies)
-            await this.initializeFoundationServices();
+            await this.timePhase('foundation', () =>
+                this.initializeFoundationServices()
+            );
 
             // Phase 2: Core services (depend on foundation)
-            await this.initializeCoreServices();
+            await this.timePhase('core', () => this.initializeCoreServices());
 
             // Phase 3: High-level services (depend on core services)
-            await this.initializeHighLevelServices();
+            await this.timePhase('high-level', () =>
+                this.initializeHighLevelServices()
+            );
 
             this.initialized = true;
+            this.services.toolCallingAnalysisProvider?.setStartupTimings(
+                this.getStartupTimings()
+            );
+            const phases = this.phaseTimings
+                .map(([phase, ms]) => `${phase} ${Math.round(ms)}ms`)
+                .join(', ');
+            Log.info(
+                `[ServiceManager]: Services initialized in ${Math.round(performance.now() - start)}ms (${phases})`
+            );
             return this.services as IServiceRegistry;
         } catch (error) {
             throw new Error(
@@ -115,6 +139,27 @@ export class ServiceManager implements vscode.Disposable {
         }
     }
 
+    /**
+     * Time spent in each initialization phase, in completion order. Git and
+     * tool registration are timed separately as well and are included in
+     * their enclosing phase.
+     */
+    public getStartupTimings(): ReadonlyArray<[string, number]> {
+        return this.phaseTimings;
+    }
+
+    private async timePhase<T>(
+        phase: string,
+        run: () => Promise<T> | T
+    ): Promise<T> {
+        const start = performance.now();
+        try {
+            return await run();
+        } finally {
+            this.phaseTimings.push([phase, performance.now() - start]);
+        }
+    }
+
     /**
      * Get initialized service registry
      */
@@ -135,6 +180,8 @@ export class ServiceManager implements vscode.Disposable {
         this.services.workspaceSettings = new WorkspaceSettingsService(
             this.context
         );
+        // Settings are read asynchronously; logging and git need them loaded
+        await this.services.workspaceSettings.whenLoaded();
         this.services.logging = LoggingService.getInstance();
         this.services.logging.initialize(this.services.workspaceSettings);
 
@@ -144,14 +191,24 @@ export class ServiceManager implements vscode.Disposable {
         this.services.gitOperations = new GitOperationsManager(
             this.services.workspaceSettings
         );
-        await this.services.gitOperations.initialize();
+        await this.timePhase('git', () =>
+            this.services.gitOperations!.initialize()
+        );
 
         // Get Git repository root path for UIManager dependency injection
         const repository = this.services.gitOperations.getRepository();
         const gitRootPath = repository?.rootUri.fsPath || '';
 
+        // Subagent tool calls are stored out-of-line here and fetched by the
+        // analysis webview through UIManager on demand
+        this.services.nestedToolCallStore = new NestedToolCallStore();
+
         // Initialize UIManager with Git repository root path
-        this.services.uiManager = new UIManager(this.context, gitRootPath);
+        this.services.uiManager = new UIManager(
+            this.context,
+            gitRootPath,
+            this.services.nestedToolCallStore
+        );
     }
 
     /**
@@ -196,6 +253,13 @@ export class ServiceManager implements vscode.Disposable {
             utilityContext
         );
         this.services.conversationManager = new ConversationManager();
+        // Per-tool latency/size statistics, shared by every ToolExecutor
+        this.services.toolMetrics = new ToolMetricsStore();
+        // Shared across analyses so repeated reviews of the same branch can reuse
+        // subagent investigations whose files are unchanged
+        this.services.subagentResultCache = new SubagentResultCache(
+            this.services.gitOperations!
+        );
         // Note: SubagentSessionManager and SubagentExecutor are created per-analysis
         // in ToolCallingAnalysisProvider for concurrent-safety.
         // Note: ToolCallingAnalysisProvider creates its own ConversationManager per-analysis
@@ -205,11 +269,14 @@ export class ServiceManager implements vscode.Disposable {
                 this.services.toolRegistry,
                 this.services.copilotModelManager!,
                 this.services.promptGenerator!,
-                this.services.workspaceSettings!
+                this.services.workspaceSettings!,
+                this.services.subagentResultCache,
+                this.services.nestedToolCallStore!,
+                this.services.toolMetrics
             );
 
         // Register available tools
-        this.initializeTools();
+        await this.timePhase('tools', () => this.initializeTools());
 
         // Note: PlanSessionManager is created per-analysis in ToolCallingAnalysisProvider
 
@@ -221,7 +288,8 @@ export class ServiceManager implements vscode.Disposable {
             this.context,
             gitRootPath,
             this.services.toolRegistry,
-            this.services.workspaceSettings!
+            this.services.workspaceSettings!,
+            this.services.toolMetrics
         );
 
         this.services.chatParticipantService =
@@ -232,6 +300,8 @@ export class ServiceManager implements vscode.Disposable {
             promptGenerator: this.services.promptGenerator!,
             gitOperations: this.services.gitOperations!,
             copilotModelManager: this.services.copilotModelManager!,
+            subagentResultCache: this.services.subagentResultCache!,
+            toolMetrics: this.services.toolMetrics!,
         });
 
         // Register language model tools for Agent Mode
@@ -313,6 +383,9 @@ export class ServiceManager implements vscode.Disposable {
                 this.services.workspaceSettings!
             );
             this.services.toolRegistry!.registerTool(runSubagentTool);
+            this.services.toolRegistry!.registerTool(
+                new RunSubagentsTool(this.services.workspaceSettings!)
+            );
 
             // Register the SubmitReviewTool for explicit completion signaling
             this.services.toolRegistry!.registerTool(new SubmitReviewTool());
@@ -345,6 +418,8 @@ export class ServiceManager implements vscode.Disposable {
             this.services.promptGenerator,
             this.services.languageModelToolProvider,
             this.services.toolCallingAnalysisProvider,
+            this.services.subagentResultCache,
+            this.services.nestedToolCallStore,
             this.services.conversationManager,
             this.services.toolExecutor,
             this.services.toolRegistry,
@@ -0,0 +1,215 @@
+import { WorkspaceSettingsService } from './workspaceSettingsService';
+import { SubagentLimits } from '../models/toolConstants';
+import type { ConversationBudget } from '../models/conversationRunner';
+import type {
+    SubagentTask,
+    SubagentBudget,
+    SubagentUsage,
+} from '../types/modelTypes';
+import { Log } from './loggingService';
+
+/** Numbered questions ("1. ...", "2) ...") in the task template */
+const QUESTION_PATTERN = /^\s*\d+[.)]\s/gm;
+/** File references such as src/auth.ts or utils/pathUtils.tsx */
+const FILE_REFERENCE_PATTERN = /[\w./-]+\.[a-z]{1,5}\b/gi;
+
+/**
+ * Allocates iteration, token and time budgets to subagents from a per-analysis pool.
+ *
+ * Pools are sized from the parent conversation's remaining budget when the
+ * first subagent spawns:
+ * - iterations: parent iterations left × BUDGET_ITERATION_POOL_FACTOR
+ * - tokens: iteration pool × BUDGET_TOKENS_PER_ITERATION, capped by the parent's token budget
+ * - time: the parent's expected remaining run time, minus a reserve for the parent
+ *
+ * The parent is consulted again on every spawn, so the pools shrink as the
+ * parent uses up its own iterations and time. The parent's time estimate
+ * assumes it runs to maxIterations, so it is also capped by the configured
+ * wall-clock window: requestTimeout × BUDGET_TIME_WINDOW_FACTOR from
+ * `startedAt`, less the reserve. Without a linked parent the pools fall back
+ * to workspace settings (maxIterations, and that window).
+ *
+ * Each spawn receives a fair share of what remains (divided by the spawns still
+ * allowed), scaled by a weight estimated from the task. Unused iterations and
+ * tokens are returned to the pool when the subagent finishes, so later spawns
+ * benefit from early finishers. Time is not pooled: late spawns only get the
+ * time left before the parent needs their results.
+ *
+ * Created per-analysis (via SubagentSessionManager) for concurrency safety.
+ */
+export class SubagentBudgetScheduler {
+    private iterationsRemaining: number;
+    private tokensRemaining: number;
+    private readonly deadline: number;
+
+    /**
+     * @param workspaceSettings Per-subagent limits, and pool sizes without a parent
+     * @param startedAt Start of the wall-clock time window
+     * @param parentBudget Remaining budget of the conversation that spawns the subagents
+     */
+    constructor(
+        private readonly workspaceSettings: WorkspaceSettingsService,
+        startedAt: number = Date.now(),
+        private readonly parentBudget?: () => ConversationBudget
+    ) {
+        const parent = parentBudget?.();
+        this.iterationsRemaining =
+            (parent?.iterations ?? workspaceSettings.getMaxIterations()) *
+            SubagentLimits.BUDGET_ITERATION_POOL_FACTOR;
+        this.tokensRemaining = Math.min(
+            this.iterationsRemaining *
+                SubagentLimits.BUDGET_TOKENS_PER_ITERATION,
+            parent?.tokens ?? Infinity
+        );
+        this.deadline =
+            startedAt +
+            workspaceSettings.getRequestTimeoutSeconds() *
+                1000 *
+                SubagentLimits.BUDGET_TIME_WINDOW_FACTOR -
+            SubagentLimits.BUDGET_PARENT_RESERVE_MS;
+    }
+
+    /**
+     * Reserve a budget for a new subagent.
+     * @param task The task to size the budget for
+     * @param remainingSpawns Spawns still allowed this session, including this one
+     * @returns The reserved budget, or undefined if the pool can't fund a useful run
+     */
+    allocate(
+        task: SubagentTask,
+        remainingSpawns: number
+    ): SubagentBudget | undefined {
+        const minTokens =
+            SubagentLimits.BUDGET_MIN_ITERATIONS *
+            SubagentLimits.BUDGET_TOKENS_PER_ITERATION;
+        const available = this.getAvailable();
+        const timeLeft = available.timeMs;
+
+        if (
+            available.iterations < SubagentLimits.BUDGET_MIN_ITERATIONS ||
+            available.tokens < minTokens ||
+            timeLeft < SubagentLimits.BUDGET_MIN_TIMEOUT_MS
+        ) {
+            Log.warn(
+                `Subagent budget exhausted: ${available.iterations} iterations, ` +
+                    `${available.tokens} tokens, ${Math.max(0, Math.round(timeLeft / 1000))}s left`
+            );
+            return undefined;
+        }
+
+        const weight = SubagentBudgetScheduler.estimateTaskWeight(task);
+        const slots = Math.max(1, remainingSpawns);
+
+        const iterations = scaledShare(
+            available.iterations,
+            slots,
+            weight,
+            SubagentLimits.BUDGET_MIN_ITERATIONS,
+            this.workspaceSettings.getMaxIterations()
+        );
+        const tokens = scaledShare(
+            available.tokens,
+            slots,
+            weight,
+            minTokens,
+            iterations * SubagentLimits.BUDGET_TOKENS_PER_ITERATION
+        );
+        const timeoutMs = Math.min(
+            this.workspaceSettings.getRequestTimeoutSeconds() * 1000,
+            timeLeft
+        );
+
+        this.iterationsRemaining -= iterations;
+        this.tokensRemaining -= tokens;
+
+        return { iterations, tokens, timeoutMs };
+    }
+
+    /**
+     * Return the unused part of an allocation to the pool.
+     * Without usage (e.g., the run threw), the allocation is treated as spent.
+     */
+    release(budget: SubagentBudget, usage: SubagentUsage | undefined): void {
+        if (!usage) {
+            return;
+        }
+        const iterations = Math.max(0, budget.iterations - usage.iterations);
+        const tokens = Math.max(0, budget.tokens - usage.tokens);
+        this.iterationsRemaining += iterations;
+        this.tokensRemaining += tokens;
+        Log.debug(
+            `Subagent budget returned: ${iterations} iterations, ${tokens} tokens`
+        );
+    }
+
+    /**
+     * What a spawn can draw on now: the pools, capped by what the parent has
+     * left. A subagent can use at most BUDGET_ITERATION_POOL_FACTOR iterations
+     * per parent iteration remaining.
+     */
+    private getAvailable(): ConversationBudget & { tokens: number } {
+        const parent = this.parentBudget?.();
+        if (!parent) {
+            return {
+                iterations: this.iterationsRemaining,
+                tokens: this.tokensRemaining,
+                timeMs: this.deadline - Date.now(),
+            };
+        }
+
+        const iterations = Math.min(
+            this.iterationsRemaining,
+            parent.iterations * SubagentLimits.BUDGET_ITERATION_POOL_FACTOR
+        );
+        return {
+            iterations,
+            tokens: Math.min(
+                this.tokensRemaining,
+                iterations * SubagentLimits.BUDGET_TOKENS_PER_ITERATION,
+                parent.tokens ?? Infinity
+            ),
+            timeMs: Math.min(
+                parent.timeMs - SubagentLimits.BUDGET_PARENT_RESERVE_MS,
+                this.deadline - Date.now()
+            ),
+        };
+    }
+
+    getIterationsRemaining(): number {
+        return this.iterationsRemaining;
+    }
+
+    getTokensRemaining(): number {
+        return this.tokensRemaining;
+    }
+
+    /**
+     * Estimate relative task size from the structure the run_subagent template asks for:
+     * each numbered question and each referenced file adds to a base weight.
+     */
+    static estimateTaskWeight(task: SubagentTask): number {
+        const text = `${task.task}\n${task.context ?? ''}`;
+        const questions = text.match(QUESTION_PATTERN)?.length ?? 0;
+        const files = new Set(text.match(FILE_REFERENCE_PATTERN) ?? []).size;
+        const weight = 0.75 + 0.25 * (questions + files);
+        return Math.min(
+            SubagentLimits.BUDGET_MAX_TASK_WEIGHT,
+            Math.max(SubagentLimits.BUDGET_MIN_TASK_WEIGHT, weight)
+        );
+    }
+}
+
+/**
+ * Fair share of `remaining` across `slots`, scaled by `weight` and clamped to
+ * [min, max]. Never exceeds what remains in the pool.
+ */
+function scaledShare(
+    remaining: number,
+    slots: number,
+    weight: number,
+    min: number,
+    max: number
+): number {
+    const share = Math.round((remaining / slots) * weight);
+    return Math.min(remaining, max, Math.max(min, share));
+}
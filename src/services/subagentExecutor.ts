@@ -3,11 +3,18 @@ import { ConversationManager } from '../models/conversationManager';
 import { ConversationRunner } from '../models/conversationRunner';
 import { ToolRegistry } from '../models/toolRegistry';
 import { ToolExecutor } from '../models/toolExecutor';
+import type { ToolResultCache } from '../models/toolResultCache';
+import type { ToolMetricsStore } from './toolMetricsStore';
 import { CopilotModelManager } from '../models/copilotModelManager';
 import { SubagentPromptGenerator } from '../prompts/subagentPromptGenerator';
 import { SubagentLimits } from '../models/toolConstants';
 import { SubagentStreamAdapter } from '../models/subagentStreamAdapter';
-import type { SubagentTask, SubagentResult } from '../types/modelTypes';
+import type {
+    SubagentTask,
+    SubagentResult,
+    SubagentBudget,
+    SubagentUsage,
+} from '../types/modelTypes';
 import type {
     ToolCallRecord,
     AnalysisProgressCallback,
@@ -20,6 +27,19 @@ import { Log } from './loggingService';
 import { isCancellationError } from '../utils/asyncUtils';
 import { getErrorMessage } from '../utils/errorUtils';
 import { WorkspaceSettingsService } from './workspaceSettingsService';
+import { SubagentResultCache } from './subagentResultCache';
+
+/**
+ * Per-invocation options handed down from the parent analysis.
+ */
+export interface SubagentExecutionOptions {
+    /** Parent's read-only tool cache, shared so the subagent reuses (and feeds) its results */
+    toolResultCache?: ToolResultCache;
+    /** Parent's tool metrics store, so subagent tool calls are counted too */
+    toolMetrics?: ToolMetricsStore;
+    /** Iteration and token limits from SubagentBudgetScheduler; defaults to settings when omitted */
+    budget?: SubagentBudget;
+}
 
 /**
  * Executes subagent investigations with isolated context.
@@ -32,6 +52,7 @@ import { WorkspaceSettingsService } from './workspaceSettingsService';
  * - Filter tools to prevent infinite recursion
  * - Stream tool calls to parent's chat UI with subagent prefix
  * - Return raw response for parent LLM to interpret
+ * - Reuse cached results for equivalent tasks whose files are unchanged
  */
 export class SubagentExecutor {
     constructor(
@@ -41,7 +62,8 @@ export class SubagentExecutor {
         private readonly workspaceSettings: WorkspaceSettingsService,
         private readonly chatHandler?: ChatToolCallHandler,
         private readonly progressCallback?: AnalysisProgressCallback,
-        private readonly progressContext?: SubagentProgressContext
+        private readonly progressContext?: SubagentProgressContext,
+        private readonly resultCache?: SubagentResultCache
     ) {}
 
     /**
@@ -69,11 +91,13 @@ export class SubagentExecutor {
      * @param task The investigation task
      * @param token Cancellation token
      * @param subagentId Unique ID for this subagent (for logging)
+     * @param options State shared from the parent analysis (tool cache, budget)
      */
     async execute(
         task: SubagentTask,
         token: vscode.CancellationToken,
-        subagentId: number
+        subagentId: number,
+        options: SubagentExecutionOptions = {}
     ): Promise<SubagentResult> {
         const startTime = Date.now();
         let toolCallsMade = 0;
@@ -86,6 +110,15 @@ export class SubagentExecutor {
         const logLabel = `Subagent #${subagentId}`;
 
         try {
+            const cached = await this.resultCache?.get(task);
+            if (cached) {
+                Log.info(
+                    `${logLabel} Reused cached result for "${taskLabel}" (${cached.toolCallsMade} tool calls saved)`
+                );
+                this.reportProgress(`Sub-analysis (cached): ${taskLabel}`, 0.5);
+                return { ...cached, usage: { iterations: 0, tokens: 0 } };
+            }
+
             Log.info(`${logLabel} Starting: "${taskLabel}"`);
             this.reportProgress(`Sub-analysis: ${taskLabel}`, 0.5);
 
@@ -93,28 +126,35 @@ export class SubagentExecutor {
             const filteredTools = this.filterTools();
             const filteredRegistry = this.createFilteredRegistry(filteredTools);
 
-            // Pass cancellationToken so subagent tools can observe cancellation.
+            // Pass cancellationToken so subagent tools can observe cancellation, and the
+            // parent's tool cache so reads already done by the parent or siblings are reused.
             // Note: planManager and subagentExecutor are NOT passed - SubagentLimits.DISALLOWED_TOOLS
             // filters out run_subagent and update_plan which require those dependencies.
             const toolExecutor = new ToolExecutor(
                 filteredRegistry,
                 this.workspaceSettings,
-                { cancellationToken: token }
+                {
+                    cancellationToken: token,
+                    toolResultCache: options.toolResultCache,
+                    toolMetrics: options.toolMetrics,
+                }
             );
             const conversationRunner = new ConversationRunner(
                 this.modelManager,
                 toolExecutor
             );
 
-            const maxIterations = this.workspaceSettings.getMaxIterations();
-            const systemPrompt = this.promptGenerator.generateSystemPrompt(
-                task,
-                filteredTools,
-                maxIterations
+            const maxIterations =
+                options.budget?.iterations ??
+                this.workspaceSettings.getMaxIterations();
+            // Task details go in the first user message so the system prompt is
+            // identical across subagents (shared prompt-cache prefix)
+            const systemPrompt =
+                this.promptGenerator.generateSystemPrompt(filteredTools);
+            conversation.addUserMessage(
+                this.promptGenerator.generateTaskMessage(task, maxIterations)
             );
 
-            conversation.addUserMessage(`Please investigate: ${task.task}`);
-
             // Track tool calls made by the subagent with full details
             const toolCalls: ToolCallRecord[] = [];
 
@@ -131,6 +171,7 @@ export class SubagentExecutor {
                     maxIterations,
                     tools: filteredTools,
                     label: logLabel,
+                    tokenBudget: options.budget?.tokens,
                 },
                 conversation,
                 token,
@@ -194,6 +235,10 @@ export class SubagentExecutor {
             );
 
             const duration = Date.now() - startTime;
+            const usage: SubagentUsage = {
+                iterations: conversationRunner.iterationsUsed,
+                tokens: conversationRunner.tokensUsed,
+            };
 
             // Check max iterations first — runner completed but hit the limit.
             // This must be checked before cancellation since the token may also
@@ -208,6 +253,7 @@ export class SubagentExecutor {
                     toolCallsMade,
                     toolCalls,
                     error: 'max_iterations',
+                    usage,
                 };
             }
 
@@ -217,25 +263,32 @@ export class SubagentExecutor {
                 Log.warn(
                     `${logLabel} Cancelled after ${duration}ms with ${toolCallsMade} tool calls`
                 );
+                // Keep the reasoning gathered so far; the run may have been stopped
+                // early by the orchestrator rather than abandoned.
                 return {
                     success: false,
-                    response: '',
+                    response: this.collectPartialResponse(conversation),
                     toolCallsMade,
                     toolCalls,
                     error: 'cancelled',
+                    usage,
                 };
             }
 
             Log.info(
-                `${logLabel} Completed in ${duration}ms with ${toolCallsMade} tool calls`
+                `${logLabel} Completed in ${duration}ms with ${toolCallsMade} tool calls ` +
+                    `(${usage.iterations}/${maxIterations} iterations, ~${usage.tokens} prompt tokens)`
             );
 
-            return {
+            const result: SubagentResult = {
                 success: true,
                 response,
                 toolCallsMade,
                 toolCalls,
+                usage,
             };
+            await this.resultCache?.set(task, result, startTime);
+            return result;
         } catch (error) {
             if (isCancellationError(error)) {
                 throw error;
@@ -254,6 +307,17 @@ export class SubagentExecutor {
         }
     }
 
+    /**
+     * Join the assistant text written before cancellation (tool calls excluded).
+     */
+    private collectPartialResponse(conversation: ConversationManager): string {
+        return conversation
+            .getMessagesByRole('assistant')
+            .map((message) => message.content?.trim())
+            .filter((content): content is string => !!content)
+            .join('\n\n');
+    }
+
     /**
      * Filter tools to exclude run_subagent and prevent infinite recursion.
      */
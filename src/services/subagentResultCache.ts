@@ -0,0 +1,289 @@
+import * as vscode from 'vscode';
+import * as path from 'path';
+import { GitOperationsManager } from './gitOperationsManager';
+import { SubagentLimits } from '../models/toolConstants';
+import { PathSanitizer } from '../utils/pathSanitizer';
+import type { SubagentTask, SubagentResult } from '../types/modelTypes';
+import type { ToolCallRecord } from '../types/toolCallTypes';
+import { Log } from './loggingService';
+
+/**
+ * Tool argument keys that name a file or directory the subagent read.
+ * Covers every path-taking argument of the read-only tools.
+ */
+const PATH_ARGUMENT_KEYS = [
+    'file_path',
+    'relative_path',
+    'path',
+    'search_path',
+    'search_directory',
+] as const;
+
+/**
+ * Tools whose results depend on files anywhere in the workspace rather than
+ * on the paths in their arguments. Runs that used them are not cached, since
+ * an edit to any matching file would go unnoticed.
+ */
+const WORKSPACE_SEARCH_TOOLS = new Set([
+    'find_usages',
+    'search_for_pattern',
+    'find_files_by_pattern',
+]);
+
+/** Fingerprint marker for paths that did not exist when the entry was stored */
+const MISSING_FINGERPRINT = 'missing';
+
+interface CacheEntry {
+    result: SubagentResult;
+    /** Relative path → `mtime:size` (or MISSING_FINGERPRINT) captured after the run */
+    fingerprints: Map<string, string>;
+    createdAt: number;
+}
+
+interface Fingerprints {
+    fingerprints: Map<string, string>;
+    directories: Set<string>;
+    /** Latest mtime among the paths that exist */
+    newestMtime: number;
+}
+
+/**
+ * Caches successful subagent results so equivalent investigations can be reused
+ * within one analysis and across repeated analyses of the same branch.
+ *
+ * Entries are keyed on the repository root and the normalized task and context
+ * text. Each entry stores a fingerprint (mtime + size) of every path the
+ * subagent's tools touched; a lookup re-stats those paths and drops the entry if
+ * any of them changed. Fingerprints are taken after the run, so a run during
+ * which any of its paths changed is not cached: it may have seen either version.
+ *
+ * A directory's mtime only changes when entries are added or removed, so it
+ * covers a plain listing but not a search below it. Runs that searched a
+ * directory or the whole workspace are therefore not cached.
+ *
+ * Long-lived (owned by ServiceManager) and safe to share between concurrent analyses.
+ */
+export class SubagentResultCache {
+    private readonly entries = new Map<string, CacheEntry>();
+
+    constructor(private readonly gitOperations: GitOperationsManager) {}
+
+    /**
+     * Look up a still-valid cached result for an equivalent task.
+     * @returns The cached result marked with `fromCache`, or undefined on miss/stale entry
+     */
+    async get(task: SubagentTask): Promise<SubagentResult | undefined> {
+        const gitRoot = this.getGitRoot();
+        if (!gitRoot) {
+            return undefined;
+        }
+        const key = SubagentResultCache.buildKey(gitRoot, task);
+        const entry = this.entries.get(key);
+        if (!entry) {
+            return undefined;
+        }
+
+        if (Date.now() - entry.createdAt > SubagentLimits.RESULT_CACHE_TTL_MS) {
+            this.entries.delete(key);
+            return undefined;
+        }
+
+        const { fingerprints: current } = await this.fingerprint(gitRoot, [
+            ...entry.fingerprints.keys(),
+        ]);
+        for (const [filePath, fingerprint] of entry.fingerprints) {
+            if (current.get(filePath) !== fingerprint) {
+                Log.debug(
+                    `Subagent cache entry invalidated: '${filePath}' changed`
+                );
+                this.entries.delete(key);
+                return undefined;
+            }
+        }
+
+        // Refresh LRU position
+        this.entries.delete(key);
+        this.entries.set(key, entry);
+
+        return { ...entry.result, fromCache: true };
+    }
+
+    /**
+     * Store a result. Only successful investigations are cached, since failures
+     * (timeouts, max iterations) are worth retrying.
+     * @param startedAt When the run started (epoch ms); paths modified since then
+     *                  make the result unsafe to reuse
+     */
+    async set(
+        task: SubagentTask,
+        result: SubagentResult,
+        startedAt: number
+    ): Promise<void> {
+        const gitRoot = this.getGitRoot();
+        if (!result.success || !gitRoot) {
+            return;
+        }
+
+        const search = result.toolCalls.find(isWorkspaceSearch);
+        if (search) {
+            Log.debug(
+                `Subagent result not cached: used workspace-wide ${search.toolName}`
+            );
+            return;
+        }
+
+        const paths = SubagentResultCache.collectReadPaths(result.toolCalls);
+        if (paths.length > SubagentLimits.RESULT_CACHE_MAX_TRACKED_PATHS) {
+            Log.debug(
+                `Subagent result not cached: read ${paths.length} paths (max ${SubagentLimits.RESULT_CACHE_MAX_TRACKED_PATHS})`
+            );
+            return;
+        }
+
+        const { fingerprints, directories, newestMtime } =
+            await this.fingerprint(gitRoot, paths);
+        if (newestMtime >= startedAt) {
+            Log.debug(
+                'Subagent result not cached: a path it read changed during the run'
+            );
+            return;
+        }
+        const searchedDirectory = SubagentResultCache.collectReadPaths(
+            result.toolCalls.filter((call) => !isPlainListing(call))
+        ).find((readPath) => directories.has(readPath));
+        if (searchedDirectory !== undefined) {
+            Log.debug(
+                `Subagent result not cached: searched directory '${searchedDirectory}'`
+            );
+            return;
+        }
+
+        const key = SubagentResultCache.buildKey(gitRoot, task);
+        this.entries.delete(key);
+        this.entries.set(key, {
+            result: { ...result, fromCache: undefined },
+            fingerprints,
+            createdAt: Date.now(),
+        });
+
+        while (this.entries.size > SubagentLimits.RESULT_CACHE_MAX_ENTRIES) {
+            const oldestKey = this.entries.keys().next().value;
+            if (oldestKey === undefined) {
+                break;
+            }
+            this.entries.delete(oldestKey);
+        }
+    }
+
+    /**
+     * Number of cached entries (including ones not yet validated as stale).
+     */
+    get size(): number {
+        return this.entries.size;
+    }
+
+    clear(): void {
+        this.entries.clear();
+    }
+
+    dispose(): void {
+        this.clear();
+    }
+
+    /**
+     * Build the cache key from the repository root and normalized task and
+     * context text. Normalization ignores case and whitespace differences, which
+     * is how the main agent typically varies otherwise identical delegations.
+     */
+    static buildKey(gitRoot: string, task: SubagentTask): string {
+        return [
+            gitRoot,
+            normalizeText(task.task),
+            normalizeText(task.context ?? ''),
+        ].join('\u0000');
+    }
+
+    /**
+     * Extract the distinct relative paths a subagent's tool calls read.
+     */
+    static collectReadPaths(toolCalls: ToolCallRecord[]): string[] {
+        const paths = new Set<string>();
+        for (const call of toolCalls) {
+            for (const key of PATH_ARGUMENT_KEYS) {
+                const value = call.arguments[key];
+                if (typeof value !== 'string') {
+                    continue;
+                }
+                try {
+                    paths.add(PathSanitizer.sanitizePath(value));
+                } catch {
+                    // Invalid paths were rejected by the tool itself; nothing was read
+                    continue;
+                }
+            }
+        }
+        return [...paths];
+    }
+
+    /**
+     * Stat each path. Also reports which of them are directories, whose
+     * fingerprint doesn't reflect edits to the files inside.
+     */
+    private async fingerprint(
+        gitRoot: string,
+        relativePaths: string[]
+    ): Promise<Fingerprints> {
+        const fingerprints = new Map<string, string>();
+        const directories = new Set<string>();
+        let newestMtime = 0;
+
+        await Promise.all(
+            relativePaths.map(async (relativePath) => {
+                try {
+                    const stat = await vscode.workspace.fs.stat(
+                        vscode.Uri.file(path.join(gitRoot, relativePath))
+                    );
+                    fingerprints.set(relativePath, `${stat.mtime}:${stat.size}`);
+                    newestMtime = Math.max(newestMtime, stat.mtime);
+                    if (stat.type & vscode.FileType.Directory) {
+                        directories.add(relativePath);
+                    }
+                } catch {
+                    fingerprints.set(relativePath, MISSING_FINGERPRINT);
+                }
+            })
+        );
+
+        return { fingerprints, directories, newestMtime };
+    }
+
+    private getGitRoot(): string | undefined {
+        return this.gitOperations.getRepository()?.rootUri.fsPath;
+    }
+}
+
+/**
+ * Whether a call's result depends on files outside its path arguments.
+ * find_symbol without a relative_path searches the whole workspace.
+ */
+function isWorkspaceSearch(call: ToolCallRecord): boolean {
+    return (
+        WORKSPACE_SEARCH_TOOLS.has(call.toolName) ||
+        (call.toolName === 'find_symbol' &&
+            typeof call.arguments.relative_path !== 'string')
+    );
+}
+
+/**
+ * A non-recursive directory listing: the only read of a directory its mtime
+ * fully covers.
+ */
+function isPlainListing(call: ToolCallRecord): boolean {
+    return (
+        call.toolName === 'list_directory' && call.arguments.recursive !== true
+    );
+}
+
+function normalizeText(text: string): string {
+    return text.replace(/\s+/g, ' ').trim().toLowerCase();
+}
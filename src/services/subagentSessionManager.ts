@@ -1,13 +1,37 @@
 import * as vscode from 'vscode';
 import { WorkspaceSettingsService } from './workspaceSettingsService';
+import { SubagentBudgetScheduler } from './subagentBudgetScheduler';
+import type { ConversationBudget } from '../models/conversationRunner';
+import type {
+    SubagentTask,
+    SubagentBudget,
+    SubagentUsage,
+} from '../types/modelTypes';
+import type { SubagentTokenUsage } from '../types/toolCallTypes';
+import { Log } from './loggingService';
 
 /**
  * Tracks subagent usage per analysis session.
- * Prevents excessive subagent spawning that could exhaust resources.
+ * Prevents excessive subagent spawning that could exhaust resources, and
+ * budgets iterations, tokens and time across subagents via SubagentBudgetScheduler.
+ * Also tracks running subagents so the orchestrator can cancel ones whose work
+ * has become moot (e.g., after submit_review).
  */
 export class SubagentSessionManager {
     private count = 0;
     private parentCancellationToken: vscode.CancellationToken | undefined;
+    private parentBudget: (() => ConversationBudget) | undefined;
+    private startedAt = Date.now();
+    private scheduler: SubagentBudgetScheduler | undefined;
+    /** Cancellation sources of subagents still running, by subagent ID */
+    private readonly running = new Map<
+        number,
+        vscode.CancellationTokenSource
+    >();
+    /** Why a subagent was cancelled early, for subagents stopped via cancel*() */
+    private readonly cancelReasons = new Map<number, string>();
+    /** Usage of finished subagents, for the analysis token breakdown */
+    private readonly tokenUsage: SubagentTokenUsage[] = [];
 
     constructor(private readonly workspaceSettings: WorkspaceSettingsService) {}
 
@@ -35,6 +59,36 @@ export class SubagentSessionManager {
         return Math.max(0, this.maxPerSession - this.count);
     }
 
+    /**
+     * Reserve iteration, token and time budget for a subagent about to spawn.
+     * Call before recordSpawn() so the remaining spawn count includes this one.
+     * @returns The budget, or undefined if the session's pool is exhausted
+     */
+    allocateBudget(task: SubagentTask): SubagentBudget | undefined {
+        return this.getScheduler().allocate(task, this.getRemainingBudget());
+    }
+
+    /**
+     * Return unused budget from a finished subagent to the session pool.
+     */
+    releaseBudget(
+        budget: SubagentBudget,
+        usage: SubagentUsage | undefined
+    ): void {
+        this.getScheduler().release(budget, usage);
+    }
+
+    /**
+     * Record what a finished subagent consumed, for the analysis token breakdown.
+     */
+    recordUsage(subagentId: number, task: string, usage: SubagentUsage): void {
+        this.tokenUsage.push({ subagentId, task, ...usage });
+    }
+
+    getTokenUsage(): SubagentTokenUsage[] {
+        return [...this.tokenUsage].sort((a, b) => a.subagentId - b.subagentId);
+    }
+
     /**
      * Link a parent cancellation token (main analysis) so subagents cancel promptly.
      */
@@ -44,6 +98,14 @@ export class SubagentSessionManager {
         this.parentCancellationToken = token;
     }
 
+    /**
+     * Link the remaining budget of the conversation that spawns subagents, so
+     * subagent pools and deadlines shrink with it. Link before the first spawn.
+     */
+    setParentBudget(budget: (() => ConversationBudget) | undefined): void {
+        this.parentBudget = budget;
+    }
+
     /**
      * Register a subagent cancellation source so it mirrors the parent cancellation token.
      */
@@ -59,8 +121,86 @@ export class SubagentSessionManager {
         });
     }
 
+    /**
+     * Track a running subagent so the orchestrator can cancel it before it finishes.
+     * @returns Disposable that stops tracking; dispose when the subagent finishes
+     */
+    trackSubagent(
+        subagentId: number,
+        source: vscode.CancellationTokenSource
+    ): vscode.Disposable {
+        this.running.set(subagentId, source);
+        return {
+            dispose: () => {
+                this.running.delete(subagentId);
+            },
+        };
+    }
+
+    /**
+     * Cancel one running subagent whose work is no longer needed.
+     * The subagent returns the findings gathered so far.
+     * @returns Whether a running subagent with that ID was found
+     */
+    cancelSubagent(subagentId: number, reason: string): boolean {
+        const source = this.running.get(subagentId);
+        if (!source) {
+            return false;
+        }
+        this.cancelReasons.set(subagentId, reason);
+        source.cancel();
+        return true;
+    }
+
+    /**
+     * Cancel every running subagent, e.g. once the review has been submitted.
+     * @returns Number of subagents cancelled
+     */
+    cancelOutstanding(reason: string): number {
+        const ids = [...this.running.keys()];
+        for (const id of ids) {
+            this.cancelSubagent(id, reason);
+        }
+        if (ids.length > 0) {
+            Log.info(
+                `Cancelled ${ids.length} outstanding subagent(s): ${reason}`
+            );
+        }
+        return ids.length;
+    }
+
+    /**
+     * Reason passed to cancelSubagent/cancelOutstanding, if this subagent was stopped early.
+     */
+    getCancellationReason(subagentId: number): string | undefined {
+        return this.cancelReasons.get(subagentId);
+    }
+
+    getRunningCount(): number {
+        return this.running.size;
+    }
+
     reset(): void {
         this.count = 0;
+        this.running.clear();
+        this.cancelReasons.clear();
+        this.tokenUsage.length = 0;
         this.parentCancellationToken = undefined;
+        this.parentBudget = undefined;
+        this.startedAt = Date.now();
+        this.scheduler = undefined;
+    }
+
+    /**
+     * Pools are sized lazily from the parent's budget on first use; the
+     * fallback time window starts when the session does.
+     */
+    private getScheduler(): SubagentBudgetScheduler {
+        this.scheduler ??= new SubagentBudgetScheduler(
+            this.workspaceSettings,
+            this.startedAt,
+            this.parentBudget
+        );
+        return this.scheduler;
     }
 }
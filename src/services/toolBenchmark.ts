@@ -0,0 +1,166 @@
+import type * as vscode from 'vscode';
+import type { ToolExecutionResult } from '../models/toolExecutor';
+import {
+    summarizeDistribution,
+    type DistributionSummary,
+} from '../utils/statsUtils';
+import { isCancellationError } from '../utils/asyncUtils';
+import { getErrorMessage } from '../utils/errorUtils';
+
+/**
+ * - cold: every run starts without warm-up
+ * - warm: one untimed run first, so language servers, ripgrep and the OS
+ *   file cache are primed before measuring
+ */
+export type BenchmarkCacheMode = 'cold' | 'warm';
+
+export interface ToolBenchmarkOptions {
+    toolName: string;
+    parameters: Record<string, unknown>;
+    runs: number;
+    /** Runs in flight at once */
+    concurrency: number;
+    cacheMode: BenchmarkCacheMode;
+}
+
+export interface ToolBenchmarkRun {
+    /** 1-based, in start order */
+    run: number;
+    durationMs: number;
+    success: boolean;
+    /** Response length in characters; 0 for failed runs */
+    responseChars: number;
+    error?: string;
+}
+
+export interface ToolBenchmarkReport extends ToolBenchmarkOptions {
+    /** ISO timestamp */
+    startedAt: string;
+    /** Wall-clock time of all timed runs */
+    totalMs: number;
+    /** Whether the benchmark was cancelled before every run finished */
+    cancelled: boolean;
+    /** p50 is the median */
+    latencyMs: DistributionSummary & { min: number };
+    /** Successful runs only */
+    responseChars: DistributionSummary;
+    errors: number;
+    errorRate: number;
+    results: ToolBenchmarkRun[];
+}
+
+export const BENCHMARK_LIMITS = {
+    maxRuns: 500,
+    maxConcurrency: 16,
+} as const;
+
+/**
+ * Run one tool call and report how it ended. Each call should use a fresh
+ * ToolExecutor so the per-analysis rate limit and result cache don't apply.
+ */
+export type BenchmarkExecutor = () => Promise<ToolExecutionResult>;
+
+/**
+ * Run a tool repeatedly with the same parameters and summarize latency,
+ * response size and errors. Used by the tool testing interface to measure
+ * tools on a real workspace without running an analysis.
+ *
+ * Runs are started by `concurrency` workers pulling from a shared counter.
+ * `token` only stops new runs from starting; runs in flight finish and are
+ * kept. Cancelling the tools themselves is up to `execute`.
+ */
+export async function runToolBenchmark(
+    options: ToolBenchmarkOptions,
+    execute: BenchmarkExecutor,
+    token: vscode.CancellationToken,
+    onProgress?: (completed: number, total: number) => void
+): Promise<ToolBenchmarkReport> {
+    const runs = clamp(options.runs, 1, BENCHMARK_LIMITS.maxRuns);
+    const concurrency = clamp(
+        options.concurrency,
+        1,
+        Math.min(runs, BENCHMARK_LIMITS.maxConcurrency)
+    );
+    const startedAt = new Date().toISOString();
+
+    if (options.cacheMode === 'warm' && !token.isCancellationRequested) {
+        await timeRun(0, execute);
+    }
+
+    const results: ToolBenchmarkRun[] = [];
+    let nextRun = 1;
+    const worker = async () => {
+        while (nextRun <= runs && !token.isCancellationRequested) {
+            const run = nextRun++;
+            results.push(await timeRun(run, execute));
+            onProgress?.(results.length, runs);
+        }
+    };
+
+    const start = performance.now();
+    await Promise.all(Array.from({ length: concurrency }, worker));
+    const totalMs = performance.now() - start;
+
+    results.sort((a, b) => a.run - b.run);
+    const latencies = results.map((r) => r.durationMs);
+    const errors = results.filter((r) => !r.success).length;
+
+    return {
+        ...options,
+        runs,
+        concurrency,
+        startedAt,
+        totalMs,
+        cancelled: results.length < runs,
+        latencyMs: {
+            min: latencies.length > 0 ? Math.min(...latencies) : 0,
+            ...summarizeDistribution(latencies),
+        },
+        responseChars: summarizeDistribution(
+            results.filter((r) => r.success).map((r) => r.responseChars)
+        ),
+        errors,
+        errorRate: results.length > 0 ? errors / results.length : 0,
+        results,
+    };
+}
+
+async function timeRun(
+    run: number,
+    execute: BenchmarkExecutor
+): Promise<ToolBenchmarkRun> {
+    const start = performance.now();
+    try {
+        const result = await execute();
+        const durationMs = performance.now() - start;
+        return result.success
+            ? {
+                  run,
+                  durationMs,
+                  success: true,
+                  responseChars: result.result?.length ?? 0,
+              }
+            : {
+                  run,
+                  durationMs,
+                  success: false,
+                  responseChars: 0,
+                  error: result.error,
+              };
+    } catch (error) {
+        if (isCancellationError(error)) {
+            throw error;
+        }
+        return {
+            run,
+            durationMs: performance.now() - start,
+            success: false,
+            responseChars: 0,
+            error: getErrorMessage(error),
+        };
+    }
+}
+
+function clamp(value: number, min: number, max: number): number {
+    return Math.max(min, Math.min(max, Math.floor(value) || min));
+}
@@ -2,6 +2,7 @@ import * as vscode from 'vscode';
 import { ConversationManager } from '../models/conversationManager';
 import { ToolExecutor } from '../models/toolExecutor';
 import { ToolRegistry } from '../models/toolRegistry';
+import { ToolResultCache } from '../models/toolResultCache';
 import { CopilotModelManager } from '../models/copilotModelManager';
 import { PromptGenerator } from '../models/promptGenerator';
 import { TokenValidator } from '../models/tokenValidator';
@@ -12,10 +13,13 @@ import {
 import type {
     ToolCallRecord,
     ToolCallingAnalysisResult,
+    TokenBreakdown,
     AnalysisProgressCallback,
+    AnalysisUpdateCallback,
     SubagentProgressContext,
 } from '../types/toolCallTypes';
 import { TokenConstants } from '../models/tokenConstants';
+import { buildTokenBreakdown } from '../models/tokenBreakdown';
 import { DiffUtils } from '../utils/diffUtils';
 import { Log } from './loggingService';
 import { isCancellationError } from '../utils/asyncUtils';
@@ -23,8 +27,17 @@ import { getErrorMessage } from '../utils/errorUtils';
 import { WorkspaceSettingsService } from './workspaceSettingsService';
 import { SubagentSessionManager } from './subagentSessionManager';
 import { SubagentExecutor } from './subagentExecutor';
+import { SubagentResultCache } from './subagentResultCache';
+import { NestedToolCallStore } from './nestedToolCallStore';
+import type { ToolMetricsStore } from './toolMetricsStore';
 import { SubagentPromptGenerator } from '../prompts/subagentPromptGenerator';
 import { PlanSessionManager } from './planSessionManager';
+import { PerformanceTrace, Trace } from './performanceTrace';
+import {
+    AnalysisMemoryMonitor,
+    compactToolCallRecords,
+    estimateToolRecordBytes,
+} from './analysisMemoryMonitor';
 
 /**
  * Orchestrates the entire analysis process, including managing the conversation loop,
@@ -34,17 +47,32 @@ import { PlanSessionManager } from './planSessionManager';
  * locally within the analyze() method, allowing multiple concurrent analyses.
  */
 export class ToolCallingAnalysisProvider {
+    private startupTimings: ReadonlyArray<[string, number]> | undefined;
+    private analysesStarted = 0;
+
     constructor(
         private toolRegistry: ToolRegistry,
         private copilotModelManager: CopilotModelManager,
         private promptGenerator: PromptGenerator,
-        private workspaceSettings: WorkspaceSettingsService
+        private workspaceSettings: WorkspaceSettingsService,
+        private subagentResultCache?: SubagentResultCache,
+        private nestedToolCallStore?: NestedToolCallStore,
+        private toolMetrics?: ToolMetricsStore
     ) {}
 
     private get maxIterations(): number {
         return this.workspaceSettings.getMaxIterations();
     }
 
+    /**
+     * Extension startup phase timings (see ServiceManager.getStartupTimings),
+     * exported with the first analysis's trace so a cold start can be
+     * profiled from activation through the first review.
+     */
+    setStartupTimings(timings: ReadonlyArray<[string, number]>): void {
+        this.startupTimings = timings;
+    }
+
     /**
      * Analyze a diff using the LLM with tool-calling capabilities.
      *
@@ -54,12 +82,62 @@ export class ToolCallingAnalysisProvider {
      * @param diff The diff content to analyze
      * @param token Cancellation token
      * @param progressCallback Optional callback for reporting progress to UI
+     * @param onUpdate Optional callback receiving each tool call and plan
+     *   update as it happens
      * @returns Promise resolving to the analysis result with tool call history
+     *   and a performance trace
      */
     async analyze(
         diff: string,
         token: vscode.CancellationToken,
-        progressCallback?: AnalysisProgressCallback
+        progressCallback?: AnalysisProgressCallback,
+        onUpdate?: AnalysisUpdateCallback
+    ): Promise<ToolCallingAnalysisResult> {
+        const trace = new PerformanceTrace('Main Analysis');
+        // The first analysis pays for model selection, language server and
+        // ripgrep warm-up; mark its trace so cold and warm runs can be compared
+        const isFirstAnalysis = this.analysesStarted++ === 0;
+        if (isFirstAnalysis) {
+            trace.setMetadata('firstAnalysis', true);
+            if (this.startupTimings) {
+                trace.setMetadata(
+                    'startupPhasesMs',
+                    Object.fromEntries(
+                        this.startupTimings.map(([phase, ms]) => [
+                            phase,
+                            Math.round(ms),
+                        ])
+                    )
+                );
+            }
+        }
+        const start = performance.now();
+        const result = await Trace.run(trace, async () => {
+            const span = Trace.span('Analysis', 'analysis');
+            try {
+                return await this.runAnalysis(
+                    diff,
+                    token,
+                    progressCallback,
+                    onUpdate
+                );
+            } finally {
+                span.end();
+            }
+        });
+        if (isFirstAnalysis) {
+            Log.info(
+                `[Startup]: First analysis took ${Math.round(performance.now() - start)}ms (export its trace for the breakdown)`
+            );
+        }
+        return { ...result, trace: trace.toJSON() };
+    }
+
+    private async runAnalysis(
+        diff: string,
+        token: vscode.CancellationToken,
+        progressCallback?: AnalysisProgressCallback,
+        onUpdate?: AnalysisUpdateCallback
     ): Promise<ToolCallingAnalysisResult> {
         // === Per-analysis state (local for concurrent-safety) ===
         const toolCallRecords: ToolCallRecord[] = [];
@@ -74,7 +152,9 @@ export class ToolCallingAnalysisProvider {
 
         // Create per-analysis instances for complete isolation
         const conversationManager = new ConversationManager();
-        const planManager = new PlanSessionManager();
+        const planManager = new PlanSessionManager(
+            onUpdate && ((plan) => onUpdate({ type: 'plan', plan }))
+        );
         const subagentSessionManager = new SubagentSessionManager(
             this.workspaceSettings
         );
@@ -85,8 +165,10 @@ export class ToolCallingAnalysisProvider {
             this.workspaceSettings,
             undefined, // No chat handler in command context
             progressCallback,
-            progressContext
+            progressContext,
+            this.subagentResultCache
         );
+        const toolResultCache = new ToolResultCache();
         const toolExecutor = new ToolExecutor(
             this.toolRegistry,
             this.workspaceSettings,
@@ -94,6 +176,9 @@ export class ToolCallingAnalysisProvider {
                 planManager,
                 subagentSessionManager,
                 subagentExecutor,
+                toolResultCache,
+                nestedToolCallStore: this.nestedToolCallStore,
+                toolMetrics: this.toolMetrics,
                 cancellationToken: token,
             }
         );
@@ -106,16 +191,28 @@ export class ToolCallingAnalysisProvider {
         let analysisError: string | undefined;
         let analysisText = '';
         let toolCallCount = 0;
+        let maxInputTokens: number = TokenConstants.DEFAULT_MAX_INPUT_TOKENS;
+        const memoryMonitor = new AnalysisMemoryMonitor(
+            this.workspaceSettings.getHeapBudgetMB() * 1024 * 1024
+        );
+        let processedDiffLength = 0;
+        let compactHistory = false;
+        // Kept up to date per call so sampling doesn't walk every record
+        let toolRecordBytes = 0;
 
         try {
             Log.info('Starting analysis with tool-calling support');
             progressCallback?.('Initializing analysis...', 0.5);
             subagentSessionManager.setParentCancellationToken(token);
+            subagentSessionManager.setParentBudget(
+                () => conversationRunner.remainingBudget
+            );
 
             // Check diff size and handle truncation/tool availability
             progressCallback?.('Processing diff...', 0.5);
             const { processedDiff, toolsAvailable, toolsDisabledMessage } =
                 await this.processDiffSize(diff);
+            processedDiffLength = processedDiff.length;
 
             // Get available tools and generate system prompt based on tool availability
             const availableTools = toolsAvailable
@@ -147,6 +244,7 @@ export class ToolCallingAnalysisProvider {
                 `Using model: ${model.name} (${model.vendor}/${model.id}, ${model.maxInputTokens} tokens)`
             );
             const tokenValidator = new TokenValidator(model);
+            maxInputTokens = model.maxInputTokens || maxInputTokens;
 
             // Create context status function that captures local state
             const getContextStatusSuffix = async (): Promise<string> => {
@@ -191,6 +289,29 @@ export class ToolCallingAnalysisProvider {
                         `Turn ${current}/${max}: Analyzing...`,
                         0.2
                     );
+
+                    const compaction = memoryMonitor.sample(current, {
+                        conversation:
+                            conversationManager.getContentLength() * 2,
+                        toolRecords: toolRecordBytes,
+                        diff: (diff.length + processedDiffLength) * 2,
+                    });
+                    if (compaction !== 'none') {
+                        const dropped = compactToolCallRecords(toolCallRecords);
+                        toolRecordBytes = Math.max(
+                            0,
+                            toolRecordBytes - dropped * 2
+                        );
+                        Log.info(
+                            `[Memory]: Dropped ${dropped} characters of stored tool results`
+                        );
+                        compactHistory = compaction === 'history';
+                    }
+                },
+                shouldCompactContext: () => {
+                    const compact = compactHistory;
+                    compactHistory = false;
+                    return compact;
                 },
                 onToolCallComplete: (
                     toolCallId,
@@ -203,7 +324,7 @@ export class ToolCallingAnalysisProvider {
                     metadata
                 ) => {
                     toolCallCount++;
-                    toolCallRecords.push({
+                    const record: ToolCallRecord = {
                         id: toolCallId,
                         toolName,
                         arguments: args,
@@ -213,7 +334,11 @@ export class ToolCallingAnalysisProvider {
                         durationMs: durationMs ?? 0,
                         timestamp: Date.now(),
                         nestedCalls: metadata?.nestedToolCalls,
-                    });
+                        nestedCallsRef: metadata?.nestedToolCallsRef,
+                    };
+                    toolCallRecords.push(record);
+                    toolRecordBytes += estimateToolRecordBytes([record]);
+                    onUpdate?.({ type: 'toolCall', call: record });
                 },
                 getContextStatusSuffix,
             };
@@ -251,17 +376,39 @@ export class ToolCallingAnalysisProvider {
             Log.error(errorMessage, error);
             analysisText = errorMessage;
         } finally {
+            // Nothing can consume subagent results once the main loop has ended
+            subagentSessionManager.cancelOutstanding('analysis finished');
             // Clear parent cancellation token to release references
             subagentSessionManager.setParentCancellationToken(undefined);
+            subagentSessionManager.setParentBudget(undefined);
+            const cacheStats = toolResultCache.getStats();
+            Log.info(
+                `Tool cache: ${cacheStats.hits} hits, ${cacheStats.misses} misses`
+            );
+            const memory = memoryMonitor.report();
+            Log.info(
+                `Memory: peak heap ${Math.round(memory.peakHeapUsed / (1024 * 1024))}MB (started at ${Math.round(memory.baselineHeapUsed / (1024 * 1024))}MB), ${memory.toolResultCompactions} tool result and ${memory.historyCompactions} history compactions`
+            );
             // No other cleanup needed - all per-analysis instances are garbage collected
         }
 
+        const tokenUsage = conversationRunner.tokenUsage;
+        const tokenBreakdown =
+            tokenUsage.length > 0
+                ? buildTokenBreakdown(
+                      maxInputTokens,
+                      tokenUsage,
+                      subagentSessionManager.getTokenUsage()
+                  )
+                : undefined;
+
         return this.buildAnalysisResult(
             toolCallRecords,
             analysisText,
             analysisCompleted,
             analysisError,
-            conversationRunner.wasCancelled
+            conversationRunner.wasCancelled,
+            tokenBreakdown
         );
     }
 
@@ -270,7 +417,8 @@ export class ToolCallingAnalysisProvider {
         analysis: string,
         completed: boolean,
         error: string | undefined,
-        wasCancelled: boolean
+        wasCancelled: boolean,
+        tokenBreakdown: TokenBreakdown | undefined
     ): ToolCallingAnalysisResult {
         const successfulCalls = toolCallRecords.filter((r) => r.success).length;
         const failedCalls = toolCallRecords.filter((r) => !r.success).length;
@@ -284,6 +432,7 @@ export class ToolCallingAnalysisProvider {
                 failedCalls,
                 analysisCompleted: completed,
                 analysisError: error,
+                tokenBreakdown,
             },
             wasCancelled,
         };
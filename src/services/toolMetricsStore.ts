@@ -0,0 +1,155 @@
+import {
+    summarizeDistribution,
+    type DistributionSummary,
+} from '../utils/statsUtils';
+
+/**
+ * How a tool call that reached the tool ended.
+ * - timeout: the call timed out, or the tool returned partial results after
+ *   timing out internally (ToolResultMetadata.timedOut)
+ * - oversized: the tool succeeded but ToolExecutor rejected the response size
+ */
+export type ToolCallOutcome = 'success' | 'error' | 'timeout' | 'oversized';
+
+export interface ToolCallSample {
+    toolName: string;
+    durationMs: number;
+    outcome: ToolCallOutcome;
+    /** Response length in characters; omitted when the tool returned no data */
+    responseChars?: number;
+}
+
+/**
+ * Aggregated statistics for one tool.
+ * Counts cover every recorded call; distributions cover the most recent
+ * MAX_SAMPLES_PER_TOOL calls.
+ */
+export interface ToolMetricsSummary {
+    toolName: string;
+    calls: number;
+    errors: number;
+    timeouts: number;
+    oversized: number;
+    errorRate: number;
+    timeoutRate: number;
+    oversizedRate: number;
+    latencyMs: DistributionSummary;
+    responseChars: DistributionSummary;
+}
+
+export interface ToolMetricsSnapshot {
+    /** ISO timestamp when recording started (store creation or last reset) */
+    since: string;
+    totalCalls: number;
+    tools: ToolMetricsSummary[];
+}
+
+/** Bounds memory per tool; older samples are overwritten */
+const MAX_SAMPLES_PER_TOOL = 1000;
+
+/**
+ * Fixed-size ring buffer of the most recent values
+ */
+class SampleWindow {
+    private readonly values: number[] = [];
+    private next = 0;
+
+    push(value: number): void {
+        if (this.values.length < MAX_SAMPLES_PER_TOOL) {
+            this.values.push(value);
+        } else {
+            this.values[this.next] = value;
+            this.next = (this.next + 1) % MAX_SAMPLES_PER_TOOL;
+        }
+    }
+
+    summarize(): DistributionSummary {
+        return summarizeDistribution(this.values);
+    }
+}
+
+interface ToolCounters {
+    calls: number;
+    errors: number;
+    timeouts: number;
+    oversized: number;
+    latencies: SampleWindow;
+    responseSizes: SampleWindow;
+}
+
+/**
+ * Per-tool performance statistics across analyses, chat requests and tool
+ * testing: call counts, latency and response size percentiles, and the rates
+ * of timeouts and response-size rejections. Used to find tools worth optimizing
+ * and to tune timeouts and size limits in ToolConstants.
+ *
+ * ToolExecutor records into the store from ExecutionContext.toolMetrics.
+ * Long-lived (owned by ServiceManager), in-memory only.
+ */
+export class ToolMetricsStore {
+    private readonly tools = new Map<string, ToolCounters>();
+    private since = new Date();
+
+    record(sample: ToolCallSample): void {
+        let counters = this.tools.get(sample.toolName);
+        if (!counters) {
+            counters = {
+                calls: 0,
+                errors: 0,
+                timeouts: 0,
+                oversized: 0,
+                latencies: new SampleWindow(),
+                responseSizes: new SampleWindow(),
+            };
+            this.tools.set(sample.toolName, counters);
+        }
+
+        counters.calls++;
+        switch (sample.outcome) {
+            case 'error':
+                counters.errors++;
+                break;
+            case 'timeout':
+                counters.timeouts++;
+                break;
+            case 'oversized':
+                counters.oversized++;
+                break;
+        }
+        counters.latencies.push(sample.durationMs);
+        if (sample.responseChars !== undefined) {
+            counters.responseSizes.push(sample.responseChars);
+        }
+    }
+
+    /**
+     * Summaries for every tool that was called, slowest p95 first
+     */
+    getSnapshot(): ToolMetricsSnapshot {
+        const tools: ToolMetricsSummary[] = [];
+        let totalCalls = 0;
+        for (const [toolName, counters] of this.tools) {
+            totalCalls += counters.calls;
+            tools.push({
+                toolName,
+                calls: counters.calls,
+                errors: counters.errors,
+                timeouts: counters.timeouts,
+                oversized: counters.oversized,
+                errorRate: counters.errors / counters.calls,
+                timeoutRate: counters.timeouts / counters.calls,
+                oversizedRate: counters.oversized / counters.calls,
+                latencyMs: counters.latencies.summarize(),
+                responseChars: counters.responseSizes.summarize(),
+            });
+        }
+        tools.sort((a, b) => b.latencyMs.p95 - a.latencyMs.p95);
+
+        return { since: this.since.toISOString(), totalCalls, tools };
+    }
+
+    reset(): void {
+        this.tools.clear();
+        this.since = new Date();
+    }
+}
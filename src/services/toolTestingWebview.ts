@@ -3,6 +3,12 @@ import { Log } from './loggingService';
 import { ToolRegistry } from '../models/toolRegistry';
 import { ToolExecutor } from '../models/toolExecutor';
 import type { WorkspaceSettingsService } from './workspaceSettingsService';
+import type { ToolMetricsStore } from './toolMetricsStore';
+import {
+    runToolBenchmark,
+    type ToolBenchmarkOptions,
+    type ToolBenchmarkReport,
+} from './toolBenchmark';
 import type { ExecutionContext } from '../types/executionContext';
 import type {
     OpenFilePayload,
@@ -20,12 +26,17 @@ import { getErrorMessage } from '../utils/errorUtils';
 export class ToolTestingWebviewService {
     /** Track active token sources to cancel in-flight requests when panel is disposed */
     private activeTokenSources = new Set<vscode.CancellationTokenSource>();
+    /** Stops the running benchmark from starting further runs */
+    private benchmarkTokenSource: vscode.CancellationTokenSource | undefined;
+    /** Last finished benchmark, for export */
+    private lastBenchmark: ToolBenchmarkReport | undefined;
 
     constructor(
         private readonly extensionContext: vscode.ExtensionContext,
         private readonly gitRepositoryRoot: string,
         private readonly toolRegistry: ToolRegistry,
-        private readonly workspaceSettings: WorkspaceSettingsService
+        private readonly workspaceSettings: WorkspaceSettingsService,
+        private readonly toolMetrics?: ToolMetricsStore
     ) {}
 
     /**
@@ -69,6 +80,7 @@ export class ToolTestingWebviewService {
                 tokenSource.dispose();
             }
             this.activeTokenSources.clear();
+            this.benchmarkTokenSource?.cancel();
         });
 
         return panel;
@@ -225,6 +237,25 @@ export class ToolTestingWebviewService {
                         case 'openFile':
                             await this.handleOpenFileMessage(message.payload);
                             break;
+                        case 'getToolMetrics':
+                            this.sendToolMetrics(webview);
+                            break;
+                        case 'resetToolMetrics':
+                            this.toolMetrics?.reset();
+                            this.sendToolMetrics(webview);
+                            break;
+                        case 'runBenchmark':
+                            await this.handleRunBenchmark(
+                                message.payload,
+                                webview
+                            );
+                            break;
+                        case 'cancelBenchmark':
+                            this.benchmarkTokenSource?.cancel();
+                            break;
+                        case 'exportBenchmark':
+                            await this.exportBenchmark();
+                            break;
                         default:
                             Log.warn(
                                 `Unknown tool testing message command: ${message.command}`
@@ -275,6 +306,16 @@ export class ToolTestingWebviewService {
         }
     }
 
+    /**
+     * Send aggregated tool statistics (all analyses, chat and tool testing)
+     */
+    private sendToolMetrics(webview: vscode.Webview): void {
+        webview.postMessage({
+            type: 'toolMetrics',
+            payload: this.toolMetrics?.getSnapshot(),
+        });
+    }
+
     /**
      * Handle tool execution request.
      * Creates a per-request ToolExecutor to ensure isolation from analysis sessions.
@@ -295,6 +336,7 @@ export class ToolTestingWebviewService {
 
             // Create per-request executor for isolation from concurrent analyses
             const executionContext: ExecutionContext = {
+                toolMetrics: this.toolMetrics,
                 cancellationToken: tokenSource.token,
             };
             const executor = new ToolExecutor(
@@ -347,6 +389,96 @@ export class ToolTestingWebviewService {
         }
     }
 
+    /**
+     * Run a tool repeatedly and post the report.
+     * Every run gets its own ToolExecutor without a result cache, so the tool
+     * really executes each time and the rate limit doesn't apply. Runs are not
+     * recorded in the tool statistics.
+     */
+    private async handleRunBenchmark(
+        options: ToolBenchmarkOptions,
+        webview: vscode.Webview
+    ): Promise<void> {
+        if (this.benchmarkTokenSource) {
+            throw new Error('A benchmark is already running');
+        }
+
+        // Cancels tools in flight when the panel closes
+        const toolTokenSource = new vscode.CancellationTokenSource();
+        this.activeTokenSources.add(toolTokenSource);
+        const benchmarkTokenSource = new vscode.CancellationTokenSource();
+        this.benchmarkTokenSource = benchmarkTokenSource;
+        try {
+            Log.info(
+                `Benchmarking ${options.toolName}: ${options.runs} runs, concurrency ${options.concurrency}, ${options.cacheMode}`
+            );
+            const executeOnce = async () => {
+                const executor = new ToolExecutor(
+                    this.toolRegistry,
+                    this.workspaceSettings,
+                    { cancellationToken: toolTokenSource.token }
+                );
+                const [result] = await executor.executeTools([
+                    { name: options.toolName, args: options.parameters },
+                ]);
+                return result;
+            };
+            const report = await runToolBenchmark(
+                options,
+                executeOnce,
+                benchmarkTokenSource.token,
+                (completed, total) =>
+                    webview.postMessage({
+                        type: 'benchmarkProgress',
+                        payload: { completed, total },
+                    })
+            );
+            this.lastBenchmark = report;
+            Log.info(
+                `Benchmark of ${options.toolName}: p50 ${Math.round(report.latencyMs.p50)}ms, p95 ${Math.round(report.latencyMs.p95)}ms, ${report.errors} errors`
+            );
+            webview.postMessage({ type: 'benchmarkResult', payload: report });
+        } catch (error) {
+            if (!isCancellationError(error)) {
+                throw error;
+            }
+            Log.debug('Benchmark cancelled:', options.toolName);
+        } finally {
+            this.benchmarkTokenSource = undefined;
+            benchmarkTokenSource.dispose();
+            this.activeTokenSources.delete(toolTokenSource);
+            toolTokenSource.dispose();
+        }
+    }
+
+    private async exportBenchmark(): Promise<void> {
+        const report = this.lastBenchmark;
+        if (!report) {
+            return;
+        }
+
+        const folder = vscode.workspace.workspaceFolders?.[0]?.uri;
+        const uri = await vscode.window.showSaveDialog({
+            defaultUri: folder
+                ? vscode.Uri.joinPath(
+                      folder,
+                      `lupa-benchmark-${report.toolName}.json`
+                  )
+                : undefined,
+            filters: { 'JSON Files': ['json'] },
+            saveLabel: 'Export Benchmark',
+        });
+        if (!uri) {
+            return;
+        }
+
+        await vscode.workspace.fs.writeFile(
+            uri,
+            Buffer.from(JSON.stringify(report, null, 2), 'utf8')
+        );
+        Log.info(`Exported benchmark of ${report.toolName} to ${uri.fsPath}`);
+    }
+
     /**
      * Handle openFile message from webview
      */
@@ -1,7 +1,7 @@
 import * as vscode from 'vscode';
 import { StatusBarService } from './statusBarService';
 import { AnalysisMode } from '../types/modelTypes';
-import type { ToolCallsData } from '../types/toolCallTypes';
+import type { ToolCallRecord, ToolCallsData } from '../types/toolCallTypes';
 import {
     type AnalysisTargetType,
     ANALYSIS_TARGET_OPTIONS,
@@ -13,20 +13,43 @@ import type {
     ValidatePathPayload,
     PathValidationResultPayload,
     ThemeUpdatePayload,
+    GetNestedToolCallsPayload,
+    NestedToolCallsResultPayload,
+    GetDiffFilesPayload,
+    DiffFilesResultPayload,
+    GetToolCallDetailsPayload,
+    ToolCallDetailsResultPayload,
+    AnalysisUpdatePayload,
 } from '../types/webviewMessages';
+import type { NestedToolCallStore } from './nestedToolCallStore';
+import { AnalysisPanelData } from './analysisPanelData';
 import { safeJsonStringify } from '../utils/safeJson';
 import { getErrorMessage } from '../utils/errorUtils';
 
+/**
+ * Handle for streaming a running analysis into the analysis panel
+ */
+export interface LiveAnalysisPanel {
+    appendToolCall(record: ToolCallRecord): void;
+    updatePlan(plan: string): void;
+    updateStatus(message: string): void;
+    /** The analysis ended without a result (cancelled or failed) */
+    stop(message: string): void;
+    complete(analysis: string, toolCalls: ToolCallsData | undefined): void;
+}
+
 /**
  * UIManager handles all UI-related functionality
  */
 export class UIManager {
     private statusBarService: StatusBarService;
     private activeAnalysisPanel: vscode.WebviewPanel | undefined;
+    private panelMessageListener: vscode.Disposable | undefined;
 
     constructor(
         private readonly extensionContext: vscode.ExtensionContext,
-        private readonly gitRepositoryRoot: string
+        private readonly gitRepositoryRoot: string,
+        private readonly nestedToolCallStore?: NestedToolCallStore
     ) {
         this.statusBarService = StatusBarService.getInstance();
     }
@@ -106,23 +129,25 @@ export class UIManager {
         );
     }
 
+    private truncateTitle(title: string): string {
+        return title.length > 100 ? title.substring(0, 97) + '...' : title;
+    }
+
     /**
-     * Generate PR analysis with HTML that loads React app
+     * Generate PR analysis with HTML that loads React app.
+     * Only the manifest of `data` is embedded; the webview requests diff files
+     * and tool call details through messages as they are displayed.
      */
     public generatePRAnalysisHtml(
         title: string,
-        diffText: string,
         analysis: string,
         panel: vscode.WebviewPanel,
-        toolCalls: ToolCallsData | undefined
+        data: AnalysisPanelData
     ): string {
         // Strip output tags before sending to frontend
         const cleanedAnalysis = this.stripOutputTags(analysis);
 
-        let titleTruncated = title;
-        if (title.length > 100) {
-            titleTruncated = title.substring(0, 97) + '...';
-        }
+        const titleTruncated = this.truncateTitle(title);
 
         // Generate URIs for the assets using extension context
         const mainScriptUri = panel.webview.asWebviewUri(
@@ -189,12 +214,9 @@ export class UIManager {
                 })();
             </script>
             <script id="analysis-data" type="application/json">
-                ${safeJsonStringify({
-                    title: titleTruncated,
-                    diffText: diffText,
-                    analysis: cleanedAnalysis,
-                    toolCalls: toolCalls ?? null,
-                })}
+                ${safeJsonStringify(
+                    data.getManifest(titleTruncated, cleanedAnalysis)
+                )}
             </script>
             <script>
                 // Parse analysis data from JSON script tag
@@ -246,6 +268,70 @@ export class UIManager {
         diffText: string,
         analysis: string,
         toolCalls: ToolCallsData | undefined = undefined
+    ): vscode.WebviewPanel {
+        return this.showAnalysisPanel(
+            title,
+            analysis,
+            new AnalysisPanelData(diffText, toolCalls)
+        );
+    }
+
+    /**
+     * Open the analysis panel for an analysis that is still running. Tool
+     * calls, plan updates and status messages are appended to the open panel
+     * as they arrive; `complete` shows the final result in place, or opens
+     * the panel again if the user closed it meanwhile.
+     */
+    public openLiveAnalysis(
+        title: string,
+        diffText: string
+    ): LiveAnalysisPanel {
+        const data = new AnalysisPanelData(diffText, undefined, true);
+        const panel = this.showAnalysisPanel(title, '', data);
+        const post = (payload: AnalysisUpdatePayload) => {
+            if (this.activeAnalysisPanel === panel) {
+                panel.webview.postMessage({
+                    command: 'analysisUpdate',
+                    payload,
+                });
+            }
+        };
+
+        return {
+            appendToolCall: (record) =>
+                post({ kind: 'toolCall', ...data.appendToolCall(record) }),
+            updatePlan: (plan) => {
+                data.setPlan(plan);
+                post({ kind: 'plan', plan });
+            },
+            updateStatus: (message) => post({ kind: 'status', message }),
+            stop: (message) => post({ kind: 'stopped', message }),
+            complete: (analysis, toolCalls) => {
+                if (this.activeAnalysisPanel !== panel) {
+                    this.displayAnalysisResults(
+                        title,
+                        diffText,
+                        analysis,
+                        toolCalls
+                    );
+                    return;
+                }
+                data.finish(toolCalls);
+                post({
+                    kind: 'complete',
+                    manifest: data.getManifest(
+                        this.truncateTitle(title),
+                        this.stripOutputTags(analysis)
+                    ),
+                });
+            },
+        };
+    }
+
+    private showAnalysisPanel(
+        title: string,
+        analysis: string,
+        data: AnalysisPanelData
     ): vscode.WebviewPanel {
         let panel: vscode.WebviewPanel;
 
@@ -266,14 +352,18 @@ export class UIManager {
 
         panel.webview.html = this.generatePRAnalysisHtml(
             title,
-            diffText,
             analysis,
             panel,
-            toolCalls
+            data
         );
 
-        // Set up message listeners for webview communication
-        this.setupWebviewMessageHandlers(panel.webview);
+        // Set up message listeners for webview communication, replacing those
+        // of the previous analysis when the panel is reused
+        this.panelMessageListener?.dispose();
+        this.panelMessageListener = this.setupWebviewMessageHandlers(
+            panel.webview,
+            data
+        );
 
         // Listen for theme changes and update webview
         const themeChangeDisposable = vscode.window.onDidChangeActiveColorTheme(
@@ -287,6 +377,8 @@ export class UIManager {
             themeChangeDisposable.dispose();
             if (this.activeAnalysisPanel === panel) {
                 this.activeAnalysisPanel = undefined;
+                this.panelMessageListener?.dispose();
+                this.panelMessageListener = undefined;
             }
         });
 
@@ -296,8 +388,11 @@ export class UIManager {
     /**
      * Set up message handlers for webview communication
      */
-    private setupWebviewMessageHandlers(webview: vscode.Webview): void {
-        webview.onDidReceiveMessage((message: WebviewMessageType) => {
+    private setupWebviewMessageHandlers(
+        webview: vscode.Webview,
+        data: AnalysisPanelData
+    ): vscode.Disposable | undefined {
+        return webview.onDidReceiveMessage((message: WebviewMessageType) => {
             switch (message.command) {
                 case 'openFile':
                     this.handleOpenFileMessage(message.payload);
@@ -305,6 +400,26 @@ export class UIManager {
                 case 'validatePath':
                     this.handleValidatePathMessage(message.payload, webview);
                     break;
+                case 'getNestedToolCalls':
+                    this.handleGetNestedToolCallsMessage(
+                        message.payload,
+                        webview
+                    );
+                    break;
+                case 'getDiffFiles':
+                    this.handleGetDiffFilesMessage(
+                        message.payload,
+                        webview,
+                        data
+                    );
+                    break;
+                case 'getToolCallDetails':
+                    this.handleGetToolCallDetailsMessage(
+                        message.payload,
+                        webview,
+                        data
+                    );
+                    break;
                 default:
                     Log.warn(
                         `Unknown webview message command: ${(message as any).command}`
@@ -485,6 +600,86 @@ export class UIManager {
         }
     }
 
+    /**
+     * Handle getNestedToolCalls message from webview.
+     * Decompresses subagent tool calls from the store when the user expands them.
+     */
+    private async handleGetNestedToolCallsMessage(
+        payload: GetNestedToolCallsPayload,
+        webview: vscode.Webview
+    ): Promise<void> {
+        const response: NestedToolCallsResultPayload = { key: payload.key };
+        try {
+            response.calls = await this.nestedToolCallStore?.get(payload.key);
+            if (!response.calls) {
+                response.error =
+                    'Subagent tool calls are no longer available. Re-run the analysis to inspect them.';
+            }
+        } catch (error) {
+            Log.error(
+                `Failed to load nested tool calls: ${payload.key}`,
+                error
+            );
+            response.error = `Could not load subagent tool calls. ${getErrorMessage(error)}`;
+        }
+
+        webview.postMessage({
+            command: 'nestedToolCallsResult',
+            payload: response,
+        });
+    }
+
+    /**
+     * Reply with the requested diff files, in batches of bounded size. The
+     * last batch lists the requested indices, so the webview can settle
+     * those that were skipped.
+     */
+    private async handleGetDiffFilesMessage(
+        payload: GetDiffFilesPayload,
+        webview: vscode.Webview,
+        data: AnalysisPanelData
+    ): Promise<void> {
+        const batches = data.getDiffFiles(payload.indices);
+        if (batches.length === 0) {
+            batches.push([]);
+        }
+        for (const [index, files] of batches.entries()) {
+            const response: DiffFilesResultPayload =
+                index === batches.length - 1
+                    ? { files, requested: payload.indices }
+                    : { files };
+            await webview.postMessage({
+                command: 'diffFilesResult',
+                payload: response,
+            });
+        }
+    }
+
+    /**
+     * Reply with the requested tool call records, in batches of bounded size.
+     * The last batch lists the requested indices, as for diff files.
+     */
+    private async handleGetToolCallDetailsMessage(
+        payload: GetToolCallDetailsPayload,
+        webview: vscode.Webview,
+        data: AnalysisPanelData
+    ): Promise<void> {
+        const batches = data.getToolCallDetails(payload.indices);
+        if (batches.length === 0) {
+            batches.push([]);
+        }
+        for (const [index, calls] of batches.entries()) {
+            const response: ToolCallDetailsResultPayload =
+                index === batches.length - 1
+                    ? { calls, requested: payload.indices }
+                    : { calls };
+            await webview.postMessage({
+                command: 'toolCallDetailsResult',
+                payload: response,
+            });
+        }
+    }
+
     /**
      * Send current theme information to webview
      */
@@ -28,38 +28,73 @@ export class WorkspaceSettingsService implements vscode.Disposable {
     private settings: WorkspaceSettings = getDefaultSettings();
     private settingsPath: string | null = null;
     private saveDebounceTimeout: NodeJS.Timeout | null = null;
+    /** Pending load of the settings file; defaults apply until it settles */
+    private loading: Promise<void>;
+    /** Incremented per load so a superseded load doesn't apply what it read */
+    private loadGeneration = 0;
+    /**
+     * Values set while a load is in flight, applied over what it reads so the
+     * file doesn't overwrite them. Null when no load is pending.
+     */
+    private changedDuringLoad: Partial<WorkspaceSettings> | null = null;
 
     /**
-     * Creates a new WorkspaceSettingsService
+     * Creates a new WorkspaceSettingsService.
+     * Settings are read asynchronously so activation doesn't block on disk I/O;
+     * await whenLoaded() before relying on stored values.
      * @param context VS Code extension context
      */
     constructor(private readonly context: vscode.ExtensionContext) {
-        this.initializeSettings();
+        this.loading = this.initializeSettings();
 
         // Watch for workspace folder changes
         vscode.workspace.onDidChangeWorkspaceFolders(() => {
-            this.initializeSettings();
+            this.loading = this.initializeSettings();
         });
     }
 
     /**
-     * Initialize settings for the current workspace
+     * Resolves once settings for the current workspace have been read from disk,
+     * including loads started by workspace folder changes while waiting
      */
-    private initializeSettings(): void {
-        // First try to get settings path from workspace
-        this.settingsPath = this.getWorkspaceSettingsPath();
+    public async whenLoaded(): Promise<void> {
+        let loading: Promise<void>;
+        do {
+            loading = this.loading;
+            await loading;
+        } while (loading !== this.loading);
+    }
 
-        // If no workspace is open, use global storage
-        if (!this.settingsPath) {
-            this.settingsPath = this.getGlobalSettingsPath();
+    /**
+     * Initialize settings for the current workspace.
+     * Folder changes can start a load while another is still reading; only the
+     * most recent one applies its result.
+     */
+    private async initializeSettings(): Promise<void> {
+        const generation = ++this.loadGeneration;
+        this.changedDuringLoad ??= {};
+
+        // Use global storage if no workspace is open
+        this.settingsPath =
+            this.getWorkspaceSettingsPath() ?? this.getGlobalSettingsPath();
+
+        const { settings, rewrite } = await this.readSettings(
+            this.settingsPath
+        );
+        if (generation !== this.loadGeneration) {
+            return;
         }
 
-        // Load settings
-        this.loadSettings();
+        this.settings = { ...settings, ...this.changedDuringLoad };
+        this.changedDuringLoad = null;
+        if (rewrite) {
+            await this.saveSettings();
+        }
     }
 
     /**
-     * Get settings file path for the current workspace
+     * Get settings file path for the current workspace.
+     * The .vscode directory is created on first save, not here.
      */
     private getWorkspaceSettingsPath(): string | null {
         // Get the workspace folder
@@ -70,22 +105,11 @@ export class WorkspaceSettingsService implements vscode.Disposable {
 
         // Use the first workspace folder as the root
         const workspaceRoot = workspaceFolders[0]!.uri.fsPath;
-        const vscodeDir = path.join(workspaceRoot, '.vscode');
-
-        // Create the .vscode directory if it doesn't exist
-        if (!fs.existsSync(vscodeDir)) {
-            try {
-                fs.mkdirSync(vscodeDir, { recursive: true });
-            } catch (error) {
-                Log.error(
-                    `Failed to create .vscode directory: ${getErrorMessage(error)}`,
-                    error
-                );
-                return null;
-            }
-        }
-
-        return path.join(vscodeDir, WorkspaceSettingsService.SETTINGS_FILENAME);
+        return path.join(
+            workspaceRoot,
+            '.vscode',
+            WorkspaceSettingsService.SETTINGS_FILENAME
+        );
     }
 
     /**
@@ -100,58 +124,114 @@ export class WorkspaceSettingsService implements vscode.Disposable {
     }
 
     /**
-     * Load settings from disk
+     * Read settings from disk.
+     * @returns The settings, and whether the file should be rewritten with them
+     *          (it doesn't exist or holds invalid values)
      */
-    private loadSettings(): void {
-        if (!this.settingsPath) {
-            return;
+    private async readSettings(
+        settingsPath: string
+    ): Promise<{ settings: WorkspaceSettings; rewrite: boolean }> {
+        let data: string;
+        try {
+            data = await fs.promises.readFile(settingsPath, 'utf-8');
+        } catch (error) {
+            if ((error as NodeJS.ErrnoException).code === 'ENOENT') {
+                return { settings: getDefaultSettings(), rewrite: true };
+            }
+            Log.error(
+                `Failed to load settings: ${getErrorMessage(error)}`,
+                error
+            );
+            return { settings: getDefaultSettings(), rewrite: false };
         }
 
         try {
-            if (fs.existsSync(this.settingsPath)) {
-                const data = fs.readFileSync(this.settingsPath, 'utf-8');
-                const parsed = JSON.parse(data);
-                const result = WorkspaceSettingsSchema.safeParse(parsed);
-
-                if (result.success) {
-                    this.settings = result.data;
-                } else {
-                    const errorMessages = z.prettifyError(result.error);
-                    Log.error(
-                        `Invalid settings in ${this.settingsPath}: ${errorMessages}. Resetting to defaults.`
-                    );
-                    this.settings = getDefaultSettings();
-                    this.saveSettings();
-                }
-            } else {
-                this.settings = getDefaultSettings();
-                this.saveSettings();
+            const parsed = JSON.parse(data);
+            const result = WorkspaceSettingsSchema.safeParse(parsed);
+
+            if (result.success) {
+                return { settings: result.data, rewrite: false };
             }
+            const errorMessages = z.prettifyError(result.error);
+            Log.error(
+                `Invalid settings in ${settingsPath}: ${errorMessages}. Resetting to defaults.`
+            );
+            return { settings: getDefaultSettings(), rewrite: true };
         } catch (error) {
             Log.error(
                 `Failed to load settings: ${getErrorMessage(error)}`,
                 error
             );
-            this.settings = getDefaultSettings();
+            return { settings: getDefaultSettings(), rewrite: false };
+        }
+    }
+
+    /**
+     * Apply changed values, recording them if a load is in flight
+     */
+    private updateSettings(changes: Partial<WorkspaceSettings>): void {
+        Object.assign(this.settings, changes);
+        if (this.changedDuringLoad) {
+            Object.assign(this.changedDuringLoad, changes);
+        }
+    }
+
+    /**
+     * Replace all settings. During a load every key counts as changed,
+     * including ones the new settings leave unset.
+     */
+    private replaceSettings(settings: WorkspaceSettings): void {
+        this.settings = settings;
+        if (this.changedDuringLoad) {
+            const changes: Partial<WorkspaceSettings> = { ...settings };
+            for (const key of Object.keys(WorkspaceSettingsSchema.shape)) {
+                if (!(key in changes)) {
+                    changes[key] = undefined;
+                }
+            }
+            this.changedDuringLoad = changes;
         }
     }
 
     /**
      * Save settings to disk
      */
-    private saveSettings(): void {
+    private async saveSettings(): Promise<void> {
         if (!this.settingsPath) {
             return;
         }
 
         try {
             // Make sure the directory exists
-            const dir = path.dirname(this.settingsPath);
-            if (!fs.existsSync(dir)) {
-                fs.mkdirSync(dir, { recursive: true });
-            }
+            await fs.promises.mkdir(path.dirname(this.settingsPath), {
+                recursive: true,
+            });
 
             // Write settings to file
+            await fs.promises.writeFile(
+                this.settingsPath,
+                JSON.stringify(this.settings, null, 2),
+                'utf-8'
+            );
+        } catch (error) {
+            Log.error(
+                `Failed to save settings: ${getErrorMessage(error)}`,
+                error
+            );
+        }
+    }
+
+    /**
+     * Save synchronously; only for dispose(), where a pending write could be
+     * cut off by extension shutdown
+     */
+    private saveSettingsSync(): void {
+        if (!this.settingsPath) {
+            return;
+        }
+
+        try {
+            fs.mkdirSync(path.dirname(this.settingsPath), { recursive: true });
             fs.writeFileSync(
                 this.settingsPath,
                 JSON.stringify(this.settings, null, 2),
@@ -174,7 +254,8 @@ export class WorkspaceSettingsService implements vscode.Disposable {
         }
 
         this.saveDebounceTimeout = setTimeout(() => {
-            this.saveSettings();
+            // Writing before a pending load applies would clobber the file
+            void this.whenLoaded().then(() => this.saveSettings());
             this.saveDebounceTimeout = null;
         }, 500); // 500ms debounce
     }
@@ -203,7 +284,9 @@ export class WorkspaceSettingsService implements vscode.Disposable {
         key: K,
         value: WorkspaceSettings[K]
     ): void {
-        this.settings[key] = value;
+        const changes: Partial<WorkspaceSettings> = {};
+        changes[key] = value;
+        this.updateSettings(changes);
         this.debouncedSaveSettings();
     }
 
@@ -251,7 +334,7 @@ export class WorkspaceSettingsService implements vscode.Disposable {
      */
     public setSelectedRepositoryPath(repoPath: string | undefined): void {
         if (repoPath === undefined) {
-            this.settings.selectedRepositoryPath = undefined;
+            this.updateSettings({ selectedRepositoryPath: undefined });
             this.debouncedSaveSettings();
             return;
         }
@@ -261,9 +344,11 @@ export class WorkspaceSettingsService implements vscode.Disposable {
             workspaceRoot &&
             this.normalizePath(repoPath) === this.normalizePath(workspaceRoot)
         ) {
-            this.settings.selectedRepositoryPath = WORKSPACE_ROOT_MARKER;
+            this.updateSettings({
+                selectedRepositoryPath: WORKSPACE_ROOT_MARKER,
+            });
         } else {
-            this.settings.selectedRepositoryPath = repoPath;
+            this.updateSettings({ selectedRepositoryPath: repoPath });
         }
         this.debouncedSaveSettings();
     }
@@ -280,7 +365,7 @@ export class WorkspaceSettingsService implements vscode.Disposable {
      * @param identifier Model identifier in 'vendor/id' format (e.g., 'copilot/gpt-4.1')
      */
     public setPreferredModelIdentifier(identifier: string | undefined): void {
-        this.settings.preferredModelIdentifier = identifier;
+        this.updateSettings({ preferredModelIdentifier: identifier });
         this.debouncedSaveSettings();
     }
 
@@ -298,6 +383,13 @@ export class WorkspaceSettingsService implements vscode.Disposable {
         return this.settings.requestTimeoutSeconds;
     }
 
+    /**
+     * Get the heap size in MB above which an analysis compacts its data
+     */
+    public getHeapBudgetMB(): number {
+        return this.settings.heapBudgetMB;
+    }
+
     /**
      * Get the maximum subagents per analysis session
      */
@@ -309,11 +401,13 @@ export class WorkspaceSettingsService implements vscode.Disposable {
      * Reset all analysis limit settings to their defaults
      */
     public resetAnalysisLimitsToDefaults(): void {
-        this.settings.maxIterations = ANALYSIS_LIMITS.maxIterations.default;
-        this.settings.requestTimeoutSeconds =
-            ANALYSIS_LIMITS.requestTimeoutSeconds.default;
-        this.settings.maxSubagentsPerSession =
-            SUBAGENT_LIMITS.maxPerSession.default;
+        this.updateSettings({
+            maxIterations: ANALYSIS_LIMITS.maxIterations.default,
+            requestTimeoutSeconds:
+                ANALYSIS_LIMITS.requestTimeoutSeconds.default,
+            heapBudgetMB: ANALYSIS_LIMITS.heapBudgetMB.default,
+            maxSubagentsPerSession: SUBAGENT_LIMITS.maxPerSession.default,
+        });
         this.debouncedSaveSettings();
     }
 
@@ -324,16 +418,17 @@ export class WorkspaceSettingsService implements vscode.Disposable {
         const preferredModelIdentifier = this.settings.preferredModelIdentifier;
         const selectedRepositoryPath = this.settings.selectedRepositoryPath;
 
-        this.settings = getDefaultSettings();
+        const settings = getDefaultSettings();
 
         if (preferredModelIdentifier) {
-            this.settings.preferredModelIdentifier = preferredModelIdentifier;
+            settings.preferredModelIdentifier = preferredModelIdentifier;
         }
 
         if (selectedRepositoryPath) {
-            this.settings.selectedRepositoryPath = selectedRepositoryPath;
+            settings.selectedRepositoryPath = selectedRepositoryPath;
         }
 
+        this.replaceSettings(settings);
         this.saveSettings();
     }
 
@@ -342,7 +437,7 @@ export class WorkspaceSettingsService implements vscode.Disposable {
      * Use with caution - changing model may cause incompatibility with existing data
      */
     public resetAllSettings(): void {
-        this.settings = getDefaultSettings();
+        this.replaceSettings(getDefaultSettings());
         this.saveSettings();
     }
 
@@ -352,7 +447,7 @@ export class WorkspaceSettingsService implements vscode.Disposable {
     public dispose(): void {
         if (this.saveDebounceTimeout) {
             clearTimeout(this.saveDebounceTimeout);
-            this.saveSettings(); // Save immediately before disposal
+            this.saveSettingsSync(); // Save immediately before disposal
         }
     }
 }
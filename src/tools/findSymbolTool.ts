@@ -19,6 +19,7 @@ import {
 } from '../utils/asyncUtils';
 import { getErrorMessage } from '../utils/errorUtils';
 import { Log } from '../services/loggingService';
+import { Trace } from '../services/performanceTrace';
 import { ToolResult, toolSuccess, toolError } from '../types/toolResultTypes';
 import { ExecutionContext } from '../types/executionContext';
 import { isCancellationError } from '../utils/asyncUtils';
@@ -165,9 +166,12 @@ Use relative_path to scope searches: "src/services" or "src/auth/login.ts".`;
 
         if (searchResult.symbols.length === 0) {
             if (searchResult.timedOut) {
-                return toolError(
-                    `Symbol '${namePath}' search timed out with no results. Try narrowing search scope with relative_path.`
-                );
+                return {
+                    ...toolError(
+                        `Symbol '${namePath}' search timed out with no results. Try narrowing search scope with relative_path.`
+                    ),
+                    metadata: { timedOut: true },
+                };
             }
             if (searchResult.truncated) {
                 return toolError(
@@ -193,7 +197,10 @@ Use relative_path to scope searches: "src/services" or "src/auth/login.ts".`;
             finalResult += `\n\n[Note: Results may be incomplete due to ${reason}. Consider narrowing search scope with relative_path.]`;
         }
 
-        return toolSuccess(finalResult);
+        return toolSuccess(
+            finalResult,
+            searchResult.timedOut ? { timedOut: true } : undefined
+        );
     }
 
     /**
@@ -293,7 +300,9 @@ Use relative_path to scope searches: "src/services" or "src/auth/login.ts".`;
 
             let workspaceSymbols: vscode.SymbolInformation[] = [];
             try {
-                const symbolsPromise = Promise.resolve(
+                const symbolsPromise = Trace.measure(
+                    'vscode.executeWorkspaceSymbolProvider',
+                    'lsp',
                     vscode.commands.executeCommand<vscode.SymbolInformation[]>(
                         'vscode.executeWorkspaceSymbolProvider',
                         targetSymbolName
@@ -615,7 +624,9 @@ Use relative_path to scope searches: "src/services" or "src/auth/login.ts".`;
 
             const document = await vscode.workspace.openTextDocument(fileUri);
             const documentSymbols = await withCancellableTimeout(
-                Promise.resolve(
+                Trace.measure(
+                    'vscode.executeDocumentSymbolProvider',
+                    'lsp',
                     vscode.commands.executeCommand<vscode.DocumentSymbol[]>(
                         'vscode.executeDocumentSymbolProvider',
                         fileUri
@@ -984,7 +995,9 @@ Use relative_path to scope searches: "src/services" or "src/auth/login.ts".`;
     ): Promise<vscode.DocumentSymbol | undefined> {
         try {
             const documentSymbols = await withCancellableTimeout(
-                Promise.resolve(
+                Trace.measure(
+                    'vscode.executeDocumentSymbolProvider',
+                    'lsp',
                     vscode.commands.executeCommand<vscode.DocumentSymbol[]>(
                         'vscode.executeDocumentSymbolProvider',
                         document.uri
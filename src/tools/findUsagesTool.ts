@@ -14,6 +14,7 @@ import { ToolResult, toolSuccess, toolError } from '../types/toolResultTypes';
 import { ExecutionContext } from '../types/executionContext';
 import { GitOperationsManager } from '../services/gitOperationsManager';
 import { Log } from '../services/loggingService';
+import { Trace } from '../services/performanceTrace';
 
 const LSP_OPERATION_TIMEOUT = 60000; // 60 seconds for language server operations
 const DEFINITION_CHECK_TIMEOUT = 10000; // 10 seconds per definition check (non-fatal)
@@ -134,7 +135,9 @@ Requires file_path where the symbol is defined as starting point.`;
 
         // Use VS Code's reference provider to find all references (with timeout and cancellation)
         const references = await withCancellableTimeout(
-            Promise.resolve(
+            Trace.measure(
+                'vscode.executeReferenceProvider',
+                'lsp',
                 vscode.commands.executeCommand<vscode.Location[]>(
                     'vscode.executeReferenceProvider',
                     document.uri,
@@ -273,7 +276,9 @@ Requires file_path where the symbol is defined as starting point.`;
                 // Verify this is actually a symbol definition by checking if definition provider returns this location
                 try {
                     const definitions = await withCancellableTimeout(
-                        Promise.resolve(
+                        Trace.measure(
+                            'vscode.executeDefinitionProvider',
+                            'lsp',
                             vscode.commands.executeCommand<vscode.Location[]>(
                                 'vscode.executeDefinitionProvider',
                                 document.uri,
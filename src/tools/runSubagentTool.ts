@@ -5,14 +5,17 @@ import { SubagentLimits, SubagentErrors } from '../models/toolConstants';
 import type { SubagentResult } from '../types/modelTypes';
 import { ToolResult, toolSuccess, toolError } from '../types/toolResultTypes';
 import { ExecutionContext } from '../types/executionContext';
-import { Log } from '../services/loggingService';
 import { WorkspaceSettingsService } from '../services/workspaceSettingsService';
-import { isCancellationError } from '../utils/asyncUtils';
-import { getErrorMessage } from '../utils/errorUtils';
+import { compactSubagentResponse } from '../utils/subagentResultFormatter';
+import {
+    runSubagent,
+    buildNestedToolCallsMetadata,
+    MAX_RESULT_CHARS,
+} from './subagentRunner';
 
 /**
  * Tool that spawns isolated subagent investigations.
- * Delegates execution to SubagentExecutor, tracks usage via SubagentSessionManager.
+ * Spawning, limits and timeouts are handled by runSubagent (shared with run_subagents).
  *
  * Both SubagentExecutor and SubagentSessionManager are obtained from ExecutionContext
  * (created per-analysis) for concurrency safety.
@@ -73,11 +76,8 @@ MANDATORY when: 4+ files, security code, 3+ file dependency chains.`;
             throw new vscode.CancellationError();
         }
 
-        // Get per-analysis dependencies from ExecutionContext
-        const executor = context.subagentExecutor;
-        const sessionManager = context.subagentSessionManager;
-
-        if (!executor || !sessionManager) {
+        // Per-analysis dependencies come from ExecutionContext
+        if (!context.subagentExecutor || !context.subagentSessionManager) {
             return toolError(
                 'Subagent execution requires ExecutionContext with subagentExecutor and subagentSessionManager. This is an internal error.'
             );
@@ -91,117 +91,40 @@ MANDATORY when: 4+ files, security code, 3+ file dependency chains.`;
         }
 
         const { task, context: taskContext } = validationResult.data;
-        const maxSubagents = this.workspaceSettings.getMaxSubagentsPerSession();
-        const timeoutMs =
-            this.workspaceSettings.getRequestTimeoutSeconds() * 1000;
+        const outcome = await runSubagent(
+            { task, context: taskContext },
+            context,
+            this.workspaceSettings
+        );
 
-        if (!sessionManager.canSpawn()) {
-            Log.warn(
-                `Subagent spawn rejected: session limit reached (${maxSubagents})`
+        if (!outcome.result) {
+            return toolError(
+                outcome.error ?? SubagentErrors.failed('Unknown error')
             );
-            return toolError(SubagentErrors.maxExceeded(maxSubagents));
         }
 
-        const subagentId = sessionManager.recordSpawn();
-        const remaining = sessionManager.getRemainingBudget();
-        Log.info(
-            `Subagent #${subagentId} spawned (${sessionManager.getCount()}/${maxSubagents}, ${remaining} remaining)`
+        const metadata = await buildNestedToolCallsMetadata(
+            outcome.result.toolCalls,
+            context
+        );
+        return toolSuccess(
+            this.formatResult(outcome.result, outcome.subagentId!),
+            metadata
         );
-
-        // Subagent needs a combined cancellation signal: cancel on parent cancellation OR timeout.
-        // We can't add timeout to the parent token (would cancel the entire analysis), so we
-        // create a local source and link it to the parent via sessionManager.
-        // Local variable (not instance) prevents race condition with parallel subagents.
-        const cancellationTokenSource = new vscode.CancellationTokenSource();
-        const parentCancellationDisposable =
-            sessionManager.registerSubagentCancellation(
-                cancellationTokenSource
-            );
-        let cancelledByTimeout = false;
-        const timeoutHandle = setTimeout(() => {
-            cancelledByTimeout = true;
-            cancellationTokenSource.cancel();
-        }, timeoutMs);
-
-        try {
-            const result = await executor.execute(
-                {
-                    task,
-                    context: taskContext,
-                },
-                cancellationTokenSource.token,
-                subagentId
-            );
-
-            clearTimeout(timeoutHandle);
-
-            if (!result.success && result.error === 'cancelled') {
-                // Only attribute to timeout if parent wasn't also cancelled.
-                // Race condition: timeout timer can fire while executor unwinds
-                // from parent cancellation, setting cancelledByTimeout incorrectly.
-                if (
-                    cancelledByTimeout &&
-                    !context.cancellationToken.isCancellationRequested
-                ) {
-                    return toolError(SubagentErrors.timeout(timeoutMs));
-                }
-                return toolError('Subagent was cancelled');
-            }
-
-            if (!result.success && result.error === 'max_iterations') {
-                const maxIterMsg = SubagentErrors.maxIterations(
-                    result.toolCallsMade,
-                    this.workspaceSettings.getMaxIterations()
-                );
-                // Include partial response so parent LLM can use findings gathered so far
-                const partialFindings = result.response?.trim();
-                return toolError(
-                    partialFindings
-                        ? `${maxIterMsg}\n\nPartial findings:\n${partialFindings}`
-                        : maxIterMsg
-                );
-            }
-
-            // Any other failure (LLM errors, service errors, etc.)
-            if (!result.success) {
-                return toolError(
-                    SubagentErrors.failed(result.error || 'Unknown error')
-                );
-            }
-
-            return toolSuccess(this.formatResult(result, subagentId), {
-                nestedToolCalls: result.toolCalls,
-            });
-        } catch (error) {
-            clearTimeout(timeoutHandle);
-
-            if (isCancellationError(error)) {
-                throw error;
-            }
-
-            if (
-                cancelledByTimeout &&
-                !context.cancellationToken.isCancellationRequested
-            ) {
-                return toolError(SubagentErrors.timeout(timeoutMs));
-            }
-
-            const errorMessage = getErrorMessage(error);
-            return toolError(SubagentErrors.failed(errorMessage));
-        } finally {
-            parentCancellationDisposable?.dispose();
-            cancellationTokenSource.dispose();
-        }
     }
 
     /**
      * Format successful subagent result for parent LLM consumption.
+     * The response is compacted to its structured sections under a hard size cap.
      */
     private formatResult(result: SubagentResult, subagentId: number): string {
+        const toolCallsLine = result.fromCache
+            ? `**Reused earlier investigation** (${result.toolCallsMade} tool calls, files unchanged since)`
+            : `**Tool calls made:** ${result.toolCallsMade}`;
         return (
             `## Subagent #${subagentId} Investigation Complete\n\n` +
-            `**Tool calls made:** ${result.toolCallsMade}\n\n` +
-            `---\n\n${result.response}`
+            `${toolCallsLine}\n\n` +
+            `---\n\n${compactSubagentResponse(result.response, MAX_RESULT_CHARS)}`
         );
     }
 }
@@ -0,0 +1,206 @@
+import * as z from 'zod';
+import * as vscode from 'vscode';
+import { BaseTool } from './baseTool';
+import { SubagentLimits, SubagentErrors } from '../models/toolConstants';
+import { TokenConstants } from '../models/tokenConstants';
+import { ToolResult, toolSuccess, toolError } from '../types/toolResultTypes';
+import { ExecutionContext } from '../types/executionContext';
+import { Log } from '../services/loggingService';
+import { WorkspaceSettingsService } from '../services/workspaceSettingsService';
+import {
+    aggregateSubagentResponses,
+    SubagentResponseEntry,
+} from '../utils/subagentResultFormatter';
+import {
+    runSubagent,
+    buildNestedToolCallsMetadata,
+    SubagentRunOutcome,
+} from './subagentRunner';
+
+/** Character budget for the aggregated report shown to the parent */
+const MAX_AGGREGATE_CHARS =
+    SubagentLimits.FANOUT_RESULT_MAX_TOKENS *
+    TokenConstants.CHARS_PER_TOKEN_ESTIMATE;
+
+/**
+ * Tool that runs several independent subagent investigations concurrently and
+ * returns one aggregated, deduplicated report.
+ *
+ * Each task is spawned through runSubagent, so session limits, budgets and
+ * timeouts apply per subagent exactly as for run_subagent. Tasks beyond the
+ * session limit are reported as not run rather than failing the whole call.
+ * Wall-clock time is that of the slowest investigation.
+ */
+export class RunSubagentsTool extends BaseTool {
+    name = 'run_subagents';
+    description = `Run several independent subagent investigations in parallel and get one merged report.
+
+Use instead of multiple run_subagent calls when investigating 2+ UNRELATED modules.
+Each task follows the run_subagent template (one module, questions about CURRENT code).
+Findings reported by several subagents are merged and attributed ([Task 1, Task 3]).
+
+Do NOT use when one task needs another's answer - run those sequentially.`;
+
+    schema: z.ZodObject<{
+        tasks: z.ZodArray<
+            z.ZodObject<{
+                task: z.ZodString;
+                context: z.ZodOptional<z.ZodString>;
+            }>
+        >;
+    }>;
+
+    constructor(private readonly workspaceSettings: WorkspaceSettingsService) {
+        super();
+
+        this.schema = z.object({
+            tasks: z
+                .array(
+                    z.object({
+                        task: z
+                            .string()
+                            .min(
+                                SubagentLimits.MIN_TASK_LENGTH,
+                                SubagentErrors.taskTooShort(
+                                    SubagentLimits.MIN_TASK_LENGTH
+                                )
+                            )
+                            .describe(
+                                'Investigation task: WHAT to investigate, WHERE to look, WHAT to return.'
+                            ),
+                        context: z
+                            .string()
+                            .optional()
+                            .describe(
+                                'Relevant context from your analysis for this task.'
+                            ),
+                    })
+                )
+                .min(2, 'Provide at least 2 tasks; use run_subagent for one.')
+                .max(
+                    SubagentLimits.FANOUT_MAX_TASKS,
+                    `At most ${SubagentLimits.FANOUT_MAX_TASKS} tasks per call.`
+                )
+                .describe('Independent investigation tasks, one module each.'),
+        });
+    }
+
+    async execute(
+        args: z.infer<typeof this.schema>,
+        context: ExecutionContext
+    ): Promise<ToolResult> {
+        if (context.cancellationToken.isCancellationRequested) {
+            throw new vscode.CancellationError();
+        }
+
+        if (!context.subagentExecutor || !context.subagentSessionManager) {
+            return toolError(
+                'Subagent execution requires ExecutionContext with subagentExecutor and subagentSessionManager. This is an internal error.'
+            );
+        }
+
+        const validationResult = this.schema.safeParse(args);
+        if (!validationResult.success) {
+            return toolError(
+                validationResult.error.issues.map((e) => e.message).join(', ')
+            );
+        }
+
+        const { tasks } = validationResult.data;
+        if (!context.subagentSessionManager.canSpawn()) {
+            return toolError(
+                SubagentErrors.maxExceeded(
+                    this.workspaceSettings.getMaxSubagentsPerSession()
+                )
+            );
+        }
+
+        // runSubagent reserves its spawn slot and budget synchronously, so starting
+        // all runs at once still respects the session limits in task order.
+        const startTime = Date.now();
+        const outcomes = await Promise.all(
+            tasks.map((task) =>
+                runSubagent(task, context, this.workspaceSettings)
+            )
+        );
+        const succeeded = outcomes.filter((outcome) => outcome.result);
+        Log.info(
+            `Subagent fan-out finished: ${succeeded.length}/${tasks.length} succeeded in ${Date.now() - startTime}ms`
+        );
+
+        if (
+            succeeded.length === 0 &&
+            !outcomes.some((outcome) => outcome.partialResponse)
+        ) {
+            return toolError(
+                SubagentErrors.fanOutFailed(this.formatFailures(outcomes))
+            );
+        }
+
+        // Flattened into one list, so each call keeps the task it belongs to
+        const toolCalls = outcomes.flatMap((outcome, i) =>
+            (outcome.result?.toolCalls ?? []).map((call) => ({
+                ...call,
+                subagentLabel: `Task ${i + 1}`,
+            }))
+        );
+        const metadata = await buildNestedToolCallsMetadata(
+            toolCalls,
+            context
+        );
+        return toolSuccess(this.formatResult(outcomes), metadata);
+    }
+
+    /**
+     * Format the aggregated report for parent LLM consumption.
+     * Tasks are labelled by their position in the call so the parent can map
+     * findings back to the questions it asked.
+     */
+    private formatResult(outcomes: SubagentRunOutcome[]): string {
+        const entries: SubagentResponseEntry[] = [];
+        outcomes.forEach((outcome, i) => {
+            if (outcome.result) {
+                entries.push({
+                    label: `Task ${i + 1}`,
+                    response: outcome.result.response,
+                });
+            } else if (outcome.partialResponse) {
+                entries.push({
+                    label: `Task ${i + 1} (incomplete)`,
+                    response: outcome.partialResponse,
+                });
+            }
+        });
+
+        const succeeded = outcomes.filter((outcome) => outcome.result).length;
+        const toolCallsMade = outcomes.reduce(
+            (sum, outcome) => sum + (outcome.result?.toolCallsMade ?? 0),
+            0
+        );
+        const failed = outcomes.some((outcome) => !outcome.result);
+
+        return (
+            `## Parallel Investigation Complete (${succeeded}/${outcomes.length} subagents succeeded)\n\n` +
+            `**Tool calls made:** ${toolCallsMade}\n\n` +
+            `---\n\n${aggregateSubagentResponses(entries, MAX_AGGREGATE_CHARS)}` +
+            (failed
+                ? `\n\n### Failed Tasks\n${this.formatFailures(outcomes)}`
+                : '')
+        );
+    }
+
+    /**
+     * One line per failed task; details such as partial findings are already
+     * merged into the report, so only the first line of each error is kept.
+     */
+    private formatFailures(outcomes: SubagentRunOutcome[]): string {
+        return outcomes
+            .map((outcome, i) =>
+                outcome.result
+                    ? undefined
+                    : `- Task ${i + 1}: ${outcome.error?.split('\n')[0] ?? 'Unknown error'}`
+            )
+            .filter((line) => line !== undefined)
+            .join('\n');
+    }
+}
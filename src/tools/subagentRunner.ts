@@ -0,0 +1,213 @@
+import * as vscode from 'vscode';
+import { SubagentLimits, SubagentErrors } from '../models/toolConstants';
+import { TokenConstants } from '../models/tokenConstants';
+import type {
+    SubagentTask,
+    SubagentResult,
+    SubagentUsage,
+} from '../types/modelTypes';
+import type { ToolResultMetadata } from '../types/toolResultTypes';
+import type { ToolCallRecord } from '../types/toolCallTypes';
+import { ExecutionContext } from '../types/executionContext';
+import { Log } from '../services/loggingService';
+import { Trace } from '../services/performanceTrace';
+import { WorkspaceSettingsService } from '../services/workspaceSettingsService';
+import { isCancellationError } from '../utils/asyncUtils';
+import { getErrorMessage } from '../utils/errorUtils';
+import { compactSubagentResponse } from '../utils/subagentResultFormatter';
+
+/** Character budget for a single subagent response shown to the parent */
+export const MAX_RESULT_CHARS =
+    SubagentLimits.RESULT_MAX_TOKENS * TokenConstants.CHARS_PER_TOKEN_ESTIMATE;
+
+/**
+ * Outcome of one subagent run. Exactly one of `result` or `error` is set;
+ * `error` is already phrased for the parent LLM.
+ */
+export interface SubagentRunOutcome {
+    /** Undefined when the spawn was rejected before a subagent was created */
+    subagentId: number | undefined;
+    result?: SubagentResult;
+    error?: string;
+    /** Findings gathered before the subagent hit its iteration limit */
+    partialResponse?: string;
+}
+
+/**
+ * Spawn one subagent under the session limits and budget of `context`, and
+ * wait for it to finish. Shared by run_subagent and run_subagents.
+ *
+ * The spawn checks and budget reservation run synchronously before the first
+ * await, so callers can start several runs at once and each sees the spawn
+ * count and pool left by the previous one.
+ *
+ * @throws vscode.CancellationError when the parent analysis is cancelled
+ */
+export async function runSubagent(
+    task: SubagentTask,
+    context: ExecutionContext,
+    workspaceSettings: WorkspaceSettingsService
+): Promise<SubagentRunOutcome> {
+    const executor = context.subagentExecutor!;
+    const sessionManager = context.subagentSessionManager!;
+    const maxSubagents = workspaceSettings.getMaxSubagentsPerSession();
+
+    if (!sessionManager.canSpawn()) {
+        Log.warn(
+            `Subagent spawn rejected: session limit reached (${maxSubagents})`
+        );
+        return {
+            subagentId: undefined,
+            error: SubagentErrors.maxExceeded(maxSubagents),
+        };
+    }
+
+    // Reserve iterations, tokens and time from the session pool before spawning
+    const budget = sessionManager.allocateBudget(task);
+    if (!budget) {
+        return {
+            subagentId: undefined,
+            error: SubagentErrors.budgetExhausted(),
+        };
+    }
+    const timeoutMs = budget.timeoutMs;
+
+    const subagentId = sessionManager.recordSpawn();
+    const remaining = sessionManager.getRemainingBudget();
+    Log.info(
+        `Subagent #${subagentId} spawned (${sessionManager.getCount()}/${maxSubagents}, ${remaining} remaining) ` +
+            `with budget: ${budget.iterations} iterations, ${budget.tokens} tokens, ${Math.round(timeoutMs / 1000)}s`
+    );
+
+    // Subagent needs a combined cancellation signal: cancel on parent cancellation OR timeout.
+    // We can't add timeout to the parent token (would cancel the entire analysis), so we
+    // create a local source and link it to the parent via sessionManager.
+    // Local variable (not instance) prevents race condition with parallel subagents.
+    const cancellationTokenSource = new vscode.CancellationTokenSource();
+    const parentCancellationDisposable =
+        sessionManager.registerSubagentCancellation(cancellationTokenSource);
+    const tracking = sessionManager.trackSubagent(
+        subagentId,
+        cancellationTokenSource
+    );
+    let cancelledByTimeout = false;
+    const timeoutHandle = setTimeout(() => {
+        cancelledByTimeout = true;
+        cancellationTokenSource.cancel();
+    }, timeoutMs);
+    let usage: SubagentUsage | undefined;
+    const span = Trace.asyncSpan(`Subagent #${subagentId}`, 'subagent', {
+        budgetIterations: budget.iterations,
+        budgetTokens: budget.tokens,
+    });
+
+    try {
+        // Own track, so the subagent's iterations don't interleave with the parent's
+        const result = await Trace.track(`Subagent #${subagentId}`, () =>
+            executor.execute(task, cancellationTokenSource.token, subagentId, {
+                toolResultCache: context.toolResultCache,
+                toolMetrics: context.toolMetrics,
+                budget,
+            })
+        );
+
+        clearTimeout(timeoutHandle);
+        usage = result.usage;
+
+        // Include partial response so parent LLM can use findings gathered so far
+        const partialResponse = result.response?.trim() || undefined;
+
+        if (!result.success && result.error === 'cancelled') {
+            if (context.cancellationToken.isCancellationRequested) {
+                return { subagentId, error: 'Subagent was cancelled' };
+            }
+            // Only attribute to timeout if parent wasn't also cancelled.
+            // Race condition: timeout timer can fire while executor unwinds
+            // from parent cancellation, setting cancelledByTimeout incorrectly.
+            const earlyReason = sessionManager.getCancellationReason(subagentId);
+            const message = earlyReason
+                ? SubagentErrors.cancelledEarly(earlyReason)
+                : cancelledByTimeout
+                  ? SubagentErrors.timeout(timeoutMs)
+                  : 'Subagent was cancelled';
+            return {
+                subagentId,
+                partialResponse,
+                error: withPartialFindings(message, partialResponse),
+            };
+        }
+
+        if (!result.success && result.error === 'max_iterations') {
+            const maxIterMsg = SubagentErrors.maxIterations(
+                result.toolCallsMade,
+                budget.iterations
+            );
+            return {
+                subagentId,
+                partialResponse,
+                error: withPartialFindings(maxIterMsg, partialResponse),
+            };
+        }
+
+        // Any other failure (LLM errors, service errors, etc.)
+        if (!result.success) {
+            return {
+                subagentId,
+                error: SubagentErrors.failed(result.error || 'Unknown error'),
+            };
+        }
+
+        return { subagentId, result };
+    } catch (error) {
+        clearTimeout(timeoutHandle);
+
+        if (isCancellationError(error)) {
+            throw error;
+        }
+
+        if (
+            cancelledByTimeout &&
+            !context.cancellationToken.isCancellationRequested
+        ) {
+            return { subagentId, error: SubagentErrors.timeout(timeoutMs) };
+        }
+
+        return {
+            subagentId,
+            error: SubagentErrors.failed(getErrorMessage(error)),
+        };
+    } finally {
+        span.end(usage ? { ...usage } : undefined);
+        sessionManager.releaseBudget(budget, usage);
+        if (usage) {
+            sessionManager.recordUsage(subagentId, task.task, usage);
+        }
+        tracking.dispose();
+        parentCancellationDisposable?.dispose();
+        cancellationTokenSource.dispose();
+    }
+}
+
+function withPartialFindings(
+    message: string,
+    partialResponse: string | undefined
+): string {
+    return partialResponse
+        ? `${message}\n\nPartial findings:\n${compactSubagentResponse(partialResponse, MAX_RESULT_CHARS)}`
+        : message;
+}
+
+/**
+ * Build tool metadata for subagent tool calls.
+ * Full nested tool results go out-of-line when a store is available;
+ * the parent conversation only ever sees the compact summary.
+ */
+export async function buildNestedToolCallsMetadata(
+    toolCalls: ToolCallRecord[],
+    context: ExecutionContext
+): Promise<ToolResultMetadata> {
+    const nestedStore = context.nestedToolCallStore;
+    return nestedStore
+        ? { nestedToolCallsRef: await nestedStore.put(toolCalls) }
+        : { nestedToolCalls: toolCalls };
+}
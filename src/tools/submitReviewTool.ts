@@ -49,6 +49,9 @@ export class SubmitReviewTool extends BaseTool {
             throw new vscode.CancellationError();
         }
 
+        // The review is final; subagents still running in this turn can't change it
+        context.subagentSessionManager?.cancelOutstanding('review submitted');
+
         // Return review content as-is - the output format prompt already defines structure
         return toolSuccess(args.review_content, { isCompletion: true });
     }
@@ -6,6 +6,7 @@ import {
 } from '../utils/asyncUtils';
 import { getErrorMessage } from '../utils/errorUtils';
 import { Log } from '../services/loggingService';
+import { Trace } from '../services/performanceTrace';
 
 /** Timeout for document symbol provider call */
 const SYMBOL_PROVIDER_TIMEOUT = 5_000; // 5 seconds
@@ -33,7 +34,11 @@ export class SymbolRangeExpander {
             >('vscode.executeDocumentSymbolProvider', document.uri);
 
             const symbols = await withCancellableTimeout(
-                Promise.resolve(symbolsPromise),
+                Trace.measure(
+                    'vscode.executeDocumentSymbolProvider',
+                    'lsp',
+                    symbolsPromise
+                ),
                 SYMBOL_PROVIDER_TIMEOUT,
                 `Document symbols for ${document.fileName}`,
                 token
@@ -2,6 +2,9 @@ import * as vscode from 'vscode';
 import { PlanSessionManager } from '../services/planSessionManager';
 import { SubagentSessionManager } from '../services/subagentSessionManager';
 import { SubagentExecutor } from '../services/subagentExecutor';
+import { ToolResultCache } from '../models/toolResultCache';
+import { NestedToolCallStore } from '../services/nestedToolCallStore';
+import { ToolMetricsStore } from '../services/toolMetricsStore';
 
 /**
  * Context passed to tools during execution.
@@ -34,6 +37,28 @@ export interface ExecutionContext {
      */
     subagentExecutor?: SubagentExecutor;
 
+    /**
+     * Read-only tool result cache for the current analysis.
+     * Shared by the main agent and its subagents so repeated file reads and
+     * symbol queries are served once (concurrent identical requests are coalesced).
+     * Undefined disables caching (e.g., tool testing).
+     */
+    toolResultCache?: ToolResultCache;
+
+    /**
+     * Out-of-line store for subagent tool calls shown in the analysis webview.
+     * RunSubagentTool keeps only a reference in tool metadata when present;
+     * otherwise nested calls stay inline (e.g., chat, where they aren't displayed).
+     */
+    nestedToolCallStore?: NestedToolCallStore;
+
+    /**
+     * Long-lived store of per-tool latency, response size and failure statistics.
+     * ToolExecutor records every call that reaches a tool; undefined disables
+     * recording (e.g., tests).
+     */
+    toolMetrics?: ToolMetricsStore;
+
     /**
      * Cancellation token for the current analysis.
      * Tools should pass this to long-running operations (symbol extraction, LSP calls)
@@ -85,6 +85,14 @@ export interface ToolCallMessage {
 export interface ToolCallRequest {
     messages: ToolCallMessage[];
     tools?: LanguageModelChatTool[];
+    /**
+     * Called for each tool call as soon as it is fully parsed from the response
+     * stream, before the rest of the response has arrived. Lets the caller start
+     * safe tools while the model is still generating.
+     */
+    onToolCall?: (toolCall: ToolCall) => void;
+    /** Called once when the first response part arrives (time to first token) */
+    onFirstChunk?: () => void;
 }
 
 /**
@@ -103,6 +111,26 @@ export interface SubagentTask {
     context?: string;
 }
 
+/**
+ * Resources granted to a single subagent by SubagentBudgetScheduler.
+ */
+export interface SubagentBudget {
+    /** Maximum conversation iterations */
+    iterations: number;
+    /** Maximum prompt tokens sent across all iterations */
+    tokens: number;
+    /** Wall-clock timeout for the whole investigation */
+    timeoutMs: number;
+}
+
+/**
+ * Resources a subagent actually consumed, reported back so unused budget can be returned.
+ */
+export interface SubagentUsage {
+    iterations: number;
+    tokens: number;
+}
+
 /**
  * Result from a completed subagent investigation.
  */
@@ -117,4 +145,8 @@ export interface SubagentResult {
     toolCalls: ToolCallRecord[];
     /** Error message if success is false */
     error?: string;
+    /** True when the result was reused from SubagentResultCache instead of a fresh run */
+    fromCache?: boolean;
+    /** Resources consumed by this run (zero for cached results) */
+    usage?: SubagentUsage;
 }
@@ -2,6 +2,8 @@
  * Types for displaying tool call history in the webview
  */
 
+import type { ChromeTrace } from '../services/performanceTrace';
+
 /**
  * Represents a single tool call record for display purposes
  */
@@ -24,6 +26,21 @@ export interface ToolCallRecord {
     timestamp: number;
     /** Nested tool calls from subagent (only for run_subagent tool) */
     nestedCalls?: ToolCallRecord[];
+    /** Out-of-line nested tool calls, fetched by the webview on demand (only for run_subagent tool) */
+    nestedCallsRef?: NestedToolCallsRef;
+    /** Fan-out task that made this nested call, such as "Task 2" (only for run_subagents) */
+    subagentLabel?: string;
+}
+
+/**
+ * Handle to subagent tool calls stored compressed in NestedToolCallStore.
+ * Keeps full nested tool results out of the analysis record and initial webview payload.
+ */
+export interface NestedToolCallsRef {
+    /** Store key used to fetch the calls */
+    key: string;
+    /** Number of stored calls (for display before loading) */
+    count: number;
 }
 
 /**
@@ -42,6 +59,73 @@ export interface ToolCallsData {
     analysisCompleted: boolean;
     /** Error message if the analysis was interrupted */
     analysisError: string | undefined;
+    /** Where the prompt tokens went (main analysis only) */
+    tokenBreakdown?: TokenBreakdown;
+}
+
+/**
+ * Tool call as listed in the analysis panel manifest: everything needed for
+ * the collapsed row. Arguments, result and inline nested calls are fetched
+ * from the extension host when the row is expanded.
+ */
+export type ToolCallSummary = Omit<
+    ToolCallRecord,
+    'arguments' | 'result' | 'nestedCalls'
+> & {
+    /** Number of inline nested calls (for display before loading) */
+    nestedCallCount?: number;
+};
+
+/**
+ * ToolCallsData with calls reduced to summaries, as embedded in the analysis
+ * panel HTML
+ */
+export interface ToolCallsManifest extends Omit<ToolCallsData, 'calls'> {
+    calls: ToolCallSummary[];
+}
+
+/**
+ * Prompt tokens of one main-analysis request, by message category
+ */
+export interface IterationTokenUsage {
+    iteration: number;
+    /** System prompt */
+    system: number;
+    /** First user message: instructions and the diff */
+    prompt: number;
+    /** Assistant text and tool call arguments */
+    assistant: number;
+    /** Tool results, by tool name */
+    toolResults: Record<string, number>;
+    /** Later user messages (completion nudges, context notices) */
+    other: number;
+    total: number;
+    /** Tokens removed by context cleanup before this request */
+    evicted: number;
+}
+
+/**
+ * Prompt tokens used by one subagent across its iterations
+ */
+export interface SubagentTokenUsage {
+    subagentId: number;
+    task: string;
+    iterations: number;
+    tokens: number;
+}
+
+/**
+ * Token accounting for an analysis, computed from the counts
+ * ConversationRunner already makes for context management
+ */
+export interface TokenBreakdown {
+    maxInputTokens: number;
+    iterations: IterationTokenUsage[];
+    /** Prompt tokens sent by the main analysis across all iterations */
+    totalPromptTokens: number;
+    /** Tokens removed from the context by cleanupContext */
+    evictedTokens: number;
+    subagents: SubagentTokenUsage[];
 }
 
 /**
@@ -54,6 +138,8 @@ export interface ToolCallingAnalysisResult {
     toolCalls: ToolCallsData;
     /** Whether the analysis was cancelled by the user */
     wasCancelled: boolean;
+    /** Where the analysis spent its time, in Chrome trace-event format */
+    trace?: ChromeTrace;
 }
 
 /**
@@ -66,6 +152,15 @@ export type AnalysisProgressCallback = (
     incrementPercent?: number
 ) => void;
 
+/**
+ * Intermediate result of a running analysis, for showing it as it builds up
+ */
+export type AnalysisUpdate =
+    | { type: 'toolCall'; call: ToolCallRecord }
+    | { type: 'plan'; plan: string };
+
+export type AnalysisUpdateCallback = (update: AnalysisUpdate) => void;
+
 /**
  * Context provider for subagent progress reporting.
  * Returns the current main analysis iteration info for context-aware messages.
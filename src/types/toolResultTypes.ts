@@ -1,4 +1,4 @@
-import type { ToolCallRecord } from './toolCallTypes';
+import type { ToolCallRecord, NestedToolCallsRef } from './toolCallTypes';
 
 /**
  * Standard result interface for all tool executions.
@@ -22,8 +22,12 @@ export interface ToolResult {
 export interface ToolResultMetadata {
     /** Nested tool calls from subagent execution (reuses ToolCallRecord for consistency) */
     nestedToolCalls?: ToolCallRecord[];
+    /** Reference to nested tool calls kept out-of-line in NestedToolCallStore */
+    nestedToolCallsRef?: NestedToolCallsRef;
     /** Whether this tool signals completion (used by submit_review) */
     isCompletion?: boolean;
+    /** Part of the work timed out; a successful result may be incomplete */
+    timedOut?: boolean;
 }
 
 /**
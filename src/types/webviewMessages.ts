@@ -2,6 +2,12 @@
  * Types for webview-to-extension-host communication
  */
 
+import type {
+    ToolCallRecord,
+    ToolCallsManifest,
+    ToolCallSummary,
+} from './toolCallTypes';
+
 // Base message structure
 export interface WebviewMessage<T = any> {
     command: string;
@@ -52,6 +58,99 @@ export interface ThemeUpdateMessage extends WebviewMessage<ThemeUpdatePayload> {
     command: 'themeUpdate';
 }
 
+// Nested (subagent) tool calls, fetched lazily from NestedToolCallStore
+export interface GetNestedToolCallsPayload {
+    key: string;
+}
+
+export interface GetNestedToolCallsMessage extends WebviewMessage<GetNestedToolCallsPayload> {
+    command: 'getNestedToolCalls';
+}
+
+export interface NestedToolCallsResultPayload {
+    key: string;
+    /** Undefined when the calls were evicted or could not be loaded */
+    calls?: ToolCallRecord[];
+    error?: string;
+}
+
+export interface NestedToolCallsResultMessage extends WebviewMessage<NestedToolCallsResultPayload> {
+    command: 'nestedToolCallsResult';
+}
+
+// Analysis panel manifest, embedded in the panel HTML. Diff file contents and
+// tool call details stay in the extension host and are fetched on demand.
+export interface DiffFileSummary {
+    oldPath: string;
+    newPath: string;
+    additions: number;
+    deletions: number;
+    /** Rendered lines, including unchanged context */
+    lines: number;
+    hunks: number;
+}
+
+export interface AnalysisManifest {
+    title: string;
+    analysis: string;
+    diffFiles: DiffFileSummary[];
+    toolCalls: ToolCallsManifest | null;
+    /** The analysis is still running; updates arrive as analysisUpdate messages */
+    running: boolean;
+    /** Latest review plan from update_plan (while running) */
+    plan?: string;
+}
+
+// Live updates of a running analysis, appended to what the panel shows
+export type AnalysisUpdatePayload =
+    | { kind: 'toolCall'; index: number; call: ToolCallSummary }
+    | { kind: 'plan'; plan: string }
+    | { kind: 'status'; message: string }
+    | { kind: 'stopped'; message: string }
+    | { kind: 'complete'; manifest: AnalysisManifest };
+
+export interface AnalysisUpdateMessage extends WebviewMessage<AnalysisUpdatePayload> {
+    command: 'analysisUpdate';
+}
+
+// Diff file contents by index into AnalysisManifest.diffFiles
+export interface GetDiffFilesPayload {
+    indices: number[];
+}
+
+export interface GetDiffFilesMessage extends WebviewMessage<GetDiffFilesPayload> {
+    command: 'getDiffFiles';
+}
+
+export interface DiffFilesResultPayload {
+    files: { index: number; text: string }[];
+    /** Set on the last reply to a request: every index it asked for */
+    requested?: number[];
+}
+
+export interface DiffFilesResultMessage extends WebviewMessage<DiffFilesResultPayload> {
+    command: 'diffFilesResult';
+}
+
+// Full tool call records by index into AnalysisManifest.toolCalls.calls
+export interface GetToolCallDetailsPayload {
+    indices: number[];
+}
+
+export interface GetToolCallDetailsMessage extends WebviewMessage<GetToolCallDetailsPayload> {
+    command: 'getToolCallDetails';
+}
+
+export interface ToolCallDetailsResultPayload {
+    calls: { index: number; call: ToolCallRecord }[];
+    /** Set on the last reply to a request: every index it asked for */
+    requested?: number[];
+}
+
+export interface ToolCallDetailsResultMessage extends WebviewMessage<ToolCallDetailsResultPayload> {
+    command: 'toolCallDetailsResult';
+}
+
 // Tool Testing command types
 export interface GetToolsPayload {
     // No specific payload needed
@@ -93,7 +192,14 @@ export type WebviewMessageType =
     | ValidatePathMessage
     | PathValidationResultMessage
     | ThemeUpdateMessage
-    | CopyToClipboardMessage;
+    | CopyToClipboardMessage
+    | GetNestedToolCallsMessage
+    | NestedToolCallsResultMessage
+    | GetDiffFilesMessage
+    | DiffFilesResultMessage
+    | GetToolCallDetailsMessage
+    | ToolCallDetailsResultMessage
+    | AnalysisUpdateMessage;
 
 export type ToolTestingMessageType =
     | GetToolsMessage
@@ -1,6 +1,121 @@
 import * as vscode from 'vscode';
 import * as path from 'path';
-import { parseMarkdownFileLinks } from '../lib/pathUtils';
+import {
+    iterateMarkdownFileLinks,
+    type MarkdownSegment,
+} from '../lib/pathUtils';
+
+/** Characters written before pausing so the chat view can render */
+const CHUNK_CHARS = 2000;
+
+/** Pause between chunks, about one frame */
+const CHUNK_PACE_MS = 16;
+
+type StreamPart =
+    | { kind: 'markdown'; value: string }
+    | {
+          kind: 'anchor';
+          target: vscode.Uri | vscode.Location;
+          title: string | undefined;
+          /** Length of the markdown link it replaces, for pacing */
+          length: number;
+      };
+
+/**
+ * Resolves relative file paths in review links to files of the analyzed diff,
+ * so a link to `handler.ts` opens `src/auth/handler.ts`.
+ *
+ * Built once per review: every file is indexed by each trailing run of its
+ * path segments, so matching a link is a single map lookup. Suffixes shared
+ * by several files resolve to nothing rather than to a guess.
+ */
+export class DiffPathMatcher {
+    private readonly exact = new Set<string>();
+    private readonly bySuffix = new Map<string, string | null>();
+    /** resolve() results by link path, so repeated links stat once */
+    private readonly resolved = new Map<string, Promise<string | undefined>>();
+
+    constructor(filePaths: Iterable<string>) {
+        for (const filePath of filePaths) {
+            const normalized = DiffPathMatcher.normalize(filePath);
+            this.exact.add(normalized);
+
+            const segments = normalized.split('/');
+            for (let start = 0; start < segments.length; start++) {
+                const suffix = segments.slice(start).join('/');
+                const existing = this.bySuffix.get(suffix);
+                if (existing === undefined) {
+                    this.bySuffix.set(suffix, normalized);
+                } else if (existing !== normalized) {
+                    this.bySuffix.set(suffix, null);
+                }
+            }
+        }
+    }
+
+    /**
+     * @returns The diff file the relative path refers to, or undefined
+     */
+    match(filePath: string): string | undefined {
+        const normalized = DiffPathMatcher.normalize(filePath);
+        if (this.exact.has(normalized)) {
+            return normalized;
+        }
+        return this.bySuffix.get(normalized) ?? undefined;
+    }
+
+    /**
+     * Like match(), but a suffix match is only used when the path is not a
+     * file under the workspace root already: a link to an existing root
+     * `index.ts` stays there even if the diff only touches `src/index.ts`.
+     */
+    resolve(
+        filePath: string,
+        workspaceRoot: vscode.Uri | undefined
+    ): Promise<string | undefined> {
+        const normalized = DiffPathMatcher.normalize(filePath);
+        let resolved = this.resolved.get(normalized);
+        if (!resolved) {
+            resolved = this.resolveUncached(normalized, workspaceRoot);
+            this.resolved.set(normalized, resolved);
+        }
+        return resolved;
+    }
+
+    private async resolveUncached(
+        normalized: string,
+        workspaceRoot: vscode.Uri | undefined
+    ): Promise<string | undefined> {
+        const matched = this.match(normalized);
+        if (!matched || matched === normalized || !workspaceRoot) {
+            return matched;
+        }
+        try {
+            const stat = await vscode.workspace.fs.stat(
+                vscode.Uri.joinPath(workspaceRoot, normalized)
+            );
+            return stat.type === vscode.FileType.File ? undefined : matched;
+        } catch {
+            return matched;
+        }
+    }
+
+    private static normalize(filePath: string): string {
+        return filePath.replace(/\\/g, '/').replace(/^\.\//, '');
+    }
+}
+
+export interface StreamMarkdownOptions {
+    /** Resolves link paths against the diff's files */
+    pathMatcher?: DiffPathMatcher;
+    /** Stops streaming between chunks */
+    token?: vscode.CancellationToken;
+}
+
+export interface StreamMarkdownResult {
+    /** The token stopped streaming before all content was written */
+    cancelled: boolean;
+}
 
 /**
  * Streams markdown content to a ChatResponseStream, converting file links
@@ -10,64 +125,140 @@ import { parseMarkdownFileLinks } from '../lib/pathUtils';
  * don't render as clickable links in VS Code Chat. By parsing the markdown
  * and using stream.anchor() for file links, we get proper file navigation.
  *
+ * The markdown is scanned once, lazily. Text between anchors is written as
+ * one part, and output is paced in chunks of about 2,000 characters so long
+ * reviews render progressively instead of in one burst.
+ *
  * @param stream The VS Code chat response stream
  * @param markdown The markdown content to stream
  * @param workspaceRoot Optional workspace root for resolving relative paths
+ * @param options Diff path matching and cancellation
+ * @returns Whether streaming was cancelled part way
  */
-export function streamMarkdownWithAnchors(
-    stream: vscode.ChatResponseStream,
+export async function streamMarkdownWithAnchors(
+    stream: Pick<vscode.ChatResponseStream, 'markdown' | 'anchor'>,
     markdown: string,
-    workspaceRoot: vscode.Uri | undefined
-): void {
-    const segments = parseMarkdownFileLinks(markdown);
+    workspaceRoot: vscode.Uri | undefined,
+    options: StreamMarkdownOptions = {}
+): Promise<StreamMarkdownResult> {
+    const { pathMatcher, token } = options;
+    let chunkChars = 0;
 
-    for (const segment of segments) {
-        if (segment.type === 'text') {
-            stream.markdown(segment.content);
-        } else if (segment.type === 'fileLink' && segment.filePath) {
-            // Resolve the file path to a proper URI
-            const fileUri = resolveFileUri(segment.filePath, workspaceRoot);
+    const parts = toStreamParts(markdown, workspaceRoot, pathMatcher);
+    for await (const part of parts) {
+        if (chunkChars >= CHUNK_CHARS) {
+            chunkChars = 0;
+            await new Promise((resolve) => setTimeout(resolve, CHUNK_PACE_MS));
+            if (token?.isCancellationRequested) {
+                return { cancelled: true };
+            }
+        }
+
+        if (part.kind === 'markdown') {
+            stream.markdown(part.value);
+            chunkChars += part.value.length;
+        } else {
+            stream.anchor(part.target, part.title);
+            chunkChars += part.length;
+        }
+    }
+    return { cancelled: false };
+}
 
-            // Use title or fall back to file path
-            const displayText = segment.title || segment.filePath;
+/**
+ * Turn markdown segments into stream writes: anchors for resolvable file
+ * links, and merged text split at line breaks into chunk-sized parts.
+ */
+async function* toStreamParts(
+    markdown: string,
+    workspaceRoot: vscode.Uri | undefined,
+    pathMatcher: DiffPathMatcher | undefined
+): AsyncGenerator<StreamPart> {
+    let text = '';
 
-            // Can't resolve - emit as plain text (preserves content without broken anchor)
-            if (!fileUri) {
-                stream.markdown(displayText);
+    for (const segment of iterateMarkdownFileLinks(markdown)) {
+        if (segment.type === 'fileLink' && segment.filePath) {
+            const target = await resolveAnchorTarget(
+                segment,
+                segment.filePath,
+                workspaceRoot,
+                pathMatcher
+            );
+            if (target) {
+                if (text) {
+                    yield { kind: 'markdown', value: text };
+                    text = '';
+                }
+                yield {
+                    kind: 'anchor',
+                    target,
+                    title: segment.title,
+                    length: segment.content.length,
+                };
                 continue;
             }
+            // Can't resolve - emit as plain text (preserves content without broken anchor)
+            text += segment.title || segment.filePath;
+        } else {
+            text += segment.content;
+        }
 
-            if (segment.line !== undefined) {
-                // Create a Location with line or range (convert 1-based to 0-based)
-                const startLine = segment.line - 1;
-                const endLine =
-                    segment.endLine !== undefined
-                        ? segment.endLine - 1
-                        : startLine;
-
-                // Determine column positions based on format:
-                // - line:column (e.g., file.ts:42:10) → cursor at specific position (zero-width)
-                // - line-endLine (e.g., file.ts:10-20) → select entire line range
-                // - line only (e.g., file.ts:42) → cursor at start of line (zero-width)
-                const startColumn =
-                    segment.column !== undefined ? segment.column - 1 : 0;
-                const endColumn =
-                    segment.endLine !== undefined
-                        ? Number.MAX_SAFE_INTEGER // Line range: select to end of last line
-                        : startColumn; // Single position: zero-width selection
-
-                const range = new vscode.Range(
-                    new vscode.Position(startLine, startColumn),
-                    new vscode.Position(endLine, endColumn)
-                );
-                const location = new vscode.Location(fileUri, range);
-                stream.anchor(location, segment.title);
-            } else {
-                // Just a file reference without line number
-                stream.anchor(fileUri, segment.title);
-            }
+        while (text.length > CHUNK_CHARS) {
+            const cut =
+                text.lastIndexOf('\n', CHUNK_CHARS - 1) + 1 || CHUNK_CHARS;
+            yield { kind: 'markdown', value: text.slice(0, cut) };
+            text = text.slice(cut);
         }
     }
+
+    if (text) {
+        yield { kind: 'markdown', value: text };
+    }
+}
+
+/**
+ * Anchor target for a file link: a Location when it has a line number,
+ * otherwise the file's URI. Undefined when the path can't be resolved.
+ */
+async function resolveAnchorTarget(
+    segment: MarkdownSegment,
+    filePath: string,
+    workspaceRoot: vscode.Uri | undefined,
+    pathMatcher: DiffPathMatcher | undefined
+): Promise<vscode.Uri | vscode.Location | undefined> {
+    const diffPath = path.isAbsolute(filePath)
+        ? undefined
+        : await pathMatcher?.resolve(filePath, workspaceRoot);
+    const fileUri = resolveFileUri(diffPath ?? filePath, workspaceRoot);
+    if (!fileUri) {
+        return undefined;
+    }
+
+    if (segment.line === undefined) {
+        // Just a file reference without line number
+        return fileUri;
+    }
+
+    // Create a Location with line or range (convert 1-based to 0-based)
+    const startLine = segment.line - 1;
+    const endLine =
+        segment.endLine !== undefined ? segment.endLine - 1 : startLine;
+
+    // Determine column positions based on format:
+    // - line:column (e.g., file.ts:42:10) → cursor at specific position (zero-width)
+    // - line-endLine (e.g., file.ts:10-20) → select entire line range
+    // - line only (e.g., file.ts:42) → cursor at start of line (zero-width)
+    const startColumn = segment.column !== undefined ? segment.column - 1 : 0;
+    const endColumn =
+        segment.endLine !== undefined
+            ? Number.MAX_SAFE_INTEGER // Line range: select to end of last line
+            : startColumn; // Single position: zero-width selection
+
+    const range = new vscode.Range(
+        new vscode.Position(startLine, startColumn),
+        new vscode.Position(endLine, endColumn)
+    );
+    return new vscode.Location(fileUri, range);
 }
 
 /**
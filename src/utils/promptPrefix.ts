@@ -0,0 +1,47 @@
+import { createHash } from 'crypto';
+import type { LanguageModelChatTool } from 'vscode';
+import type { ToolCallMessage } from '../types/modelTypes';
+
+/**
+ * Fingerprint of the static part of a request: system prompt, tool schemas and
+ * the first user message (the diff for PR analysis, the task for subagents).
+ *
+ * Providers cache long prompt prefixes, but only when they are byte-identical
+ * across requests. Logging this fingerprint per request shows whether the
+ * prefix stayed stable across iterations and between sibling subagents.
+ */
+export interface PromptPrefixFingerprint {
+    /** First 12 hex characters of the SHA-256 of the prefix */
+    hash: string;
+    /** Prefix length in characters */
+    chars: number;
+}
+
+/**
+ * Compute the prefix fingerprint for a request.
+ * @param messages Request messages; the system message is expected first
+ * @param tools Tool schemas sent with the request
+ */
+export function fingerprintPromptPrefix(
+    messages: ToolCallMessage[],
+    tools: LanguageModelChatTool[]
+): PromptPrefixFingerprint {
+    const system = messages.find((message) => message.role === 'system');
+    const firstUser = messages.find((message) => message.role === 'user');
+    const parts = [
+        system?.content ?? '',
+        JSON.stringify(tools),
+        firstUser?.content ?? '',
+    ];
+
+    const hash = createHash('sha256');
+    for (const part of parts) {
+        // Separator keeps ("ab", "c") and ("a", "bc") distinct
+        hash.update(part).update('\0');
+    }
+
+    return {
+        hash: hash.digest('hex').slice(0, 12),
+        chars: parts.reduce((sum, part) => sum + part.length, 0),
+    };
+}
@@ -0,0 +1,38 @@
+/**
+ * Nearest-rank percentile of an ascending-sorted array.
+ * @param sorted Values sorted ascending
+ * @param p Percentile in [0, 100]
+ * @returns The percentile value, or 0 for an empty array
+ */
+export function percentile(sorted: readonly number[], p: number): number {
+    if (sorted.length === 0) {
+        return 0;
+    }
+    const rank = Math.ceil((p / 100) * sorted.length);
+    return sorted[Math.min(sorted.length - 1, Math.max(0, rank - 1))];
+}
+
+/**
+ * Percentile summary of a sample
+ */
+export interface DistributionSummary {
+    p50: number;
+    p95: number;
+    p99: number;
+    max: number;
+}
+
+/**
+ * Summarize a sample by its p50/p95/p99/max. The input is not modified.
+ */
+export function summarizeDistribution(
+    values: readonly number[]
+): DistributionSummary {
+    const sorted = [...values].sort((a, b) => a - b);
+    return {
+        p50: percentile(sorted, 50),
+        p95: percentile(sorted, 95),
+        p99: percentile(sorted, 99),
+        max: sorted.at(-1) ?? 0,
+    };
+}
@@ -0,0 +1,341 @@
+/**
+ * Parsing and compaction of subagent responses for the parent conversation.
+ *
+ * Subagents are prompted to answer with Summary / Findings / Evidence / Confidence
+ * sections. The parent only needs those conclusions, not the subagent's narration
+ * or code snippets (it can read the cited locations itself), so the response is
+ * re-rendered compactly under a hard size cap to keep the parent's context for
+ * its own reasoning.
+ */
+
+export type SubagentConfidence = 'high' | 'medium' | 'low';
+
+export interface StructuredSubagentResponse {
+    /** One-paragraph answer to the delegated task */
+    summary: string;
+    /** One entry per finding, flattened to a single line */
+    findings: string[];
+    /** file:line references with a short note each */
+    evidence: string[];
+    /** Self-reported confidence, if stated */
+    confidence: SubagentConfidence | undefined;
+    /** Reason given alongside the confidence level */
+    confidenceNote: string;
+}
+
+const SECTION_PATTERN =
+    /^#{2,4}\s*\**\s*(summary|findings|evidence|confidence)\b.*$/gim;
+const LIST_ITEM_PATTERN = /^\s*(?:[-*+]|\d+[.)])\s+/;
+const LOCATION_PATTERN = /[\w./-]+\.[a-z]{1,5}:\d+(?:-\d+)?/gi;
+const CONFIDENCE_PATTERN = /\b(high|medium|low)\b/i;
+
+/** Space kept free for the "Omitted N finding(s)..." line */
+const OMISSION_NOTE_RESERVE = 120;
+
+const TRUNCATION_NOTE =
+    '\n\n[Subagent response truncated to fit the result size limit]';
+
+/**
+ * Parse a subagent response into its structured sections.
+ * @returns The structured response, or undefined if it has neither Findings nor Evidence
+ */
+export function parseSubagentResponse(
+    response: string
+): StructuredSubagentResponse | undefined {
+    const sections = splitSections(response);
+    const findingsBody = sections.get('findings');
+    const evidenceBody = sections.get('evidence');
+
+    if (findingsBody === undefined && evidenceBody === undefined) {
+        return undefined;
+    }
+
+    const findings = findingsBody ? toItems(findingsBody) : [];
+    const evidence = evidenceBody
+        ? toItems(evidenceBody)
+        : extractLocations(findings.join('\n'));
+
+    const confidenceText = collapse(sections.get('confidence') ?? '');
+    const confidenceMatch = confidenceText.match(CONFIDENCE_PATTERN);
+    const confidence = confidenceMatch
+        ? (confidenceMatch[1]!.toLowerCase() as SubagentConfidence)
+        : undefined;
+    const confidenceNote = confidenceMatch
+        ? confidenceText
+              .slice(confidenceMatch.index! + confidenceMatch[0].length)
+              .replace(/^[\s*:—–-]+/, '')
+              .trim()
+        : confidenceText;
+
+    return {
+        summary: collapse(stripCodeBlocks(sections.get('summary') ?? '')),
+        findings,
+        evidence,
+        confidence,
+        confidenceNote,
+    };
+}
+
+/**
+ * Render a subagent response for the parent conversation within `maxChars`.
+ * Structured responses are rebuilt section by section, dropping trailing items
+ * that don't fit; unstructured responses are truncated at a line boundary.
+ */
+export function compactSubagentResponse(
+    response: string,
+    maxChars: number
+): string {
+    const parsed = parseSubagentResponse(response);
+    if (!parsed) {
+        return truncateAtLine(response.trim(), maxChars);
+    }
+
+    const writer = new SectionWriter(maxChars);
+
+    if (parsed.confidence) {
+        const level = formatConfidence(parsed.confidence);
+        writer.tryAdd(
+            parsed.confidenceNote
+                ? `**Confidence:** ${level} — ${parsed.confidenceNote}`
+                : `**Confidence:** ${level}`
+        );
+    }
+
+    if (parsed.summary) {
+        writer.tryAdd(
+            `### Summary\n${truncateAtLine(parsed.summary, writer.budget / 3)}`
+        );
+    }
+
+    const omittedFindings = writer.addSection('### Findings', parsed.findings);
+    const omittedEvidence = writer.addSection('### Evidence', parsed.evidence);
+
+    return writer.finish(omittedFindings, omittedEvidence);
+}
+
+/** One subagent's response in a fan-out, with the label used to attribute it */
+export interface SubagentResponseEntry {
+    /** Short label such as "Task 3", or "Task 3 (incomplete)" for partial findings */
+    label: string;
+    response: string;
+}
+
+/**
+ * Merge several subagent responses into one report within `maxChars`.
+ *
+ * Each subagent contributes a one-line summary. Findings reported by more than
+ * one subagent are listed once with every label that reported them, and
+ * evidence is deduplicated by its file:line location.
+ */
+export function aggregateSubagentResponses(
+    entries: SubagentResponseEntry[],
+    maxChars: number
+): string {
+    const writer = new SectionWriter(maxChars);
+    const summaryChars = writer.budget / 3 / Math.max(1, entries.length);
+    const summaries: string[] = [];
+    const findings = new Map<string, { text: string; labels: string[] }>();
+    const evidence = new Map<string, string>();
+
+    const parsedEntries = entries.map(({ label, response }) => {
+        const parsed = parseSubagentResponse(response);
+        const summary = parsed
+            ? parsed.summary || 'No summary given.'
+            : collapse(stripCodeBlocks(response));
+        const confidence = parsed?.confidence
+            ? ` (${formatConfidence(parsed.confidence)} confidence)`
+            : '';
+        summaries.push(
+            `- **${label}**${confidence}: ${truncateAtWord(summary, summaryChars)}`
+        );
+        return { label, parsed };
+    });
+
+    // Interleave items across subagents so truncation doesn't starve later tasks
+    for (const { label, item: finding } of interleave(
+        parsedEntries.map(({ label, parsed }) => ({
+            label,
+            items: parsed?.findings ?? [],
+        }))
+    )) {
+        const key = normalizeForDedup(finding);
+        const existing = findings.get(key);
+        if (existing) {
+            existing.labels.push(label);
+        } else {
+            findings.set(key, { text: finding, labels: [label] });
+        }
+    }
+
+    for (const { item } of interleave(
+        parsedEntries.map(({ label, parsed }) => ({
+            label,
+            items: parsed?.evidence ?? [],
+        }))
+    )) {
+        const location = item.match(LOCATION_PATTERN)?.[0];
+        const key = location ? location.toLowerCase() : normalizeForDedup(item);
+        if (!evidence.has(key)) {
+            evidence.set(key, item);
+        }
+    }
+
+    writer.addSection('### Summaries', summaries, false);
+    const omittedFindings = writer.addSection(
+        '### Findings',
+        [...findings.values()].map(
+            ({ text, labels }) => `[${labels.join(', ')}] ${text}`
+        )
+    );
+    const omittedEvidence = writer.addSection('### Evidence', [
+        ...evidence.values(),
+    ]);
+
+    return writer.finish(omittedFindings, omittedEvidence);
+}
+
+/**
+ * Accumulates lines under a character budget. Items are kept in order; once one
+ * doesn't fit, the rest of its section is dropped. Space is reserved for the
+ * omission note so the cap holds even when items are dropped.
+ */
+class SectionWriter {
+    readonly budget: number;
+    private readonly lines: string[] = [];
+    private used = 0;
+
+    constructor(maxChars: number) {
+        this.budget = maxChars - OMISSION_NOTE_RESERVE;
+    }
+
+    tryAdd(line: string): boolean {
+        if (this.used + line.length + 1 > this.budget) {
+            return false;
+        }
+        this.lines.push(line);
+        this.used += line.length + 1;
+        return true;
+    }
+
+    /**
+     * Add a section; the heading is only written together with its first item.
+     * @param listed Prefix items with a list marker
+     * @returns Number of items dropped
+     */
+    addSection(title: string, items: string[], listed = true): number {
+        let omitted = 0;
+        let headed = false;
+        for (const item of items) {
+            const entry = listed ? `- ${item}` : item;
+            const line = headed ? entry : `${title}\n${entry}`;
+            if (omitted > 0 || !this.tryAdd(line)) {
+                omitted++;
+            } else {
+                headed = true;
+            }
+        }
+        return omitted;
+    }
+
+    finish(omittedFindings: number, omittedEvidence: number): string {
+        if (omittedFindings > 0 || omittedEvidence > 0) {
+            this.lines.push(
+                `_Omitted ${omittedFindings} finding(s) and ${omittedEvidence} evidence item(s) to stay within the result size limit._`
+            );
+        }
+        return this.lines.join('\n');
+    }
+}
+
+function splitSections(response: string): Map<string, string> {
+    const sections = new Map<string, string>();
+    const headings = [...response.matchAll(SECTION_PATTERN)];
+
+    headings.forEach((heading, i) => {
+        const name = heading[1]!.toLowerCase();
+        const start = heading.index! + heading[0].length;
+        const end = headings[i + 1]?.index ?? response.length;
+        // Keep the first occurrence; later duplicates are usually quoted examples
+        if (!sections.has(name)) {
+            sections.set(name, response.slice(start, end));
+        }
+    });
+
+    return sections;
+}
+
+/**
+ * Flatten a section body into single-line items. List markers start a new item;
+ * other non-empty lines continue the current one. Code blocks are dropped.
+ */
+function toItems(body: string): string[] {
+    const items: string[] = [];
+    for (const line of stripCodeBlocks(body).split('\n')) {
+        if (!line.trim()) {
+            continue;
+        }
+        if (LIST_ITEM_PATTERN.test(line) || items.length === 0) {
+            items.push(line.replace(LIST_ITEM_PATTERN, '').trim());
+        } else {
+            items[items.length - 1] += ` ${line.trim()}`;
+        }
+    }
+    return items.map(collapse).filter((item) => item.length > 0);
+}
+
+function extractLocations(text: string): string[] {
+    return [...new Set(text.match(LOCATION_PATTERN) ?? [])];
+}
+
+function stripCodeBlocks(text: string): string {
+    return text.replace(/```[\s\S]*?(```|$)/g, '');
+}
+
+function collapse(text: string): string {
+    return text.replace(/\s+/g, ' ').trim();
+}
+
+/** Round-robin over each source's items: first item of every source, then the second, ... */
+function interleave(
+    sources: { label: string; items: string[] }[]
+): { label: string; item: string }[] {
+    const result: { label: string; item: string }[] = [];
+    const longest = Math.max(0, ...sources.map(({ items }) => items.length));
+    for (let i = 0; i < longest; i++) {
+        for (const { label, items } of sources) {
+            if (i < items.length) {
+                result.push({ label, item: items[i]! });
+            }
+        }
+    }
+    return result;
+}
+
+function formatConfidence(confidence: SubagentConfidence): string {
+    return confidence.charAt(0).toUpperCase() + confidence.slice(1);
+}
+
+/** Lowercase, punctuation-free form so trivially reworded duplicates match */
+function normalizeForDedup(text: string): string {
+    return text
+        .toLowerCase()
+        .replace(/[^\p{L}\p{N}:./]+/gu, ' ')
+        .trim();
+}
+
+function truncateAtWord(text: string, maxChars: number): string {
+    if (text.length <= maxChars) {
+        return text;
+    }
+    const cut = text.lastIndexOf(' ', maxChars - 1);
+    return `${text.slice(0, cut > 0 ? cut : maxChars - 1)}…`;
+}
+
+function truncateAtLine(text: string, maxChars: number): string {
+    if (text.length <= maxChars) {
+        return text;
+    }
+    const limit = Math.max(0, maxChars - TRUNCATION_NOTE.length);
+    const cut = text.lastIndexOf('\n', limit);
+    return text.slice(0, cut > 0 ? cut : limit).trimEnd() + TRUNCATION_NOTE;
+}
@@ -12,6 +12,7 @@ import {
 } from './asyncUtils';
 import { getErrorMessage } from './errorUtils';
 import { Log } from '../services/loggingService';
+import { Trace } from '../services/performanceTrace';
 
 /** Timeout for extracting symbols from a single file */
 const FILE_SYMBOL_TIMEOUT = 5_000; // 5 seconds per file
@@ -88,7 +89,11 @@ export class SymbolExtractor {
             >('vscode.executeDocumentSymbolProvider', fileUri);
 
             const symbols = await withCancellableTimeout(
-                Promise.resolve(symbolsPromise),
+                Trace.measure(
+                    'vscode.executeDocumentSymbolProvider',
+                    'lsp',
+                    symbolsPromise
+                ),
                 FILE_SYMBOL_TIMEOUT,
                 `Symbol extraction for ${path.basename(fileUri.fsPath)}`,
                 token
@@ -150,10 +155,11 @@ export class SymbolExtractor {
 
         if (gitignoreContent.trim()) {
             Log.debug(
-                `Loaded gitignore patterns: ${gitignoreContent
-                    .split('\n')
-                    .filter((line) => line.trim() && !line.startsWith('#'))
-                    .join(', ')}`
+                () =>
+                    `Loaded gitignore patterns: ${gitignoreContent
+                        .split('\n')
+                        .filter((line) => line.trim() && !line.startsWith('#'))
+                        .join(', ')}`
             );
         } else {
             Log.debug(`No gitignore patterns found`);
@@ -5,20 +5,30 @@ import { useCopyToClipboard } from './hooks/useCopyToClipboard';
 import { AnalysisTab } from './components/AnalysisTab';
 import { ToolCallsTab } from './components/ToolCallsTab';
 import { DiffTab } from './components/DiffTab';
-import type { ToolCallsData } from '../types/toolCallTypes';
+import type { ToolCallsManifest } from '../types/toolCallTypes';
+import type { DiffFileSummary } from '../types/webviewMessages';
+import { formatLiveAnalysisContent } from './utils/liveAnalysis';
 
 interface AnalysisViewProps {
     title: string;
-    diffText: string;
+    diffFiles: DiffFileSummary[];
     analysis: string;
-    toolCalls: ToolCallsData | null;
+    toolCalls: ToolCallsManifest | null;
+    /** Still running: tool calls and the plan are updated live */
+    running: boolean;
+    plan?: string;
+    /** Latest progress message, or why the analysis stopped */
+    statusMessage?: string;
 }
 
 const AnalysisView: React.FC<AnalysisViewProps> = ({
     title,
-    diffText,
+    diffFiles,
     analysis,
     toolCalls,
+    running,
+    plan,
+    statusMessage,
 }) => {
     const [windowWidth, setWindowWidth] = useState<number>(window.innerWidth);
 
@@ -48,6 +58,9 @@ const AnalysisView: React.FC<AnalysisViewProps> = ({
     const viewType = windowWidth > 1024 ? 'split' : 'unified';
 
     const toolCallsCount = toolCalls?.totalCalls ?? 0;
+    const analysisContent = running
+        ? formatLiveAnalysisContent(plan)
+        : analysis || (statusMessage ? `_${statusMessage}_` : '');
 
     return (
         <div className="h-full flex flex-col bg-background min-h-0">
@@ -59,8 +72,8 @@ const AnalysisView: React.FC<AnalysisViewProps> = ({
                             {title}
                         </h1>
                         <p className="text-xs text-muted-foreground mt-0.5 opacity-75">
-                            Pull request analysis with tool calls and code
-                            changes
+                            {statusMessage ??
+                                'Pull request analysis with tool calls and code changes'}
                         </p>
                     </div>
                 </div>
@@ -99,8 +112,7 @@ const AnalysisView: React.FC<AnalysisViewProps> = ({
                     className="vscode-tab-content flex-1 min-h-0 overflow-auto bg-background"
                 >
                     <AnalysisTab
-                        content={analysis}
-                        isDarkTheme={isDarkTheme}
+                        content={analysisContent}
                         onCopy={copyToClipboard}
                     />
                 </TabsContent>
@@ -111,6 +123,7 @@ const AnalysisView: React.FC<AnalysisViewProps> = ({
                 >
                     <ToolCallsTab
                         toolCalls={toolCalls}
+                        running={running}
                         onCopy={copyToClipboard}
                     />
                 </TabsContent>
@@ -119,7 +132,7 @@ const AnalysisView: React.FC<AnalysisViewProps> = ({
                     value="changes"
                     className="vscode-tab-content flex-1 min-h-0 overflow-hidden flex flex-col bg-background"
                 >
-                    <DiffTab diffText={diffText} viewType={viewType} />
+                    <DiffTab diffFiles={diffFiles} viewType={viewType} />
                 </TabsContent>
             </Tabs>
         </div>
@@ -0,0 +1,79 @@
+import React from 'react';
+import { Fragment, jsx, jsxs } from 'react/jsx-runtime';
+import { toJsxRuntime } from 'hast-util-to-jsx-runtime';
+import { CopyButton } from './CopyButton';
+import { useHighlightedCode } from '../hooks/useHighlightedCode';
+import { useNearViewport } from '../hooks/useNearViewport';
+import type { MarkdownCodeBlock } from '../utils/markdownTree';
+
+/** How far outside the viewport code blocks are still highlighted */
+const CODE_BLOCK_OVERSCAN_MARGIN = '600px 0px';
+
+const editorFont = {
+    fontFamily: 'var(--vscode-editor-font-family)',
+    fontSize: 'var(--vscode-editor-font-size)',
+    fontWeight: 'var(--vscode-editor-font-weight)',
+};
+
+interface CodeBlockProps {
+    block: MarkdownCodeBlock;
+    onCopy?: (text: string) => void;
+}
+
+/**
+ * Fenced code block from a rendered markdown document. A block is
+ * highlighted (in a worker) when it first nears the viewport, and its spans
+ * are only mounted while it is near; elsewhere the same text renders plain,
+ * so the block keeps its size and long reviews stay light.
+ */
+export const CodeBlock = ({ block, onCopy }: CodeBlockProps) => {
+    const [preRef, { near }] = useNearViewport<HTMLPreElement>(
+        null,
+        CODE_BLOCK_OVERSCAN_MARGIN
+    );
+    const highlighted = useHighlightedCode(block, near);
+
+    return (
+        <div style={{ position: 'relative' }}>
+            <pre
+                ref={preRef}
+                className="hljs"
+                style={{
+                    ...editorFont,
+                    margin: 0,
+                    padding: '1em',
+                    overflow: 'auto',
+                    borderRadius: '0.5rem',
+                    background: 'var(--vscode-textCodeBlock-background)',
+                    lineHeight: '1.5',
+                    color: 'var(--vscode-editor-foreground)',
+                }}
+            >
+                <code
+                    className={
+                        block.language
+                            ? `language-${block.language}`
+                            : undefined
+                    }
+                    style={{
+                        ...editorFont,
+                        background: 'transparent',
+                        color: 'inherit',
+                    }}
+                >
+                    {near && highlighted
+                        ? toJsxRuntime(
+                              { type: 'root', children: highlighted },
+                              { Fragment, jsx, jsxs }
+                          )
+                        : block.code}
+                </code>
+            </pre>
+            <CopyButton
+                text={block.code}
+                className="absolute top-2 right-2"
+                onCopy={onCopy}
+            />
+        </div>
+    );
+};
@@ -4,20 +4,23 @@ import { Button } from '@/components/ui/button';
 import { cn } from '@/lib/utils';
 
 interface CopyButtonProps {
-    text: string;
+    text?: string;
+    /** Produces the text on click, for content that is loaded on demand */
+    getText?: () => Promise<string>;
     className?: string;
     onCopy?: (text: string) => void;
 }
 
 export const CopyButton: React.FC<CopyButtonProps> = ({
     text,
+    getText,
     className,
     onCopy,
 }) => {
     const [isCopied, setIsCopied] = useState(false);
     const timeoutRef = useRef<NodeJS.Timeout | null>(null);
 
-    const handleClick = () => {
+    const handleClick = async () => {
         // Clear any existing timeout
         if (timeoutRef.current) {
             clearTimeout(timeoutRef.current);
@@ -27,7 +30,13 @@ export const CopyButton: React.FC<CopyButtonProps> = ({
         setIsCopied(true);
 
         // Call the onCopy handler (which does the actual clipboard operation)
-        onCopy?.(text);
+        try {
+            onCopy?.(getText ? await getText() : (text ?? ''));
+        } catch (error) {
+            console.error('Failed to produce text to copy:', error);
+            setIsCopied(false);
+            return;
+        }
 
         // Reset state after 1 second
         timeoutRef.current = setTimeout(() => {
@@ -1,27 +1,56 @@
-import React from 'react';
-import { Diff, Hunk, tokenize, markEdits, parseDiff } from 'react-diff-view';
+import React, { useState } from 'react';
+import { Diff, Hunk, type FileData } from 'react-diff-view';
 import 'react-diff-view/style/index.css';
+import { useDiffFile } from '../hooks/useAnalysisData';
+import { useDiffTokens } from '../hooks/useDiffTokens';
+import { useVirtualList } from '../hooks/useVirtualList';
+import {
+    DIFF_FILE_GAP_PX,
+    DIFF_OVERSCAN_PX,
+    HUNK_BATCH_SIZE,
+    estimateDiffHeight,
+    estimateFileSectionHeight,
+    isCollapsedByDefault,
+} from '../utils/diffWindowing';
+import type { DiffFileSummary } from '../../types/webviewMessages';
 
 interface DiffTabProps {
-    diffText: string;
+    diffFiles: DiffFileSummary[];
     viewType: 'split' | 'unified';
 }
 
-export const DiffTab = ({ diffText, viewType }: DiffTabProps) => {
-    console.time('Diff tab render');
+/**
+ * Changed files of the analyzed diff, virtualized: only file sections near
+ * the visible area are mounted. Headers come from the manifest; a file's
+ * diff is requested from the extension host when its section mounts, and
+ * word-level highlighting is computed in a worker, so diffs with thousands
+ * of files stay responsive.
+ *
+ * Files toggled away from their default expansion are kept here, so
+ * sections scrolled away and back keep their state.
+ */
+export const DiffTab = ({ diffFiles, viewType }: DiffTabProps) => {
+    const [toggledFiles, setToggledFiles] = useState<ReadonlySet<number>>(
+        () => new Set()
+    );
+    const isExpanded = (index: number) =>
+        isCollapsedByDefault(diffFiles[index]!) === toggledFiles.has(index);
+    const { setScrollElement, range, measureItem } = useVirtualList(
+        diffFiles.length,
+        (index) =>
+            estimateFileSectionHeight(diffFiles[index]!, isExpanded(index)),
+        DIFF_OVERSCAN_PX
+    );
 
-    // Parse diff - React Compiler handles memoization
-    let diffFiles: ReturnType<typeof parseDiff> = [];
-    if (diffText) {
-        console.time('Diff parsing');
-        try {
-            diffFiles = parseDiff(diffText);
-            console.timeEnd('Diff parsing');
-        } catch (error) {
-            console.error('Error parsing diff:', error);
-            console.timeEnd('Diff parsing');
-        }
-    }
+    const toggleFile = (index: number) => {
+        setToggledFiles((prev) => {
+            const next = new Set(prev);
+            if (!next.delete(index)) {
+                next.add(index);
+            }
+            return next;
+        });
+    };
 
     if (diffFiles.length === 0) {
         return (
@@ -31,63 +60,128 @@ export const DiffTab = ({ diffText, viewType }: DiffTabProps) => {
         );
     }
 
-    // Tokenize files for word-level diff highlighting
-    const tokenizedFiles = diffFiles.map((file) => {
-        try {
-            // Use tokenize with markEdits enhancer for word-level highlighting
-            const options = {
-                enhancers: [markEdits(file.hunks, { type: 'line' })],
-            };
-            const tokens = tokenize(file.hunks, options);
-            return { ...file, tokens };
-        } catch (error) {
-            console.warn(
-                'Failed to tokenize file:',
-                file.newPath || file.oldPath,
-                error
-            );
-            return { ...file, tokens: null };
-        }
-    });
-
-    const result = (
-        <div className="border rounded-lg bg-background flex-1 min-h-0 overflow-auto">
-            <div className="w-full">
-                {tokenizedFiles.map((file, index) => (
-                    <div key={index} className="mb-4">
-                        {/* File header */}
-                        <div className="bg-muted p-2 text-sm font-mono border-b">
-                            {file.oldPath &&
-                            file.newPath &&
-                            file.oldPath !== file.newPath ? (
-                                <span>
-                                    {file.oldPath} → {file.newPath}
-                                </span>
-                            ) : (
-                                <span>{file.newPath || file.oldPath}</span>
-                            )}
-                        </div>
-
-                        {/* Diff content */}
-                        <Diff
+    return (
+        <div
+            ref={setScrollElement}
+            className="border rounded-lg bg-background flex-1 min-h-0 overflow-auto"
+        >
+            <div style={{ height: range.offsetBefore }} />
+            {diffFiles.slice(range.start, range.end).map((file, offset) => {
+                const index = range.start + offset;
+                // Padding rather than margin, so the gap is measured
+                return (
+                    <div
+                        key={`${index}:${file.oldPath}:${file.newPath}`}
+                        data-index={index}
+                        ref={measureItem}
+                        style={{ paddingBottom: DIFF_FILE_GAP_PX }}
+                    >
+                        <DiffFileSection
+                            index={index}
+                            file={file}
                             viewType={viewType}
-                            diffType={file.type}
-                            hunks={file.hunks}
-                            className="text-sm"
-                            tokens={file.tokens}
-                        >
-                            {(hunks) =>
-                                hunks.map((hunk) => (
-                                    <Hunk key={hunk.content} hunk={hunk} />
-                                ))
-                            }
-                        </Diff>
+                            expanded={isExpanded(index)}
+                            onToggle={() => toggleFile(index)}
+                        />
                     </div>
-                ))}
-            </div>
+                );
+            })}
+            <div style={{ height: range.offsetAfter }} />
         </div>
     );
+};
+
+interface DiffFileSectionProps {
+    index: number;
+    file: DiffFileSummary;
+    viewType: 'split' | 'unified';
+    expanded: boolean;
+    onToggle: () => void;
+}
 
-    console.timeEnd('Diff tab render');
-    return result;
+const DiffFileSection = ({
+    index,
+    file,
+    viewType,
+    expanded,
+    onToggle,
+}: DiffFileSectionProps) => {
+    const { value: fileData } = useDiffFile(index, expanded);
+    const renamed =
+        file.oldPath && file.newPath && file.oldPath !== file.newPath;
+
+    return (
+        <>
+            <button
+                type="button"
+                className="w-full flex items-center gap-2 bg-muted p-2 text-sm font-mono border-b text-left"
+                onClick={onToggle}
+                aria-expanded={expanded}
+            >
+                <span className="opacity-70">{expanded ? '▾' : '▸'}</span>
+                <span className="flex-1 truncate">
+                    {renamed
+                        ? `${file.oldPath} → ${file.newPath}`
+                        : file.newPath || file.oldPath}
+                </span>
+                <span className="text-xs text-muted-foreground shrink-0">
+                    +{file.additions} −{file.deletions}
+                    {!expanded && isCollapsedByDefault(file) && ' (large)'}
+                </span>
+            </button>
+
+            {expanded &&
+                (fileData ? (
+                    <DiffFileBody file={fileData} viewType={viewType} />
+                ) : (
+                    <div style={{ height: estimateDiffHeight(file) }} />
+                ))}
+        </>
+    );
+};
+
+interface DiffFileBodyProps {
+    file: FileData;
+    viewType: 'split' | 'unified';
+}
+
+const DiffFileBody = ({ file, viewType }: DiffFileBodyProps) => {
+    const tokens = useDiffTokens(file.hunks);
+    const [shownHunks, setShownHunks] = useState(HUNK_BATCH_SIZE);
+    const remainingHunks = file.hunks.length - shownHunks;
+
+    if (file.hunks.length === 0) {
+        return (
+            <div className="p-2 text-xs text-muted-foreground">
+                Binary file or no textual changes
+            </div>
+        );
+    }
+
+    return (
+        <>
+            <Diff
+                viewType={viewType}
+                diffType={file.type}
+                hunks={file.hunks.slice(0, shownHunks)}
+                className="text-sm"
+                tokens={tokens}
+            >
+                {(hunks) =>
+                    hunks.map((hunk) => <Hunk key={hunk.content} hunk={hunk} />)
+                }
+            </Diff>
+            {remainingHunks > 0 && (
+                <button
+                    type="button"
+                    className="w-full p-2 text-xs text-muted-foreground hover:text-foreground border-t"
+                    onClick={() =>
+                        setShownHunks((prev) => prev + HUNK_BATCH_SIZE)
+                    }
+                >
+                    Show more ({remainingHunks} hunks remaining)
+                </button>
+            )}
+        </>
+    );
 };
@@ -1,31 +1,33 @@
 import React from 'react';
-import ReactMarkdown from 'react-markdown';
-import remarkGfm from 'remark-gfm';
-import { PrismAsyncLight as SyntaxHighlighter } from 'react-syntax-highlighter';
-import {
-    vscDarkPlus,
-    vs,
-} from 'react-syntax-highlighter/dist/esm/styles/prism';
+import { Fragment, jsx, jsxs } from 'react/jsx-runtime';
+import { toJsxRuntime } from 'hast-util-to-jsx-runtime';
+import { CodeBlock } from './CodeBlock';
 import { CopyButton } from './CopyButton';
 import { FileLink } from './FileLink';
 import { parseFilePathFromUrl } from '../../lib/pathUtils';
+import { useRenderedMarkdown } from '../hooks/useRenderedMarkdown';
 
 interface MarkdownRendererProps {
     content: string;
     id: string;
-    isDarkTheme: boolean;
     showCopy?: boolean;
     onCopy?: (text: string) => void;
 }
 
+/**
+ * Markdown parsed in a Web Worker (see useRenderedMarkdown), so long reviews
+ * don't block input while they render. Code blocks highlight themselves
+ * lazily (see CodeBlock).
+ */
 export const MarkdownRenderer = ({
     content,
-    isDarkTheme,
     showCopy = true,
     onCopy,
 }: MarkdownRendererProps) => {
+    const rendered = useRenderedMarkdown(content);
+
     const customComponents = {
-        a: ({ href, children, ...props }: any) => {
+        a: ({ href, children, node: _node, ...props }: any) => {
             const parsedPath = href ? parseFilePathFromUrl(href) : null;
 
             if (parsedPath) {
@@ -47,88 +49,25 @@ export const MarkdownRenderer = ({
                 </a>
             );
         },
-        pre: ({ children }: any) => {
-            return <>{children}</>;
-        },
-        code: ({ className, children, node, ...props }: any) => {
-            const match = /language-(\w+)/.exec(className || '');
-            const language = match ? match[1] : '';
-            const textContent = String(children).replace(/\n$/, '');
-
-            // In react-markdown v9, the inline prop was removed
-            // We need to use alternative detection methods:
-            // 1. Check if parent element is <pre> (block code)
-            // 2. Check for newlines in content
-            // 3. Check for language class
-            const isBlock = node?.parent?.tagName === 'pre';
-            const hasNewlines = String(children).includes('\n');
-            const hasLanguageClass = !!match;
-
-            // A code block is detected if:
-            // - It's wrapped in a <pre> tag, OR
-            // - It has a language class, OR
-            // - It contains newlines (multiline)
-            const isCodeBlock = isBlock || hasLanguageClass || hasNewlines;
-
-            if (isCodeBlock) {
-                return (
-                    <div style={{ position: 'relative' }}>
-                        <SyntaxHighlighter
-                            style={
-                                isDarkTheme ? (vscDarkPlus as any) : (vs as any)
-                            }
-                            language={language || 'text'}
-                            PreTag="div"
-                            showLineNumbers={false}
-                            customStyle={{
-                                margin: 0,
-                                borderRadius: '0.5rem',
-                                background:
-                                    'var(--vscode-textCodeBlock-background)',
-                                fontSize: 'var(--vscode-editor-font-size)',
-                                fontFamily: 'var(--vscode-editor-font-family)',
-                                fontWeight: 'var(--vscode-editor-font-weight)',
-                                lineHeight: '1.5',
-                                color: 'var(--vscode-editor-foreground)',
-                            }}
-                            codeTagProps={{
-                                style: {
-                                    background: 'transparent',
-                                    color: 'inherit',
-                                    fontFamily:
-                                        'var(--vscode-editor-font-family)',
-                                    fontWeight:
-                                        'var(--vscode-editor-font-weight)',
-                                    fontSize: 'var(--vscode-editor-font-size)',
-                                },
-                            }}
-                            {...props}
-                        >
-                            {textContent}
-                        </SyntaxHighlighter>
-                        <CopyButton
-                            text={textContent}
-                            className="absolute top-2 right-2"
-                            onCopy={onCopy}
-                        />
-                    </div>
-                );
-            } else {
-                return (
-                    <code
-                        className="bg-muted px-1 py-0.5 rounded"
-                        style={{
-                            fontFamily: 'var(--vscode-editor-font-family)',
-                            fontSize: 'var(--vscode-editor-font-size)',
-                            fontWeight: 'var(--vscode-editor-font-weight)',
-                        }}
-                        {...props}
-                    >
-                        {children}
-                    </code>
-                );
-            }
+        // Fenced code blocks were extracted by the worker; see markdownTree
+        pre: ({ node }: any) => {
+            const block =
+                rendered?.codeBlocks[node?.properties?.dataCodeBlock];
+            return block ? <CodeBlock block={block} onCopy={onCopy} /> : null;
         },
+        code: ({ children, node: _node, ...props }: any) => (
+            <code
+                className="bg-muted px-1 py-0.5 rounded"
+                style={{
+                    fontFamily: 'var(--vscode-editor-font-family)',
+                    fontSize: 'var(--vscode-editor-font-size)',
+                    fontWeight: 'var(--vscode-editor-font-weight)',
+                }}
+                {...props}
+            >
+                {children}
+            </code>
+        ),
     };
 
     return (
@@ -139,12 +78,19 @@ export const MarkdownRenderer = ({
                 </div>
             )}
             <div className="prose prose-sm max-w-none dark:prose-invert">
-                <ReactMarkdown
-                    remarkPlugins={[remarkGfm]}
-                    components={customComponents}
-                >
-                    {content}
-                </ReactMarkdown>
+                {rendered ? (
+                    toJsxRuntime(rendered.tree, {
+                        Fragment,
+                        jsx,
+                        jsxs,
+                        components: customComponents,
+                        ignoreInvalidStyle: true,
+                        passKeys: true,
+                        passNode: true,
+                    })
+                ) : (
+                    <p className="text-muted-foreground">Rendering…</p>
+                )}
             </div>
         </div>
     );
@@ -0,0 +1,191 @@
+import { useState } from 'react';
+import type { TokenBreakdown } from '../../types/toolCallTypes';
+import { sumTokenCategories } from '../utils/tokenBreakdown';
+
+/** Tools listed individually; the rest are summed into one row */
+const TOP_TOOLS = 5;
+
+const formatTokens = (tokens: number) =>
+    tokens < 1000 ? String(tokens) : `${(tokens / 1000).toFixed(1)}k`;
+
+const formatShare = (tokens: number, total: number) =>
+    total > 0 ? `${Math.round((tokens / total) * 100)}%` : '–';
+
+interface TokenBreakdownSectionProps {
+    breakdown: TokenBreakdown;
+}
+
+/**
+ * Collapsible summary of where the analysis' prompt tokens went: by message
+ * category, by tool, per request, and per subagent.
+ */
+export const TokenBreakdownSection = ({
+    breakdown,
+}: TokenBreakdownSectionProps) => {
+    const [expanded, setExpanded] = useState(false);
+    const totals = sumTokenCategories(breakdown.iterations);
+    const total = breakdown.totalPromptTokens;
+    const subagentTokens = breakdown.subagents.reduce(
+        (sum, subagent) => sum + subagent.tokens,
+        0
+    );
+
+    const topTools = totals.tools.slice(0, TOP_TOOLS);
+    const otherToolTokens = totals.tools
+        .slice(TOP_TOOLS)
+        .reduce((sum, [, tokens]) => sum + tokens, 0);
+
+    const categories: [string, number][] = [
+        ['System prompt', totals.system],
+        ['Diff and instructions', totals.prompt],
+        ['Assistant messages', totals.assistant],
+        ['Tool results', totals.toolResults],
+        ['Other messages', totals.other],
+    ];
+
+    const toggle = () => setExpanded((prev) => !prev);
+
+    return (
+        <div className="tool-call-item token-breakdown">
+            <div
+                className="tool-call-header"
+                onClick={toggle}
+                role="button"
+                tabIndex={0}
+                onKeyDown={(e) => e.key === 'Enter' && toggle()}
+            >
+                <svg
+                    className={`tool-call-chevron ${expanded ? 'tool-call-chevron--expanded' : ''}`}
+                    viewBox="0 0 16 16"
+                    fill="currentColor"
+                >
+                    <path d="M5.7 13.7L5 13l4.6-4.6L5 3.7l.7-.7 5 5.3-5 5.4z" />
+                </svg>
+                <span className="tool-call-name">Token Usage</span>
+                <span className="tool-call-duration">
+                    {formatTokens(total)} sent in{' '}
+                    {breakdown.iterations.length} requests
+                    {subagentTokens > 0 &&
+                        ` + ${formatTokens(subagentTokens)} by subagents`}
+                </span>
+            </div>
+            <div
+                className={`tool-call-body ${expanded ? 'tool-call-body--expanded' : ''}`}
+            >
+                <div className="tool-call-section">
+                    <div className="tool-call-section-title">By Category</div>
+                    <table className="token-breakdown-table">
+                        <tbody>
+                            {categories.map(([label, tokens]) => (
+                                <tr key={label}>
+                                    <td>{label}</td>
+                                    <td>{formatTokens(tokens)}</td>
+                                    <td>{formatShare(tokens, total)}</td>
+                                </tr>
+                            ))}
+                            <tr>
+                                <td>Evicted by context cleanup</td>
+                                <td>{formatTokens(breakdown.evictedTokens)}</td>
+                                <td />
+                            </tr>
+                        </tbody>
+                    </table>
+                </div>
+
+                {topTools.length > 0 && (
+                    <div className="tool-call-section">
+                        <div className="tool-call-section-title">
+                            Tool Results by Tool
+                        </div>
+                        <table className="token-breakdown-table">
+                            <tbody>
+                                {topTools.map(([toolName, tokens]) => (
+                                    <tr key={toolName}>
+                                        <td>{toolName}</td>
+                                        <td>{formatTokens(tokens)}</td>
+                                        <td>{formatShare(tokens, total)}</td>
+                                    </tr>
+                                ))}
+                                {otherToolTokens > 0 && (
+                                    <tr>
+                                        <td>Other tools</td>
+                                        <td>{formatTokens(otherToolTokens)}</td>
+                                        <td>
+                                            {formatShare(
+                                                otherToolTokens,
+                                                total
+                                            )}
+                                        </td>
+                                    </tr>
+                                )}
+                            </tbody>
+                        </table>
+                    </div>
+                )}
+
+                <div className="tool-call-section">
+                    <div className="tool-call-section-title">Per Request</div>
+                    <table className="token-breakdown-table">
+                        <thead>
+                            <tr>
+                                <th>#</th>
+                                <th>Sent</th>
+                                <th>Window</th>
+                                <th>Tool results</th>
+                                <th>Evicted</th>
+                            </tr>
+                        </thead>
+                        <tbody>
+                            {breakdown.iterations.map((usage) => (
+                                <tr key={usage.iteration}>
+                                    <td>{usage.iteration}</td>
+                                    <td>{formatTokens(usage.total)}</td>
+                                    <td>
+                                        {formatShare(
+                                            usage.total,
+                                            breakdown.maxInputTokens
+                                        )}
+                                    </td>
+                                    <td>
+                                        {formatTokens(
+                                            Object.values(
+                                                usage.toolResults
+                                            ).reduce((a, b) => a + b, 0)
+                                        )}
+                                    </td>
+                                    <td>
+                                        {usage.evicted > 0
+                                            ? formatTokens(usage.evicted)
+                                            : '–'}
+                                    </td>
+                                </tr>
+                            ))}
+                        </tbody>
+                    </table>
+                </div>
+
+                {breakdown.subagents.length > 0 && (
+                    <div className="tool-call-section">
+                        <div className="tool-call-section-title">Subagents</div>
+                        <table className="token-breakdown-table">
+                            <tbody>
+                                {breakdown.subagents.map((subagent) => (
+                                    <tr key={subagent.subagentId}>
+                                        <td title={subagent.task}>
+                                            #{subagent.subagentId}{' '}
+                                            {subagent.task}
+                                        </td>
+                                        <td>
+                                            {subagent.iterations} iterations
+                                        </td>
+                                        <td>{formatTokens(subagent.tokens)}</td>
+                                    </tr>
+                                ))}
+                            </tbody>
+                        </table>
+                    </div>
+                )}
+            </div>
+        </div>
+    );
+};
@@ -1,116 +1,145 @@
 import React, { useState } from 'react';
 import { JsonViewer } from './JsonViewer';
 import { CopyButton } from './CopyButton';
-import type { ToolCallsData, ToolCallRecord } from '../../types/toolCallTypes';
+import { TokenBreakdownSection } from './TokenBreakdownSection';
+import { useNestedToolCalls } from '../hooks/useNestedToolCalls';
+import { useToolCallDetails } from '../hooks/useAnalysisData';
+import { useVirtualList } from '../hooks/useVirtualList';
+import { loadToolCall } from '../utils/analysisDataClient';
+import { formatToolCallsAsMarkdown } from '../utils/toolCallsMarkdown';
+import { createWorkerClient } from '../utils/workerClient';
+import ToolCallsExportWorker from '../workers/toolCallsExport.worker?worker&inline';
+import type {
+    ToolCallsManifest,
+    ToolCallRecord,
+    ToolCallSummary,
+} from '../../types/toolCallTypes';
+
+/** Height of a collapsed row, used until the row has been measured */
+const TOOL_CALL_ROW_HEIGHT_PX = 42;
+
+/** String results longer than this show a preview until "Show all" is clicked */
+const RESULT_PREVIEW_CHARS = 5000;
+
+const formatInWorker = createWorkerClient(
+    'Tool calls export',
+    () => new ToolCallsExportWorker(),
+    formatToolCallsAsMarkdown
+);
 
 interface ToolCallsTabProps {
-    toolCalls: ToolCallsData | null;
+    toolCalls: ToolCallsManifest | null;
+    /** The analysis is still running and calls are being appended */
+    running?: boolean;
     onCopy?: (text: string) => void;
 }
 
 /**
- * Formats tool calls data as markdown for clipboard export
+ * Fetch every tool call record from the extension host and format the report
+ * in a worker
  */
-const formatToolCallsAsMarkdown = (toolCalls: ToolCallsData): string => {
-    const lines: string[] = [
-        '# Tool Calls Report',
-        '',
-        '## Summary',
-        '',
-        `- **Total Calls:** ${toolCalls.totalCalls}`,
-        `- **Successful:** ${toolCalls.successfulCalls}`,
-        `- **Failed:** ${toolCalls.failedCalls}`,
-        `- **Analysis Completed:** ${toolCalls.analysisCompleted ? 'Yes' : 'No'}`,
-    ];
+const exportToolCallsAsMarkdown = async (
+    toolCalls: ToolCallsManifest
+): Promise<string> => {
+    const calls = await Promise.all(
+        toolCalls.calls.map(
+            async (summary, index): Promise<ToolCallRecord> =>
+                (await loadToolCall(index)) ?? {
+                    ...summary,
+                    arguments: {},
+                    result: '',
+                }
+        )
+    );
+    return formatInWorker({ ...toolCalls, calls });
+};
 
-    if (toolCalls.analysisError) {
-        lines.push(`- **Error:** ${toolCalls.analysisError}`);
-    }
+const ChevronIcon = ({ expanded }: { expanded: boolean }) => (
+    <svg
+        className={`tool-call-chevron ${expanded ? 'tool-call-chevron--expanded' : ''}`}
+        viewBox="0 0 16 16"
+        fill="currentColor"
+    >
+        <path d="M5.7 13.7L5 13l4.6-4.6L5 3.7l.7-.7 5 5.3-5 5.4z" />
+    </svg>
+);
 
-    lines.push('', '## Tool Calls', '');
+const resultPreStyle: React.CSSProperties = {
+    margin: 0,
+    padding: '0.5rem',
+    fontSize: '0.75rem',
+    whiteSpace: 'pre-wrap',
+    wordBreak: 'break-word',
+    fontFamily: 'var(--vscode-editor-font-family, monospace)',
+    color: 'var(--vscode-editor-foreground)',
+    maxHeight: '200px',
+    overflow: 'auto',
+};
 
-    const formatCall = (
-        call: ToolCallRecord,
-        prefix: string,
-        isNested: boolean = false
-    ) => {
-        const status = call.success ? '✅' : '❌';
-        const duration =
-            call.durationMs !== undefined ? ` (${call.durationMs}ms)` : '';
-        const headingLevel = isNested ? '####' : '###';
+const ToolCallResult = ({ result }: { result: ToolCallRecord['result'] }) => {
+    const [showAll, setShowAll] = useState(false);
 
-        lines.push(
-            `${headingLevel} ${prefix} ${status} ${call.toolName}${duration}`
+    if (typeof result !== 'string') {
+        return (
+            <JsonViewer
+                data={result}
+                rootKey="result"
+                collapseDepth={2}
+                maxHeight="200px"
+            />
         );
-        lines.push('');
-
-        lines.push('**Arguments:**');
-        lines.push('```json');
-        lines.push(JSON.stringify(call.arguments, null, 2));
-        lines.push('```');
-        lines.push('');
-
-        if (call.error) {
-            lines.push('**Error:**');
-            lines.push(`> ${call.error}`);
-        } else {
-            lines.push('**Result:**');
-            if (typeof call.result === 'string') {
-                lines.push('```');
-                lines.push(call.result);
-                lines.push('```');
-            } else {
-                lines.push('```json');
-                lines.push(JSON.stringify(call.result, null, 2));
-                lines.push('```');
-            }
-        }
-        lines.push('');
-
-        // Format nested calls if present (for subagent)
-        if (call.nestedCalls && call.nestedCalls.length > 0) {
-            lines.push('**Subagent Tool Calls:**', '');
-            call.nestedCalls.forEach((nestedCall, nestedIndex) => {
-                formatCall(nestedCall, `${prefix}.${nestedIndex + 1}`, true);
-            });
-        }
-    };
-
-    toolCalls.calls.forEach((call, index) => {
-        formatCall(call, `${index + 1}`);
-    });
+    }
 
-    return lines.join('\n');
+    const truncated = !showAll && result.length > RESULT_PREVIEW_CHARS;
+    return (
+        <>
+            <pre style={resultPreStyle}>
+                {truncated ? result.slice(0, RESULT_PREVIEW_CHARS) : result}
+            </pre>
+            {truncated && (
+                <button
+                    type="button"
+                    className="tool-call-show-all"
+                    onClick={() => setShowAll(true)}
+                >
+                    Show all ({result.length.toLocaleString()} characters)
+                </button>
+            )}
+        </>
+    );
 };
 
 interface ToolCallItemProps {
-    call: ToolCallRecord;
+    call: ToolCallSummary;
+    /** Full record when already loaded (nested calls); otherwise fetched on expand */
+    record?: ToolCallRecord;
     index: number;
     prefix?: string;
     isNested?: boolean;
+    /** Controlled expansion, so it survives the row being virtualized away */
+    expanded?: boolean;
+    onToggle?: () => void;
 }
 
-const ChevronIcon = ({ expanded }: { expanded: boolean }) => (
-    <svg
-        className={`tool-call-chevron ${expanded ? 'tool-call-chevron--expanded' : ''}`}
-        viewBox="0 0 16 16"
-        fill="currentColor"
-    >
-        <path d="M5.7 13.7L5 13l4.6-4.6L5 3.7l.7-.7 5 5.3-5 5.4z" />
-    </svg>
-);
-
 const ToolCallItem = ({
     call,
+    record,
     index,
     prefix = '',
     isNested = false,
+    expanded: controlledExpanded,
+    onToggle,
 }: ToolCallItemProps) => {
-    const [expanded, setExpanded] = useState(false);
+    const [localExpanded, setLocalExpanded] = useState(false);
     const [nestedExpanded, setNestedExpanded] = useState(false);
+    const expanded = controlledExpanded ?? localExpanded;
 
     const handleToggle = () => {
-        setExpanded((prev) => !prev);
+        if (onToggle) {
+            onToggle();
+        } else {
+            setLocalExpanded((prev) => !prev);
+        }
     };
 
     const handleNestedToggle = () => {
@@ -128,7 +157,20 @@ const ToolCallItem = ({
     };
 
     const displayIndex = prefix ? `${prefix}.${index + 1}` : `${index + 1}`;
-    const hasNestedCalls = call.nestedCalls && call.nestedCalls.length > 0;
+    const details = useToolCallDetails(index, expanded && !record);
+    const fullCall = record ?? details.value;
+    // Nested calls are inline (chat/tests) or stored out-of-line and loaded on expand
+    const nested = useNestedToolCalls(
+        fullCall?.nestedCalls ? undefined : call.nestedCallsRef,
+        nestedExpanded
+    );
+    const nestedCalls = fullCall?.nestedCalls ?? nested.calls;
+    const nestedCount =
+        call.nestedCallCount ??
+        record?.nestedCalls?.length ??
+        call.nestedCallsRef?.count ??
+        0;
+    const hasNestedCalls = nestedCount > 0;
 
     return (
         <div
@@ -148,9 +190,14 @@ const ToolCallItem = ({
                 <span className="tool-call-name">
                     {displayIndex}. {call.toolName}
                 </span>
+                {record?.subagentLabel && (
+                    <span className="tool-call-subagent-badge">
+                        {record.subagentLabel}
+                    </span>
+                )}
                 {hasNestedCalls && (
                     <span className="tool-call-subagent-badge">
-                        {call.nestedCalls!.length} subagent calls
+                        {nestedCount} subagent calls
                     </span>
                 )}
                 {call.durationMs !== undefined && (
@@ -159,99 +206,148 @@ const ToolCallItem = ({
                     </span>
                 )}
             </div>
-            <div
-                className={`tool-call-body ${expanded ? 'tool-call-body--expanded' : ''}`}
-            >
-                <div className="tool-call-section">
-                    <div className="tool-call-section-title">Arguments</div>
-                    <div className="tool-call-json-wrapper">
-                        <JsonViewer
-                            data={call.arguments}
-                            rootKey="args"
-                            collapseDepth={3}
-                            maxHeight="200px"
-                        />
-                    </div>
-                </div>
-
-                {call.error ? (
-                    <div className="tool-call-section">
-                        <div className="tool-call-section-title">Error</div>
-                        <div className="tool-call-error-message">
-                            {call.error}
+            {/* Arguments and results are only rendered while expanded */}
+            {expanded && (
+                <div className="tool-call-body tool-call-body--expanded">
+                    {!fullCall && (
+                        <div className="tool-call-nested-status">
+                            Loading tool call...
                         </div>
-                    </div>
-                ) : (
-                    <div className="tool-call-section">
-                        <div className="tool-call-section-title">Result</div>
-                        <div className="tool-call-json-wrapper">
-                            {typeof call.result === 'string' ? (
-                                <pre
-                                    style={{
-                                        margin: 0,
-                                        padding: '0.5rem',
-                                        fontSize: '0.75rem',
-                                        whiteSpace: 'pre-wrap',
-                                        wordBreak: 'break-word',
-                                        fontFamily:
-                                            'var(--vscode-editor-font-family, monospace)',
-                                        color: 'var(--vscode-editor-foreground)',
-                                        maxHeight: '200px',
-                                        overflow: 'auto',
-                                    }}
-                                >
-                                    {call.result}
-                                </pre>
-                            ) : (
+                    )}
+
+                    {fullCall && (
+                        <div className="tool-call-section">
+                            <div className="tool-call-section-title">
+                                Arguments
+                            </div>
+                            <div className="tool-call-json-wrapper">
                                 <JsonViewer
-                                    data={call.result}
-                                    rootKey="result"
-                                    collapseDepth={2}
+                                    data={fullCall.arguments}
+                                    rootKey="args"
+                                    collapseDepth={3}
                                     maxHeight="200px"
                                 />
-                            )}
+                            </div>
                         </div>
-                    </div>
-                )}
+                    )}
 
-                {/* Nested tool calls from subagent */}
-                {hasNestedCalls && (
-                    <div className="tool-call-section tool-call-nested-section">
-                        <div
-                            className="tool-call-section-title tool-call-nested-header"
-                            onClick={handleNestedToggle}
-                            role="button"
-                            tabIndex={0}
-                            onKeyDown={(e) =>
-                                e.key === 'Enter' && handleNestedToggle()
-                            }
-                        >
-                            <ChevronIcon expanded={nestedExpanded} />
-                            Subagent Tool Calls ({call.nestedCalls!.length})
+                    {!fullCall ? null : call.error ? (
+                        <div className="tool-call-section">
+                            <div className="tool-call-section-title">Error</div>
+                            <div className="tool-call-error-message">
+                                {call.error}
+                            </div>
+                        </div>
+                    ) : (
+                        <div className="tool-call-section">
+                            <div className="tool-call-section-title">
+                                Result
+                            </div>
+                            <div className="tool-call-json-wrapper">
+                                <ToolCallResult result={fullCall.result} />
+                            </div>
                         </div>
-                        <div
-                            className={`tool-call-nested-list ${nestedExpanded ? 'tool-call-nested-list--expanded' : ''}`}
-                        >
-                            {call.nestedCalls!.map(
-                                (nestedCall, nestedIndex) => (
-                                    <ToolCallItem
-                                        key={nestedCall.id}
-                                        call={nestedCall}
-                                        index={nestedIndex}
-                                        prefix={displayIndex}
-                                        isNested={true}
-                                    />
-                                )
+                    )}
+
+                    {/* Nested tool calls from subagent */}
+                    {hasNestedCalls && (
+                        <div className="tool-call-section tool-call-nested-section">
+                            <div
+                                className="tool-call-section-title tool-call-nested-header"
+                                onClick={handleNestedToggle}
+                                role="button"
+                                tabIndex={0}
+                                onKeyDown={(e) =>
+                                    e.key === 'Enter' && handleNestedToggle()
+                                }
+                            >
+                                <ChevronIcon expanded={nestedExpanded} />
+                                Subagent Tool Calls ({nestedCount})
+                            </div>
+                            {nestedExpanded && (
+                                <div className="tool-call-nested-list tool-call-nested-list--expanded">
+                                    {nested.loading && (
+                                        <div className="tool-call-nested-status">
+                                            Loading subagent tool calls...
+                                        </div>
+                                    )}
+                                    {nested.error && (
+                                        <div className="tool-call-error-message">
+                                            {nested.error}
+                                        </div>
+                                    )}
+                                    {nestedCalls?.map(
+                                        (nestedCall, nestedIndex) => (
+                                            <ToolCallItem
+                                                key={nestedCall.id}
+                                                call={nestedCall}
+                                                record={nestedCall}
+                                                index={nestedIndex}
+                                                prefix={displayIndex}
+                                                isNested={true}
+                                            />
+                                        )
+                                    )}
+                                </div>
                             )}
                         </div>
+                    )}
+                </div>
+            )}
+        </div>
+    );
+};
+
+/**
+ * Top-level calls, virtualized: only rows near the visible area are mounted.
+ * Expansion is kept here so rows scrolled away and back stay expanded.
+ */
+const ToolCallList = ({ calls }: { calls: ToolCallSummary[] }) => {
+    const [expandedRows, setExpandedRows] = useState<ReadonlySet<number>>(
+        () => new Set()
+    );
+    const { setScrollElement, range, measureItem } = useVirtualList(
+        calls.length,
+        TOOL_CALL_ROW_HEIGHT_PX
+    );
+
+    const toggleRow = (index: number) => {
+        setExpandedRows((prev) => {
+            const next = new Set(prev);
+            if (!next.delete(index)) {
+                next.add(index);
+            }
+            return next;
+        });
+    };
+
+    return (
+        <div className="tool-calls-list" ref={setScrollElement}>
+            <div style={{ height: range.offsetBefore }} />
+            {calls.slice(range.start, range.end).map((call, offset) => {
+                const index = range.start + offset;
+                return (
+                    <div
+                        key={call.id}
+                        className="tool-call-row"
+                        data-index={index}
+                        ref={measureItem}
+                    >
+                        <ToolCallItem
+                            call={call}
+                            index={index}
+                            expanded={expandedRows.has(index)}
+                            onToggle={() => toggleRow(index)}
+                        />
                     </div>
-                )}
-            </div>
+                );
+            })}
+            <div style={{ height: range.offsetAfter }} />
         </div>
     );
 };
 
-const EmptyState = () => (
+const EmptyState = ({ running }: { running: boolean }) => (
     <div className="tool-calls-empty">
         <svg
             className="tool-calls-empty-icon"
@@ -262,16 +358,24 @@ const EmptyState = () => (
         >
             <path d="M9.75 17L9 20l-1 1h8l-1-1-.75-3M3 13h18M5 17h14a2 2 0 002-2V5a2 2 0 00-2-2H5a2 2 0 00-2 2v10a2 2 0 002 2z" />
         </svg>
-        <div className="tool-calls-empty-title">No Tool Calls</div>
+        <div className="tool-calls-empty-title">
+            {running ? 'No Tool Calls Yet' : 'No Tool Calls'}
+        </div>
         <div className="tool-calls-empty-description">
-            The analysis was performed without using any tools.
+            {running
+                ? 'Tool calls appear here as the analysis makes them.'
+                : 'The analysis was performed without using any tools.'}
         </div>
     </div>
 );
 
-export const ToolCallsTab = ({ toolCalls, onCopy }: ToolCallsTabProps) => {
+export const ToolCallsTab = ({
+    toolCalls,
+    running = false,
+    onCopy,
+}: ToolCallsTabProps) => {
     if (!toolCalls || toolCalls.calls.length === 0) {
-        return <EmptyState />;
+        return <EmptyState running={running} />;
     }
 
     const {
@@ -281,10 +385,9 @@ export const ToolCallsTab = ({ toolCalls, onCopy }: ToolCallsTabProps) => {
         failedCalls,
         analysisCompleted,
         analysisError,
+        tokenBreakdown,
     } = toolCalls;
 
-    const markdownText = formatToolCallsAsMarkdown(toolCalls);
-
     return (
         <div className="tool-calls-container">
             <div className="tool-calls-summary">
@@ -308,15 +411,26 @@ export const ToolCallsTab = ({ toolCalls, onCopy }: ToolCallsTabProps) => {
                         </span>
                     </div>
                 )}
-                {!analysisCompleted && (
-                    <div className="tool-calls-stat tool-calls-stat--error">
+                {running ? (
+                    <div className="tool-calls-stat">
                         <span className="tool-calls-stat-label">
-                            Analysis incomplete
+                            Analysis running
                         </span>
                     </div>
+                ) : (
+                    !analysisCompleted && (
+                        <div className="tool-calls-stat tool-calls-stat--error">
+                            <span className="tool-calls-stat-label">
+                                Analysis incomplete
+                            </span>
+                        </div>
+                    )
                 )}
                 <div className="tool-calls-copy-button">
-                    <CopyButton text={markdownText} onCopy={onCopy} />
+                    <CopyButton
+                        getText={() => exportToolCallsAsMarkdown(toolCalls)}
+                        onCopy={onCopy}
+                    />
                 </div>
             </div>
 
@@ -328,11 +442,11 @@ export const ToolCallsTab = ({ toolCalls, onCopy }: ToolCallsTabProps) => {
                 </div>
             )}
 
-            <div className="tool-calls-list">
-                {calls.map((call, index) => (
-                    <ToolCallItem key={call.id} call={call} index={index} />
-                ))}
-            </div>
+            {tokenBreakdown && (
+                <TokenBreakdownSection breakdown={tokenBreakdown} />
+            )}
+
+            <ToolCallList calls={calls} />
         </div>
     );
 };
@@ -0,0 +1,55 @@
+import { useEffect, useState } from 'react';
+import type { FileData } from 'react-diff-view';
+import type { ToolCallRecord } from '../../types/toolCallTypes';
+import { loadDiffFile, loadToolCall } from '../utils/analysisDataClient';
+
+interface LoadState<T> {
+    value: T | undefined;
+    loading: boolean;
+}
+
+/**
+ * Value of `load(index)` once `enabled` becomes true. Loaders cache by index,
+ * so remounting a component does not request the data again.
+ */
+const useIndexedData = <T,>(
+    load: (index: number) => Promise<T | undefined>,
+    index: number,
+    enabled: boolean
+): LoadState<T> => {
+    const [state, setState] = useState<LoadState<T>>({
+        value: undefined,
+        loading: false,
+    });
+
+    useEffect(() => {
+        if (!enabled) {
+            return;
+        }
+
+        let active = true;
+        setState((prev) => ({ ...prev, loading: prev.value === undefined }));
+        load(index).then((value) => {
+            if (active) {
+                setState({ value, loading: false });
+            }
+        });
+        return () => {
+            active = false;
+        };
+    }, [load, index, enabled]);
+
+    return state;
+};
+
+/** One file of the analyzed diff, requested from the extension host */
+export const useDiffFile = (
+    index: number,
+    enabled: boolean
+): LoadState<FileData> => useIndexedData(loadDiffFile, index, enabled);
+
+/** Arguments and result of a tool call, requested when first expanded */
+export const useToolCallDetails = (
+    index: number,
+    enabled: boolean
+): LoadState<ToolCallRecord> => useIndexedData(loadToolCall, index, enabled);
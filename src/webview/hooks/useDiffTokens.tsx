@@ -0,0 +1,51 @@
+import { useEffect, useState } from 'react';
+import type { HunkData } from 'react-diff-view';
+import DiffTokenizerWorker from '../workers/diffTokenizer.worker?worker&inline';
+import { tokenizeHunks, type DiffTokens } from '../utils/diffTokens';
+import { createWorkerClient } from '../utils/workerClient';
+
+/** Tokens by hunks array, so files scrolled out and back in aren't redone */
+const tokenCache = new WeakMap<HunkData[], DiffTokens | null>();
+
+const requestTokens = createWorkerClient(
+    'Diff tokenizer',
+    () => new DiffTokenizerWorker(),
+    tokenizeHunks
+);
+
+/**
+ * Word-level diff tokens for one file, computed in a Web Worker when the
+ * component mounts (DiffTab mounts files as they near the viewport). Until
+ * they arrive the diff renders without word highlighting.
+ */
+export const useDiffTokens = (hunks: HunkData[]): DiffTokens | null => {
+    const [tokens, setTokens] = useState<DiffTokens | null>(
+        () => tokenCache.get(hunks) ?? null
+    );
+
+    useEffect(() => {
+        if (tokenCache.has(hunks)) {
+            setTokens(tokenCache.get(hunks) ?? null);
+            return;
+        }
+
+        let active = true;
+        requestTokens(hunks)
+            .catch((error) => {
+                // Word highlighting is optional; render the plain diff
+                console.warn(error);
+                return null;
+            })
+            .then((result) => {
+                tokenCache.set(hunks, result);
+                if (active) {
+                    setTokens(result);
+                }
+            });
+        return () => {
+            active = false;
+        };
+    }, [hunks]);
+
+    return tokens;
+};
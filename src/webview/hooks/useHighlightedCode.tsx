@@ -0,0 +1,58 @@
+import { useEffect, useState } from 'react';
+import type { ElementContent } from 'hast';
+import CodeHighlighterWorker from '../workers/codeHighlighter.worker?worker&inline';
+import { highlightCode, type MarkdownCodeBlock } from '../utils/markdownTree';
+import { createWorkerClient } from '../utils/workerClient';
+
+/**
+ * Highlighted spans by code block. Blocks belong to cached rendered
+ * documents, so blocks scrolled out and back in aren't redone.
+ */
+const highlightCache = new WeakMap<MarkdownCodeBlock, ElementContent[]>();
+
+const requestHighlight = createWorkerClient(
+    'Code highlighter',
+    () => new CodeHighlighterWorker(),
+    highlightCode
+);
+
+/**
+ * Highlighted spans for a code block, computed in a Web Worker once
+ * `enabled` (the block is near the viewport). Null until they arrive, or if
+ * highlighting failed; the block then renders as plain text.
+ */
+export const useHighlightedCode = (
+    block: MarkdownCodeBlock,
+    enabled: boolean
+): ElementContent[] | null => {
+    const [highlighted, setHighlighted] = useState<ElementContent[] | null>(
+        () => highlightCache.get(block) ?? null
+    );
+
+    useEffect(() => {
+        const cached = highlightCache.get(block);
+        if (cached) {
+            setHighlighted(cached);
+            return;
+        }
+        if (!enabled) {
+            return;
+        }
+
+        let active = true;
+        requestHighlight(block).then(
+            (result) => {
+                highlightCache.set(block, result);
+                if (active) {
+                    setHighlighted(result);
+                }
+            },
+            (error) => console.warn(error)
+        );
+        return () => {
+            active = false;
+        };
+    }, [block, enabled]);
+
+    return highlighted;
+};
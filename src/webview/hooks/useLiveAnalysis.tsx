@@ -0,0 +1,42 @@
+import { useEffect, useState } from 'react';
+import type {
+    AnalysisManifest,
+    AnalysisUpdatePayload,
+} from '../../types/webviewMessages';
+import {
+    applyAnalysisUpdate,
+    type LiveAnalysisState,
+} from '../utils/liveAnalysis';
+
+/**
+ * Analysis panel data, kept up to date by the extension host's
+ * analysisUpdate messages while the analysis is running.
+ */
+export const useLiveAnalysis = (
+    initial: AnalysisManifest
+): LiveAnalysisState => {
+    const [state, setState] = useState<LiveAnalysisState>({
+        manifest: initial,
+        statusMessage: undefined,
+    });
+
+    useEffect(() => {
+        if (!initial.running) {
+            return;
+        }
+
+        const handleMessage = (event: MessageEvent) => {
+            const message = event.data;
+            if (message?.command !== 'analysisUpdate') {
+                return;
+            }
+            const update: AnalysisUpdatePayload = message.payload;
+            setState((prev) => applyAnalysisUpdate(prev, update));
+        };
+
+        window.addEventListener('message', handleMessage);
+        return () => window.removeEventListener('message', handleMessage);
+    }, [initial.running]);
+
+    return state;
+};
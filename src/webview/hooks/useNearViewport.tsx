@@ -0,0 +1,58 @@
+import { useEffect, useRef, useState } from 'react';
+
+interface NearViewportState {
+    near: boolean;
+    /** Height of the element when it last left the observed area */
+    lastHeight: number | undefined;
+}
+
+/**
+ * Track whether an element is within `rootMargin` of its scroll container,
+ * so long lists can render only what is (nearly) visible. Reports the
+ * element's height when it leaves, so a placeholder can keep the scroll
+ * position stable.
+ *
+ * @param root Scroll container; null observes against the viewport
+ */
+export const useNearViewport = <T extends Element>(
+    root: Element | null,
+    rootMargin: string
+) => {
+    const ref = useRef<T>(null);
+    const [state, setState] = useState<NearViewportState>({
+        near: false,
+        lastHeight: undefined,
+    });
+
+    useEffect(() => {
+        const element = ref.current;
+        if (!element) {
+            return;
+        }
+        if (typeof IntersectionObserver === 'undefined') {
+            setState({ near: true, lastHeight: undefined });
+            return;
+        }
+
+        const observer = new IntersectionObserver(
+            ([entry]) => {
+                if (!entry) {
+                    return;
+                }
+                setState((prev) =>
+                    entry.isIntersecting
+                        ? { ...prev, near: true }
+                        : {
+                              near: false,
+                              lastHeight: entry.boundingClientRect.height,
+                          }
+                );
+            },
+            { root, rootMargin }
+        );
+        observer.observe(element);
+        return () => observer.disconnect();
+    }, [root, rootMargin]);
+
+    return [ref, state] as const;
+};
@@ -0,0 +1,75 @@
+import { useEffect, useRef, useState } from 'react';
+import { useVSCodeApi } from './useVSCodeApi';
+import type {
+    ToolCallRecord,
+    NestedToolCallsRef,
+} from '../../types/toolCallTypes';
+import type {
+    GetNestedToolCallsPayload,
+    NestedToolCallsResultPayload,
+} from '../../types/webviewMessages';
+
+interface NestedToolCallsState {
+    calls: ToolCallRecord[] | undefined;
+    loading: boolean;
+    error: string | undefined;
+}
+
+/**
+ * Fetch subagent tool calls stored out-of-line by the extension host.
+ * Nothing is requested until `enabled` is true (i.e., the user expanded the list),
+ * and the result is kept for the lifetime of the component.
+ */
+export const useNestedToolCalls = (
+    ref: NestedToolCallsRef | undefined,
+    enabled: boolean
+): NestedToolCallsState => {
+    const vscode = useVSCodeApi();
+    const [state, setState] = useState<NestedToolCallsState>({
+        calls: undefined,
+        loading: false,
+        error: undefined,
+    });
+    const settledRef = useRef(false);
+    const key = ref?.key;
+
+    useEffect(() => {
+        if (!enabled || !key || !vscode || settledRef.current) {
+            return;
+        }
+
+        const handleMessage = (event: MessageEvent) => {
+            const message = event.data;
+            if (message.command !== 'nestedToolCallsResult') {
+                return;
+            }
+            const payload: NestedToolCallsResultPayload = message.payload;
+            if (payload.key !== key) {
+                return;
+            }
+            settledRef.current = true;
+            window.removeEventListener('message', handleMessage);
+            setState({
+                calls: payload.calls,
+                loading: false,
+                error: payload.calls ? undefined : payload.error,
+            });
+        };
+
+        window.addEventListener('message', handleMessage);
+        setState((prev) => ({ ...prev, loading: true }));
+
+        const payload: GetNestedToolCallsPayload = { key };
+        vscode.postMessage({ command: 'getNestedToolCalls', payload });
+
+        return () => {
+            window.removeEventListener('message', handleMessage);
+            // Collapsed before the response arrived: allow a fresh request on re-expand
+            if (!settledRef.current) {
+                setState((prev) => ({ ...prev, loading: false }));
+            }
+        };
+    }, [enabled, key, vscode]);
+
+    return state;
+};
@@ -0,0 +1,100 @@
+import { useEffect, useState } from 'react';
+import MarkdownRendererWorker from '../workers/markdownRenderer.worker?worker&inline';
+import {
+    hashContent,
+    renderMarkdown,
+    type RenderedMarkdown,
+} from '../utils/markdownTree';
+import { createWorkerClient } from '../utils/workerClient';
+
+/** Rendered documents kept for switching tabs and panels back and forth */
+const MAX_CACHED_DOCUMENTS = 20;
+
+/** Rendered documents by content hash, least recently used first */
+const renderedCache = new Map<string, RenderedMarkdown>();
+
+const getCached = (key: string): RenderedMarkdown | undefined => {
+    const rendered = renderedCache.get(key);
+    if (rendered) {
+        // Refresh LRU position
+        renderedCache.delete(key);
+        renderedCache.set(key, rendered);
+    }
+    return rendered;
+};
+
+const setCached = (key: string, rendered: RenderedMarkdown): void => {
+    renderedCache.delete(key);
+    renderedCache.set(key, rendered);
+    if (renderedCache.size > MAX_CACHED_DOCUMENTS) {
+        const oldest = renderedCache.keys().next().value;
+        if (oldest !== undefined) {
+            renderedCache.delete(oldest);
+        }
+    }
+};
+
+const requestRender = createWorkerClient(
+    'Markdown renderer',
+    () => new MarkdownRendererWorker(),
+    renderMarkdown
+);
+
+/** Content shown as preformatted text when rendering it failed */
+const renderPlainText = (content: string): RenderedMarkdown => ({
+    tree: {
+        type: 'root',
+        children: [
+            {
+                type: 'element',
+                tagName: 'div',
+                properties: { className: ['whitespace-pre-wrap'] },
+                children: [{ type: 'text', value: content }],
+            },
+        ],
+    },
+    codeBlocks: [],
+});
+
+/**
+ * Markdown parsed in a Web Worker. Returns null until the first document is
+ * ready; when `content` changes the previous document is kept on screen
+ * until the new one arrives, so live updates don't flicker.
+ */
+export const useRenderedMarkdown = (
+    content: string
+): RenderedMarkdown | null => {
+    const [rendered, setRendered] = useState<RenderedMarkdown | null>(
+        () => getCached(hashContent(content)) ?? null
+    );
+
+    useEffect(() => {
+        const key = hashContent(content);
+        const cached = getCached(key);
+        if (cached) {
+            setRendered(cached);
+            return;
+        }
+
+        let active = true;
+        requestRender(content).then(
+            (result) => {
+                setCached(key, result);
+                if (active) {
+                    setRendered(result);
+                }
+            },
+            (error) => {
+                console.warn(error);
+                if (active) {
+                    setRendered(renderPlainText(content));
+                }
+            }
+        );
+        return () => {
+            active = false;
+        };
+    }, [content]);
+
+    return rendered;
+};
@@ -0,0 +1,117 @@
+import { useEffect, useState } from 'react';
+import {
+    VIRTUAL_OVERSCAN_PX,
+    computeVirtualRange,
+    type VirtualRange,
+} from '../utils/virtualList';
+
+const readHeight = (entry: ResizeObserverEntry) =>
+    entry.borderBoxSize?.[0]?.blockSize ??
+    entry.target.getBoundingClientRect().height;
+
+/**
+ * Render only the items of a long list that are near the visible area.
+ * Items start at `estimatedHeight` (fixed, or per item) and are measured
+ * once rendered, so they may grow (e.g. when expanded).
+ *
+ * Attach `setScrollElement` to the scrolling container and `measureItem` to
+ * each rendered item, which must carry its index in `data-index`. Render
+ * spacers of `offsetBefore` / `offsetAfter` around the items.
+ */
+export const useVirtualList = (
+    count: number,
+    estimatedHeight: number | ((index: number) => number),
+    overscanPx: number = VIRTUAL_OVERSCAN_PX
+) => {
+    const [scrollElement, setScrollElement] = useState<HTMLElement | null>(
+        null
+    );
+    const [viewport, setViewport] = useState({ scrollTop: 0, height: 0 });
+    const [measured, setMeasured] = useState<ReadonlyMap<number, number>>(
+        () => new Map()
+    );
+    const [itemObserver] = useState(() =>
+        typeof ResizeObserver === 'undefined'
+            ? null
+            : new ResizeObserver((entries) => {
+                  setMeasured((prev) => {
+                      let next: Map<number, number> | undefined;
+                      for (const entry of entries) {
+                          const index = Number(
+                              (entry.target as HTMLElement).dataset.index
+                          );
+                          const height = readHeight(entry);
+                          if (prev.get(index) !== height) {
+                              next ??= new Map(prev);
+                              next.set(index, height);
+                          }
+                      }
+                      return next ?? prev;
+                  });
+              })
+    );
+
+    useEffect(() => () => itemObserver?.disconnect(), [itemObserver]);
+
+    useEffect(() => {
+        if (!scrollElement) {
+            return;
+        }
+
+        const update = () =>
+            setViewport({
+                scrollTop: scrollElement.scrollTop,
+                height: scrollElement.clientHeight,
+            });
+        // At most one update per frame while scrolling
+        let frame = 0;
+        const handleScroll = () => {
+            if (!frame) {
+                frame = requestAnimationFrame(() => {
+                    frame = 0;
+                    update();
+                });
+            }
+        };
+
+        update();
+        scrollElement.addEventListener('scroll', handleScroll, {
+            passive: true,
+        });
+        const resizeObserver =
+            typeof ResizeObserver === 'undefined'
+                ? null
+                : new ResizeObserver(update);
+        resizeObserver?.observe(scrollElement);
+        return () => {
+            cancelAnimationFrame(frame);
+            scrollElement.removeEventListener('scroll', handleScroll);
+            resizeObserver?.disconnect();
+        };
+    }, [scrollElement]);
+
+    const estimate =
+        typeof estimatedHeight === 'number'
+            ? () => estimatedHeight
+            : estimatedHeight;
+    const heights = Array.from(
+        { length: count },
+        (_, index) => measured.get(index) ?? estimate(index)
+    );
+    const range: VirtualRange = computeVirtualRange(
+        heights,
+        viewport.scrollTop,
+        viewport.height,
+        overscanPx
+    );
+
+    const measureItem = (element: HTMLElement | null) => {
+        if (!element || !itemObserver) {
+            return;
+        }
+        itemObserver.observe(element);
+        return () => itemObserver.unobserve(element);
+    };
+
+    return { setScrollElement, range, measureItem };
+};
@@ -1,19 +1,15 @@
 import React from 'react';
 import { createRoot } from 'react-dom/client';
 import AnalysisView from './AnalysisView';
-import type { ToolCallsData } from '../types/toolCallTypes';
+import { useLiveAnalysis } from './hooks/useLiveAnalysis';
+import type { AnalysisManifest } from '../types/webviewMessages';
 import './types/webviewGlobals'; // Import for side-effect (global declarations)
 import './globals.css';
 import { onDomReady } from './utils/domReady';
 
 declare global {
     interface Window {
-        analysisData: {
-            title: string;
-            diffText: string;
-            analysis: string;
-            toolCalls: ToolCallsData | null;
-        };
+        analysisData: AnalysisManifest;
     }
 }
 
@@ -23,57 +19,69 @@ const AnalysisApp: React.FC = () => {
     const analysisData = window.analysisData;
 
     if (!analysisData || typeof analysisData !== 'object') {
-        return (
-            <div
-                style={{
-                    display: 'flex',
-                    flexDirection: 'column',
-                    justifyContent: 'center',
-                    alignItems: 'center',
-                    height: '100vh',
-                    fontFamily:
-                        "-apple-system, BlinkMacSystemFont, 'Segoe UI', Roboto, sans-serif",
-                    color: 'var(--vscode-foreground)',
-                    backgroundColor: 'var(--vscode-editor-background)',
-                    textAlign: 'center',
-                    padding: '20px',
-                }}
-            >
-                <div style={{ fontSize: '48px', marginBottom: '20px' }}>⚠️</div>
-                <h2 style={{ marginBottom: '10px' }}>
-                    Analysis Data Not Found
-                </h2>
-                <p
-                    style={{
-                        color: 'var(--vscode-descriptionForeground)',
-                        marginBottom: '20px',
-                    }}
-                >
-                    The analysis data was not properly initialized.
-                </p>
-                <p
-                    style={{
-                        fontSize: '14px',
-                        color: 'var(--vscode-descriptionForeground)',
-                    }}
-                >
-                    Please check the VS Code developer console for more
-                    information.
-                </p>
-            </div>
-        );
+        return <MissingDataNotice />;
     }
 
+    return <LiveAnalysisView initial={analysisData} />;
+};
+
+/** Applies live updates while the analysis is running */
+const LiveAnalysisView = ({ initial }: { initial: AnalysisManifest }) => {
+    const { manifest, statusMessage } = useLiveAnalysis(initial);
+
     return (
         <AnalysisView
-            title={analysisData.title}
-            diffText={analysisData.diffText}
-            analysis={analysisData.analysis}
-            toolCalls={analysisData.toolCalls}
+            title={manifest.title}
+            diffFiles={manifest.diffFiles}
+            analysis={manifest.analysis}
+            toolCalls={manifest.toolCalls}
+            running={manifest.running}
+            plan={manifest.plan}
+            statusMessage={statusMessage}
         />
     );
 };
 
+const MissingDataNotice = () => (
+    <div
+        style={{
+            display: 'flex',
+            flexDirection: 'column',
+            justifyContent: 'center',
+            alignItems: 'center',
+            height: '100vh',
+            fontFamily:
+                "-apple-system, BlinkMacSystemFont, 'Segoe UI', Roboto, sans-serif",
+            color: 'var(--vscode-foreground)',
+            backgroundColor: 'var(--vscode-editor-background)',
+            textAlign: 'center',
+            padding: '20px',
+        }}
+    >
+        <div style={{ fontSize: '48px', marginBottom: '20px' }}>⚠️</div>
+        <h2 style={{ marginBottom: '10px' }}>
+            Analysis Data Not Found
+        </h2>
+        <p
+            style={{
+                color: 'var(--vscode-descriptionForeground)',
+                marginBottom: '20px',
+            }}
+        >
+            The analysis data was not properly initialized.
+        </p>
+        <p
+            style={{
+                fontSize: '14px',
+                color: 'var(--vscode-descriptionForeground)',
+            }}
+        >
+            Please check the VS Code developer console for more
+            information.
+        </p>
+    </div>
+);
+
 // Initialize the React application
 // Note: Module scripts execute after DOMContentLoaded, so we use onDomReady
 // to handle both cases (still loading vs already ready)
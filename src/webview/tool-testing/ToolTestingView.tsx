@@ -2,6 +2,8 @@ import React, { useState, useEffect } from 'react';
 import { ToolLibrarySidebar } from './components/ToolLibrarySidebar';
 import { ParameterInputPanel } from './components/ParameterInputPanel';
 import { ResultsPanel } from './components/ResultsPanel';
+import { ToolMetricsPanel } from './components/ToolMetricsPanel';
+import { BenchmarkPanel } from './components/BenchmarkPanel';
 import { useVSCodeApi } from '../hooks/useVSCodeApi';
 import { useTheme } from '../hooks/useTheme';
 import { useToolExecution } from '../hooks/useToolExecution';
@@ -29,6 +31,12 @@ const ToolTestingView: React.FC<ToolTestingViewProps> = ({
         initialTool
     );
     const [searchQuery, setSearchQuery] = useState('');
+    const [showMetrics, setShowMetrics] = useState(false);
+    /** Parameters to benchmark with; set while benchmark mode is open */
+    const [benchmarkParameters, setBenchmarkParameters] = useState<Record<
+        string,
+        any
+    > | null>(null);
     const [activeTab, setActiveTab] = useState<'parameters' | 'results'>(
         'parameters'
     );
@@ -78,6 +86,8 @@ const ToolTestingView: React.FC<ToolTestingViewProps> = ({
     // Event handlers
     const handleToolSelect = (toolName: string) => {
         setSelectedTool(toolName);
+        setShowMetrics(false);
+        setBenchmarkParameters(null);
         clearSession(); // Clear previous results when selecting new tool
     };
 
@@ -113,12 +123,25 @@ const ToolTestingView: React.FC<ToolTestingViewProps> = ({
                     searchQuery={searchQuery}
                     onToolSelect={handleToolSelect}
                     onSearchChange={setSearchQuery}
+                    showingMetrics={showMetrics}
+                    onShowMetrics={() => {
+                        setShowMetrics(true);
+                        setBenchmarkParameters(null);
+                    }}
                 />
             </div>
 
             {/* Main Workspace Area */}
             <div className="flex-1 flex overflow-hidden flex-col">
-                {layout.shouldStack ? (
+                {showMetrics ? (
+                    <ToolMetricsPanel />
+                ) : selectedTool && benchmarkParameters ? (
+                    <BenchmarkPanel
+                        toolName={selectedTool}
+                        parameters={benchmarkParameters}
+                        onClose={() => setBenchmarkParameters(null)}
+                    />
+                ) : layout.shouldStack ? (
                     /* Stacked Layout for Narrow Screens */
                     <Tabs
                         value={activeTab}
@@ -152,6 +175,7 @@ const ToolTestingView: React.FC<ToolTestingViewProps> = ({
                                     toolInfo={currentToolInfo}
                                     initialParameters={initialParameters}
                                     onExecute={handleExecute}
+                                    onBenchmark={setBenchmarkParameters}
                                     isExecuting={isExecuting}
                                     validationErrors={validationErrors}
                                     onCancel={cancelExecution}
@@ -176,6 +200,7 @@ const ToolTestingView: React.FC<ToolTestingViewProps> = ({
                                 toolInfo={currentToolInfo}
                                 initialParameters={initialParameters}
                                 onExecute={handleExecute}
+                                onBenchmark={setBenchmarkParameters}
                                 isExecuting={isExecuting}
                                 validationErrors={validationErrors}
                                 onCancel={cancelExecution}
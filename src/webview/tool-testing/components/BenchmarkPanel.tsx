@@ -0,0 +1,254 @@
+import React, { useEffect, useState } from 'react';
+import { useVSCodeApi } from '../../hooks/useVSCodeApi';
+import { Button } from '../../../components/ui/button';
+import { Input } from '../../../components/ui/input';
+import { Label } from '../../../components/ui/label';
+import { ScrollArea } from '../../../components/ui/scroll-area';
+import type {
+    BenchmarkCacheMode,
+    ToolBenchmarkReport,
+} from '../../../services/toolBenchmark';
+
+interface BenchmarkPanelProps {
+    toolName: string;
+    parameters: Record<string, unknown>;
+    onClose: () => void;
+}
+
+const formatMs = (ms: number) =>
+    ms < 1000 ? `${ms.toFixed(1)}ms` : `${(ms / 1000).toFixed(2)}s`;
+
+const formatChars = (chars: number) =>
+    chars < 1000 ? String(chars) : `${(chars / 1000).toFixed(1)}k`;
+
+/**
+ * Runs the selected tool N times with the parameters from the form and shows
+ * latency and response size percentiles. The report can be saved as JSON.
+ */
+export const BenchmarkPanel: React.FC<BenchmarkPanelProps> = ({
+    toolName,
+    parameters,
+    onClose,
+}) => {
+    const vscode = useVSCodeApi();
+    const [runs, setRuns] = useState(20);
+    const [concurrency, setConcurrency] = useState(1);
+    const [cacheMode, setCacheMode] = useState<BenchmarkCacheMode>('warm');
+    const [progress, setProgress] = useState<{
+        completed: number;
+        total: number;
+    } | null>(null);
+    const [report, setReport] = useState<ToolBenchmarkReport | null>(null);
+    const [error, setError] = useState<string | null>(null);
+    const isRunning = progress !== null;
+
+    useEffect(() => {
+        const handleMessage = (event: MessageEvent) => {
+            const message = event.data;
+            switch (message.type) {
+                case 'benchmarkProgress':
+                    setProgress(message.payload);
+                    break;
+                case 'benchmarkResult':
+                    setReport(message.payload);
+                    setProgress(null);
+                    break;
+                case 'error':
+                    setError(message.payload.message);
+                    setProgress(null);
+                    break;
+            }
+        };
+
+        window.addEventListener('message', handleMessage);
+        return () => window.removeEventListener('message', handleMessage);
+    }, []);
+
+    const start = () => {
+        setReport(null);
+        setError(null);
+        setProgress({ completed: 0, total: runs });
+        vscode?.postMessage({
+            command: 'runBenchmark',
+            payload: { toolName, parameters, runs, concurrency, cacheMode },
+        });
+    };
+    const cancel = () =>
+        vscode?.postMessage({ command: 'cancelBenchmark', payload: {} });
+    // Leaving the panel stops a run in progress; its results would be lost
+    const close = () => {
+        if (isRunning) {
+            cancel();
+        }
+        onClose();
+    };
+    const exportReport = () =>
+        vscode?.postMessage({ command: 'exportBenchmark', payload: {} });
+
+    const stats: [string, string][] = report
+        ? [
+              ['Min', formatMs(report.latencyMs.min)],
+              ['Median', formatMs(report.latencyMs.p50)],
+              ['p95', formatMs(report.latencyMs.p95)],
+              ['Max', formatMs(report.latencyMs.max)],
+              [
+                  'Size p50/p95/max',
+                  `${formatChars(report.responseChars.p50)}/${formatChars(report.responseChars.p95)}/${formatChars(report.responseChars.max)}`,
+              ],
+              [
+                  'Errors',
+                  `${report.errors} (${(report.errorRate * 100).toFixed(1)}%)`,
+              ],
+              ['Wall time', formatMs(report.totalMs)],
+          ]
+        : [];
+
+    return (
+        <div className="flex flex-col h-full">
+            <div className="px-4 py-3 border-b border-border flex items-center justify-between shrink-0">
+                <div>
+                    <h2 className="font-semibold">Benchmark {toolName}</h2>
+                    <p className="text-xs text-muted-foreground font-mono truncate max-w-md">
+                        {JSON.stringify(parameters)}
+                    </p>
+                </div>
+                <Button variant="ghost" size="sm" onClick={close}>
+                    Back
+                </Button>
+            </div>
+
+            <div className="px-4 py-3 border-b border-border flex flex-wrap items-end gap-4 shrink-0">
+                <div className="flex flex-col gap-1.5">
+                    <Label htmlFor="benchmark-runs">Runs</Label>
+                    <Input
+                        id="benchmark-runs"
+                        type="number"
+                        min={1}
+                        className="w-24"
+                        value={runs}
+                        disabled={isRunning}
+                        onChange={(e) => setRuns(Number(e.target.value))}
+                    />
+                </div>
+                <div className="flex flex-col gap-1.5">
+                    <Label htmlFor="benchmark-concurrency">Concurrency</Label>
+                    <Input
+                        id="benchmark-concurrency"
+                        type="number"
+                        min={1}
+                        className="w-24"
+                        value={concurrency}
+                        disabled={isRunning}
+                        onChange={(e) => setConcurrency(Number(e.target.value))}
+                    />
+                </div>
+                <div className="flex flex-col gap-1.5">
+                    <Label htmlFor="benchmark-cache">Start</Label>
+                    <select
+                        id="benchmark-cache"
+                        className="h-9 rounded-md border border-input bg-transparent px-2 text-sm"
+                        value={cacheMode}
+                        disabled={isRunning}
+                        onChange={(e) =>
+                            setCacheMode(e.target.value as BenchmarkCacheMode)
+                        }
+                        title="Warm runs the tool once before measuring"
+                    >
+                        <option value="warm">Warm</option>
+                        <option value="cold">Cold</option>
+                    </select>
+                </div>
+                <div className="flex items-center gap-2 ml-auto">
+                    {isRunning ? (
+                        <Button variant="destructive" onClick={cancel}>
+                            Stop ({progress.completed}/{progress.total})
+                        </Button>
+                    ) : (
+                        <Button onClick={start} disabled={runs < 1}>
+                            Run Benchmark
+                        </Button>
+                    )}
+                    <Button
+                        variant="outline"
+                        onClick={exportReport}
+                        disabled={!report || isRunning}
+                    >
+                        Export JSON
+                    </Button>
+                </div>
+            </div>
+
+            {error && (
+                <div className="px-4 py-2 text-sm text-destructive border-b border-border">
+                    {error}
+                </div>
+            )}
+
+            {!report ? (
+                <div className="flex-1 flex flex-col items-center justify-center p-8 text-muted-foreground text-center">
+                    <div className="text-4xl mb-4">⏱️</div>
+                    <p className="max-w-xs">
+                        {isRunning
+                            ? 'Running...'
+                            : 'Each run uses a fresh executor without the result cache, so the tool really runs every time'}
+                    </p>
+                </div>
+            ) : (
+                <ScrollArea className="flex-1 min-h-0">
+                    <div className="px-4 py-3 grid grid-cols-[repeat(auto-fill,minmax(9rem,1fr))] gap-3">
+                        {stats.map(([label, value]) => (
+                            <div
+                                key={label}
+                                className="rounded-md border border-border p-2"
+                            >
+                                <div className="text-xs text-muted-foreground">
+                                    {label}
+                                </div>
+                                <div className="font-mono text-sm">{value}</div>
+                            </div>
+                        ))}
+                    </div>
+                    {report.cancelled && (
+                        <p className="px-4 text-xs text-muted-foreground">
+                            Stopped after {report.results.length} of{' '}
+                            {report.runs} runs
+                        </p>
+                    )}
+                    <table className="w-full text-xs font-mono">
+                        <thead className="text-muted-foreground text-left">
+                            <tr className="border-b border-border">
+                                <th className="px-4 py-2">Run</th>
+                                <th className="px-2 py-2 text-right">Time</th>
+                                <th className="px-2 py-2 text-right">Size</th>
+                                <th className="px-4 py-2">Error</th>
+                            </tr>
+                        </thead>
+                        <tbody>
+                            {report.results.map((run) => (
+                                <tr
+                                    key={run.run}
+                                    className="border-b border-border/50"
+                                >
+                                    <td className="px-4 py-1">{run.run}</td>
+                                    <td className="px-2 py-1 text-right">
+                                        {formatMs(run.durationMs)}
+                                    </td>
+                                    <td className="px-2 py-1 text-right">
+                                        {run.success
+                                            ? formatChars(run.responseChars)
+                                            : '–'}
+                                    </td>
+                                    <td className="px-4 py-1 text-destructive truncate max-w-xs">
+                                        {run.error}
+                                    </td>
+                                </tr>
+                            ))}
+                        </tbody>
+                    </table>
+                </ScrollArea>
+            )}
+        </div>
+    );
+};
+
+export default BenchmarkPanel;
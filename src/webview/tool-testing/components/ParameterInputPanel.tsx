@@ -13,6 +13,8 @@ interface ParameterInputPanelProps {
     toolInfo: ToolInfo | undefined;
     initialParameters: Record<string, any>;
     onExecute: (parameters: Record<string, any>) => Promise<void>;
+    /** Open benchmark mode with the current parameters */
+    onBenchmark?: (parameters: Record<string, any>) => void;
     isExecuting: boolean;
     validationErrors: FormValidationError[];
     onCancel: () => void;
@@ -36,6 +38,7 @@ export const ParameterInputPanel: React.FC<ParameterInputPanelProps> = ({
     toolInfo,
     initialParameters,
     onExecute,
+    onBenchmark,
     isExecuting,
     validationErrors,
     onCancel,
@@ -165,12 +168,9 @@ export const ParameterInputPanel: React.FC<ParameterInputPanelProps> = ({
         return value;
     };
 
-    const handleExecute = async () => {
-        if (!toolInfo || isExecuting) {
-            return;
-        }
-
-        const filteredParams = Object.entries(parameters).reduce(
+    // Drop empty optional parameters and parse array/object inputs
+    const buildParameters = () =>
+        Object.entries(parameters).reduce(
             (acc, [key, value]) => {
                 const paramInfo = parameterInfos.find((p) => p.name === key);
                 if (
@@ -187,7 +187,12 @@ export const ParameterInputPanel: React.FC<ParameterInputPanelProps> = ({
             {} as Record<string, any>
         );
 
-        await onExecute(filteredParams);
+    const handleExecute = async () => {
+        if (!toolInfo || isExecuting) {
+            return;
+        }
+
+        await onExecute(buildParameters());
     };
 
     const handleClearForm = () => {
@@ -353,6 +358,17 @@ export const ParameterInputPanel: React.FC<ParameterInputPanelProps> = ({
                         >
                             Clear Form
                         </Button>
+                        {onBenchmark && (
+                            <Button
+                                type="button"
+                                variant="outline"
+                                onClick={() => onBenchmark(buildParameters())}
+                                disabled={!isFormValid}
+                                title="Run the tool repeatedly and measure latency"
+                            >
+                                Benchmark
+                            </Button>
+                        )}
                         <Button
                             type="button"
                             onClick={handleExecute}
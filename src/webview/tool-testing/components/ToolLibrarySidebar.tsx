@@ -8,6 +8,8 @@ interface ToolLibrarySidebarProps {
     searchQuery: string;
     onToolSelect: (toolName: string) => void;
     onSearchChange: (query: string) => void;
+    showingMetrics: boolean;
+    onShowMetrics: () => void;
 }
 
 // React Compiler handles memoization automatically
@@ -17,6 +19,8 @@ export const ToolLibrarySidebar: React.FC<ToolLibrarySidebarProps> = ({
     searchQuery,
     onToolSelect,
     onSearchChange,
+    showingMetrics,
+    onShowMetrics,
 }) => {
     // Filter tools based on search query
     const filteredTools = searchQuery
@@ -84,7 +88,10 @@ export const ToolLibrarySidebar: React.FC<ToolLibrarySidebarProps> = ({
                             <ToolItem
                                 key={tool.name}
                                 tool={tool}
-                                isSelected={selectedTool === tool.name}
+                                isSelected={
+                                    !showingMetrics &&
+                                    selectedTool === tool.name
+                                }
                                 onSelect={handleToolSelect}
                             />
                         ))}
@@ -107,6 +114,20 @@ export const ToolLibrarySidebar: React.FC<ToolLibrarySidebarProps> = ({
                     )}
                 </div>
             </div>
+
+            <div className="p-2 border-t border-border">
+                <button
+                    className={`w-full text-left p-1.5 rounded-sm transition-colors ${
+                        showingMetrics
+                            ? 'bg-accent text-accent-foreground'
+                            : 'hover:bg-accent/50 hover:text-accent-foreground'
+                    }`}
+                    onClick={onShowMetrics}
+                    aria-pressed={showingMetrics}
+                >
+                    📈 Tool Statistics
+                </button>
+            </div>
         </div>
     );
 };
@@ -0,0 +1,143 @@
+import React, { useEffect, useState } from 'react';
+import { useVSCodeApi } from '../../hooks/useVSCodeApi';
+import { Button } from '../../../components/ui/button';
+import { ScrollArea } from '../../../components/ui/scroll-area';
+import type { ToolMetricsSnapshot } from '../../../services/toolMetricsStore';
+
+const formatMs = (ms: number) =>
+    ms < 1000 ? `${Math.round(ms)}ms` : `${(ms / 1000).toFixed(1)}s`;
+
+const formatChars = (chars: number) =>
+    chars < 1000 ? String(chars) : `${(chars / 1000).toFixed(1)}k`;
+
+const formatRate = (rate: number) =>
+    rate === 0 ? '–' : `${(rate * 100).toFixed(1)}%`;
+
+/**
+ * Aggregated per-tool statistics from every analysis, chat request and tool
+ * test since the extension started (or the last reset).
+ */
+export const ToolMetricsPanel: React.FC = () => {
+    const vscode = useVSCodeApi();
+    const [snapshot, setSnapshot] = useState<ToolMetricsSnapshot | null>(
+        null
+    );
+
+    useEffect(() => {
+        const handleMessage = (event: MessageEvent) => {
+            if (event.data.type === 'toolMetrics') {
+                setSnapshot(event.data.payload ?? null);
+            }
+        };
+
+        window.addEventListener('message', handleMessage);
+        vscode?.postMessage({ command: 'getToolMetrics', payload: {} });
+        return () => window.removeEventListener('message', handleMessage);
+    }, [vscode]);
+
+    const refresh = () =>
+        vscode?.postMessage({ command: 'getToolMetrics', payload: {} });
+    const reset = () =>
+        vscode?.postMessage({ command: 'resetToolMetrics', payload: {} });
+
+    return (
+        <div className="flex flex-col h-full">
+            <div className="px-4 py-3 border-b border-border flex items-center justify-between shrink-0">
+                <div>
+                    <h2 className="font-semibold">Tool Statistics</h2>
+                    {snapshot && (
+                        <p className="text-xs text-muted-foreground">
+                            {snapshot.totalCalls} calls since{' '}
+                            {new Date(snapshot.since).toLocaleString()}
+                        </p>
+                    )}
+                </div>
+                <div className="flex items-center gap-2">
+                    <Button variant="secondary" size="sm" onClick={refresh}>
+                        Refresh
+                    </Button>
+                    <Button variant="ghost" size="sm" onClick={reset}>
+                        Reset
+                    </Button>
+                </div>
+            </div>
+
+            {!snapshot || snapshot.tools.length === 0 ? (
+                <div className="flex-1 flex flex-col items-center justify-center p-8 text-muted-foreground text-center">
+                    <div className="text-4xl mb-4">📈</div>
+                    <h3 className="text-lg font-semibold mb-2">
+                        No Tool Calls Recorded
+                    </h3>
+                    <p className="max-w-xs">
+                        Statistics appear here after an analysis, chat request
+                        or tool test
+                    </p>
+                </div>
+            ) : (
+                <ScrollArea className="flex-1 min-h-0">
+                    <table className="w-full text-xs font-mono">
+                        <thead className="text-muted-foreground text-left">
+                            <tr className="border-b border-border">
+                                <th className="px-4 py-2">Tool</th>
+                                <th className="px-2 py-2 text-right">Calls</th>
+                                <th className="px-2 py-2 text-right">p50</th>
+                                <th className="px-2 py-2 text-right">p95</th>
+                                <th className="px-2 py-2 text-right">p99</th>
+                                <th className="px-2 py-2 text-right">
+                                    Size p50/p95/max
+                                </th>
+                                <th className="px-2 py-2 text-right">Errors</th>
+                                <th className="px-2 py-2 text-right">
+                                    Timeouts
+                                </th>
+                                <th className="px-4 py-2 text-right">
+                                    Too large
+                                </th>
+                            </tr>
+                        </thead>
+                        <tbody>
+                            {snapshot.tools.map((tool) => (
+                                <tr
+                                    key={tool.toolName}
+                                    className="border-b border-border/50"
+                                >
+                                    <td className="px-4 py-1.5">
+                                        {tool.toolName}
+                                    </td>
+                                    <td className="px-2 py-1.5 text-right">
+                                        {tool.calls}
+                                    </td>
+                                    <td className="px-2 py-1.5 text-right">
+                                        {formatMs(tool.latencyMs.p50)}
+                                    </td>
+                                    <td className="px-2 py-1.5 text-right">
+                                        {formatMs(tool.latencyMs.p95)}
+                                    </td>
+                                    <td className="px-2 py-1.5 text-right">
+                                        {formatMs(tool.latencyMs.p99)}
+                                    </td>
+                                    <td className="px-2 py-1.5 text-right">
+                                        {formatChars(tool.responseChars.p50)}/
+                                        {formatChars(tool.responseChars.p95)}/
+                                        {formatChars(tool.responseChars.max)}
+                                    </td>
+                                    <td className="px-2 py-1.5 text-right">
+                                        {formatRate(tool.errorRate)}
+                                    </td>
+                                    <td className="px-2 py-1.5 text-right">
+                                        {formatRate(tool.timeoutRate)}
+                                    </td>
+                                    <td className="px-4 py-1.5 text-right">
+                                        {formatRate(tool.oversizedRate)}
+                                    </td>
+                                </tr>
+                            ))}
+                        </tbody>
+                    </table>
+                </ScrollArea>
+            )}
+        </div>
+    );
+};
+
+export default ToolMetricsPanel;
@@ -0,0 +1,8 @@
+/**
+ * Vite bundles `?worker&inline` imports into a blob-backed Worker
+ * constructor. Webviews can only start workers from blob: or data: URLs.
+ */
+declare module '*?worker&inline' {
+    const WorkerConstructor: new () => Worker;
+    export default WorkerConstructor;
+}
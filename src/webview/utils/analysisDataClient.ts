@@ -0,0 +1,120 @@
+import { parseDiff, type FileData } from 'react-diff-view';
+import type { ToolCallRecord } from '../../types/toolCallTypes';
+import type {
+    DiffFilesResultPayload,
+    ToolCallDetailsResultPayload,
+} from '../../types/webviewMessages';
+
+/**
+ * Loads items by index from the extension host. Requests made in the same
+ * task are sent as one message, and every item is requested at most once.
+ * Items the host has no data for resolve to undefined.
+ */
+class IndexedLoader<T> {
+    private readonly cache = new Map<number, Promise<T | undefined>>();
+    private readonly waiting = new Map<
+        number,
+        (value: T | undefined) => void
+    >();
+    private queued: number[] = [];
+
+    constructor(private readonly command: string) {}
+
+    load(index: number): Promise<T | undefined> {
+        const cached = this.cache.get(index);
+        if (cached) {
+            return cached;
+        }
+
+        const vscode = window.vscode;
+        if (!vscode) {
+            return Promise.resolve(undefined);
+        }
+        const promise = new Promise<T | undefined>((resolve) => {
+            this.waiting.set(index, resolve);
+        });
+        this.cache.set(index, promise);
+
+        if (this.queued.length === 0) {
+            setTimeout(() => {
+                const indices = this.queued;
+                this.queued = [];
+                vscode.postMessage({
+                    command: this.command,
+                    payload: { indices },
+                });
+            }, 0);
+        }
+        this.queued.push(index);
+        return promise;
+    }
+
+    receive(index: number, value: T): void {
+        this.waiting.get(index)?.(value);
+        this.waiting.delete(index);
+    }
+
+    /** The host answered a request; resolve what it skipped as missing */
+    settle(requested: readonly number[]): void {
+        for (const index of requested) {
+            const resolve = this.waiting.get(index);
+            if (resolve) {
+                this.waiting.delete(index);
+                resolve(undefined);
+            }
+        }
+    }
+}
+
+const diffFiles = new IndexedLoader<string>('getDiffFiles');
+const toolCalls = new IndexedLoader<ToolCallRecord>('getToolCallDetails');
+const parsedFiles = new Map<number, Promise<FileData | undefined>>();
+
+window.addEventListener('message', (event: MessageEvent) => {
+    const message = event.data;
+    if (message?.command === 'diffFilesResult') {
+        const payload: DiffFilesResultPayload = message.payload;
+        for (const file of payload.files) {
+            diffFiles.receive(file.index, file.text);
+        }
+        if (payload.requested) {
+            diffFiles.settle(payload.requested);
+        }
+    } else if (message?.command === 'toolCallDetailsResult') {
+        const payload: ToolCallDetailsResultPayload = message.payload;
+        for (const { index, call } of payload.calls) {
+            toolCalls.receive(index, call);
+        }
+        if (payload.requested) {
+            toolCalls.settle(payload.requested);
+        }
+    }
+});
+
+/**
+ * Parsed diff of one file, by index into the manifest's diff files. Parsed
+ * once, so word tokens cached by hunks stay valid across remounts.
+ */
+export const loadDiffFile = (index: number): Promise<FileData | undefined> => {
+    let parsed = parsedFiles.get(index);
+    if (!parsed) {
+        parsed = diffFiles.load(index).then((text) => {
+            if (!text) {
+                return undefined;
+            }
+            try {
+                return parseDiff(text)[0];
+            } catch (error) {
+                console.error('Error parsing diff:', error);
+                return undefined;
+            }
+        });
+        parsedFiles.set(index, parsed);
+    }
+    return parsed;
+};
+
+/** Full tool call record, by index into the manifest's tool calls */
+export const loadToolCall = (
+    index: number
+): Promise<ToolCallRecord | undefined> => toolCalls.load(index);
@@ -0,0 +1,19 @@
+import { tokenize, markEdits, type HunkData } from 'react-diff-view';
+
+export type DiffTokens = ReturnType<typeof tokenize>;
+
+/**
+ * Word-level tokens for a file's hunks, so edited words within changed lines
+ * are highlighted. Returns null when tokenization fails; the diff is then
+ * shown without word highlighting.
+ */
+export function tokenizeHunks(hunks: HunkData[]): DiffTokens | null {
+    try {
+        return tokenize(hunks, {
+            enhancers: [markEdits(hunks, { type: 'line' })],
+        });
+    } catch (error) {
+        console.warn('Failed to tokenize diff hunks:', error);
+        return null;
+    }
+}
@@ -0,0 +1,59 @@
+import type { DiffFileSummary } from '../../types/webviewMessages';
+
+/** Approximate rendered height of one diff line */
+export const DIFF_LINE_HEIGHT_PX = 20;
+
+/** Approximate height of a file's header row */
+export const DIFF_FILE_HEADER_HEIGHT_PX = 37;
+
+/** Space below each file section */
+export const DIFF_FILE_GAP_PX = 16;
+
+/** Files with more lines than this start collapsed */
+export const LARGE_FILE_LINES = 400;
+
+/** Hunks rendered at once per file; more are added on request */
+export const HUNK_BATCH_SIZE = 40;
+
+/**
+ * How far outside the scroll container a file may be and still be rendered,
+ * so content is ready before it scrolls into view
+ */
+export const DIFF_OVERSCAN_PX = 1200;
+
+export function isCollapsedByDefault(
+    file: Pick<DiffFileSummary, 'lines'>
+): boolean {
+    return file.lines > LARGE_FILE_LINES;
+}
+
+/**
+ * Placeholder height for a file's diff that has not been rendered yet: the
+ * first batch of hunks, with one header line per hunk. Lines are assumed to
+ * be spread evenly over hunks.
+ */
+export function estimateDiffHeight(
+    file: Pick<DiffFileSummary, 'lines' | 'hunks'>
+): number {
+    const shownHunks = Math.min(file.hunks, HUNK_BATCH_SIZE);
+    const shownLines =
+        file.hunks > HUNK_BATCH_SIZE
+            ? Math.round((file.lines * shownHunks) / file.hunks)
+            : file.lines;
+    return (shownLines + shownHunks) * DIFF_LINE_HEIGHT_PX;
+}
+
+/**
+ * Height of a file section that has not been measured yet: header, gap and,
+ * when expanded, the estimated diff
+ */
+export function estimateFileSectionHeight(
+    file: Pick<DiffFileSummary, 'lines' | 'hunks'>,
+    expanded: boolean
+): number {
+    return (
+        DIFF_FILE_HEADER_HEIGHT_PX +
+        DIFF_FILE_GAP_PX +
+        (expanded ? estimateDiffHeight(file) : 0)
+    );
+}
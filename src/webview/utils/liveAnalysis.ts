@@ -0,0 +1,73 @@
+import type {
+    AnalysisManifest,
+    AnalysisUpdatePayload,
+} from '../../types/webviewMessages';
+
+export interface LiveAnalysisState {
+    manifest: AnalysisManifest;
+    /** Latest progress message while running, or why the analysis stopped */
+    statusMessage: string | undefined;
+}
+
+/**
+ * Apply one analysisUpdate message. Returns new objects for whatever changed
+ * so React re-renders only the affected tabs.
+ */
+export function applyAnalysisUpdate(
+    state: LiveAnalysisState,
+    update: AnalysisUpdatePayload
+): LiveAnalysisState {
+    const { manifest } = state;
+    switch (update.kind) {
+        case 'toolCall': {
+            const toolCalls = manifest.toolCalls ?? {
+                calls: [],
+                totalCalls: 0,
+                successfulCalls: 0,
+                failedCalls: 0,
+                analysisCompleted: false,
+                analysisError: undefined,
+            };
+            const calls = [...toolCalls.calls];
+            calls[update.index] = update.call;
+            return {
+                ...state,
+                manifest: {
+                    ...manifest,
+                    toolCalls: {
+                        ...toolCalls,
+                        calls,
+                        totalCalls: calls.length,
+                        successfulCalls:
+                            toolCalls.successfulCalls +
+                            (update.call.success ? 1 : 0),
+                        failedCalls:
+                            toolCalls.failedCalls +
+                            (update.call.success ? 0 : 1),
+                    },
+                },
+            };
+        }
+        case 'plan':
+            return { ...state, manifest: { ...manifest, plan: update.plan } };
+        case 'status':
+            return { ...state, statusMessage: update.message };
+        case 'stopped':
+            return {
+                manifest: { ...manifest, running: false },
+                statusMessage: update.message,
+            };
+        case 'complete':
+            return { manifest: update.manifest, statusMessage: undefined };
+    }
+}
+
+/**
+ * Markdown for the Analysis tab while the analysis is running: the latest
+ * review plan, if the model has written one
+ */
+export function formatLiveAnalysisContent(plan: string | undefined): string {
+    const note =
+        '_Analysis in progress. The review appears here when it completes; tool calls are listed in the Tool Calls tab as they run._';
+    return plan ? `${note}\n\n## Review Plan\n\n${plan}` : note;
+}
@@ -0,0 +1,185 @@
+import type { Element, ElementContent, Root, RootContent } from 'hast';
+import rehypeHighlight from 'rehype-highlight';
+import remarkGfm from 'remark-gfm';
+import remarkParse from 'remark-parse';
+import remarkRehype from 'remark-rehype';
+import { unified } from 'unified';
+
+export interface MarkdownCodeBlock {
+    /** From the fence info string, e.g. `ts`; empty if none */
+    language: string;
+    /** Source text without the trailing newline, for copying */
+    code: string;
+}
+
+/**
+ * Markdown parsed into plain data, so it can be produced in a worker and
+ * cached. Each fenced code block is replaced in `tree` by an empty `pre`
+ * whose `dataCodeBlock` property indexes `codeBlocks`, which lets the
+ * renderer highlight a block only when it nears the viewport (see
+ * highlightCode).
+ */
+export interface RenderedMarkdown {
+    tree: Root;
+    codeBlocks: MarkdownCodeBlock[];
+}
+
+const processor = unified().use(remarkParse).use(remarkGfm).use(remarkRehype);
+
+const highlighter = unified().use(rehypeHighlight);
+
+const textOf = (node: Root | RootContent): string => {
+    if (node.type === 'text') {
+        return node.value;
+    }
+    if ('children' in node) {
+        return (node.children as RootContent[]).map(textOf).join('');
+    }
+    return '';
+};
+
+const languageOf = (code: Element): string => {
+    const classNames = code.properties.className;
+    const languageClass = Array.isArray(classNames)
+        ? classNames.map(String).find((name) => name.startsWith('language-'))
+        : undefined;
+    return languageClass?.slice('language-'.length) ?? '';
+};
+
+const SAFE_PROTOCOL = /^(https?|ircs?|mailto|xmpp)$/i;
+
+/**
+ * Drop URLs with unsafe protocols (e.g. `javascript:`), keeping relative
+ * ones such as file links. Same rules as react-markdown's default.
+ */
+const sanitizeUrl = (url: string): string => {
+    const colon = url.indexOf(':');
+    const firstDelimiter = url.search(/[/?#]/);
+    if (
+        colon === -1 ||
+        (firstDelimiter !== -1 && colon > firstDelimiter) ||
+        SAFE_PROTOCOL.test(url.slice(0, colon))
+    ) {
+        return url;
+    }
+    return '';
+};
+
+/**
+ * Sanitize link and image URLs, and remove source positions: they are only
+ * useful for diagnostics and double the size sent from the worker.
+ */
+const cleanTree = (node: Root | RootContent): void => {
+    delete node.position;
+    if (node.type === 'element') {
+        for (const property of ['href', 'src']) {
+            const url = node.properties[property];
+            if (typeof url === 'string') {
+                node.properties[property] = sanitizeUrl(url);
+            }
+        }
+    }
+    if ('children' in node) {
+        for (const child of node.children as RootContent[]) {
+            cleanTree(child);
+        }
+    }
+};
+
+const extractCodeBlocks = (
+    parent: Root | Element,
+    codeBlocks: MarkdownCodeBlock[]
+): void => {
+    const children = parent.children as RootContent[];
+    for (let index = 0; index < children.length; index++) {
+        const child = children[index]!;
+        if (child.type !== 'element') {
+            continue;
+        }
+        const code =
+            child.tagName === 'pre'
+                ? child.children.find(
+                      (node): node is Element =>
+                          node.type === 'element' && node.tagName === 'code'
+                  )
+                : undefined;
+        if (!code) {
+            extractCodeBlocks(child, codeBlocks);
+            continue;
+        }
+        children[index] = {
+            type: 'element',
+            tagName: 'pre',
+            properties: { dataCodeBlock: codeBlocks.length },
+            children: [],
+        };
+        codeBlocks.push({
+            language: languageOf(code),
+            code: textOf(code).replace(/\n$/, ''),
+        });
+    }
+};
+
+/**
+ * Parse GitHub-flavored markdown, setting its fenced code blocks aside. Raw
+ * HTML in the markdown is dropped. Runs in the markdown renderer worker.
+ */
+export function renderMarkdown(content: string): RenderedMarkdown {
+    const tree = processor.runSync(processor.parse(content));
+    cleanTree(tree);
+    const codeBlocks: MarkdownCodeBlock[] = [];
+    extractCodeBlocks(tree, codeBlocks);
+    return { tree, codeBlocks };
+}
+
+/**
+ * highlight.js `hljs-*` spans for one code block; plain text for unknown
+ * languages. Runs in the code highlighter worker, one block at a time.
+ */
+export function highlightCode(block: MarkdownCodeBlock): ElementContent[] {
+    const tree: Root = {
+        type: 'root',
+        children: [
+            {
+                type: 'element',
+                tagName: 'pre',
+                properties: {},
+                children: [
+                    {
+                        type: 'element',
+                        tagName: 'code',
+                        properties: block.language
+                            ? { className: [`language-${block.language}`] }
+                            : {},
+                        children: [{ type: 'text', value: block.code }],
+                    },
+                ],
+            },
+        ],
+    };
+    const highlighted = highlighter.runSync(tree);
+    const pre = highlighted.children[0] as Element;
+    const code = pre.children[0] as Element;
+    cleanTree(code);
+    return code.children;
+}
+
+/**
+ * Cache key for a markdown document: its length and a 53-bit hash (cyrb53)
+ * of its text, so large documents needn't be kept around as keys.
+ */
+export function hashContent(content: string): string {
+    let h1 = 0xdeadbeef;
+    let h2 = 0x41c6ce57;
+    for (let index = 0; index < content.length; index++) {
+        const char = content.charCodeAt(index);
+        h1 = Math.imul(h1 ^ char, 2654435761);
+        h2 = Math.imul(h2 ^ char, 1597334677);
+    }
+    h1 = Math.imul(h1 ^ (h1 >>> 16), 2246822507);
+    h1 ^= Math.imul(h2 ^ (h2 >>> 13), 3266489909);
+    h2 = Math.imul(h2 ^ (h2 >>> 16), 2246822507);
+    h2 ^= Math.imul(h1 ^ (h1 >>> 13), 3266489909);
+    const hash = 4294967296 * (2097151 & h2) + (h1 >>> 0);
+    return `${content.length.toString(36)}:${hash.toString(36)}`;
+}
@@ -0,0 +1,100 @@
+import type {
+    IterationTokenUsage,
+    TokenBreakdown,
+} from '../../types/toolCallTypes';
+
+export interface TokenCategoryTotals {
+    system: number;
+    prompt: number;
+    assistant: number;
+    toolResults: number;
+    other: number;
+    /** Tool result tokens by tool name, largest first */
+    tools: [string, number][];
+}
+
+/**
+ * Sum the per-iteration categories. Every request re-sends the history, so
+ * these are tokens sent, not unique tokens.
+ */
+export const sumTokenCategories = (
+    iterations: IterationTokenUsage[]
+): TokenCategoryTotals => {
+    const totals: TokenCategoryTotals = {
+        system: 0,
+        prompt: 0,
+        assistant: 0,
+        toolResults: 0,
+        other: 0,
+        tools: [],
+    };
+    const byTool = new Map<string, number>();
+
+    for (const usage of iterations) {
+        totals.system += usage.system;
+        totals.prompt += usage.prompt;
+        totals.assistant += usage.assistant;
+        totals.other += usage.other;
+        for (const [toolName, tokens] of Object.entries(usage.toolResults)) {
+            totals.toolResults += tokens;
+            byTool.set(toolName, (byTool.get(toolName) ?? 0) + tokens);
+        }
+    }
+
+    totals.tools = [...byTool].sort((a, b) => b[1] - a[1]);
+    return totals;
+};
+
+/**
+ * Make text safe inside a markdown table cell: line breaks would end the row
+ * and an unescaped `|` would start a new cell.
+ */
+const escapeTableCell = (text: string): string =>
+    text
+        .replace(/\s+/g, ' ')
+        .trim()
+        .replace(/\\/g, '\\\\')
+        .replace(/\|/g, '\\|');
+
+/**
+ * Token usage section for the markdown export of the Tool Calls tab
+ */
+export const formatTokenBreakdownAsMarkdown = (
+    breakdown: TokenBreakdown
+): string[] => {
+    const totals = sumTokenCategories(breakdown.iterations);
+    const lines = [
+        '## Token Usage',
+        '',
+        `- **Prompt Tokens Sent:** ${breakdown.totalPromptTokens} over ${breakdown.iterations.length} requests (context window ${breakdown.maxInputTokens})`,
+        `- **System Prompt:** ${totals.system}`,
+        `- **Diff and Instructions:** ${totals.prompt}`,
+        `- **Assistant Messages:** ${totals.assistant}`,
+        `- **Tool Results:** ${totals.toolResults}`,
+        `- **Other Messages:** ${totals.other}`,
+        `- **Evicted by Context Cleanup:** ${breakdown.evictedTokens}`,
+    ];
+
+    if (totals.tools.length > 0) {
+        lines.push('', '| Tool | Result Tokens |', '| --- | ---: |');
+        for (const [toolName, tokens] of totals.tools) {
+            lines.push(`| ${escapeTableCell(toolName)} | ${tokens} |`);
+        }
+    }
+
+    if (breakdown.subagents.length > 0) {
+        lines.push(
+            '',
+            '| Subagent | Iterations | Tokens |',
+            '| --- | ---: | ---: |'
+        );
+        for (const subagent of breakdown.subagents) {
+            lines.push(
+                `| #${subagent.subagentId} ${escapeTableCell(subagent.task)} | ${subagent.iterations} | ${subagent.tokens} |`
+            );
+        }
+    }
+
+    lines.push('');
+    return lines;
+};
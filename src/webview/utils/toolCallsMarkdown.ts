@@ -0,0 +1,88 @@
+import type { ToolCallsData, ToolCallRecord } from '../../types/toolCallTypes';
+import { formatTokenBreakdownAsMarkdown } from './tokenBreakdown';
+
+/**
+ * Formats tool calls data as markdown for clipboard export
+ */
+export const formatToolCallsAsMarkdown = (toolCalls: ToolCallsData): string => {
+    const lines: string[] = [
+        '# Tool Calls Report',
+        '',
+        '## Summary',
+        '',
+        `- **Total Calls:** ${toolCalls.totalCalls}`,
+        `- **Successful:** ${toolCalls.successfulCalls}`,
+        `- **Failed:** ${toolCalls.failedCalls}`,
+        `- **Analysis Completed:** ${toolCalls.analysisCompleted ? 'Yes' : 'No'}`,
+    ];
+
+    if (toolCalls.analysisError) {
+        lines.push(`- **Error:** ${toolCalls.analysisError}`);
+    }
+
+    lines.push('');
+    if (toolCalls.tokenBreakdown) {
+        lines.push(...formatTokenBreakdownAsMarkdown(toolCalls.tokenBreakdown));
+    }
+
+    lines.push('## Tool Calls', '');
+
+    const formatCall = (
+        call: ToolCallRecord,
+        prefix: string,
+        isNested: boolean = false
+    ) => {
+        const status = call.success ? '✅' : '❌';
+        const duration =
+            call.durationMs !== undefined ? ` (${call.durationMs}ms)` : '';
+        const headingLevel = isNested ? '####' : '###';
+        const subagent = call.subagentLabel ? ` [${call.subagentLabel}]` : '';
+
+        lines.push(
+            `${headingLevel} ${prefix} ${status} ${call.toolName}${subagent}${duration}`
+        );
+        lines.push('');
+
+        lines.push('**Arguments:**');
+        lines.push('```json');
+        lines.push(JSON.stringify(call.arguments, null, 2));
+        lines.push('```');
+        lines.push('');
+
+        if (call.error) {
+            lines.push('**Error:**');
+            lines.push(`> ${call.error}`);
+        } else {
+            lines.push('**Result:**');
+            if (typeof call.result === 'string') {
+                lines.push('```');
+                lines.push(call.result);
+                lines.push('```');
+            } else {
+                lines.push('```json');
+                lines.push(JSON.stringify(call.result, null, 2));
+                lines.push('```');
+            }
+        }
+        lines.push('');
+
+        // Format nested calls if present (for subagent)
+        if (call.nestedCalls && call.nestedCalls.length > 0) {
+            lines.push('**Subagent Tool Calls:**', '');
+            call.nestedCalls.forEach((nestedCall, nestedIndex) => {
+                formatCall(nestedCall, `${prefix}.${nestedIndex + 1}`, true);
+            });
+        } else if (call.nestedCallsRef && call.nestedCallsRef.count > 0) {
+            lines.push(
+                `**Subagent Tool Calls:** ${call.nestedCallsRef.count} (expand in the Tool Calls tab to view)`,
+                ''
+            );
+        }
+    };
+
+    toolCalls.calls.forEach((call, index) => {
+        formatCall(call, `${index + 1}`);
+    });
+
+    return lines.join('\n');
+};
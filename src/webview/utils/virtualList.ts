@@ -0,0 +1,50 @@
+/** How far outside the scroll container items are still rendered */
+export const VIRTUAL_OVERSCAN_PX = 600;
+
+export interface VirtualRange {
+    /** First rendered item */
+    start: number;
+    /** One past the last rendered item */
+    end: number;
+    /** Space taken by the items before `start` */
+    offsetBefore: number;
+    /** Space taken by the items from `end` on */
+    offsetAfter: number;
+}
+
+/**
+ * Items of a vertical list that intersect the scrolled viewport, widened by
+ * `overscanPx` on both sides.
+ *
+ * @param heights Height of every item, measured or estimated
+ */
+export function computeVirtualRange(
+    heights: readonly number[],
+    scrollTop: number,
+    viewportHeight: number,
+    overscanPx: number = VIRTUAL_OVERSCAN_PX
+): VirtualRange {
+    const top = scrollTop - overscanPx;
+    const bottom = scrollTop + viewportHeight + overscanPx;
+
+    let start = 0;
+    let offset = 0;
+    while (start < heights.length && offset + heights[start]! <= top) {
+        offset += heights[start]!;
+        start++;
+    }
+    const offsetBefore = offset;
+
+    let end = start;
+    while (end < heights.length && offset < bottom) {
+        offset += heights[end]!;
+        end++;
+    }
+
+    let offsetAfter = 0;
+    for (let index = end; index < heights.length; index++) {
+        offsetAfter += heights[index]!;
+    }
+
+    return { start, end, offsetBefore, offsetAfter };
+}
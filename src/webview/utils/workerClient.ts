@@ -0,0 +1,125 @@
+export interface WorkerRequest<T> {
+    id: number;
+    request: T;
+}
+
+export type WorkerResponse<T> =
+    | { id: number; result: T }
+    /** The handler threw; the message of what it threw */
+    | { id: number; error: string };
+
+/**
+ * Answer requests sent by a client from `createWorkerClient`. Call once at
+ * the top level of a worker module. A handler that throws answers with the
+ * error, so the request still settles.
+ */
+export const handleWorkerRequests = <Request, Result>(
+    handler: (request: Request) => Result
+): void => {
+    const scope = self as unknown as {
+        onmessage:
+            | ((event: MessageEvent<WorkerRequest<Request>>) => void)
+            | null;
+        postMessage(message: WorkerResponse<Result>): void;
+    };
+    scope.onmessage = (event) => {
+        const { id, request } = event.data;
+        try {
+            scope.postMessage({ id, result: handler(request) });
+        } catch (error) {
+            scope.postMessage({
+                id,
+                error: error instanceof Error ? error.message : String(error),
+            });
+        }
+    };
+};
+
+/**
+ * Send requests to a lazily started Web Worker. If the worker can't be
+ * started or fails, requests run on the main thread instead, each deferred
+ * to its own task so a burst of them doesn't block input.
+ *
+ * The returned promise rejects when the computation itself throws, in the
+ * worker or on the main thread; callers fall back to a plain rendering.
+ *
+ * @param name For console warnings
+ * @param createWorker Constructor from a `?worker&inline` import
+ * @param runOnMainThread Same computation as the worker's handler
+ */
+export const createWorkerClient = <Request, Result>(
+    name: string,
+    createWorker: () => Worker,
+    runOnMainThread: (request: Request) => Result
+): ((request: Request) => Promise<Result>) => {
+    const pending = new Map<
+        number,
+        {
+            request: Request;
+            resolve: (result: Result) => void;
+            reject: (error: Error) => void;
+        }
+    >();
+    let nextRequestId = 1;
+    /** undefined until first use; null if workers are unavailable */
+    let worker: Worker | null | undefined;
+
+    const runDeferred = (request: Request): Promise<Result> =>
+        new Promise((resolve, reject) =>
+            setTimeout(() => {
+                try {
+                    resolve(runOnMainThread(request));
+                } catch (error) {
+                    reject(error);
+                }
+            }, 0)
+        );
+
+    const getWorker = (): Worker | null => {
+        if (worker !== undefined) {
+            return worker;
+        }
+        try {
+            worker = createWorker();
+            worker.onmessage = (
+                event: MessageEvent<WorkerResponse<Result>>
+            ) => {
+                const response = event.data;
+                const entry = pending.get(response.id);
+                pending.delete(response.id);
+                if ('error' in response) {
+                    entry?.reject(
+                        new Error(`${name} failed: ${response.error}`)
+                    );
+                } else {
+                    entry?.resolve(response.result);
+                }
+            };
+            worker.onerror = (event) => {
+                console.warn(`${name} worker failed:`, event.message);
+                worker?.terminate();
+                worker = null;
+                for (const { request, resolve, reject } of pending.values()) {
+                    runDeferred(request).then(resolve, reject);
+                }
+                pending.clear();
+            };
+        } catch (error) {
+            console.warn(`${name} worker unavailable:`, error);
+            worker = null;
+        }
+        return worker;
+    };
+
+    return (request) => {
+        const target = getWorker();
+        if (!target) {
+            return runDeferred(request);
+        }
+        const id = nextRequestId++;
+        return new Promise((resolve, reject) => {
+            pending.set(id, { request, resolve, reject });
+            target.postMessage({ id, request });
+        });
+    };
+};
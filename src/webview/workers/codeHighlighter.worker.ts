@@ -0,0 +1,8 @@
+import { highlightCode } from '../utils/markdownTree';
+import { handleWorkerRequests } from '../utils/workerClient';
+
+/**
+ * Highlights review code blocks off the webview's main thread, one block at
+ * a time as they near the viewport.
+ */
+handleWorkerRequests(highlightCode);
@@ -0,0 +1,8 @@
+import { tokenizeHunks } from '../utils/diffTokens';
+import { handleWorkerRequests } from '../utils/workerClient';
+
+/**
+ * Tokenizes diff hunks off the webview's main thread. Loaded as an inline
+ * (blob) worker because webviews can't load workers from extension files.
+ */
+handleWorkerRequests(tokenizeHunks);
@@ -0,0 +1,8 @@
+import { renderMarkdown } from '../utils/markdownTree';
+import { handleWorkerRequests } from '../utils/workerClient';
+
+/**
+ * Parses review markdown off the webview's main thread. Code blocks are
+ * highlighted separately, in codeHighlighter.worker.ts.
+ */
+handleWorkerRequests(renderMarkdown);
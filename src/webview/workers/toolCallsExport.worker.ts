@@ -0,0 +1,8 @@
+import { formatToolCallsAsMarkdown } from '../utils/toolCallsMarkdown';
+import { handleWorkerRequests } from '../utils/workerClient';
+
+/**
+ * Formats the Tool Calls report off the webview's main thread; large results
+ * make the JSON formatting take long enough to freeze the tab.
+ */
+handleWorkerRequests(formatToolCallsAsMarkdown);
@@ -73,7 +73,6 @@ export default defineConfig(({ mode, command }: ConfigEnv): UserConfig => {
         : { main: resolve(__dirname, 'src/webview/main.tsx') };
 
     // Webview app configuration (browser-like)
-    // Note: PrismAsyncLight creates separate chunks for each language - this is expected
     const webviewBuildConfig: BuildOptions = {
         rollupOptions: {
             input: webviewInputs,
@@ -136,6 +135,9 @@ export default defineConfig(({ mode, command }: ConfigEnv): UserConfig => {
                     environment: 'node',
                     include: ['src/**/*.{test,spec}.ts'],
                     exclude: ['src/**/*.{test,spec}.tsx'],
+                    benchmark: {
+                        include: ['src/__benchmarks__/**/*.bench.ts'],
+                    },
                     alias: {
                         vscode: resolve(__dirname, './__mocks__/vscode.js'),
                     },